@@ -23,17 +23,23 @@ set(CPACK_PACKAGE_VENDOR "FFI (Forsvarets forskningsinstitutt)")
 set(CPACK_RESOURCE_FILE_LICENSE "${CMAKE_SOURCE_DIR}/LICENSE")
 set(CPACK_VERBATIM_VARIABLES TRUE)
 
-set(CPACK_DEBIAN_PACKAGE_PROVIDES  "superflow-core,superflow-curses,superflow-loader,superflow-yaml")
-set(CPACK_DEBIAN_PACKAGE_CONFLICTS "superflow-core,superflow-curses,superflow-loader,superflow-yaml")
-set(CPACK_DEBIAN_PACKAGE_REPLACES  "superflow-core,superflow-curses,superflow-loader,superflow-yaml")
+set(CPACK_DEBIAN_PACKAGE_PROVIDES  "superflow-core,superflow-curses,superflow-io,superflow-ipc,superflow-loader,superflow-metrics,superflow-yaml")
+set(CPACK_DEBIAN_PACKAGE_CONFLICTS "superflow-core,superflow-curses,superflow-io,superflow-ipc,superflow-loader,superflow-metrics,superflow-yaml")
+set(CPACK_DEBIAN_PACKAGE_REPLACES  "superflow-core,superflow-curses,superflow-io,superflow-ipc,superflow-loader,superflow-metrics,superflow-yaml")
 unset_provides_conflicts_replaces("CORE")
 unset_provides_conflicts_replaces("CURSES")
+unset_provides_conflicts_replaces("IO")
+unset_provides_conflicts_replaces("IPC")
 unset_provides_conflicts_replaces("LOADER")
+unset_provides_conflicts_replaces("METRICS")
 unset_provides_conflicts_replaces("YAML")
 
 set(CPACK_DEBIAN_CORE_PACKAGE_DEPENDS "build-essential")
 set(CPACK_DEBIAN_CURSES_PACKAGE_DEPENDS "libncurses-dev")
+set(CPACK_DEBIAN_IO_PACKAGE_DEPENDS "build-essential")
+set(CPACK_DEBIAN_IPC_PACKAGE_DEPENDS "build-essential")
 set(CPACK_DEBIAN_LOADER_PACKAGE_DEPENDS "libboost-filesystem-dev")
+set(CPACK_DEBIAN_METRICS_PACKAGE_DEPENDS "build-essential")
 set(CPACK_DEBIAN_YAML_PACKAGE_DEPENDS "libyaml-cpp-dev")
 
 set(CPACK_DEB_COMPONENT_INSTALL ON)
@@ -74,5 +80,8 @@ include(CPack)
 
 cpack_add_component(core   DISPLAY_NAME core   DESCRIPTION "The flow::core library"   GROUP dev)
 cpack_add_component(curses DISPLAY_NAME curses DESCRIPTION "The flow::curses library" GROUP dev DEPENDS core)
+cpack_add_component(io     DISPLAY_NAME io     DESCRIPTION "The flow::io library"     GROUP dev DEPENDS core)
+cpack_add_component(ipc    DISPLAY_NAME ipc    DESCRIPTION "The flow::ipc library"    GROUP dev DEPENDS core)
 cpack_add_component(loader DISPLAY_NAME loader DESCRIPTION "The flow::loader library" GROUP dev DEPENDS core)
+cpack_add_component(metrics DISPLAY_NAME metrics DESCRIPTION "The flow::metrics library" GROUP dev DEPENDS core)
 cpack_add_component(yaml   DISPLAY_NAME yaml   DESCRIPTION "The flow::yaml library"   GROUP dev DEPENDS core)
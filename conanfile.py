@@ -22,7 +22,10 @@ class superflowRecipe(ConanFile):
     options = {
         "all":    [False, True],
         "curses": [False, True],
+        "io":     [False, True],
+        "ipc":    [False, True],
         "loader": [False, True],
+        "metrics": [False, True],
         "yaml":   [False, True],
         "shared": [False, True],
         "tests":  [False, True],
@@ -38,7 +41,10 @@ class superflowRecipe(ConanFile):
         "cmake/*",
         "core/*",
         "curses/*",
+        "io/*",
+        "ipc/*",
         "loader/*",
+        "metrics/*",
         "yaml/*",
         )
 
@@ -52,19 +58,31 @@ class superflowRecipe(ConanFile):
         if self.settings.os == "Windows" and self.options.curses:
             raise ConanInvalidConfiguration("Windows not supported for module 'curses'")
 
+        if self.settings.os != "Linux" and self.options.io:
+            raise ConanInvalidConfiguration("Only Linux is supported for module 'io'")
+
+        if self.settings.os != "Linux" and self.options.ipc:
+            raise ConanInvalidConfiguration("Only Linux is supported for module 'ipc'")
+
+        if self.settings.os == "Windows" and self.options.metrics:
+            raise ConanInvalidConfiguration("Windows not supported for module 'metrics'")
+
     def config_options(self):
         pass
 
     def configure(self):
         if self.options.all:
             self.options.curses = True
+            self.options.io = self.settings.os == "Linux"
+            self.options.ipc = self.settings.os == "Linux"
             self.options.loader = True
+            self.options.metrics = True
             self.options.yaml = True
 
         if self.options.loader:
             self.options.yaml = True
 
-        for lib_name in ['curses', 'loader', 'yaml']:
+        for lib_name in ['curses', 'io', 'ipc', 'loader', 'metrics', 'yaml']:
             if not getattr(self.options, lib_name):
                 setattr(self.options, lib_name, False)
 
@@ -80,7 +98,10 @@ class superflowRecipe(ConanFile):
         tc.variables["BUILD_TESTS"] = self.options.tests
         tc.variables["BUILD_all"] = self.options.all
         tc.variables["BUILD_curses"] = self.options.curses
+        tc.variables["BUILD_io"] = self.options.io
+        tc.variables["BUILD_ipc"] = self.options.ipc
         tc.variables["BUILD_loader"] = self.options.loader
+        tc.variables["BUILD_metrics"] = self.options.metrics
         tc.variables["BUILD_yaml"] = self.options.yaml
         tc.generate()
 
@@ -112,7 +133,7 @@ class superflowRecipe(ConanFile):
         cmake_layout(self)
 
     def package_info(self):
-        for lib_name in ['core', 'curses', 'loader', 'yaml']:
+        for lib_name in ['core', 'curses', 'io', 'ipc', 'loader', 'metrics', 'yaml']:
             if lib_name == 'core' or getattr(self.options, lib_name):
                 self.output.info("adding component '{}'".format(lib_name))
                 self.cpp_info.components[lib_name].set_property("cmake_target_name", f"{self.name}::{lib_name}")
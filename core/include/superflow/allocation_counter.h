@@ -0,0 +1,65 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace flow
+{
+/// \brief Heap allocations made by the thread running a Proxel.
+/// \see allocation::getThreadCounters, ProxelStatus
+struct AllocationStatistics
+{
+  uint64_t count = 0;          ///< Number of allocations
+  uint64_t bytes = 0;          ///< Number of bytes allocated
+  double count_per_item = 0.;  ///< Allocations per item consumed. 0 if nothing has been consumed.
+  double bytes_per_item = 0.;  ///< Bytes allocated per item consumed. 0 if nothing has been consumed.
+};
+
+/// \brief Opt-in accounting of heap allocations per thread.
+///
+/// Allocations are only counted if the executable replaces the global `operator new`
+/// by including `superflow/allocation_hooks.h` in exactly one of its source files.
+/// Then, every thread that has called getThreadCounters counts its allocations
+/// with two relaxed atomic increments each. Graph does this for every Proxel thread,
+/// and reports the counts in ProxelStatus::allocations.
+///
+/// \code{.cpp}
+/// const auto counters = flow::allocation::getThreadCounters();
+/// const auto before = flow::allocation::read(*counters);
+/// producer->send(item);
+/// consumer->getNext();
+/// const auto after = flow::allocation::read(*counters);
+/// EXPECT_EQ(before.count, after.count);
+/// \endcode
+namespace allocation
+{
+/// \brief The allocation totals of one thread, readable from any thread
+struct Counters
+{
+  std::atomic<uint64_t> count{0};
+  std::atomic<uint64_t> bytes{0};
+};
+
+/// \brief Start counting the allocations of the calling thread, if not already counting.
+/// \return The counters of the calling thread, valid after the thread has exited.
+[[nodiscard]] std::shared_ptr<const Counters> getThreadCounters();
+
+/// \brief Read a snapshot of counters
+[[nodiscard]] AllocationStatistics read(const Counters& counters);
+
+/// \brief True if `superflow/allocation_hooks.h` is part of the executable.
+[[nodiscard]] bool isInstrumented();
+
+namespace detail
+{
+/// Called by the allocation hooks for every allocation
+void record(size_t bytes) noexcept;
+
+/// Set by the allocation hooks when the executable is loaded
+extern std::atomic<bool> instrumented;
+}
+}
+}
@@ -0,0 +1,38 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+/// \file
+/// \brief Replaces the global `operator new` and `operator delete` in order to count allocations.
+///
+/// Include this header in exactly one source file of an executable, typically the one with
+/// `main`, to enable the allocation accounting of flow::allocation. The array, sized and
+/// nothrow variants all forward to the replaced operators. Over-aligned allocations are not counted.
+/// \see allocation::getThreadCounters
+
+#include "superflow/allocation_counter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace flow::allocation::detail
+{
+namespace
+{
+const bool hooks_installed = (instrumented.store(true), true);
+}
+}
+
+void* operator new(const std::size_t size)
+{
+  flow::allocation::detail::record(size);
+
+  if (void* ptr = std::malloc(size == 0 ? 1 : size))
+  { return ptr; }
+
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
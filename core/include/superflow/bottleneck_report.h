@@ -0,0 +1,64 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include "superflow/connection_spec.h"
+#include "superflow/proxel_status.h"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace flow
+{
+/// \brief Which Proxels limit the throughput of each pipeline in a Graph.
+///
+/// A pipeline is a set of Proxels connected to each other. The limiting stages of a pipeline are
+/// the busiest Proxels that also show backpressure, i.e. items queue up in their input buffers,
+/// are dropped from them, or block the producers. If no Proxel shows backpressure, the busiest
+/// Proxels are limiting. Busyness is measured by the consumer ports, and excludes the time a
+/// Proxel has been blocked by the full input buffers of its consumers, so that in a blocking chain
+/// only the slow stage is limiting, not the stages upstream of it that wait for it.
+/// \see analyzeBottlenecks, Graph::getBottleneckReport
+struct BottleneckReport
+{
+  struct Stage
+  {
+    std::string proxel;
+    double busyness = 0.;      ///< ProxelStatus::busyness, less the share of `output_blocked_time`
+    size_t queue_size = 0;     ///< Items waiting in the input buffers
+    size_t num_dropped = 0;    ///< Items dropped from full input buffers since start
+    double blocked_time = 0.;  ///< Time producers have been blocked by full input buffers since start, in seconds
+    bool backpressure = false; ///< True if any of the above is non-zero
+    double output_blocked_time = 0.; ///< Time the Proxel has been blocked by full buffers of its consumers since start, in seconds
+  };
+
+  struct Pipeline
+  {
+    std::vector<std::string> proxels;   ///< All Proxels of the pipeline, in alphabetical order
+    std::vector<Stage> limiting_stages; ///< Busiest first. Empty if no Proxel is measurably busy.
+    double predicted_speedup = 1.;      ///< Throughput gain if each limiting stage ran `parallelism` instances
+  };
+
+  size_t parallelism = 2;
+  std::vector<Pipeline> pipelines;
+};
+
+/// \brief Find the limiting stages of every pipeline, and predict the throughput gain
+/// from parallelizing them.
+///
+/// The busyness of each stage is assumed to be proportional to the throughput. Running
+/// the limiting stages on `parallelism` instances divides their busyness, so the pipeline
+/// can speed up until either they or the next busiest stage are fully loaded.
+/// \param statuses As returned by Graph::getProxelStatuses
+/// \param connections As returned by Graph::getConnections, from lhs (producer) to rhs (consumer)
+/// \param parallelism Number of instances assumed for each limiting stage
+/// \throws std::invalid_argument if `parallelism` is 0
+[[nodiscard]] BottleneckReport analyzeBottlenecks(
+  const ProxelStatusMap& statuses,
+  const std::vector<ConnectionSpec>& connections,
+  size_t parallelism = 2
+);
+
+/// \brief Write a BottleneckReport as one line per pipeline
+std::ostream& operator<<(std::ostream& os, const BottleneckReport& report);
+}
@@ -6,14 +6,31 @@
 #include "superflow/policy.h"
 #include "superflow/port.h"
 #include "superflow/queue_getter.h"
+#include "superflow/timeline.h"
+#include "superflow/trace.h"
 #include "superflow/utils/data_stream.h"
+#include "superflow/utils/edge_counter.h"
+#include "superflow/utils/get_timer.h"
 #include "superflow/utils/lock_queue.h"
+#include "superflow/utils/spill_queue.h"
+
+#include <atomic>
+#include <chrono>
+#include <type_traits>
 
 namespace flow
 {
 /// \brief
 ///
 /// The port has a buffer with configurable size containing data received from the producer.
+/// If tracing is enabled, each item keeps its trace while buffered, and `getNext` makes the
+/// trace current on the consuming thread.
+/// The time spent waiting in and between calls to `getNext`, the buffer usage and the time
+/// producers spend blocked by a full PushBlocking buffer are reported in the PortStatus.
+/// The items received, dropped and consumed are also counted per producer, \see getEdgeStatuses.
+/// With LeakPolicy::Spill, items that arrive while the buffer is full are spilled to a file instead
+/// of being dropped or blocking the producer, \see SpillQueue. The spilled items are reported in
+/// the PortStatus, and count towards its `queue_size`.
 /// \tparam T The type of data to be exchanged between ports.
 /// \tparam P ConnectPolicy, default is Single
 /// \tparam M GetMode, default is Blocking
@@ -35,6 +52,11 @@ public:
   using Ptr = std::shared_ptr<BufferedConsumerPort>;
   explicit BufferedConsumerPort(unsigned int buffer_size = 1);
 
+  /// \brief Create a port with LeakPolicy::Spill
+  /// \param buffer_size Number of items held in memory
+  /// \param spill_options Where and how much to spill when the memory is full
+  BufferedConsumerPort(unsigned int buffer_size, const SpillOptions& spill_options);
+
   void receive(const T&, const Port::Ptr&) override;
 
   void connect(const Port::Ptr& ptr) override;
@@ -61,13 +83,18 @@ public:
 
   PortStatus getStatus() const;
 
+  std::map<const Port*, EdgeStatus> getEdgeStatuses() const override;
+
   size_t getQueueSize() const;
 
 private:
   size_t num_transactions_ = 0;
-  LockQueue<T, L> buffer_;
+  GetTimer get_timer_;
+  EdgeCounter edge_counter_;
+  std::atomic<int64_t> blocked_ns_{0};
+  std::conditional_t<L == LeakPolicy::Spill, SpillQueue<T>, LockQueue<Traced<T>, L>> buffer_;
   ConnectionManager<P> connection_manager_;
-  QueueGetter<T, M, L> queue_getter_;
+  QueueGetter<Traced<T>, M, L> queue_getter_;
 };
 
 // ----- Implementations -----
@@ -89,12 +116,47 @@ template<
     LeakPolicy L,
     typename... Variants
 >
-void BufferedConsumerPort<T, P, M, L, Variants...>::receive(const T& item, const Port::Ptr&)
+BufferedConsumerPort<T, P, M, L, Variants...>::BufferedConsumerPort(
+  const unsigned int buffer_size,
+  const SpillOptions& spill_options
+)
+    : buffer_(buffer_size, spill_options)
+{
+  static_assert(L == LeakPolicy::Spill, "SpillOptions require LeakPolicy::Spill");
+}
+
+template<
+    typename T,
+    ConnectPolicy P,
+    GetMode M,
+    LeakPolicy L,
+    typename... Variants
+>
+void BufferedConsumerPort<T, P, M, L, Variants...>::receive(const T& item, const Port::Ptr& sender)
 {
   if (!buffer_.isTerminated())
   {
-    try { buffer_.push(item); }
-    catch(const flow::TerminatedException&) {}
+    const auto stamp = edge_counter_.received(sender.get(), ByteSize<T>{}(item));
+
+    if constexpr (L == LeakPolicy::PushBlocking)
+    {
+      const auto push_start = std::chrono::steady_clock::now();
+      const timeline::Span span{timeline::Activity::Blocked};
+      try { buffer_.push({item, tracing::getCurrent().id, sender.get(), stamp}); }
+      catch(const flow::TerminatedException&) {}
+
+      // Includes the uncontended push, which is negligible compared to actual blocking
+      blocked_ns_ += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - push_start).count();
+    }
+    else
+    {
+      try
+      {
+        if (const auto dropped = buffer_.push({item, tracing::getCurrent().id, sender.get(), stamp}))
+        { edge_counter_.dropped(dropped->sender); }
+      }
+      catch(const flow::TerminatedException&) {}
+    }
   }
 }
 
@@ -108,6 +170,7 @@ template<
 void BufferedConsumerPort<T, P, M, L, Variants...>::connect(const Port::Ptr& ptr)
 {
   connection_manager_.connect(shared_from_this(), ptr);
+  edge_counter_.add(ptr.get());
 }
 
 template<
@@ -120,6 +183,7 @@ template<
 void BufferedConsumerPort<T, P, M, L, Variants...>::disconnect() noexcept
 {
   connection_manager_.disconnect(shared_from_this());
+  edge_counter_.clear();
 }
 
 template<
@@ -132,6 +196,7 @@ template<
 void BufferedConsumerPort<T, P, M, L, Variants...>::disconnect(const Port::Ptr& ptr) noexcept
 {
   connection_manager_.disconnect(shared_from_this(), ptr);
+  edge_counter_.remove(ptr.get());
 }
 
 template<
@@ -155,12 +220,24 @@ template<
 >
 std::optional<T> BufferedConsumerPort<T, P, M, L, Variants...>::getNext()
 {
-  const auto item = queue_getter_.get(buffer_);
+  std::optional<Traced<T>> traced;
 
-  if (item)
-  { ++num_transactions_; }
+  {
+    const GetTimer::Scope timing{get_timer_};
+    const timeline::Span span{timeline::Activity::Waiting};
+    traced = queue_getter_.get(buffer_);
+  }
 
-  return item;
+  if (!traced)
+  { return std::nullopt; }
+
+  ++num_transactions_;
+  edge_counter_.consumed(traced->sender, traced->stamp);
+  const auto trace = tracing::find(traced->trace_id);
+  tracing::setCurrent(trace);
+  tracing::record(trace, this);
+
+  return std::move(traced->item);
 }
 
 template<
@@ -196,10 +273,35 @@ template<
 >
 PortStatus BufferedConsumerPort<T, P, M, L, Variants...>::getStatus() const
 {
-  return {
+  PortStatus status{
       connection_manager_.getNumConnections(),
-      num_transactions_
+      num_transactions_,
+      get_timer_.getWaitingTime(),
+      get_timer_.getProcessingTime(),
+      buffer_.getQueueSize(),
+      buffer_.getNumDropped(),
+      static_cast<double>(blocked_ns_.load(std::memory_order_relaxed)) * 1e-9
   };
+
+  if constexpr (L == LeakPolicy::Spill)
+  {
+    status.spilled_bytes = buffer_.getSpilledBytes();
+    status.num_spilled = buffer_.getNumSpilled();
+  }
+
+  return status;
+}
+
+template<
+    typename T,
+    ConnectPolicy P,
+    GetMode M,
+    LeakPolicy L,
+    typename... Variants
+>
+std::map<const Port*, EdgeStatus> BufferedConsumerPort<T, P, M, L, Variants...>::getEdgeStatuses() const
+{
+  return edge_counter_.get();
 }
 
 template<
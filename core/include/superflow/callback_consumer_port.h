@@ -4,12 +4,17 @@
 #include "superflow/connection_manager.h"
 #include "superflow/consumer_port.h"
 #include "superflow/policy.h"
+#include "superflow/trace.h"
+#include "superflow/utils/edge_counter.h"
 
 #include <functional>
 
 namespace flow
 {
 /// \brief This port calls a function every time data is received.
+/// The callback runs on the thread of the sender, with the trace of the item as the current trace.
+/// The items are counted per producer, \see getEdgeStatuses. There is no buffer, so nothing is
+/// dropped, and every item is consumed immediately.
 /// \tparam T The type of data to be exchanged between ports.
 /// \tparam P ConnectPolicy
 /// \tparam Variants... Optionally supported input variant types. \see ConsumerPort
@@ -40,8 +45,11 @@ public:
 
   PortStatus getStatus() const override;
 
+  std::map<const Port*, EdgeStatus> getEdgeStatuses() const override;
+
 private:
   size_t num_transactions_ = 0;
+  EdgeCounter edge_counter_;
 
   Callback callback_;
   ConnectionManager<P> connection_manager_;
@@ -62,8 +70,10 @@ template<
   ConnectPolicy P,
   typename... Variants
 >
-inline void CallbackConsumerPort<T, P, Variants...>::receive(const T& t, const Port::Ptr&)
+inline void CallbackConsumerPort<T, P, Variants...>::receive(const T& t, const Port::Ptr& sender)
 {
+  edge_counter_.delivered(sender.get(), ByteSize<T>{}(t));
+  tracing::record(tracing::getCurrent(), this);
   callback_(t);
   ++num_transactions_;
 }
@@ -76,6 +86,7 @@ template<
 void CallbackConsumerPort<T, P, Variants...>::connect(const Port::Ptr& ptr)
 {
   connection_manager_.connect(shared_from_this(), ptr);
+  edge_counter_.add(ptr.get());
 }
 
 template<
@@ -86,6 +97,7 @@ template<
 void CallbackConsumerPort<T, P, Variants...>::disconnect() noexcept
 {
   connection_manager_.disconnect(shared_from_this());
+  edge_counter_.clear();
 }
 
 template<
@@ -96,6 +108,7 @@ template<
 void CallbackConsumerPort<T, P, Variants...>::disconnect(const Port::Ptr& ptr) noexcept
 {
   connection_manager_.disconnect(shared_from_this(), ptr);
+  edge_counter_.remove(ptr.get());
 }
 
 template<
@@ -120,4 +133,14 @@ PortStatus CallbackConsumerPort<T, P, Variants...>::getStatus() const
       num_transactions_
   };
 }
+
+template<
+  typename T,
+  ConnectPolicy P,
+  typename... Variants
+>
+std::map<const Port*, EdgeStatus> CallbackConsumerPort<T, P, Variants...>::getEdgeStatuses() const
+{
+  return edge_counter_.get();
+}
 }
@@ -0,0 +1,308 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace flow
+{
+/// \brief The bytes of an item that can be written as they are, without encoding.
+struct ByteView
+{
+  const std::byte* data = nullptr;
+  size_t size = 0;
+};
+
+/// \brief The name of a trivially copyable type in the schema of its Codec.
+///
+/// The name must stay the same across builds and compilers, and change when the layout of the type
+/// changes in a way that its size does not tell. Arithmetic types, std::byte and std::arrays of named
+/// types are named out of the box. Specialize the trait for other trivially copyable types:
+/// \code{.cpp}
+/// template<>
+/// struct flow::SchemaTag<Pose>
+/// {
+///   static std::string name() { return "Pose{double x; double y; int64 timestamp;}"; }
+/// };
+/// \endcode
+/// \see Codec
+template<typename T, typename Enable = void>
+struct SchemaTag;
+
+template<typename T>
+struct SchemaTag<T, std::enable_if_t<std::is_arithmetic_v<T>>>
+{
+  static std::string name()
+  {
+    if constexpr (std::is_same_v<T, bool>)
+    { return "bool"; }
+    else if constexpr (std::is_same_v<T, char>)
+    { return "char"; }
+    else if constexpr (std::is_floating_point_v<T>)
+    { return "float" + std::to_string(8 * sizeof(T)); }
+    else if constexpr (std::is_signed_v<T>)
+    { return "int" + std::to_string(8 * sizeof(T)); }
+    else
+    { return "uint" + std::to_string(8 * sizeof(T)); }
+  }
+};
+
+template<>
+struct SchemaTag<std::byte>
+{
+  static std::string name()
+  { return "byte"; }
+};
+
+template<typename T, size_t N>
+struct SchemaTag<std::array<T, N>, std::void_t<decltype(SchemaTag<T>::name())>>
+{
+  static std::string name()
+  { return "array<" + SchemaTag<T>::name() + ',' + std::to_string(N) + '>'; }
+};
+
+namespace codec
+{
+/// \brief True if SchemaTag<T> is defined
+template<typename T, typename = void>
+struct HasSchemaTag : std::false_type
+{};
+
+template<typename T>
+struct HasSchemaTag<T, std::void_t<decltype(SchemaTag<T>::name())>> : std::true_type
+{};
+
+template<typename T>
+inline constexpr bool has_schema_tag_v = HasSchemaTag<T>::value;
+}
+
+/// \brief Converts items to and from bytes, for anything that leaves the process,
+/// such as recordings and the ports of the ipc module.
+///
+/// Trivially copyable types, strings and vectors of trivially copyable types are supported
+/// out of the box, as long as each trivially copyable type is named by a SchemaTag. Their bytes
+/// are available as a ByteView, so that they can be written without being copied into an
+/// intermediate buffer. Specialize the trait for other types:
+/// \code{.cpp}
+/// template<>
+/// struct flow::Codec<Detection>
+/// {
+///   static constexpr uint32_t version = 2;
+///   static std::string schema() { return "Detection{string label; float score;}"; }
+///   static void encode(const Detection& item, std::vector<std::byte>& buffer);
+///   static Detection decode(const std::byte* data, size_t size);
+/// };
+/// \endcode
+/// `encode` appends the bytes of the item to the buffer, and `decode` throws if the bytes are
+/// not a valid item. `version` and `schema` identify the encoding, and are checked against the
+/// CodecHeader of each message, so that a reader built with another encoding fails loudly.
+/// A specialization may also define `static ByteView view(const T& item)`, if the encoding is
+/// the bytes of the item as they are in memory.
+/// \see codec::encodeMessage, codec::decodeMessage
+template<typename T, typename Enable = void>
+struct Codec
+{
+  static_assert(
+    std::is_trivially_copyable_v<T>,
+    "flow::Codec<T> must be specialized for types that are not trivially copyable"
+  );
+
+  static_assert(
+    codec::has_schema_tag_v<T>,
+    "flow::SchemaTag<T> must be specialized to name a trivially copyable type sent through flow::Codec<T>"
+  );
+
+  static constexpr uint32_t version = 0;
+
+  /// The layout of a trivially copyable type is identified by its SchemaTag and size
+  static std::string schema()
+  { return SchemaTag<T>::name() + '/' + std::to_string(sizeof(T)); }
+
+  static ByteView view(const T& item)
+  { return {reinterpret_cast<const std::byte*>(&item), sizeof(T)}; }
+
+  static void encode(const T& item, std::vector<std::byte>& buffer)
+  {
+    const auto bytes = view(item);
+    buffer.insert(buffer.end(), bytes.data, bytes.data + bytes.size);
+  }
+
+  static T decode(const std::byte* data, const size_t size)
+  {
+    if (size != sizeof(T))
+    { throw std::invalid_argument{"Codec: expected " + std::to_string(sizeof(T)) + " bytes, got " + std::to_string(size)}; }
+
+    T item;
+    std::memcpy(&item, data, sizeof(T));
+    return item;
+  }
+};
+
+template<>
+struct Codec<std::string>
+{
+  static constexpr uint32_t version = 0;
+
+  static std::string schema()
+  { return "string"; }
+
+  static ByteView view(const std::string& item)
+  { return {reinterpret_cast<const std::byte*>(item.data()), item.size()}; }
+
+  static void encode(const std::string& item, std::vector<std::byte>& buffer)
+  {
+    const auto bytes = view(item);
+    buffer.insert(buffer.end(), bytes.data, bytes.data + bytes.size);
+  }
+
+  static std::string decode(const std::byte* data, const size_t size)
+  { return {reinterpret_cast<const char*>(data), size}; }
+};
+
+template<typename T, typename Allocator>
+struct Codec<std::vector<T, Allocator>>
+{
+  static_assert(
+    std::is_trivially_copyable_v<T>,
+    "flow::Codec<std::vector<T>> must be specialized for element types that are not trivially copyable"
+  );
+
+  static constexpr uint32_t version = Codec<T>::version;
+
+  static std::string schema()
+  { return "vector<" + Codec<T>::schema() + '>'; }
+
+  static ByteView view(const std::vector<T, Allocator>& item)
+  { return {reinterpret_cast<const std::byte*>(item.data()), item.size() * sizeof(T)}; }
+
+  static void encode(const std::vector<T, Allocator>& item, std::vector<std::byte>& buffer)
+  {
+    const auto bytes = view(item);
+    buffer.insert(buffer.end(), bytes.data, bytes.data + bytes.size);
+  }
+
+  static std::vector<T, Allocator> decode(const std::byte* data, const size_t size)
+  {
+    if (size % sizeof(T) != 0)
+    { throw std::invalid_argument{"Codec: " + std::to_string(size) + " bytes is not a whole number of elements"}; }
+
+    std::vector<T, Allocator> item(size / sizeof(T));
+    std::memcpy(item.data(), data, size);
+    return item;
+  }
+};
+
+/// \brief Precedes each encoded item in a message, to identify the encoding and the size.
+///
+/// The header is written in the byte order of the host, which the reader detects by the magic number.
+struct CodecHeader
+{
+  static constexpr uint32_t magic_number = 0x574c4653; ///< "SFLW" in little endian
+  static constexpr uint16_t current_format = 1;
+
+  uint32_t magic = magic_number;
+  uint16_t format = current_format; ///< Version of the header layout
+  uint16_t reserved = 0;
+  uint32_t version = 0;             ///< Codec<T>::version
+  uint32_t reserved_2 = 0;
+  uint64_t schema_hash = 0;         ///< codec::hashSchema of Codec<T>::schema()
+  uint64_t payload_size = 0;        ///< Size of the encoded item following the header, in bytes
+};
+
+static_assert(sizeof(CodecHeader) == 32, "CodecHeader must have the same layout on all hosts");
+
+namespace codec
+{
+/// \brief The 64 bit FNV-1a hash of a schema
+[[nodiscard]] uint64_t hashSchema(std::string_view schema);
+
+/// \brief Check that a message header matches the expected encoding.
+/// \param header The header of the message
+/// \param version The expected Codec<T>::version
+/// \param schema_hash The expected hash of Codec<T>::schema()
+/// \param available_size Number of bytes following the header
+/// \throws std::invalid_argument if the header is corrupt, written by a host of another byte order,
+/// of another format or encoding, or if the payload is truncated
+void checkHeader(const CodecHeader& header, uint32_t version, uint64_t schema_hash, size_t available_size);
+
+/// \brief True if Codec<T> defines `view`, i.e. the item can be written without being encoded
+template<typename T, typename = void>
+struct HasView : std::false_type
+{};
+
+template<typename T>
+struct HasView<T, std::void_t<decltype(Codec<T>::view(std::declval<const T&>()))>> : std::true_type
+{};
+
+template<typename T>
+inline constexpr bool has_view_v = HasView<T>::value;
+
+/// \brief The header of a message with an item of `payload_size` bytes, encoded by Codec<T>
+template<typename T>
+CodecHeader makeHeader(const size_t payload_size)
+{
+  static const uint64_t schema_hash = hashSchema(Codec<T>::schema());
+
+  CodecHeader header;
+  header.version = Codec<T>::version;
+  header.schema_hash = schema_hash;
+  header.payload_size = payload_size;
+
+  return header;
+}
+
+/// \brief Append a CodecHeader and the encoded item to a buffer.
+/// Items with a ByteView are copied into the buffer once, without intermediate buffers.
+template<typename T>
+void encodeMessage(const T& item, std::vector<std::byte>& buffer)
+{
+  const auto header_offset = buffer.size();
+
+  if constexpr (has_view_v<T>)
+  {
+    const auto bytes = Codec<T>::view(item);
+    const auto header = makeHeader<T>(bytes.size);
+    const auto* header_bytes = reinterpret_cast<const std::byte*>(&header);
+
+    buffer.reserve(header_offset + sizeof(header) + bytes.size);
+    buffer.insert(buffer.end(), header_bytes, header_bytes + sizeof(header));
+    buffer.insert(buffer.end(), bytes.data, bytes.data + bytes.size);
+  }
+  else
+  {
+    buffer.resize(header_offset + sizeof(CodecHeader));
+    Codec<T>::encode(item, buffer);
+
+    const auto header = makeHeader<T>(buffer.size() - header_offset - sizeof(CodecHeader));
+    std::memcpy(buffer.data() + header_offset, &header, sizeof(header));
+  }
+}
+
+/// \brief Decode a message written by `encodeMessage`
+/// \param data The message, starting with the CodecHeader
+/// \param size Size of the message, in bytes. Bytes beyond the payload are ignored.
+/// \throws std::invalid_argument if the header does not match Codec<T>, \see checkHeader,
+/// or if the item cannot be decoded
+template<typename T>
+T decodeMessage(const std::byte* data, const size_t size)
+{
+  if (size < sizeof(CodecHeader))
+  { throw std::invalid_argument{"Codec: the message is shorter than its header"}; }
+
+  static const uint64_t schema_hash = hashSchema(Codec<T>::schema());
+
+  CodecHeader header;
+  std::memcpy(&header, data, sizeof(header));
+  checkHeader(header, Codec<T>::version, schema_hash, size - sizeof(header));
+
+  return Codec<T>::decode(data + sizeof(header), static_cast<size_t>(header.payload_size));
+}
+}
+}
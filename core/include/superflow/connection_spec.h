@@ -2,6 +2,7 @@
 #pragma once
 
 #include <string>
+#include <tuple>
 
 namespace flow
 {
@@ -12,4 +13,23 @@ struct ConnectionSpec
   std::string rhs_name;
   std::string rhs_port;
 };
+
+inline bool operator==(const ConnectionSpec& lhs, const ConnectionSpec& rhs)
+{
+  return lhs.lhs_name == rhs.lhs_name
+         && lhs.lhs_port == rhs.lhs_port
+         && lhs.rhs_name == rhs.rhs_name
+         && lhs.rhs_port == rhs.rhs_port;
+}
+
+inline bool operator!=(const ConnectionSpec& lhs, const ConnectionSpec& rhs)
+{
+  return !(lhs == rhs);
+}
+
+inline bool operator<(const ConnectionSpec& lhs, const ConnectionSpec& rhs)
+{
+  return std::tie(lhs.lhs_name, lhs.lhs_port, lhs.rhs_name, lhs.rhs_port)
+         < std::tie(rhs.lhs_name, rhs.lhs_port, rhs.rhs_name, rhs.rhs_port);
+}
 }
@@ -0,0 +1,67 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace flow
+{
+/// \brief Statistics of the items passed over one connection, counted by the consumer port.
+/// \see Port::getEdgeStatuses, Graph::getEdgeStatistics
+struct EdgeStatus
+{
+  size_t num_messages = 0;   ///< Number of items received from the producer
+  size_t num_bytes = 0;      ///< Size of the received items, \see ByteSize
+  size_t num_dropped = 0;    ///< Number of items dropped from the full buffer of the consumer
+  size_t num_consumed = 0;   ///< Number of items taken out of the buffer of the consumer
+  size_t num_timed = 0;      ///< Number of consumed items whose time in the buffer was measured, \see EdgeCounter
+  double queue_latency = 0.; ///< Total time from the timed items were received until they were consumed, in seconds
+};
+
+/// \brief The number of bytes an item occupies, as counted in EdgeStatus::num_bytes.
+///
+/// The default is `sizeof(T)`, with the contents of strings and vectors of trivially
+/// copyable types added. Specialize it for types that own more data, e.g.
+/// \code{.cpp}
+/// template<>
+/// struct flow::ByteSize<Image>
+/// {
+///   size_t operator()(const Image& image) const
+///   { return sizeof(Image) + image.data.size(); }
+/// };
+/// \endcode
+template<typename T>
+struct ByteSize
+{
+  size_t operator()(const T&) const
+  { return sizeof(T); }
+};
+
+template<>
+struct ByteSize<std::string>
+{
+  size_t operator()(const std::string& item) const
+  { return sizeof(std::string) + item.size(); }
+};
+
+template<typename T, typename Allocator>
+struct ByteSize<std::vector<T, Allocator>>
+{
+  size_t operator()(const std::vector<T, Allocator>& item) const
+  {
+    if constexpr (std::is_trivially_copyable_v<T>)
+    { return sizeof(item) + item.size() * sizeof(T); }
+    else
+    {
+      size_t num_bytes = sizeof(item);
+
+      for (const auto& element : item)
+      { num_bytes += ByteSize<T>{}(element); }
+
+      return num_bytes;
+    }
+  }
+};
+}
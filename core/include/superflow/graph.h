@@ -1,11 +1,23 @@
 // Copyright 2019, Forsvarets forskningsinstitutt. All rights reserved.
 #pragma once
 
+#include "superflow/allocation_counter.h"
+#include "superflow/bottleneck_report.h"
+#include "superflow/connection_spec.h"
+#include "superflow/edge_status.h"
+#include "superflow/perf_counters.h"
 #include "superflow/proxel.h"
 #include "superflow/port.h"
+#include "superflow/utils/latency_histogram.h"
 
+#include <chrono>
+#include <condition_variable>
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <set>
 #include <thread>
 #include <vector>
 
@@ -17,6 +29,10 @@ namespace flow
 /// Graph is the manager of Proxels, mainly providing a data structure for them to exist
 /// and in the current implementation providing them with worker threads.
 /// Graph can also be queried for Proxel statuses to monitor workload and processing times.
+///
+/// Proxels and connections may be added, removed and replaced while the Graph is running,
+/// without disturbing the rest of the Graph. The Graph itself is not thread safe, so all
+/// methods must be called from the thread that owns the Graph.
 /// \see Proxel
 class Graph
 {
@@ -26,6 +42,75 @@ public:
   /// \param what Second argument, the `what` of the caught exception.
   using CrashLogger = std::function<void(const std::string& proxel_name, const std::string& what)>;
 
+  using Duration = std::chrono::steady_clock::duration;
+
+  /// \brief Describes how crashed Proxels are restarted when the Graph handles exceptions.
+  ///
+  /// A Proxel that throws from `start` is restarted on its existing ports after a backoff period,
+  /// which grows by `backoff_factor` for every consecutive crash, up to `max_backoff`.
+  /// While waiting, the Proxel is reported as Crashed. After `max_restarts` restarts the Proxel
+  /// is left dead, as it is without supervision. A Proxel is not restarted once it is being stopped,
+  /// so its `stop` is called once, whether it is in its first run or in a restarted one. As in the
+  /// first run, `start` must not undo a `stop` that comes before it, e.g. by resetting a stop flag.
+  struct RestartPolicy
+  {
+    size_t max_restarts = 0;                                  ///< 0 disables supervision
+    Duration initial_backoff = std::chrono::milliseconds{10}; ///< Wait before the first restart
+    Duration max_backoff = std::chrono::seconds{10};          ///< Upper bound on the wait
+    double backoff_factor = 2.;                               ///< Growth of the wait per crash
+  };
+
+  /// \brief The outcome of `replace`
+  struct ReplaceResult
+  {
+    Duration latency;    ///< From the old Proxel was stopped until the new Proxel was started
+    bool is_over_budget; ///< True if `latency` exceeded the latency budget given to `replace`
+  };
+
+  /// \brief End-to-end latency of items traced from one port to another.
+  /// \see enableTracing
+  struct TraceStatistics
+  {
+    std::string source_proxel;
+    std::string source_port;
+    std::string sink_proxel;
+    std::string sink_port;
+    LatencyHistogram latency;
+  };
+
+  /// \brief Live statistics of one connection made through `connect`.
+  /// \see getEdgeStatistics
+  struct EdgeStatistics
+  {
+    ConnectionSpec connection;
+    EdgeStatus status;              ///< Totals since the ports were connected
+    double message_rate = 0.;       ///< Items per second, \see getEdgeStatistics
+    double byte_rate = 0.;          ///< Bytes per second, \see getEdgeStatistics
+    double mean_queue_latency = 0.; ///< Mean EdgeStatus::queue_latency of the items timed in the same window, in seconds
+  };
+
+  /// \brief The samples the rates of one poller are computed from.
+  ///
+  /// Passing the same Sampler to repeated calls of getProxelStatuses or getEdgeStatistics gives
+  /// rates averaged since the previous call, independent of other pollers with Samplers of their own.
+  /// Calls without a Sampler give rates averaged since each thread started or each connection was
+  /// made. A Sampler is not thread safe, and is meant to be owned by the poller, e.g. as a member
+  /// of the class that polls the Graph.
+  class Sampler
+  {
+  private:
+    friend class Graph;
+
+    struct EdgeSample
+    {
+      EdgeStatus status;
+      std::chrono::steady_clock::time_point time;
+    };
+
+    std::map<int64_t, PerfCounters::Sample> perf_samples_;
+    std::map<ConnectionSpec, EdgeSample> edge_samples_;
+  };
+
   Graph() = default;
 
   /// Constructor that creates graph with a predefined set of proxels.
@@ -33,7 +118,8 @@ public:
   /// \param proxels map which maps unique names to Proxels.
   explicit Graph(std::map<std::string, Proxel::Ptr> proxels);
 
-  Graph(Graph&&) = default;
+  /// Leaves `other` as an empty Graph
+  Graph(Graph&& other);
 
   Graph(const Graph&) = delete;
 
@@ -50,15 +136,71 @@ public:
     const CrashLogger& crash_logger = defaultCrashLogger
   );
 
+  /// \brief Set how crashed Proxels are restarted. Takes effect the next time the Graph is started.
+  /// \see RestartPolicy
+  void setRestartPolicy(const RestartPolicy& policy);
+
   /// Call the `stop` method of every Proxel, expecting the proxel thread to terminate.
   /// Threads are joined.
   void stop();
 
   /// \brief Add a new proxel to the Graph.
+  /// If the Graph is running, the Proxel is started on a new thread immediately.
   /// \param proxel_id Unique name for the Proxel
   /// \param proxel pointer to the proxel
   void add(const std::string& proxel_id, Proxel::Ptr&& proxel);
 
+  /// \brief Remove a Proxel and all its connections from the Graph.
+  ///
+  /// The Proxel is stopped first, and its thread is joined, while the rest of the Graph keeps running.
+  /// Stopping the Proxel deactivates its consumer ports, so that a producer blocked on one of them
+  /// is released. Then its connections are removed.
+  /// \param proxel_id Unique name of the Proxel
+  /// \throws std::invalid_argument if the Proxel does not exist or is part of a fused group
+  void remove(const std::string& proxel_id);
+
+  /// \brief Replace a Proxel with a new one, keeping all its connections.
+  ///
+  /// The old Proxel is quiesced and stopped as in `remove`, the new Proxel is connected in its place
+  /// and started if the Graph is running. The swap is completed even if it overruns `latency_budget`,
+  /// which is reported in the result. While stopping the old Proxel, a warning is also printed to
+  /// std::cerr for every elapsed budget period.
+  /// \param proxel_id Unique name of the Proxel to replace
+  /// \param proxel The new Proxel, which must have all the ports used by the current connections
+  /// \param latency_budget Expected upper bound on the duration of the swap
+  /// \return The duration of the swap, and whether it overran `latency_budget`
+  /// \throws std::invalid_argument if the Proxel does not exist, is part of a fused group, or if
+  /// the new Proxel lacks some of the connected ports, or has ports of other types, as told by
+  /// Port::canConnect. The Graph is left untouched if this happens. Should connecting the new Proxel
+  /// still fail, the old Proxel is connected and started again, and the exception is rethrown.
+  ReplaceResult replace(
+    const std::string& proxel_id,
+    Proxel::Ptr&& proxel,
+    Duration latency_budget = std::chrono::seconds{2}
+  );
+
+  /// \brief Run a group of Proxels on one shared thread instead of one thread each.
+  ///
+  /// Each member runs its `start` on a fiber of the group's thread, see fiber::run. A member that
+  /// waits for its next item in a consumer port, or for room in a PushBlocking one, lets the other
+  /// members run instead of putting the thread to sleep. When a member sends to another member,
+  /// the receiver runs until it waits for its next item before the `send` returns, so an item passes
+  /// through a chain such as decode, undistort and resize without waking a thread or switching threads,
+  /// whether the members are connected through BufferedConsumerPort%s or CallbackConsumerPort%s.
+  /// The thread only sleeps when every member waits for items from outside of the group.
+  /// Connections to Proxels outside of the group behave as before.
+  ///
+  /// A member must not wait in any other way, e.g. by sleeping or on a std::condition_variable,
+  /// since that holds up the whole group. This includes waiting to be restarted after a crash.
+  /// When the Graph is started, the members are started in reverse order,
+  /// so that downstream stages wait for their inputs before the head starts producing.
+  /// Each member is still a separate Proxel, reporting its own ProxelStatus.
+  /// \param group_name Unique name of the group, must not be the name of a Proxel
+  /// \param proxel_ids The members of the group, head first
+  /// \throws std::invalid_argument if a Proxel does not exist or is already fused
+  /// \throws std::runtime_error if the Graph is running
+  void fuse(const std::string& group_name, const std::vector<std::string>& proxel_ids);
+
   /// \brief Request a pointer to a Proxel
   /// \tparam ProxelType optional template argument in order to get a specific sub class of Proxel.
   /// \param proxel_name Unique name of Proxel
@@ -73,13 +215,103 @@ public:
   /// \param proxel2 Unique name of the second Proxel
   /// \param proxel2_port Unique name of the second Proxel's port
   void connect(const std::string& proxel1, const std::string& proxel1_port,
-               const std::string& proxel2, const std::string& proxel2_port) const;
+               const std::string& proxel2, const std::string& proxel2_port);
+
+  /// \brief Remove a connection between ports in two Proxels, given in either order.
+  /// A `send` in progress over a connection from a ProducerPort is finished before this method
+  /// returns, unless it is blocked for longer than ProducerPort::quiesce_timeout.
+  /// Does nothing if the ports are not connected.
+  /// \param proxel1 Unique name of the first Proxel
+  /// \param proxel1_port Unique name of the first Proxel's port
+  /// \param proxel2 Unique name of the second Proxel
+  /// \param proxel2_port Unique name of the second Proxel's port
+  void disconnect(const std::string& proxel1, const std::string& proxel1_port,
+                  const std::string& proxel2, const std::string& proxel2_port);
+
+  /// \brief Retreive all connections made through `connect`, in the order they were made.
+  [[nodiscard]] const std::vector<ConnectionSpec>& getConnections() const;
+
+  /// \brief Get the items passed over every connection, in the order the connections were made.
+  ///
+  /// The items are counted by the consumer port of each connection, i.e. BufferedConsumerPort,
+  /// MultiConsumerPort and CallbackConsumerPort. Connections to other kinds of ports report zeros.
+  /// The rates are averaged since each connection was made.
+  /// \see EdgeStatistics
+  [[nodiscard]] std::vector<EdgeStatistics> getEdgeStatistics() const;
+
+  /// \brief Get the items passed over every connection, with rates averaged since the previous
+  /// call with the same `sampler`.
+  /// \see Sampler
+  [[nodiscard]] std::vector<EdgeStatistics> getEdgeStatistics(Sampler& sampler) const;
+
+  /// \brief Start measuring the end-to-end latency of items flowing through the Graph.
+  ///
+  /// A sampled item sent from a port with no upstream trace, typically from a source Proxel,
+  /// starts a trace which follows the item and anything sent in response to it by downstream
+  /// Proxels, as long as each Proxel sends on the same thread it consumed the item from.
+  /// Tracing is process wide, so it also covers other Graphs running in the same process.
+  /// \param sample_interval Trace every `sample_interval`-th item from each thread
+  /// \see tracing::enable, getTraceStatistics
+  void enableTracing(size_t sample_interval = 100);
+
+  /// \brief Stop tracing. Statistics collected so far are still available.
+  void disableTracing();
+
+  /// \brief Get the latency distribution of every traced path between ports in this Graph.
+  /// Paths from or to ports that are not in this Graph are left out.
+  [[nodiscard]] std::vector<TraceStatistics> getTraceStatistics() const;
+
+  /// \brief Start recording when each Proxel thread is running, waiting for input or blocked
+  /// by a full downstream buffer. Running spans are recorded by ProxelTimer.
+  /// Like tracing, the timeline is process wide.
+  /// \param events_per_thread Number of most recent spans kept for each thread
+  /// \see timeline::enable, writeTimeline
+  void enableTimeline(size_t events_per_thread = 1u << 15);
+
+  void disableTimeline();
+
+  /// \brief Write the recorded timeline as Chrome trace event JSON, one track per thread,
+  /// named after the Proxel or fused group running on it.
+  /// The output can be opened in https://ui.perfetto.dev or `chrome://tracing`.
+  void writeTimeline(std::ostream& os) const;
+
+  /// \brief Estimate how oversubscribed the CPUs are by the threads of this Graph.
+  ///
+  /// Computed as the number of Proxel threads that are currently running or waiting for a CPU,
+  /// divided by the number of cores available to the process. Values above 1 mean that some
+  /// Proxels are starved of CPU, which shows up as growing ThreadStatistics::run_delay.
+  /// The value is a snapshot, so it should be sampled repeatedly. Always 0 on platforms
+  /// other than Linux.
+  /// \see ThreadStatistics
+  [[nodiscard]] double getOversubscription() const;
+
+  /// \brief Count cycles, instructions, cache misses, branch misses and page faults of every
+  /// Proxel thread started from now on, using `perf_event_open`.
+  ///
+  /// The rates are reported in ProxelStatus::perf, averaged since the thread started, or since
+  /// the previous call to getProxelStatuses with the same Sampler. Where hardware counters are not
+  /// available, e.g. in virtual machines, only the software counters are reported.
+  /// \see PerfCounters
+  void enablePerfCounters(bool enable = true);
 
   /// \brief Retreive the current status of all proxels.
+  /// The scheduler statistics of each Proxel thread are included on Linux, and the heap
+  /// allocations if the executable is instrumented, normalized by the number of items the
+  /// Proxel has consumed through its BufferedConsumerPort%s and MultiConsumerPort%s.
   /// \see ProxelStatusMap
   /// \return
   [[nodiscard]] ProxelStatusMap getProxelStatuses() const;
 
+  /// \brief Retreive the current status of all proxels, with rates averaged since the previous
+  /// call with the same `sampler`.
+  /// \see Sampler
+  [[nodiscard]] ProxelStatusMap getProxelStatuses(Sampler& sampler) const;
+
+  /// \brief Find the Proxels that limit the throughput of each pipeline in the Graph.
+  /// \param parallelism Number of instances of each limiting stage to predict the speedup for
+  /// \see analyzeBottlenecks
+  [[nodiscard]] BottleneckReport getBottleneckReport(size_t parallelism = 2) const;
+
   /// A CrashLogger that prints the error message to std::cerr.
   /// \see CrashLogger
   static void defaultCrashLogger(const std::string& proxel_name, const std::string& what);
@@ -89,12 +321,85 @@ public:
   static const CrashLogger quietCrashLogger;
 
 private:
+  /// Performance counters of a proxel thread, and the sample taken when the thread started.
+  struct PerfState
+  {
+    std::shared_ptr<PerfCounters> counters;
+    PerfCounters::Sample start;
+  };
+
+  /// Crash and restart bookkeeping, shared with the proxel threads.
+  struct Supervision
+  {
+    struct Record
+    {
+      size_t num_failures = 0;
+      size_t num_restarts = 0;
+      double summed_uptime = 0.;
+    };
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool stopping = false;
+    std::set<std::string> cancelled;
+    std::map<std::string, std::string> crashes;
+    std::map<std::string, Record> records;
+    std::map<std::string, int64_t> thread_ids;
+    std::map<int64_t, PerfState> perf_counters;
+    std::map<int64_t, std::shared_ptr<const allocation::Counters>> allocation_counters;
+  };
+
   std::map<std::string, Proxel::Ptr> proxels_;
-  std::map<std::string, std::string> crashes_;
+  std::unique_ptr<Supervision> supervision_ = std::make_unique<Supervision>();
+  RestartPolicy restart_policy_;
+
+  std::map<std::string, std::vector<std::string>> fused_groups_;
+  std::map<std::string, std::string> fused_members_;
+
+  std::vector<ConnectionSpec> connections_;
+  std::map<ConnectionSpec, std::chrono::steady_clock::time_point> connection_times_;
 
   std::map<std::string, std::thread> proxel_threads_;
+  bool handle_exceptions_ = true;
+  bool perf_counters_enabled_ = false;
+  CrashLogger crash_logger_ = defaultCrashLogger;
 
   [[nodiscard]] bool isRunning() const;
+
+  void startProxel(const std::string& proxel_id);
+
+  void stopProxel(const std::string& proxel_id, Duration warning_period);
+
+  /// Must be called with the supervision mutex locked
+  void forgetThread(const std::string& proxel_id);
+
+  /// Called by a proxel thread as it exits, since the kernel may give its id to a new thread
+  void forgetThreadId(int64_t thread_id);
+
+  void disconnectAll(const std::string& proxel_id);
+
+  [[nodiscard]] std::vector<ConnectionSpec> getConnections(const std::string& proxel_id) const;
+
+  void runProxel(
+    const std::string& proxel_name,
+    const Proxel::Ptr& proxel,
+    bool handle_exceptions,
+    const CrashLogger& crash_logger,
+    const RestartPolicy& restart_policy
+  );
+
+  void reportCrash(
+    const std::string& proxel_name,
+    const std::string& what,
+    const CrashLogger& crash_logger
+  );
+
+  [[nodiscard]] bool awaitRestart(
+    const std::string& proxel_name,
+    std::chrono::steady_clock::time_point run_start,
+    Duration backoff,
+    const RestartPolicy& restart_policy
+  );
 };
 
 template<typename ProxelType>
@@ -6,7 +6,11 @@
 #include "superflow/policy.h"
 #include "superflow/port.h"
 #include "superflow/multi_queue_getter.h"
+#include "superflow/timeline.h"
+#include "superflow/trace.h"
 #include "superflow/utils/data_stream.h"
+#include "superflow/utils/edge_counter.h"
+#include "superflow/utils/get_timer.h"
 #include "superflow/utils/multi_lock_queue.h"
 
 #include <map>
@@ -16,6 +20,9 @@ namespace flow
 {
 /// \brief The port has one buffer for each connected producer.
 /// Data from the the producers are received in a vector with a size depending on the GetMode selected.
+/// If tracing is enabled, the first traced item of each `get` becomes the current trace.
+/// The time spent waiting in and between calls to `get` is reported in the PortStatus,
+/// and the items received, dropped and consumed are counted per producer, \see getEdgeStatuses.
 /// \tparam T The type of data consumed
 /// \tparam M The GetMode, defining the behavior of the port.
 /// \see GetMode
@@ -50,6 +57,8 @@ public:
 
   PortStatus getStatus() const override;
 
+  std::map<const Port*, EdgeStatus> getEdgeStatuses() const override;
+
   std::optional<std::vector<T>> getNext() override;
 
   /// \brief Get new elements from the buffer
@@ -70,10 +79,14 @@ public:
 
 private:
   size_t num_transactions_ = 0;
+  GetTimer get_timer_;
+  EdgeCounter edge_counter_;
 
   ConnectionManager<ConnectPolicy::Multi> connection_manager_;
-  MultiLockQueue<Port::Ptr, T> multi_queue_;
-  MultiQueueGetter<Port::Ptr, T, M> queue_getter_;
+  MultiLockQueue<Port::Ptr, Traced<T>> multi_queue_;
+  MultiQueueGetter<Port::Ptr, Traced<T>, M> queue_getter_;
+
+  std::vector<T> unwrap(std::vector<Traced<T>>& traced_items);
 };
 
 // ----- Implementation -----
@@ -95,7 +108,10 @@ template<
 >
 inline void MultiConsumerPort<T, M, Variants...>::receive(const T& t, const Port::Ptr& ptr)
 {
-  multi_queue_.push(ptr, t);
+  const auto stamp = edge_counter_.received(ptr.get(), ByteSize<T>{}(t));
+
+  if (multi_queue_.push(ptr, {t, tracing::getCurrent().id, ptr.get(), stamp}))
+  { edge_counter_.dropped(ptr.get()); }
 }
 
 template<
@@ -107,6 +123,7 @@ void MultiConsumerPort<T, M, Variants...>::connect(const Port::Ptr& ptr)
 {
   connection_manager_.connect(shared_from_this(), ptr);
   multi_queue_.addQueue(ptr);
+  edge_counter_.add(ptr.get());
 }
 
 template<
@@ -118,6 +135,7 @@ void MultiConsumerPort<T, M, Variants...>::disconnect() noexcept
 {
   connection_manager_.disconnect(shared_from_this());
   multi_queue_.removeAllQueues();
+  edge_counter_.clear();
 }
 
 template<
@@ -129,6 +147,7 @@ void MultiConsumerPort<T, M, Variants...>::disconnect(const Port::Ptr& ptr) noex
 {
   connection_manager_.disconnect(shared_from_this(), ptr);
   multi_queue_.removeQueue(ptr);
+  edge_counter_.remove(ptr.get());
 }
 
 template<
@@ -150,10 +169,24 @@ PortStatus MultiConsumerPort<T, M, Variants...>::getStatus() const
 {
   return {
     connection_manager_.getNumConnections(),
-    num_transactions_
+    num_transactions_,
+    get_timer_.getWaitingTime(),
+    get_timer_.getProcessingTime(),
+    multi_queue_.getQueueSize(),
+    multi_queue_.getNumDropped()
   };
 }
 
+template<
+  typename T,
+  GetMode M,
+  typename... Variants
+>
+std::map<const Port*, EdgeStatus> MultiConsumerPort<T, M, Variants...>::getEdgeStatuses() const
+{
+  return edge_counter_.get();
+}
+
 template<
   typename T,
   GetMode M,
@@ -163,12 +196,7 @@ std::optional<std::vector<T>> MultiConsumerPort<T, M, Variants...>::getNext()
 {
   try
   {
-    std::vector<T> items;
-    queue_getter_.get(multi_queue_, items);
-
-    ++num_transactions_;
-
-    return items;
+    return get();
   }
   catch (const TerminatedException&)
   { return std::nullopt; }
@@ -181,12 +209,17 @@ template<
 >
 std::vector<T> MultiConsumerPort<T, M, Variants...>::get()
 {
-  std::vector<T> items;
-  queue_getter_.get(multi_queue_, items);
+  std::vector<Traced<T>> traced_items;
+
+  {
+    const GetTimer::Scope timing{get_timer_};
+    const timeline::Span span{timeline::Activity::Waiting};
+    queue_getter_.get(multi_queue_, traced_items);
+  }
 
   ++num_transactions_;
 
-  return items;
+  return unwrap(traced_items);
 }
 
 template<
@@ -228,4 +261,33 @@ void MultiConsumerPort<T, M, Variants...>::deactivate()
 {
   multi_queue_.terminate();
 }
+
+template<
+  typename T,
+  GetMode M,
+  typename... Variants
+>
+std::vector<T> MultiConsumerPort<T, M, Variants...>::unwrap(std::vector<Traced<T>>& traced_items)
+{
+  std::vector<T> items;
+  items.reserve(traced_items.size());
+
+  TraceContext current;
+
+  for (auto& traced : traced_items)
+  {
+    const auto trace = tracing::find(traced.trace_id);
+    tracing::record(trace, this);
+    edge_counter_.consumed(traced.sender, traced.stamp);
+
+    if (!current)
+    { current = trace; }
+
+    items.push_back(std::move(traced.item));
+  }
+
+  tracing::setCurrent(current);
+
+  return items;
+}
 }
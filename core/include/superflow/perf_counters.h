@@ -0,0 +1,89 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace flow
+{
+/// \brief Rates of the performance counters of the thread running a Proxel, in events per second.
+///
+/// Hardware counters are 0 if the PMU is not available, as is common in virtual machines.
+/// `cpu_utilization` and `page_faults` are software counters, available whenever
+/// `perf_event_open` is permitted.
+/// \see PerfCounters, Graph::enablePerfCounters
+struct PerfCounterRates
+{
+  double cycles = 0.;
+  double instructions = 0.;
+  double cache_misses = 0.;
+  double branch_misses = 0.;
+  double page_faults = 0.;
+  double cpu_utilization = 0.; ///< CPU seconds per second, from the task clock
+  bool hardware = false;       ///< True if the hardware counters are available
+
+  /// \brief Instructions per cycle. 0 if the hardware counters are not available.
+  [[nodiscard]] double getInstructionsPerCycle() const;
+};
+
+/// \brief Performance counters of a single thread, opened with `perf_event_open`.
+///
+/// The counters follow the thread that constructed the object, and may be read from any thread.
+/// Each counter is opened individually, so that the software counters work even when the
+/// hardware counters do not. Counters that cannot be opened read as 0, which is the case for
+/// all of them on platforms other than Linux, or if `/proc/sys/kernel/perf_event_paranoid`
+/// forbids it.
+///
+/// \code{.cpp}
+/// flow::PerfCounters counters; // counts the calling thread
+/// const auto before = counters.read();
+/// // work ...
+/// const auto rates = PerfCounters::getRates(before, counters.read());
+/// \endcode
+class PerfCounters
+{
+public:
+  enum Counter
+  {
+    Cycles,
+    Instructions,
+    CacheMisses,
+    BranchMisses,
+    PageFaults,
+    TaskClock,
+    NumCounters
+  };
+
+  /// \brief Counter totals at a point in time
+  struct Sample
+  {
+    std::chrono::steady_clock::time_point time;
+    std::array<uint64_t, NumCounters> values;
+  };
+
+  /// \brief Open the counters for the calling thread
+  PerfCounters();
+
+  ~PerfCounters();
+
+  PerfCounters(const PerfCounters&) = delete;
+
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  /// \brief Read the current totals, scaled up if the kernel had to multiplex the counters
+  [[nodiscard]] Sample read() const;
+
+  /// \brief True if any counter could be opened
+  [[nodiscard]] bool isAvailable() const;
+
+  /// \brief True if the hardware counters could be opened
+  [[nodiscard]] bool hasHardwareCounters() const;
+
+  /// \brief Compute rates from two samples of the same counters
+  [[nodiscard]] static PerfCounterRates getRates(const Sample& previous, const Sample& current, bool hardware);
+
+private:
+  std::array<int, NumCounters> fds_;
+};
+}
@@ -24,6 +24,7 @@ enum class ConnectPolicy
 enum class LeakPolicy
 {
   Leaky,        ///< Oldest data is dropped when pushing to a full buffer
-  PushBlocking  ///< Push blocks if buffer is full
+  PushBlocking, ///< Push blocks if buffer is full
+  Spill         ///< Data that does not fit in the full buffer is spilled to a file, \see SpillQueue
 };
 }
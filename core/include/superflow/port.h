@@ -1,8 +1,10 @@
 // Copyright 2019, Forsvarets forskningsinstitutt. All rights reserved.
 #pragma once
 
+#include "superflow/edge_status.h"
 #include "superflow/port_status.h"
 
+#include <map>
 #include <memory>
 
 namespace flow
@@ -37,6 +39,16 @@ public:
 
   [[nodiscard]] virtual bool isConnected() const = 0;
 
+  /// \brief Check whether the types of the ports allow `connect(ptr)`, without connecting them.
+  /// Ports that cannot tell return true, leaving the check to `connect`.
+  [[nodiscard]] virtual bool canConnect(const Port::Ptr&) const
+  { return true; }
+
   [[nodiscard]] virtual PortStatus getStatus() const = 0;
+
+  /// \brief Statistics of the items received from each connected producer, keyed by the producer.
+  /// Empty for ports that do not count their inputs, e.g. producer ports.
+  [[nodiscard]] virtual std::map<const Port*, EdgeStatus> getEdgeStatuses() const
+  { return {}; }
 };
 }
\ No newline at end of file
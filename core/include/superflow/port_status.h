@@ -14,5 +14,12 @@ struct PortStatus
 
   size_t num_connections;  ///< Number of connections to the Port
   size_t num_transactions; ///< Number of transactions passed through the Port
+  double waiting_time = 0.;    ///< Total time a consumer has spent waiting in `getNext`, in seconds
+  double processing_time = 0.; ///< Total time a consumer has spent between calls to `getNext`, in seconds
+  size_t queue_size = 0;       ///< Number of items waiting in the buffer of a consumer
+  size_t num_dropped = 0;      ///< Number of items a leaky consumer has dropped from its full buffer
+  double blocked_time = 0.;    ///< Total time producers have been blocked by the full buffer of a consumer, in seconds
+  size_t spilled_bytes = 0;    ///< Size of the items a Spill consumer holds in its spill file, in bytes
+  size_t num_spilled = 0;      ///< Number of items a Spill consumer has spilled to its file
 };
 }
@@ -3,13 +3,40 @@
 
 #include "superflow/consumer_port.h"
 #include "superflow/port.h"
-
+#include "superflow/trace.h"
+#include "superflow/utils/atomic_shared_ptr.h"
+#include "superflow/utils/fiber.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <thread>
+#include <vector>
 
 namespace flow
 {
+namespace detail
+{
+/// A `send` in progress on this thread, from the ProducerPort `port` in the epoch of parity `parity`
+struct Sending
+{
+  const Port* port;
+  size_t parity;
+
+  bool operator==(const Sending& other) const
+  { return port == other.port && parity == other.parity; }
+};
+
+/// The sends in progress on this thread, which a disconnect on the same thread must not wait for.
+/// Fibers of the thread may finish their sends in any order, so this is used as a multiset.
+inline thread_local std::vector<Sending> sendings;
+}
+
 /// \brief An output port able to connect with multiple ports extending Consumer.
 /// \tparam T The type of data to be exchanged between the ports.
 /// \tparam Variants... Optional downstream variant types of T which is also to be accepted by
@@ -57,6 +84,11 @@ public:
   using Ptr = std::shared_ptr<ProducerPort>;
   /// \brief Send data to all connected consumers.
   /// If the consumer reports to not accept data, the connection is removed.
+  /// Connections may be added or removed by other threads while sending. Each send delivers
+  /// to the consumers that were connected when it began, without holding any lock while the
+  /// consumers receive the item, so a consumer may send on or disconnect this port from `receive`.
+  /// If tracing is enabled, the item carries the current trace of this thread, or starts a new one.
+  /// \see tracing::enable
   void send(const T&);
 
   /// \brief Connect port to a new consumer.
@@ -64,17 +96,26 @@ public:
   /// \throws std::invalid_argument if ptr is incompatible.
   void connect(const Port::Ptr& ptr) override;
 
+  /// The longest a disconnect waits for the sends in progress, e.g. a send blocked by a full
+  /// consumer with LeakPolicy::PushBlocking
+  static constexpr std::chrono::seconds quiesce_timeout{1};
+
   /// \brief Disconnect all consumers.
-  /// \note Not thread safe! Should not be called while some other thread is sending data.
+  /// Waits, for at most `quiesce_timeout`, until the sends in progress have finished, so that no
+  /// consumer receives data after this method has returned. Sends in progress on the calling thread,
+  /// e.g. from which a consumer disconnects, are not waited for.
   void disconnect() noexcept override;
 
   /// \brief Disconnect one consumers.
+  /// Waits for the sends in progress as `disconnect()` does.
   /// \param ptr A pointer to the other port that will be disconnected
-  /// \note Not thread safe! Should not be called while some other thread is sending data.
   void disconnect(const Port::Ptr& ptr) noexcept override;
 
   bool isConnected() const override;
 
+  /// \brief True if `ptr` is a consumer of T or of one of the Variants
+  bool canConnect(const Port::Ptr& ptr) const override;
+
   /// \brief Request the number of consumers currently connected.
   /// \return
   size_t numConnections() const;
@@ -85,6 +126,7 @@ private:
   using Consumer = detail::Consumer<T>;
   using ConsumerPtr = typename Consumer::Ptr;
   using Connection = std::pair<Port::Ptr, ConsumerPtr>;
+  using ConsumerMap = std::map<Port::Ptr, ConsumerPtr>;
 
   template<typename Base>
   class ConsumerShim : public detail::Consumer<T>
@@ -135,9 +177,39 @@ private:
   );
 
   size_t num_transactions_ = 0;
-  std::map<Port::Ptr, ConsumerPtr> consumers_;
+  std::atomic<size_t> num_connections_{0};
+
+  /// Serializes connect and disconnect, which replace `consumers_` with a modified copy
+  std::mutex mutex_;
+
+  /// Loaded by `send`, so that it is never blocked by a connect or disconnect
+  AtomicSharedPtr<const ConsumerMap> consumers_{std::make_shared<const ConsumerMap>()};
+
+  /// Each disconnect begins a new epoch, and waits for the sends that began in the previous one.
+  /// The sends are counted by the parity of their epoch, so that new sends do not delay the wait.
+  std::atomic<size_t> epoch_{0};
+  std::array<std::atomic<size_t>, 2> num_sending_{};
+
+  /// Counts a send from construction to destruction
+  class SendScope
+  {
+  public:
+    explicit SendScope(ProducerPort& port);
+
+    ~SendScope();
 
-  bool hasConnection(const Port::Ptr& ptr) const;
+    SendScope(const SendScope&) = delete;
+    SendScope& operator=(const SendScope&) = delete;
+
+  private:
+    ProducerPort& port_;
+    size_t parity_;
+  };
+
+  void setConsumers(ConsumerMap&& consumers);
+
+  /// Wait until the sends that may have loaded the previous consumers have finished
+  void quiesce() noexcept;
 };
 
 // ----- Implementation -----
@@ -150,22 +222,43 @@ void ProducerPort<T, Variants...>::connect(const Port::Ptr& ptr)
   if (consumer == nullptr)
   { throw std::invalid_argument{std::string("Type mismatch when connecting ports")}; }
 
-  if (hasConnection(ptr))
   {
-    // already connected, do nothing
-    return;
+    std::scoped_lock lock{mutex_};
+
+    const auto current = consumers_.load();
+
+    if (current->find(ptr) != current->end())
+    {
+      // already connected, do nothing
+      return;
+    }
+
+    auto consumers = *current;
+    consumers[ptr] = consumer;
+    setConsumers(std::move(consumers));
   }
 
-  consumers_[ptr] = consumer;
   ptr->connect(shared_from_this());
 }
 
 template<typename T, typename... Variants>
 void ProducerPort<T, Variants...>::disconnect() noexcept
 {
-  auto consumers = std::move(consumers_);
+  std::shared_ptr<const ConsumerMap> consumers;
+
+  {
+    std::scoped_lock lock{mutex_};
+    consumers = consumers_.load();
+
+    if (consumers->empty())
+    { return; }
+
+    setConsumers({});
+  }
+
+  quiesce();
 
-  for (auto& kv : consumers)
+  for (auto& kv : *consumers)
   {
     kv.first->disconnect();
   }
@@ -174,16 +267,25 @@ void ProducerPort<T, Variants...>::disconnect() noexcept
 template<typename T, typename... Variants>
 void ProducerPort<T, Variants...>::disconnect(const Port::Ptr& ptr) noexcept
 {
-  auto it = consumers_.find(ptr);
+  Port::Ptr port;
 
-  if (it == consumers_.end())
   {
-    return;
-  }
+    std::scoped_lock lock{mutex_};
+    const auto current = consumers_.load();
+    auto it = current->find(ptr);
 
-  const auto port = it->first;
-  consumers_.erase(it);
+    if (it == current->end())
+    {
+      return;
+    }
+
+    port = it->first;
+    auto consumers = *current;
+    consumers.erase(port);
+    setConsumers(std::move(consumers));
+  }
 
+  quiesce();
   port->disconnect(shared_from_this());
 }
 
@@ -193,10 +295,18 @@ bool ProducerPort<T, Variants...>::isConnected() const
   return numConnections() > 0;
 }
 
+template<typename T, typename... Variants>
+bool ProducerPort<T, Variants...>::canConnect(const Port::Ptr& ptr) const
+{
+  ConsumerPtr consumer;
+
+  return getConsumerPtr<T>(ptr, consumer) || (getConsumerPtr<Variants>(ptr, consumer) || ...);
+}
+
 template<typename T, typename... Variants>
 size_t ProducerPort<T, Variants...>::numConnections() const
 {
-  return consumers_.size();
+  return num_connections_;
 }
 
 template<typename T, typename... Variants>
@@ -213,16 +323,65 @@ void ProducerPort<T, Variants...>::send(const T& t)
 {
   ++num_transactions_;
 
-  for (const auto& kv : consumers_)
   {
-    kv.second->receive(t, shared_from_this());
+    const SendScope send_scope{*this};
+    const tracing::Scope trace_scope{tracing::propagate(this)};
+    const auto consumers = consumers_.load();
+
+    for (const auto& kv : *consumers)
+    {
+      kv.second->receive(t, shared_from_this());
+    }
   }
+
+  // A consumer in the fused group of the sender handles the item before the send returns
+  fiber::yieldToWoken();
 }
 
 template<typename T, typename... Variants>
-bool ProducerPort<T, Variants...>::hasConnection(const Port::Ptr& ptr) const
+void ProducerPort<T, Variants...>::setConsumers(ConsumerMap&& consumers)
 {
-  return consumers_.find(ptr) != consumers_.end();
+  num_connections_ = consumers.size();
+  consumers_.store(std::make_shared<const ConsumerMap>(std::move(consumers)));
+}
+
+template<typename T, typename... Variants>
+void ProducerPort<T, Variants...>::quiesce() noexcept
+{
+  // Pairs with the fence in SendScope: either the send is counted here, or it loads the new consumers
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  const size_t parity = epoch_.fetch_add(1) & 1;
+  const auto num_own = static_cast<size_t>(
+    std::count(detail::sendings.begin(), detail::sendings.end(), detail::Sending{this, parity})
+  );
+
+  const auto deadline = std::chrono::steady_clock::now() + quiesce_timeout;
+
+  while (num_sending_[parity].load() > num_own && std::chrono::steady_clock::now() < deadline)
+  { std::this_thread::sleep_for(std::chrono::microseconds{50}); }
+}
+
+template<typename T, typename... Variants>
+ProducerPort<T, Variants...>::SendScope::SendScope(ProducerPort& port)
+  : port_{port}
+  , parity_{port.epoch_.load() & 1}
+{
+  ++port_.num_sending_[parity_];
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  detail::sendings.push_back({&port_, parity_});
+}
+
+template<typename T, typename... Variants>
+ProducerPort<T, Variants...>::SendScope::~SendScope()
+{
+  auto& sendings = detail::sendings;
+  const auto it = std::find(sendings.rbegin(), sendings.rend(), detail::Sending{&port_, parity_});
+
+  if (it != sendings.rend())
+  { sendings.erase(std::next(it).base()); }
+
+  --port_.num_sending_[parity_];
 }
 
 template<typename T, typename... Variants>
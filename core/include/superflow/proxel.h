@@ -4,13 +4,20 @@
 #include "superflow/port.h"
 #include "superflow/port_manager.h"
 #include "superflow/proxel_status.h"
+#include "superflow/status_field.h"
 #include "superflow/utils/mutexed.h"
 
 #include <atomic>
+#include <deque>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 
 namespace flow
 {
+class ProxelTimer;
+
 /// \brief Abstract class for Processing Element
 ///
 /// A Proxel, short for processing element, is an isolated "black box"
@@ -46,23 +53,61 @@ public:
   const PortManager::PortMap& getPorts() const;
 
   /// \brief Request the current status of the Proxel.
+  /// Status fields are read, and the status info is formatted, by the calling thread.
   /// \return
   ProxelStatus getStatus() const;
 
 protected:
   using State = ProxelStatus::State;
+  using StatusInfoFormatter = std::function<std::string()>;
 
   void setState(State state) const;
 
+  /// \brief Set the status info. Prefer status fields or a StatusInfoFormatter for
+  /// values that change on every iteration, since this copies the string under a lock.
   void setStatusInfo(const std::string& status_info) const;
 
+  /// \brief Format the status info only when the status is requested, e.g. by a GUI.
+  /// Overrides any info set by `setStatusInfo`. The formatter is called from the requesting
+  /// thread, so it must only read members that are safe to read concurrently, such as atomics.
+  void setStatusInfoFormatter(StatusInfoFormatter formatter);
+
+  /// \brief Create a named counter, reported in ProxelStatus::fields.
+  /// Typically called from the constructor. The counter lives as long as the Proxel.
+  /// \throws std::invalid_argument if a field with the same name exists
+  StatusCounter& addStatusCounter(const std::string& name);
+
+  /// \brief Create a named gauge, reported in ProxelStatus::fields.
+  /// Typically called from the constructor. The gauge lives as long as the Proxel.
+  /// \throws std::invalid_argument if a field with the same name exists
+  StatusGauge& addStatusGauge(const std::string& name);
+
+  /// \brief Report the statistics of a ProxelTimer as the gauges `<name>.time` and `<name>.busy`,
+  /// and the counter `<name>.runs`. The gauges `<name>.p99` and `<name>.max` hold the processing
+  /// times of the last 10 seconds, and `<name>.recent_busy` the ProxelTimer::getBusyness.
+  /// The timer must live as long as the Proxel.
+  /// \throws std::invalid_argument if a field with the same name exists
+  void addStatusTimer(const std::string& name, const ProxelTimer& timer);
+
   void registerPorts(PortManager::PortMap&& ports);
 
 private:
+  using StatusFieldReader = std::function<StatusField()>;
+
   mutable std::atomic<State> state_ = State::Undefined;
   mutable Mutexed<std::string> status_info_;
   PortManager port_manager_;
 
+  mutable std::mutex status_fields_mutex_;
+  std::map<std::string, StatusFieldReader> status_field_readers_;
+  std::deque<StatusCounter> status_counters_;
+  std::deque<StatusGauge> status_gauges_;
+  StatusInfoFormatter status_info_formatter_;
+
+  void requireNewStatusField(const std::string& name) const;
+
+  void addStatusField(const std::string& name, StatusFieldReader&& reader);
+
   State getState() const;
 
   std::string getStatusInfo() const;
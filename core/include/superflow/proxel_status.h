@@ -1,7 +1,11 @@
 // Copyright 2019, Forsvarets forskningsinstitutt. All rights reserved.
 #pragma once
 
+#include "superflow/allocation_counter.h"
+#include "superflow/perf_counters.h"
 #include "superflow/port_status.h"
+#include "superflow/status_field.h"
+#include "superflow/thread_statistics.h"
 
 #include <map>
 #include <ostream>
@@ -28,6 +32,14 @@ struct ProxelStatus
   State state;
   std::string info;
   std::map<std::string, PortStatus> ports;
+  size_t num_restarts = 0;                        ///< Number of times the Proxel has been restarted after a crash
+  double mean_time_between_failures = 0.;         ///< Mean uptime before a crash, in seconds. 0 if it has never crashed.
+  std::map<std::string, StatusField> fields = {}; ///< Structured status, read when the status was requested
+  double busyness = 0.;                           ///< Fraction of time spent outside of consumer port gets. 0 if never measured.
+  double processing_time = 0.;                    ///< Mean time between consumer port gets, in seconds. 0 if never measured.
+  ThreadStatistics thread = {};                   ///< The thread running the Proxel, shared by fused Proxels. Filled in by Graph.
+  PerfCounterRates perf = {};                     ///< Performance counters of the thread, if enabled in the Graph
+  AllocationStatistics allocations = {};          ///< Heap allocations of the thread, if instrumented. \see allocation::isInstrumented
 };
 
 /// A map with the latest ProxelStatuses, as key/value pairs such as { proxel_name: ProxelStatus }
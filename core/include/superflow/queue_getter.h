@@ -16,7 +16,8 @@ struct QueueGetter
 template<typename T, LeakPolicy L>
 struct QueueGetter<T, GetMode::Blocking, L>
 {
-  static std::optional<T> get(LockQueue<T, L>& queue)
+  template<typename Queue>
+  static std::optional<T> get(Queue& queue)
   {
     try
     {
@@ -26,7 +27,8 @@ struct QueueGetter<T, GetMode::Blocking, L>
     { return std::nullopt; }
   }
 
-  static bool hasNext(const LockQueue<T>& queue)
+  template<typename Queue>
+  static bool hasNext(const Queue& queue)
   {
     return !queue.isEmpty();
   }
@@ -38,7 +40,8 @@ struct QueueGetter<T, GetMode::Blocking, L>
 template<typename T, LeakPolicy L>
 struct QueueGetter<T, GetMode::Latched, L>
 {
-  std::optional<T> get(LockQueue<T, L>& queue)
+  template<typename Queue>
+  std::optional<T> get(Queue& queue)
   {
     try
     {
@@ -51,7 +54,8 @@ struct QueueGetter<T, GetMode::Latched, L>
     { return std::nullopt; }
   }
 
-  bool hasNext(const LockQueue<T>& queue) const
+  template<typename Queue>
+  bool hasNext(const Queue& queue) const
   { return opt.has_value() || !queue.isEmpty(); }
 
   void clear()
@@ -42,6 +42,9 @@ public:
 
   bool isConnected() const final;
 
+  /// \brief True if `ptr` is a responder of ReturnValue or of one of the Variants
+  bool canConnect(const Port::Ptr& ptr) const final;
+
   /// \brief Request a new response from the slave
   /// \param args Any arguments required by the slave to produce the response
   /// \return The response
@@ -171,6 +174,14 @@ bool RequesterPort<ReturnValue(Args...), Variants...>::isConnected() const
   return connection_ != nullptr;
 }
 
+template<typename ReturnValue, typename... Args, typename... Variants>
+bool RequesterPort<ReturnValue(Args...), Variants...>::canConnect(const Port::Ptr& ptr) const
+{
+  ResponderPtr responder;
+
+  return getResponderPtr<ReturnValue>(ptr, responder) || (getResponderPtr<Variants>(ptr, responder) || ...);
+}
+
 template<typename ReturnValue, typename... Args, typename... Variants>
 template<typename Variant>
 bool RequesterPort<ReturnValue(Args...), Variants...>::getResponderPtr(
@@ -0,0 +1,60 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace flow
+{
+/// \brief A numeric value reported in a ProxelStatus, such as a counter or a gauge.
+/// \see Proxel::addStatusCounter, Proxel::addStatusGauge
+struct StatusField
+{
+  enum class Type
+  {
+    Counter, ///< Monotonically increasing count, e.g. number of items processed
+    Gauge    ///< Value that may go up and down, e.g. a queue length or a processing time
+  };
+
+  Type type;
+  double value;
+};
+
+/// \brief A monotonically increasing count, owned by a Proxel and reported in its ProxelStatus.
+///
+/// Updating the counter is a single relaxed atomic increment, and may be done from any thread.
+class StatusCounter
+{
+public:
+  void increment(uint64_t count = 1) noexcept
+  { value_.fetch_add(count, std::memory_order_relaxed); }
+
+  StatusCounter& operator++() noexcept
+  {
+    increment();
+    return *this;
+  }
+
+  [[nodiscard]] uint64_t get() const noexcept
+  { return value_.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<uint64_t> value_{0};
+};
+
+/// \brief A value that may go up and down, owned by a Proxel and reported in its ProxelStatus.
+///
+/// Updating the gauge is a single relaxed atomic store, and may be done from any thread.
+class StatusGauge
+{
+public:
+  void set(const double value) noexcept
+  { value_.store(value, std::memory_order_relaxed); }
+
+  [[nodiscard]] double get() const noexcept
+  { return value_.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<double> value_{0.};
+};
+}
@@ -0,0 +1,38 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace flow
+{
+/// \brief Scheduler statistics of the thread running a Proxel, as reported by the kernel.
+///
+/// Unlike the wall clock busyness of ProxelTimer, these figures tell a Proxel that is computing
+/// from one that is runnable, but starved of CPU: the latter accumulates `run_delay`
+/// and involuntary context switches rather than `cpu_time`.
+/// All values are totals since the thread started. Only available on Linux.
+/// \see ProxelStatus, Graph::getOversubscription
+struct ThreadStatistics
+{
+  int64_t thread_id = 0;                   ///< Kernel thread id, 0 if unknown
+  double cpu_time = 0.;                    ///< Time spent on a CPU, in seconds
+  double run_delay = 0.;                   ///< Time spent runnable, waiting for a CPU, in seconds
+  size_t voluntary_context_switches = 0;   ///< Switches due to waiting, e.g. for input
+  size_t involuntary_context_switches = 0; ///< Switches due to preemption
+  bool runnable = false;                   ///< True if the thread was running or waiting for a CPU when sampled
+};
+
+/// \brief Get the kernel thread id of the calling thread.
+/// \return The id, or 0 if not supported on this platform
+[[nodiscard]] int64_t getCurrentThreadId();
+
+/// \brief Read the scheduler statistics of a thread in this process from `/proc/self/task`.
+/// \param thread_id As returned by getCurrentThreadId
+/// \return The statistics, or nothing if the thread does not exist or the platform is not supported
+[[nodiscard]] std::optional<ThreadStatistics> readThreadStatistics(int64_t thread_id);
+
+/// \brief Number of cores the process is allowed to run on, at least 1
+[[nodiscard]] size_t getNumAvailableCores();
+}
@@ -0,0 +1,105 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace flow
+{
+/// \brief Records what every thread is doing over time, for finding pipeline bubbles.
+///
+/// While enabled, ProxelTimer records when a Proxel is running, consumer ports record when
+/// a Proxel is waiting in `getNext`, and PushBlocking ports record when a sender is blocked
+/// by a full buffer. Each thread writes its spans to its own fixed size ring buffer without
+/// locking, overwriting the oldest spans, so recording costs two clock reads per span.
+/// The ring of a thread that exits is kept until another thread takes it over.
+/// When disabled, a span costs one relaxed atomic load.
+///
+/// The rings can be written at any time as Chrome trace event JSON, which is read by
+/// `chrome://tracing`, https://ui.perfetto.dev and most other trace viewers.
+/// \see Graph::writeTimeline
+namespace timeline
+{
+enum class Activity : uint8_t
+{
+  Running, ///< Between ProxelTimer::start and ProxelTimer::stop
+  Waiting, ///< Waiting for data in a consumer port
+  Blocked  ///< Waiting for room in a PushBlocking consumer port
+};
+
+/// \brief Start recording spans, and forget spans recorded before now.
+/// \param events_per_thread Capacity of the ring of each thread.
+/// Only used for threads that have not recorded any spans yet.
+/// \throws std::invalid_argument if events_per_thread is 0
+void enable(size_t events_per_thread = 1u << 15);
+
+void disable();
+
+[[nodiscard]] bool isEnabled();
+
+/// \brief Name the calling thread in the written timeline, e.g. after the Proxel it runs.
+void setThreadName(const std::string& name);
+
+/// \brief Monotonic time in nanoseconds, as used in the timeline
+[[nodiscard]] uint64_t now();
+
+/// \brief Record a span on the calling thread. Does nothing if the timeline is disabled.
+void record(Activity activity, uint64_t begin, uint64_t end);
+
+/// \brief Write all spans recorded since `enable` as Chrome trace event JSON.
+/// May be called while other threads are recording.
+void writeChromeTrace(std::ostream& os);
+
+/// \brief Records a span from construction to destruction, if the timeline is enabled.
+class Span
+{
+public:
+  explicit Span(Activity activity);
+
+  ~Span();
+
+  Span(const Span&) = delete;
+
+  Span& operator=(const Span&) = delete;
+
+private:
+  Activity activity_;
+  uint64_t begin_;
+};
+
+namespace detail
+{
+inline std::atomic<bool> enabled{false};
+}
+
+// ----- Implementation -----
+inline bool isEnabled()
+{
+  return detail::enabled.load(std::memory_order_relaxed);
+}
+
+inline uint64_t now()
+{
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()
+    ).count()
+  );
+}
+
+inline Span::Span(const Activity activity)
+  : activity_{activity}
+  , begin_{isEnabled() ? now() : 0}
+{}
+
+inline Span::~Span()
+{
+  if (begin_ != 0)
+  { record(activity_, begin_, now()); }
+}
+}
+}
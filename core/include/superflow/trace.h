@@ -0,0 +1,172 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include "superflow/utils/latency_histogram.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+
+namespace flow
+{
+class Port;
+
+/// \brief Identifies a sampled item, and where and when it entered the Graph.
+///
+/// A TraceContext is started by a ProducerPort when it sends an item while no context is current
+/// on the calling thread. It then follows the item into the consumer ports, and becomes current
+/// on the thread that consumes the item, so that the next `send` on that thread propagates it
+/// further downstream. Every consumer port that receives a traced item records the time since
+/// `origin` for the path from `source` to itself. Latched ports record the age of the item
+/// every time it is read.
+/// \see tracing::enable
+struct TraceContext
+{
+  uint64_t id = 0;                                ///< Unique id, 0 means no trace
+  std::chrono::steady_clock::time_point origin{}; ///< When the trace was started
+  const Port* source = nullptr;                   ///< The port that started the trace
+
+  explicit operator bool() const
+  { return id != 0; }
+};
+
+/// \brief An item buffered by a consumer port, together with the id of its trace,
+/// the producer it came from and its stamp from EdgeCounter::received.
+/// The rest of the trace is kept aside by tracing, so an untraced item only carries an empty id.
+/// \see tracing::find
+template<typename T>
+struct Traced
+{
+  T item;
+  uint64_t trace_id = 0;
+  const Port* sender = nullptr;
+  int64_t stamp = 0;
+};
+
+namespace tracing
+{
+/// Path of a traced item, as (source port, sink port).
+using Path = std::pair<const Port*, const Port*>;
+
+/// \brief Enable tracing for all ports in the process, and clear any collected statistics.
+///
+/// Every `sample_interval`-th item sent on a thread without a current trace starts a new trace,
+/// so the overhead can be kept negligible at full rate. Untraced items cost one relaxed atomic
+/// load and a thread local lookup per `send`.
+/// \param sample_interval 1 traces every item
+/// \throws std::invalid_argument if sample_interval is 0
+void enable(size_t sample_interval = 100);
+
+/// \brief Stop starting and recording traces. Collected statistics are kept.
+void disable();
+
+[[nodiscard]] bool isEnabled();
+
+/// \brief The trace of the item most recently consumed on this thread
+[[nodiscard]] TraceContext getCurrent();
+
+void setCurrent(const TraceContext& trace);
+
+/// \brief Find a trace by its id.
+/// The most recent `max_traces` traces are kept, which at the default sample interval are those
+/// started by the last 400k items sent. Items that are buffered for longer lose their trace.
+/// \return The trace, or an empty one if `id` is 0 or the trace has been forgotten
+[[nodiscard]] TraceContext find(uint64_t id);
+
+/// \brief Get the trace to attach to an item sent from `source`.
+/// This is the current trace if there is one, otherwise a new trace if the item is sampled.
+[[nodiscard]] TraceContext propagate(const Port* source);
+
+/// \brief Record that a traced item has arrived at `sink`. Does nothing if `trace` is empty.
+void record(const TraceContext& trace, const Port* sink);
+
+/// \brief Get the end-to-end latency distribution of every path traced since `enable`.
+[[nodiscard]] std::map<Path, LatencyHistogram> getStatistics();
+
+void clearStatistics();
+
+/// \brief Makes a trace current on this thread for the lifetime of the scope.
+class Scope
+{
+public:
+  explicit Scope(const TraceContext& trace);
+
+  ~Scope();
+
+  Scope(const Scope&) = delete;
+
+  Scope& operator=(const Scope&) = delete;
+
+private:
+  TraceContext previous_;
+};
+
+constexpr size_t max_traces = 4096;
+
+namespace detail
+{
+inline std::atomic<size_t> sample_interval{0};
+inline thread_local TraceContext current_trace{};
+inline thread_local size_t items_until_sample = 0;
+
+[[nodiscard]] TraceContext begin(const Port* source);
+
+[[nodiscard]] TraceContext lookup(uint64_t id);
+}
+
+// ----- Implementation -----
+inline bool isEnabled()
+{
+  return detail::sample_interval.load(std::memory_order_relaxed) != 0;
+}
+
+inline TraceContext getCurrent()
+{
+  return detail::current_trace;
+}
+
+inline void setCurrent(const TraceContext& trace)
+{
+  detail::current_trace = trace;
+}
+
+inline TraceContext find(const uint64_t id)
+{
+  if (id == 0)
+  { return {}; }
+
+  return detail::lookup(id);
+}
+
+inline TraceContext propagate(const Port* source)
+{
+  if (!isEnabled())
+  { return {}; }
+
+  if (detail::current_trace)
+  { return detail::current_trace; }
+
+  if (detail::items_until_sample > 0)
+  {
+    --detail::items_until_sample;
+    return {};
+  }
+
+  return detail::begin(source);
+}
+
+inline Scope::Scope(const TraceContext& trace)
+  : previous_{detail::current_trace}
+{
+  detail::current_trace = trace;
+}
+
+inline Scope::~Scope()
+{
+  detail::current_trace = previous_;
+}
+}
+}
@@ -0,0 +1,38 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include <memory>
+#include <utility>
+
+namespace flow
+{
+/// \brief A std::shared_ptr that may be loaded and stored by several threads at the same time.
+///
+/// Stands in for C++20's std::atomic<std::shared_ptr<T>>, through the std::atomic_load and
+/// std::atomic_store overloads for std::shared_ptr that C++17 offers, so that the pointer
+/// cannot be accessed in any other way by mistake.
+/// \tparam T The type pointed to, typically const, since the readers share the object
+template<typename T>
+class AtomicSharedPtr
+{
+public:
+  AtomicSharedPtr() = default;
+
+  explicit AtomicSharedPtr(std::shared_ptr<T> ptr)
+    : ptr_{std::move(ptr)}
+  {}
+
+  AtomicSharedPtr(const AtomicSharedPtr&) = delete;
+
+  AtomicSharedPtr& operator=(const AtomicSharedPtr&) = delete;
+
+  [[nodiscard]] std::shared_ptr<T> load() const
+  { return std::atomic_load(&ptr_); }
+
+  void store(std::shared_ptr<T> ptr)
+  { std::atomic_store(&ptr_, std::move(ptr)); }
+
+private:
+  std::shared_ptr<T> ptr_;
+};
+}
@@ -0,0 +1,235 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include "superflow/edge_status.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace flow
+{
+class Port;
+
+/// \brief Counts the items a consumer port receives from each of its producers.
+///
+/// Used by the consumer ports to keep an EdgeStatus per connection. An edge is added when
+/// a producer connects, or when it sends its first item, and is forgotten when it disconnects.
+/// The counters of each edge are atomics, found by a short lock free walk over the edges,
+/// so counting an item takes neither a lock nor a map lookup. The memory of a forgotten edge is
+/// reused by the next producer that connects, which may then also be counted the items
+/// an in-flight `send` from the forgotten producer delivers.
+///
+/// Every `timing_interval`-th item from a producer, starting with the first, is timed from when
+/// it is received until it is consumed, which gives EdgeStatus::queue_latency without reading
+/// the clock for every item. Each received item gets a stamp, so that latched ports which return the same
+/// item several times only count it as consumed once. Items received without a producer,
+/// i.e. not through a `send`, are counted in an edge of their own, which is not reported.
+/// All methods are thread safe.
+/// \see Port::getEdgeStatuses
+class EdgeCounter
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr uint64_t timing_interval = 16;
+
+  EdgeCounter() = default;
+
+  EdgeCounter(const EdgeCounter&) = delete;
+
+  EdgeCounter& operator=(const EdgeCounter&) = delete;
+
+  void add(const Port* producer);
+
+  void remove(const Port* producer);
+
+  void clear();
+
+  /// \return The stamp of the item, to be passed to `consumed` when the item leaves the buffer.
+  /// It is the time of reception in nanoseconds for timed items, and a negative sequence number
+  /// for the others, so it is unique per edge and never 0.
+  int64_t received(const Port* producer, size_t num_bytes);
+
+  /// \brief Count an item that is handed to the consumer as it is received, without a buffer
+  void delivered(const Port* producer, size_t num_bytes);
+
+  void dropped(const Port* producer);
+
+  void consumed(const Port* producer, int64_t stamp);
+
+  [[nodiscard]] std::map<const Port*, EdgeStatus> get() const;
+
+private:
+  struct Edge
+  {
+    std::atomic<const Port*> producer{nullptr};
+    Edge* next = nullptr;
+    std::atomic<size_t> num_messages{0};
+    std::atomic<size_t> num_bytes{0};
+    std::atomic<size_t> num_dropped{0};
+    std::atomic<size_t> num_consumed{0};
+    std::atomic<size_t> num_timed{0};
+    std::atomic<int64_t> queue_latency_ns{0};
+    std::atomic<int64_t> last_consumed{0};
+  };
+
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<Edge>> edges_;
+  std::atomic<Edge*> head_{nullptr};
+  mutable Edge unknown_producer_;
+
+  [[nodiscard]] Edge* find(const Port* producer) const;
+
+  /// Find the edge of `producer`, adding it if it is not there
+  Edge& findOrAdd(const Port* producer);
+
+  static int64_t now();
+};
+
+// ----- Implementation -----
+inline void EdgeCounter::add(const Port* producer)
+{
+  (void)findOrAdd(producer);
+}
+
+inline void EdgeCounter::remove(const Port* producer)
+{
+  std::scoped_lock lock{mutex_};
+
+  if (auto* edge = find(producer))
+  { edge->producer.store(nullptr, std::memory_order_release); }
+}
+
+inline void EdgeCounter::clear()
+{
+  std::scoped_lock lock{mutex_};
+
+  for (auto* edge = head_.load(std::memory_order_acquire); edge != nullptr; edge = edge->next)
+  { edge->producer.store(nullptr, std::memory_order_release); }
+}
+
+inline int64_t EdgeCounter::received(const Port* producer, const size_t num_bytes)
+{
+  auto& edge = findOrAdd(producer);
+  const auto sequence = edge.num_messages.fetch_add(1, std::memory_order_relaxed);
+  edge.num_bytes.fetch_add(num_bytes, std::memory_order_relaxed);
+
+  if (sequence % timing_interval == 0)
+  { return now(); }
+
+  return -static_cast<int64_t>(sequence);
+}
+
+inline void EdgeCounter::delivered(const Port* producer, const size_t num_bytes)
+{
+  auto& edge = findOrAdd(producer);
+  edge.num_messages.fetch_add(1, std::memory_order_relaxed);
+  edge.num_bytes.fetch_add(num_bytes, std::memory_order_relaxed);
+  edge.num_consumed.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void EdgeCounter::dropped(const Port* producer)
+{
+  if (auto* edge = find(producer))
+  { edge->num_dropped.fetch_add(1, std::memory_order_relaxed); }
+}
+
+inline void EdgeCounter::consumed(const Port* producer, const int64_t stamp)
+{
+  auto* edge = find(producer);
+
+  if (edge == nullptr || edge->last_consumed.exchange(stamp, std::memory_order_relaxed) == stamp)
+  { return; }
+
+  edge->num_consumed.fetch_add(1, std::memory_order_relaxed);
+
+  if (stamp > 0)
+  {
+    edge->queue_latency_ns.fetch_add(now() - stamp, std::memory_order_relaxed);
+    edge->num_timed.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+inline std::map<const Port*, EdgeStatus> EdgeCounter::get() const
+{
+  std::map<const Port*, EdgeStatus> statuses;
+
+  for (const auto* edge = head_.load(std::memory_order_acquire); edge != nullptr; edge = edge->next)
+  {
+    const auto* producer = edge->producer.load(std::memory_order_acquire);
+
+    if (producer == nullptr)
+    { continue; }
+
+    auto& status = statuses[producer];
+    status.num_messages = edge->num_messages.load(std::memory_order_relaxed);
+    status.num_bytes = edge->num_bytes.load(std::memory_order_relaxed);
+    status.num_dropped = edge->num_dropped.load(std::memory_order_relaxed);
+    status.num_consumed = edge->num_consumed.load(std::memory_order_relaxed);
+    status.num_timed = edge->num_timed.load(std::memory_order_relaxed);
+    status.queue_latency = static_cast<double>(edge->queue_latency_ns.load(std::memory_order_relaxed)) * 1e-9;
+  }
+
+  return statuses;
+}
+
+inline EdgeCounter::Edge* EdgeCounter::find(const Port* producer) const
+{
+  if (producer == nullptr)
+  { return &unknown_producer_; }
+
+  for (auto* edge = head_.load(std::memory_order_acquire); edge != nullptr; edge = edge->next)
+  {
+    if (edge->producer.load(std::memory_order_acquire) == producer)
+    { return edge; }
+  }
+
+  return nullptr;
+}
+
+inline EdgeCounter::Edge& EdgeCounter::findOrAdd(const Port* producer)
+{
+  if (auto* edge = find(producer))
+  { return *edge; }
+
+  std::scoped_lock lock{mutex_};
+
+  if (auto* edge = find(producer))
+  { return *edge; }
+
+  for (auto* edge = head_.load(std::memory_order_acquire); edge != nullptr; edge = edge->next)
+  {
+    if (edge->producer.load(std::memory_order_relaxed) != nullptr)
+    { continue; }
+
+    edge->num_messages.store(0, std::memory_order_relaxed);
+    edge->num_bytes.store(0, std::memory_order_relaxed);
+    edge->num_dropped.store(0, std::memory_order_relaxed);
+    edge->num_consumed.store(0, std::memory_order_relaxed);
+    edge->num_timed.store(0, std::memory_order_relaxed);
+    edge->queue_latency_ns.store(0, std::memory_order_relaxed);
+    edge->last_consumed.store(0, std::memory_order_relaxed);
+    edge->producer.store(producer, std::memory_order_release);
+
+    return *edge;
+  }
+
+  auto edge = std::make_unique<Edge>();
+  edge->producer.store(producer, std::memory_order_relaxed);
+  edge->next = head_.load(std::memory_order_relaxed);
+  head_.store(edge.get(), std::memory_order_release);
+  edges_.push_back(std::move(edge));
+
+  return *edges_.back();
+}
+
+inline int64_t EdgeCounter::now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+}
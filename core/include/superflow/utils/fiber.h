@@ -0,0 +1,169 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace flow
+{
+/// \brief Cooperative fibers, which let the proxels of a fused group share one thread.
+///
+/// Each function given to `run` gets a stack of its own on the calling thread. A fiber runs
+/// until it waits for a fiber::Condition, and the next fiber that is ready then runs in its place,
+/// with a switch of stacks instead of a switch of threads. The thread only sleeps when all of its
+/// fibers wait. The queues of the consumer ports wait through fiber::Condition, so a proxel that
+/// waits for its next item lets the other proxels of its group run, and a `send` to a member of
+/// the group runs that member until it waits again, before the `send` returns.
+/// Waiting in any other way, e.g. on a std::condition_variable or in a sleep, holds up the whole thread.
+/// Fibers are only available on Linux. Elsewhere, `run` gives each function a thread of its own.
+/// \see Graph::fuse
+namespace fiber
+{
+class Fiber;
+
+/// \brief Run each of `functions` on a fiber of the calling thread, and return when they all have returned.
+/// \throws The first exception thrown by one of the functions, which ends all of them
+/// \throws std::logic_error if called from a fiber
+void run(std::vector<std::function<void()>> functions);
+
+/// \brief The fiber running on the calling thread, or nullptr if it does not run fibers
+[[nodiscard]] Fiber* getCurrent();
+
+/// \brief Suspend the calling fiber, with `lock` unlocked, until it is woken, and let the other fibers run
+void park(std::unique_lock<std::mutex>& lock);
+
+/// \brief Make a parked fiber ready to run again. May be called from any thread.
+/// A fiber that is woken before it parks does not park at all.
+void wake(Fiber* fiber);
+
+/// \brief Let the other fibers that are ready run, before continuing. Does nothing outside of a fiber.
+void yield();
+
+/// \brief Let the fibers that this fiber has woken run until they wait again, before continuing
+void yieldToWoken();
+
+namespace detail
+{
+/// Set when a fiber wakes a fiber of the same thread
+inline thread_local bool has_woken = false;
+
+void handOff();
+}
+
+/// \brief A condition variable that suspends fibers instead of their thread.
+/// Threads that do not run fibers wait as on a std::condition_variable.
+class Condition
+{
+public:
+  template<typename Predicate>
+  void wait(std::unique_lock<std::mutex>& lock, Predicate predicate);
+
+  void notify_one();
+
+  void notify_all();
+
+private:
+  std::condition_variable condition_;
+  std::mutex fibers_mutex_;
+  std::vector<Fiber*> fibers_;
+  std::atomic<size_t> num_fibers_{0};
+
+  void add(Fiber* fiber);
+
+  void remove(Fiber* fiber);
+
+  void wakeFibers(bool all);
+};
+
+// ----- Implementation -----
+inline void yieldToWoken()
+{
+  if (!detail::has_woken)
+  { return; }
+
+  detail::has_woken = false;
+  detail::handOff();
+}
+
+template<typename Predicate>
+void Condition::wait(std::unique_lock<std::mutex>& lock, Predicate predicate)
+{
+  auto* fiber = getCurrent();
+
+  if (fiber == nullptr)
+  {
+    condition_.wait(lock, predicate);
+    return;
+  }
+
+  while (!predicate())
+  {
+    add(fiber);
+    park(lock);
+    remove(fiber);
+  }
+}
+
+inline void Condition::notify_one()
+{
+  condition_.notify_one();
+
+  if (num_fibers_.load() > 0)
+  { wakeFibers(false); }
+}
+
+inline void Condition::notify_all()
+{
+  condition_.notify_all();
+
+  if (num_fibers_.load() > 0)
+  { wakeFibers(true); }
+}
+
+inline void Condition::add(Fiber* fiber)
+{
+  std::scoped_lock lock{fibers_mutex_};
+
+  if (std::find(fibers_.begin(), fibers_.end(), fiber) == fibers_.end())
+  {
+    fibers_.push_back(fiber);
+    num_fibers_.store(fibers_.size());
+  }
+}
+
+inline void Condition::remove(Fiber* fiber)
+{
+  std::scoped_lock lock{fibers_mutex_};
+  fibers_.erase(std::remove(fibers_.begin(), fibers_.end(), fiber), fibers_.end());
+  num_fibers_.store(fibers_.size());
+}
+
+inline void Condition::wakeFibers(const bool all)
+{
+  // Woken under the lock, so that a fiber cannot return from `wait` and end in between
+  std::scoped_lock lock{fibers_mutex_};
+
+  if (fibers_.empty())
+  { return; }
+
+  if (all)
+  {
+    for (auto* fiber : fibers_)
+    { wake(fiber); }
+
+    fibers_.clear();
+  }
+  else
+  {
+    wake(fibers_.front());
+    fibers_.erase(fibers_.begin());
+  }
+
+  num_fibers_.store(fibers_.size());
+}
+}
+}
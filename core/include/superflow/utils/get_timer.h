@@ -0,0 +1,100 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace flow
+{
+/// \brief Measures the time a consumer spends waiting for data, and the time spent between gets.
+///
+/// Used by the consumer ports to time every `getNext` without help from the Proxel.
+/// The time between the end of one get and the beginning of the next is assumed to be
+/// processing. The first get only contributes waiting time.
+/// Must be used by one thread, the times may be read from any thread.
+///
+/// \code{.cpp}
+/// std::optional<T> getNext()
+/// {
+///   const GetTimer::Scope timing{get_timer_};
+///   return queue_getter_.get(buffer_);
+/// }
+/// \endcode
+/// \see PortStatus
+class GetTimer
+{
+public:
+  /// \brief RAII timing of a single get
+  class Scope
+  {
+  public:
+    explicit Scope(GetTimer& timer);
+    ~Scope();
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+  private:
+    GetTimer& timer_;
+  };
+
+  /// \brief Total time spent waiting in gets, in seconds
+  [[nodiscard]] double getWaitingTime() const;
+
+  /// \brief Total time spent between gets, in seconds
+  [[nodiscard]] double getProcessingTime() const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  std::atomic<int64_t> waiting_ns_{0};
+  std::atomic<int64_t> processing_ns_{0};
+  Clock::time_point begin_;
+  Clock::time_point end_;
+
+  void begin();
+  void end();
+};
+
+// ----- Implementation -----
+inline GetTimer::Scope::Scope(GetTimer& timer)
+  : timer_{timer}
+{
+  timer_.begin();
+}
+
+inline GetTimer::Scope::~Scope()
+{
+  timer_.end();
+}
+
+inline double GetTimer::getWaitingTime() const
+{
+  return static_cast<double>(waiting_ns_.load(std::memory_order_relaxed)) * 1e-9;
+}
+
+inline double GetTimer::getProcessingTime() const
+{
+  return static_cast<double>(processing_ns_.load(std::memory_order_relaxed)) * 1e-9;
+}
+
+inline void GetTimer::begin()
+{
+  begin_ = Clock::now();
+
+  if (end_ != Clock::time_point{})
+  {
+    const auto processing = std::chrono::duration_cast<std::chrono::nanoseconds>(begin_ - end_).count();
+    processing_ns_.store(processing_ns_.load(std::memory_order_relaxed) + processing, std::memory_order_relaxed);
+  }
+}
+
+inline void GetTimer::end()
+{
+  end_ = Clock::now();
+
+  const auto waiting = std::chrono::duration_cast<std::chrono::nanoseconds>(end_ - begin_).count();
+  waiting_ns_.store(waiting_ns_.load(std::memory_order_relaxed) + waiting, std::memory_order_relaxed);
+}
+}
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "superflow/connection_spec.h"
+#include "superflow/graph.h"
 
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -47,6 +49,16 @@ namespace flow
 /// \code{.sh}
 /// dot -Tsvg -o graph.svg superflow.gv
 /// \endcode
+///
+/// A running Graph can be rendered with its current load, e.g. periodically during a performance test:
+/// \code{.cpp}
+/// flow::Graph::Sampler sampler;
+///
+/// std::ofstream{"./live.gv"} << flow::GraphViz{graph, sampler}.employ();
+/// \endcode
+///
+/// Node and port names are quoted, so that any name is a valid DOT identifier, e.g. the names
+/// of the bridges between partitions.
 class GraphViz
 {
 public:
@@ -59,6 +71,27 @@ public:
     const std::vector<ConnectionSpec>& connections
   );
 
+  /// Build the data structure from the connections of a live Graph, annotated with its current load.
+  ///
+  /// Proxels are coloured from green to red by their busyness, and the limiting stages of
+  /// each pipeline are outlined in red. Edges are drawn with a width proportional to their
+  /// message rate, and labelled with the rate, the mean queue latency and the number of drops.
+  /// The rates are averaged since each connection was made.
+  /// This must be called from the thread that owns the Graph.
+  /// \param graph
+  /// \see Graph::getProxelStatuses, Graph::getEdgeStatistics, Graph::getBottleneckReport
+  explicit GraphViz(
+    const Graph& graph
+  );
+
+  /// Like GraphViz(const Graph&), but with rates averaged since the previous call with the same
+  /// `sampler`, for rendering the Graph periodically.
+  /// \see Graph::Sampler
+  GraphViz(
+    const Graph& graph,
+    Graph::Sampler& sampler
+  );
+
   /// Render the DOT-file source code
   std::string employ() const;
 
@@ -72,10 +105,22 @@ private:
     std::set<std::string> rhs_ports;
   };
 
+  struct NodeLoad
+  {
+    double busyness = 0.;
+    bool is_bottleneck = false;
+  };
+
   std::map<std::string, ProxelMeta> node_list;
+  std::map<std::string, NodeLoad> node_loads;
+  std::unordered_map<ConnectionSpec, Graph::EdgeStatistics> edge_loads;
+  double max_message_rate = 0.;
 
   void insert(const ConnectionSpec& connection);
+  void annotate(const Graph& graph, Graph::Sampler& sampler);
   std::string getNodeDefinitions() const;
   std::string getNodeConnections() const;
+  std::string getNodeAttributes(const std::string& node_name) const;
+  std::string getEdgeAttributes(const ConnectionSpec& connection) const;
 };
 }
@@ -0,0 +1,228 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace flow
+{
+/// \brief Compact histogram of durations, with logarithmically sized buckets.
+///
+/// Each power of two is split into four buckets, so that a reported percentile
+/// is within 12.5% of the true value. Durations from 1ns to about 18 minutes are
+/// resolved, longer durations end up in the last bucket.
+/// Recording is a handful of integer operations and never allocates.
+///
+/// \code{.cpp}
+/// LatencyHistogram histogram;
+/// histogram.record(std::chrono::microseconds{150});
+/// const double p99 = histogram.getPercentile(0.99); // seconds
+/// \endcode
+class LatencyHistogram
+{
+public:
+  static constexpr size_t num_buckets = 160;
+
+  /// \brief Add a duration to the histogram
+  void record(std::chrono::nanoseconds duration);
+
+  /// \brief Add a duration, given in nanoseconds, to the histogram
+  void record(uint64_t nanoseconds);
+
+  /// \brief Add all the durations of another histogram to this one
+  void merge(const LatencyHistogram& other);
+
+  /// \brief Remove all recorded durations
+  void clear();
+
+  /// \brief Number of recorded durations
+  [[nodiscard]] uint64_t getCount() const;
+
+  /// \brief Mean of the recorded durations, in seconds. 0 if empty.
+  [[nodiscard]] double getMean() const;
+
+  /// \brief Largest recorded duration, in seconds. 0 if empty.
+  [[nodiscard]] double getMax() const;
+
+  /// \brief Sum of the recorded durations, in seconds.
+  [[nodiscard]] double getSum() const;
+
+  /// \brief Estimate the duration below which the fraction `quantile` of the durations fall.
+  /// \param quantile in the range [0, 1], e.g. 0.99 for the 99th percentile
+  /// \return The estimated duration, in seconds. 0 if empty.
+  [[nodiscard]] double getPercentile(double quantile) const;
+
+  /// \brief Number of durations recorded in the given bucket
+  [[nodiscard]] uint64_t getBucketCount(size_t bucket) const;
+
+  /// \brief Upper (exclusive) bound of the given bucket, in nanoseconds
+  [[nodiscard]] static uint64_t getBucketUpperBound(size_t bucket);
+
+  /// \brief Index of the bucket a duration, given in nanoseconds, is counted in
+  [[nodiscard]] static size_t getBucketIndex(uint64_t nanoseconds);
+
+  /// \brief Create a histogram from bucket counts collected elsewhere.
+  /// \param buckets Number of durations in each bucket
+  /// \param sum_ns Sum of the durations, in nanoseconds
+  /// \param max_ns Largest duration, in nanoseconds
+  [[nodiscard]] static LatencyHistogram fromBuckets(
+    const std::array<uint64_t, num_buckets>& buckets,
+    uint64_t sum_ns,
+    uint64_t max_ns
+  );
+
+private:
+  static constexpr unsigned sub_bucket_bits = 2;
+  static constexpr uint64_t num_sub_buckets = 1u << sub_bucket_bits;
+
+  std::array<uint64_t, num_buckets> buckets_{};
+  uint64_t count_ = 0;
+  uint64_t sum_ = 0;
+  uint64_t max_ = 0;
+
+  [[nodiscard]] static uint64_t getBucketLowerBound(size_t bucket);
+};
+
+// ----- Implementation -----
+inline void LatencyHistogram::record(const std::chrono::nanoseconds duration)
+{
+  record(static_cast<uint64_t>(duration.count() > 0 ? duration.count() : 0));
+}
+
+inline void LatencyHistogram::record(const uint64_t nanoseconds)
+{
+  ++buckets_[getBucketIndex(nanoseconds)];
+  ++count_;
+  sum_ += nanoseconds;
+
+  if (nanoseconds > max_)
+  { max_ = nanoseconds; }
+}
+
+inline void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+  for (size_t i = 0; i < num_buckets; ++i)
+  { buckets_[i] += other.buckets_[i]; }
+
+  count_ += other.count_;
+  sum_ += other.sum_;
+
+  if (other.max_ > max_)
+  { max_ = other.max_; }
+}
+
+inline void LatencyHistogram::clear()
+{
+  *this = LatencyHistogram{};
+}
+
+inline uint64_t LatencyHistogram::getCount() const
+{
+  return count_;
+}
+
+inline double LatencyHistogram::getMean() const
+{
+  return count_ == 0
+         ? 0.
+         : getSum() / static_cast<double>(count_);
+}
+
+inline double LatencyHistogram::getMax() const
+{
+  return static_cast<double>(max_) * 1e-9;
+}
+
+inline double LatencyHistogram::getSum() const
+{
+  return static_cast<double>(sum_) * 1e-9;
+}
+
+inline double LatencyHistogram::getPercentile(const double quantile) const
+{
+  if (count_ == 0)
+  { return 0.; }
+
+  const auto rank = static_cast<uint64_t>(quantile * static_cast<double>(count_ - 1));
+  uint64_t seen = 0;
+
+  for (size_t i = 0; i < num_buckets; ++i)
+  {
+    seen += buckets_[i];
+
+    if (seen > rank)
+    {
+      const auto lower = static_cast<double>(getBucketLowerBound(i));
+      const auto upper = static_cast<double>(getBucketUpperBound(i));
+      const auto midpoint = std::min((lower + upper) / 2., static_cast<double>(max_));
+
+      return midpoint * 1e-9;
+    }
+  }
+
+  return getMax();
+}
+
+inline uint64_t LatencyHistogram::getBucketCount(const size_t bucket) const
+{
+  return buckets_.at(bucket);
+}
+
+inline size_t LatencyHistogram::getBucketIndex(const uint64_t nanoseconds)
+{
+  if (nanoseconds < 2 * num_sub_buckets)
+  { return static_cast<size_t>(nanoseconds); }
+
+#if defined(__GNUC__)
+  const auto msb = static_cast<unsigned>(63 - __builtin_clzll(nanoseconds));
+#else
+  unsigned msb = 0;
+  for (uint64_t v = nanoseconds; v > 1; v >>= 1)
+  { ++msb; }
+#endif
+
+  const unsigned shift = msb - sub_bucket_bits;
+  const auto sub_bucket = static_cast<size_t>((nanoseconds >> shift) & (num_sub_buckets - 1));
+  const auto index = 2 * num_sub_buckets + (msb - sub_bucket_bits - 1) * num_sub_buckets + sub_bucket;
+
+  return index < num_buckets ? index : num_buckets - 1;
+}
+
+inline LatencyHistogram LatencyHistogram::fromBuckets(
+  const std::array<uint64_t, num_buckets>& buckets,
+  const uint64_t sum_ns,
+  const uint64_t max_ns
+)
+{
+  LatencyHistogram histogram;
+  histogram.buckets_ = buckets;
+  histogram.sum_ = sum_ns;
+  histogram.max_ = max_ns;
+
+  for (const auto count : buckets)
+  { histogram.count_ += count; }
+
+  return histogram;
+}
+
+inline uint64_t LatencyHistogram::getBucketLowerBound(const size_t bucket)
+{
+  if (bucket < 2 * num_sub_buckets)
+  { return bucket; }
+
+  const auto msb = (bucket - 2 * num_sub_buckets) / num_sub_buckets + sub_bucket_bits + 1;
+  const auto sub_bucket = (bucket - 2 * num_sub_buckets) % num_sub_buckets;
+
+  return (num_sub_buckets + sub_bucket) << (msb - sub_bucket_bits);
+}
+
+inline uint64_t LatencyHistogram::getBucketUpperBound(const size_t bucket)
+{
+  return bucket + 1 < num_buckets
+         ? getBucketLowerBound(bucket + 1)
+         : UINT64_MAX;
+}
+}
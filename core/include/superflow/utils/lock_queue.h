@@ -2,18 +2,28 @@
 #pragma once
 
 #include "superflow/policy.h"
+#include "superflow/utils/fiber.h"
 #include "superflow/utils/terminated_exception.h"
 
-#include <condition_variable>
+#include <algorithm>
 #include <mutex>
-#include <queue>
+#include <optional>
+#include <stdexcept>
+#include <vector>
 
 namespace flow
 {
+/// \brief Thread safe queue with a maximum size.
+///
+/// The items are stored in a ring buffer, which grows on demand up to `max_queue_size`
+/// and is then reused, so that pushing and popping does not allocate once the queue
+/// has reached its typical size.
 template<typename T, LeakPolicy L = LeakPolicy::Leaky>
 class LockQueue
 {
 public:
+  static_assert(L == LeakPolicy::Leaky || L == LeakPolicy::PushBlocking, "LockQueue does not spill, use SpillQueue");
+
   explicit LockQueue(unsigned int max_queue_size);
 
   LockQueue(unsigned int max_queue_size, std::initializer_list<T> list);
@@ -24,15 +34,22 @@ public:
 
   [[nodiscard]] size_t getQueueSize() const;
 
+  /// \brief Number of items that have been dropped because the queue was full
+  [[nodiscard]] size_t getNumDropped() const;
+
   [[nodiscard]] bool isEmpty() const;
 
   [[nodiscard]] bool isTerminated() const;
 
   void terminate();
 
-  void push(const T& item);
+  /// \brief Add an item to the back of the queue.
+  /// A Leaky queue that is full drops its oldest item to make room.
+  /// \return The dropped item, if any
+  std::optional<T> push(const T& item);
 
-  void push(T&& item);
+  /// \copydoc push(const T&)
+  std::optional<T> push(T&& item);
 
   void front(T& t) const;
 
@@ -44,13 +61,25 @@ public:
 
 private:
   mutable std::mutex mutex_;
-  mutable std::condition_variable consumer_;
-  mutable std::condition_variable producer_;
+  mutable fiber::Condition consumer_;
+  mutable fiber::Condition producer_;
 
-  std::queue<T> queue_;
+  std::vector<std::optional<T>> slots_;
+  size_t head_ = 0;
+  size_t size_ = 0;
+  size_t num_dropped_ = 0;
   const unsigned long max_queue_size_ = 1;
   bool terminated_ = false;
 
+  template<typename U>
+  void pushBack(U&& item);
+
+  void popFront();
+
+  [[nodiscard]] T& frontItem();
+
+  [[nodiscard]] const T& frontItem() const;
+
   std::unique_lock<std::mutex> consumerWait() const;
 
   std::unique_lock<std::mutex> producerWait() const;
@@ -68,14 +97,16 @@ LockQueue<T, L>::LockQueue(unsigned int max_queue_size)
 
 template<typename T, LeakPolicy L>
 LockQueue<T, L>::LockQueue(unsigned int max_queue_size, std::initializer_list<T> list)
-  : queue_{list}
-  , max_queue_size_(max_queue_size)
+  : max_queue_size_(max_queue_size)
 {
   if (max_queue_size_ < 1)
   { throw std::invalid_argument("LockQueue ctor: argument 'max_queue_size' must be 1 or more."); }
 
-  if (queue_.size() > max_queue_size)
+  if (list.size() > max_queue_size)
   { throw std::range_error("initializer list contains more than 'max_queue_size' elements"); }
+
+  for (const auto& item : list)
+  { pushBack(item); }
 }
 
 template<typename T, LeakPolicy L>
@@ -86,22 +117,30 @@ template<typename T, LeakPolicy L>
 void LockQueue<T, L>::clearQueue()
 {
   std::lock_guard<std::mutex> mlock(mutex_);
-  std::queue<T> empty;
-  std::swap(queue_, empty);
+
+  while (size_ > 0)
+  { popFront(); }
 }
 
 template<typename T, LeakPolicy L>
 size_t LockQueue<T, L>::getQueueSize() const
 {
   std::lock_guard<std::mutex> lock{mutex_};
-  return queue_.size();
+  return size_;
+}
+
+template<typename T, LeakPolicy L>
+size_t LockQueue<T, L>::getNumDropped() const
+{
+  std::lock_guard<std::mutex> lock{mutex_};
+  return num_dropped_;
 }
 
 template<typename T, LeakPolicy L>
 bool LockQueue<T, L>::isEmpty() const
 {
   std::lock_guard<std::mutex> lock{mutex_};
-  return queue_.empty();
+  return size_ == 0;
 }
 
 template<typename T, LeakPolicy L>
@@ -111,10 +150,16 @@ bool LockQueue<T, L>::isTerminated() const
 template<typename T, LeakPolicy L>
 void LockQueue<T, L>::terminate()
 {
-  if (terminated_)
-  { return; }
+  {
+    // Set under the lock, so that a waiting fiber cannot miss it
+    std::scoped_lock lock{mutex_};
+
+    if (terminated_)
+    { return; }
+
+    terminated_ = true;
+  }
 
-  terminated_ = true;
   producer_.notify_all();
   consumer_.notify_all();
 }
@@ -124,7 +169,7 @@ void LockQueue<T, L>::front(T& t) const
 {
   const auto mlock = consumerWait();
 
-  t = queue_.front();
+  t = frontItem();
 }
 
 template<typename T, LeakPolicy L>
@@ -132,7 +177,7 @@ T LockQueue<T, L>::front() const
 {
   const auto mlock = consumerWait();
 
-  return queue_.front();
+  return frontItem();
 }
 
 template<typename T, LeakPolicy L>
@@ -140,8 +185,8 @@ T LockQueue<T, L>::pop()
 {
   auto mlock = consumerWait();
 
-  T item = std::move(queue_.front());
-  queue_.pop();
+  T item = std::move(frontItem());
+  popFront();
 
   mlock.unlock();
   consumerSatisfied();
@@ -153,43 +198,57 @@ void LockQueue<T, L>::pop(T& item)
 {
   auto mlock = consumerWait();
 
-  std::swap(item, queue_.front());
-  queue_.pop();
+  std::swap(item, frontItem());
+  popFront();
   mlock.unlock();
   consumerSatisfied();
 }
 
 template<typename T, LeakPolicy L>
-void LockQueue<T, L>::push(T&& item)
+std::optional<T> LockQueue<T, L>::push(T&& item)
 {
   auto mlock = producerWait();
+  std::optional<T> dropped;
 
-  if (queue_.size() >= max_queue_size_)
-  { queue_.pop(); }
+  if (size_ >= max_queue_size_)
+  {
+    dropped = std::move(frontItem());
+    popFront();
+    ++num_dropped_;
+  }
 
-  queue_.push(std::move(item));
+  pushBack(std::move(item));
   mlock.unlock();
   producerSatisfied();
+
+  return dropped;
 }
 
 template<typename T, LeakPolicy L>
-void LockQueue<T, L>::push(const T& item)
+std::optional<T> LockQueue<T, L>::push(const T& item)
 {
   auto mlock = producerWait();
+  std::optional<T> dropped;
 
-  if (queue_.size() >= max_queue_size_)
-  { queue_.pop(); }
+  if (size_ >= max_queue_size_)
+  {
+    dropped = std::move(frontItem());
+    popFront();
+    ++num_dropped_;
+  }
 
-  queue_.push(item);
+  pushBack(item);
   mlock.unlock();
   producerSatisfied();
+
+  return dropped;
 }
 
 template<typename T, LeakPolicy L>
 std::unique_lock<std::mutex> LockQueue<T, L>::consumerWait() const
 {
   std::unique_lock<std::mutex> mlock(mutex_);
-  consumer_.wait(mlock, [this](){ return !queue_.empty() || terminated_; });
+  consumer_.wait(mlock, [this](){ return size_ > 0 || terminated_; });
 
   if (terminated_)
   { throw TerminatedException(); }
@@ -205,7 +264,7 @@ std::unique_lock<std::mutex> LockQueue<T, L>::producerWait() const
   if constexpr (L == LeakPolicy::PushBlocking)
   {
     producer_.wait(mlock, [this]()
-    { return queue_.size() < max_queue_size_ || terminated_; });
+    { return size_ < max_queue_size_ || terminated_; });
   }
 
   if (terminated_)
@@ -228,4 +287,44 @@ void LockQueue<T, L>::producerSatisfied() const
 {
   consumer_.notify_one();
 }
+
+template<typename T, LeakPolicy L>
+template<typename U>
+void LockQueue<T, L>::pushBack(U&& item)
+{
+  if (size_ == slots_.size())
+  {
+    const size_t capacity = std::min<size_t>(std::max<size_t>(2 * slots_.size(), 1), max_queue_size_);
+    std::vector<std::optional<T>> slots(capacity);
+
+    for (size_t i = 0; i < size_; ++i)
+    { slots[i].emplace(std::move(*slots_[(head_ + i) % slots_.size()])); }
+
+    slots_ = std::move(slots);
+    head_ = 0;
+  }
+
+  slots_[(head_ + size_) % slots_.size()].emplace(std::forward<U>(item));
+  ++size_;
+}
+
+template<typename T, LeakPolicy L>
+void LockQueue<T, L>::popFront()
+{
+  slots_[head_].reset();
+  head_ = (head_ + 1) % slots_.size();
+  --size_;
+}
+
+template<typename T, LeakPolicy L>
+T& LockQueue<T, L>::frontItem()
+{
+  return *slots_[head_];
+}
+
+template<typename T, LeakPolicy L>
+const T& LockQueue<T, L>::frontItem() const
+{
+  return *slots_[head_];
+}
 }
@@ -1,9 +1,9 @@
 // Copyright 2019, Forsvarets forskningsinstitutt. All rights reserved.
 #pragma once
 
+#include "superflow/utils/fiber.h"
 #include "superflow/utils/terminated_exception.h"
 
-#include <condition_variable>
 #include <map>
 #include <mutex>
 #include <queue>
@@ -30,9 +30,11 @@ public:
       const std::vector<K>& keys
   );
 
-  void push(const K& key, const T& item);
+  /// Adds an item to the queue of `key`. If the queue is full, its oldest item is dropped.
+  /// \return true if an item was dropped
+  bool push(const K& key, const T& item);
 
-  void push(const K& key, T&& item);
+  bool push(const K& key, T&& item);
 
   /// Returns a map of the first item in all non-empty queues,
   /// while not removing the elements. Does not block. Ever.
@@ -119,13 +121,20 @@ public:
   /// Returns the number of queues.
   size_t getNumQueues() const;
 
+  /// Returns the total number of elements in all queues.
+  size_t getQueueSize() const;
+
+  /// Returns the number of elements that have been dropped because a queue was full.
+  size_t getNumDropped() const;
+
 private:
   mutable std::mutex mutex_;
-  mutable std::condition_variable cond_;
+  mutable fiber::Condition cond_;
 
   std::map<K, std::queue<T>> queues_;
   size_t max_queue_size_;
   bool terminated_;
+  size_t num_dropped_ = 0;
 
   std::unique_lock<std::mutex> waitAny() const;
 
@@ -159,8 +168,10 @@ MultiLockQueue<K, T>::MultiLockQueue(
 {}
 
 template<typename K, typename T>
-void MultiLockQueue<K, T>::push(const K& key, const T& item)
+bool MultiLockQueue<K, T>::push(const K& key, const T& item)
 {
+  bool dropped = false;
+
   {
     std::lock_guard<std::mutex> lock{mutex_};
 
@@ -169,17 +180,23 @@ void MultiLockQueue<K, T>::push(const K& key, const T& item)
     if (queue.size() >= max_queue_size_)
     {
       queue.pop();
+      ++num_dropped_;
+      dropped = true;
     }
 
     queue.push(item);
   }
 
   cond_.notify_one();
+
+  return dropped;
 }
 
 template<typename K, typename T>
-void MultiLockQueue<K, T>::push(const K& key, T&& item)
+bool MultiLockQueue<K, T>::push(const K& key, T&& item)
 {
+  bool dropped = false;
+
   {
     std::lock_guard<std::mutex> lock{mutex_};
 
@@ -188,12 +205,16 @@ void MultiLockQueue<K, T>::push(const K& key, T&& item)
     if (queue.size() >= max_queue_size_)
     {
       queue.pop();
+      ++num_dropped_;
+      dropped = true;
     }
 
     queue.push(std::move(item));
   }
 
   cond_.notify_one();
+
+  return dropped;
 }
 
 template<typename K, typename T>
@@ -348,12 +369,18 @@ bool MultiLockQueue<K, T>::hasAll(const std::unique_lock<std::mutex>&) const
 template<typename K, typename T>
 void MultiLockQueue<K, T>::terminate()
 {
-  if (terminated_)
   {
-    return;
+    // Set under the lock, so that a waiting fiber cannot miss it
+    std::lock_guard<std::mutex> lock{mutex_};
+
+    if (terminated_)
+    {
+      return;
+    }
+
+    terminated_ = true;
   }
 
-  terminated_ = true;
   cond_.notify_all();
 }
 
@@ -371,6 +398,29 @@ size_t MultiLockQueue<K, T>::getNumQueues() const
   return queues_.size();
 }
 
+template<typename K, typename T>
+size_t MultiLockQueue<K, T>::getQueueSize() const
+{
+  std::lock_guard<std::mutex> lock{mutex_};
+
+  size_t size = 0;
+
+  for (const auto& kv : queues_)
+  {
+    size += kv.second.size();
+  }
+
+  return size;
+}
+
+template<typename K, typename T>
+size_t MultiLockQueue<K, T>::getNumDropped() const
+{
+  std::lock_guard<std::mutex> lock{mutex_};
+
+  return num_dropped_;
+}
+
 template<typename K, typename T>
 std::unique_lock<std::mutex> MultiLockQueue<K, T>::waitAny() const
 {
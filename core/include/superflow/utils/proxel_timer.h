@@ -2,6 +2,7 @@
 #pragma once
 
 #include "superflow/proxel_status.h"
+#include "superflow/utils/windowed_histogram.h"
 
 #include <atomic>
 #include <chrono>
@@ -15,6 +16,8 @@ namespace flow
 /// Typical usage:
 /// \code{.cpp}
 /// flow::ProxelTimer proxel_timer_;
+/// // in the constructor, report the timer as status fields, formatted only when requested:
+/// addStatusTimer("processing", proxel_timer_);
 /// // ...
 /// for (const auto& data: *input_port_)
 /// {
@@ -22,16 +25,32 @@ namespace flow
 ///   proxel_timer_.start();
 ///   // work ...
 ///   proxel_timer_.stop();
-///   setStatusInfo(proxel_timer_.getStatusInfo());
 /// }
 /// \endcode
 class ProxelTimer
 {
 public:
+  /// \brief Statistics of the processing times within a time window, in seconds
+  struct WindowStatistics
+  {
+    double mean;
+    double p99;
+    double max;
+    unsigned long long count;
+  };
+
+  ProxelTimer() = default;
+
+  /// \param ewma_time_constant Time constant of the exponentially weighted busyness
+  /// \see getBusyness
+  explicit ProxelTimer(std::chrono::duration<double> ewma_time_constant);
+
   /// \brief Start the timer
   void start();
 
-  /// \brief Stop the timer
+  /// \brief Stop the timer.
+  /// The time since start is recorded as a running span if the timeline is enabled.
+  /// \see timeline::enable
   /// \return elapsed time since start (in seconds)
   double stop();
 
@@ -54,16 +73,37 @@ public:
   /// \return average busy ratio
   [[nodiscard]] double getAverageBusyness() const;
 
+  /// \brief Get the ratio of processing vs idle state, as an exponentially weighted moving average.
+  ///
+  /// Unlike getAverageBusyness, recent changes dominate. Each interval between two stops
+  /// contributes with a weight of \f$ \frac{dt}{\tau + dt} \f$, where \f$ \tau \f$ is the
+  /// time constant given to the constructor (10 s by default).
+  /// Idle time since the last stop is taken into account as well.
+  /// \return recent busy ratio
+  [[nodiscard]] double getBusyness() const;
+
+  /// \brief Get statistics of the processing times during the latest `window`.
+  /// \param window In the range [1s, 60s]. The resolution is one second for windows up to 10s,
+  /// and ten seconds for longer windows. \see WindowedHistogram::getWindow
+  /// \throws std::invalid_argument if `window` is out of range
+  [[nodiscard]] WindowStatistics getWindowStatistics(std::chrono::seconds window) const;
+
+  /// \brief Estimate a percentile of all processing times since the first start.
+  /// \param quantile in the range [0, 1], e.g. 0.99 for the 99th percentile
+  /// \return estimated processing time (in seconds), within 12.5% of the true value
+  [[nodiscard]] double getPercentileProcessingTime(double quantile) const;
+
   /// \brief Read how many times the timer has been stopped.
   /// \return run count
   [[nodiscard]] unsigned long long getRunCount() const;
 
-  /// \brief Create a formatted string containing average processing time and average busyness.
+  /// \brief Create a formatted string containing average processing time,
+  /// 99th percentile processing time during the last 10 seconds and average busyness.
   /// \return The formatted string.
   [[nodiscard]] std::string getStatusInfo() const;
 
 private:
-  using Clock = std::chrono::high_resolution_clock;
+  using Clock = std::chrono::steady_clock;
   using Duration = std::chrono::duration<double>;
 
   std::once_flag first_flag_;
@@ -76,5 +116,11 @@ private:
   std::atomic<double> mean_busyness_time_{0};
 
   Clock::time_point start_;
+
+  double ewma_time_constant_{10.};
+  std::atomic<double> ewma_busyness_{0};
+  std::atomic<Clock::rep> last_stop_{0};
+
+  WindowedHistogram histogram_;
 };
 }
@@ -0,0 +1,69 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include "superflow/codec.h"
+
+#include <cstddef>
+#include <string>
+
+namespace flow
+{
+/// \brief A first-in, first-out queue of byte records in a memory-mapped temporary file.
+///
+/// The file is used as a ring buffer of `max_size` bytes, which is the disk budget of the queue.
+/// It is removed from the directory as soon as it is created, so that it never outlives the process.
+/// The whole budget is reserved on the disk when the file is created, so that a full disk fails the
+/// construction instead of a later push.
+/// The queue is not thread safe. \see SpillQueue
+/// Only available on Linux.
+class SpillFile
+{
+public:
+  /// \param directory Directory of the file, or empty for the temporary directory of the system
+  /// \param max_size Size of the file, in bytes
+  /// \throws std::invalid_argument if `max_size` is too small to hold a record
+  /// \throws std::runtime_error if the file cannot be created, or the budget cannot be reserved
+  SpillFile(const std::string& directory, size_t max_size);
+
+  ~SpillFile();
+
+  SpillFile(const SpillFile&) = delete;
+  SpillFile& operator=(const SpillFile&) = delete;
+
+  /// \brief Append a record, made of `header` followed by `payload`.
+  /// \return false if the record does not fit in the remaining budget
+  bool push(ByteView header, ByteView payload);
+
+  /// \brief The oldest record. The view is valid until it is popped.
+  /// \throws std::out_of_range if the queue is empty
+  [[nodiscard]] ByteView front() const;
+
+  /// \brief Remove the oldest record
+  /// \throws std::out_of_range if the queue is empty
+  void pop();
+
+  void clear();
+
+  [[nodiscard]] bool isEmpty() const;
+
+  /// \brief Number of records in the queue
+  [[nodiscard]] size_t getNumRecords() const;
+
+  /// \brief Bytes taken up by the records in the queue, including their framing
+  [[nodiscard]] size_t getSize() const;
+
+  [[nodiscard]] size_t getMaxSize() const;
+
+private:
+  int fd_ = -1;
+  std::byte* data_ = nullptr;
+  size_t max_size_;
+  size_t head_ = 0;
+  size_t tail_ = 0;
+  size_t size_ = 0;
+  size_t num_records_ = 0;
+
+  /// \return The offset of the oldest record, after any wrap at the end of the file
+  [[nodiscard]] size_t getHead() const;
+};
+}
@@ -0,0 +1,326 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include "superflow/codec.h"
+#include "superflow/trace.h"
+#include "superflow/utils/fiber.h"
+#include "superflow/utils/spill_file.h"
+#include "superflow/utils/terminated_exception.h"
+
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace flow
+{
+/// \brief Where and how much a SpillQueue may spill, \see BufferedConsumerPort
+struct SpillOptions
+{
+  std::string directory;              ///< Directory of the spill file, or empty for the temporary directory of the system
+  size_t max_bytes = size_t{1} << 28; ///< Disk budget of the spill file, in bytes
+};
+
+/// \brief Thread safe queue that holds up to `max_queue_size` items in memory, and spills the rest to disk.
+///
+/// Items that arrive while the memory is full are encoded by flow::Codec<T> and appended to a SpillFile.
+/// Every `pop` moves the oldest spilled item back into memory, so the items come out in the order
+/// they were pushed. Pushing never blocks: only when the disk budget is used up, the newest item is
+/// dropped. A spilled item that cannot be decoded is dropped as well. Items are encoded and decoded
+/// outside of the lock of the queue, which only covers copying the bytes to and from the file.
+/// This is the buffer of a BufferedConsumerPort with LeakPolicy::Spill, for edges with bursts
+/// that are larger than the memory buffer, but not larger than the disk.
+/// \tparam T The type of data. The queue holds Traced<T>, and keeps the trace id of spilled items.
+template<typename T>
+class SpillQueue
+{
+public:
+  /// \throws std::invalid_argument if `max_queue_size` is 0, \see SpillFile
+  explicit SpillQueue(unsigned int max_queue_size, const SpillOptions& options = SpillOptions{});
+
+  ~SpillQueue();
+
+  void clearQueue();
+
+  /// \brief Number of items in memory and on disk
+  [[nodiscard]] size_t getQueueSize() const;
+
+  /// \brief Number of items that have been dropped because the disk budget was used up,
+  /// or because they could not be decoded after being spilled
+  [[nodiscard]] size_t getNumDropped() const;
+
+  /// \brief Number of items that have been spilled to disk
+  [[nodiscard]] size_t getNumSpilled() const;
+
+  /// \brief Bytes of the items currently on disk
+  [[nodiscard]] size_t getSpilledBytes() const;
+
+  [[nodiscard]] bool isEmpty() const;
+
+  [[nodiscard]] bool isTerminated() const;
+
+  void terminate();
+
+  /// \brief Add an item to the back of the queue, spilling it if the memory is full.
+  /// \return The item, if it was dropped because the disk budget is used up
+  /// \throws TerminatedException if the queue is terminated
+  std::optional<Traced<T>> push(Traced<T>&& item);
+
+  /// \copydoc push(Traced<T>&&)
+  std::optional<Traced<T>> push(const Traced<T>& item);
+
+  /// \brief Remove and return the oldest item, waiting until there is one.
+  /// \throws TerminatedException if the queue is terminated
+  Traced<T> pop();
+
+private:
+  /// Precedes each spilled item, which never leaves the process, so the pointers stay valid
+  struct SpilledHeader
+  {
+    uint64_t trace_id;
+    const Port* sender;
+    int64_t stamp;
+  };
+
+  mutable std::mutex mutex_;
+  fiber::Condition consumer_;
+
+  const size_t max_queue_size_;
+  std::deque<Traced<T>> memory_;
+  SpillFile spill_;
+  std::vector<std::byte> unspilled_; ///< The bytes of the item being unspilled
+  bool is_unspilling_ = false;
+  size_t num_dropped_ = 0;
+  size_t num_spilled_ = 0;
+  std::atomic<bool> terminated_{false};
+
+  /// An item goes to memory only if nothing older is on disk or being unspilled
+  [[nodiscard]] bool fitsInMemory() const;
+
+  /// \return false if the item does not fit in the spill file
+  bool spill(const Traced<T>& item, ByteView payload);
+
+  /// Move the oldest spilled item that can be decoded into memory, or drop them all.
+  /// Called with `lock` locked, which is unlocked while decoding.
+  void unspill(std::unique_lock<std::mutex>& lock);
+};
+
+// ----- Implementation -----
+template<typename T>
+SpillQueue<T>::SpillQueue(const unsigned int max_queue_size, const SpillOptions& options)
+  : max_queue_size_{max_queue_size}
+  , spill_{options.directory, options.max_bytes}
+{
+  if (max_queue_size_ < 1)
+  { throw std::invalid_argument("SpillQueue ctor: argument 'max_queue_size' must be 1 or more."); }
+}
+
+template<typename T>
+SpillQueue<T>::~SpillQueue()
+{ terminate(); }
+
+template<typename T>
+void SpillQueue<T>::clearQueue()
+{
+  std::scoped_lock lock{mutex_};
+  memory_.clear();
+  spill_.clear();
+}
+
+template<typename T>
+size_t SpillQueue<T>::getQueueSize() const
+{
+  std::scoped_lock lock{mutex_};
+  return memory_.size() + spill_.getNumRecords() + (is_unspilling_ ? 1 : 0);
+}
+
+template<typename T>
+size_t SpillQueue<T>::getNumDropped() const
+{
+  std::scoped_lock lock{mutex_};
+  return num_dropped_;
+}
+
+template<typename T>
+size_t SpillQueue<T>::getNumSpilled() const
+{
+  std::scoped_lock lock{mutex_};
+  return num_spilled_;
+}
+
+template<typename T>
+size_t SpillQueue<T>::getSpilledBytes() const
+{
+  std::scoped_lock lock{mutex_};
+  return spill_.getSize();
+}
+
+template<typename T>
+bool SpillQueue<T>::isEmpty() const
+{
+  std::scoped_lock lock{mutex_};
+  return memory_.empty();
+}
+
+template<typename T>
+bool SpillQueue<T>::isTerminated() const
+{ return terminated_; }
+
+template<typename T>
+void SpillQueue<T>::terminate()
+{
+  {
+    std::scoped_lock lock{mutex_};
+    terminated_ = true;
+  }
+
+  consumer_.notify_all();
+}
+
+template<typename T>
+std::optional<Traced<T>> SpillQueue<T>::push(Traced<T>&& item)
+{
+  std::unique_lock lock{mutex_};
+
+  if (terminated_)
+  { throw TerminatedException(); }
+
+  if (!fitsInMemory())
+  {
+    bool spilled;
+
+    if constexpr (codec::has_view_v<T>)
+    { spilled = spill(item, Codec<T>::view(item.item)); }
+    else
+    {
+      // Each producer thread encodes into a buffer of its own, without holding the lock
+      thread_local std::vector<std::byte> encoded;
+
+      lock.unlock();
+      encoded.clear();
+      Codec<T>::encode(item.item, encoded);
+      lock.lock();
+
+      if (terminated_)
+      { throw TerminatedException(); }
+
+      spilled = !fitsInMemory() && spill(item, {encoded.data(), encoded.size()});
+    }
+
+    if (!spilled && !fitsInMemory())
+    {
+      ++num_dropped_;
+      return std::move(item);
+    }
+  }
+
+  if (fitsInMemory())
+  { memory_.push_back(std::move(item)); }
+
+  lock.unlock();
+  consumer_.notify_one();
+
+  return std::nullopt;
+}
+
+template<typename T>
+std::optional<Traced<T>> SpillQueue<T>::push(const Traced<T>& item)
+{
+  return push(Traced<T>{item});
+}
+
+template<typename T>
+Traced<T> SpillQueue<T>::pop()
+{
+  std::unique_lock lock{mutex_};
+
+  // An item that another consumer is unspilling is newer than those in memory
+  consumer_.wait(lock, [this]() { return !memory_.empty() || terminated_; });
+
+  if (terminated_)
+  { throw TerminatedException(); }
+
+  Traced<T> item = std::move(memory_.front());
+  memory_.pop_front();
+
+  if (!spill_.isEmpty())
+  {
+    unspill(lock);
+    lock.unlock();
+    consumer_.notify_one();
+  }
+
+  return item;
+}
+
+template<typename T>
+bool SpillQueue<T>::fitsInMemory() const
+{
+  return spill_.isEmpty() && !is_unspilling_ && memory_.size() < max_queue_size_;
+}
+
+template<typename T>
+bool SpillQueue<T>::spill(const Traced<T>& item, const ByteView payload)
+{
+  const SpilledHeader header{
+    item.trace_id,
+    item.sender,
+    item.stamp
+  };
+  const ByteView header_bytes{reinterpret_cast<const std::byte*>(&header), sizeof(header)};
+  const bool spilled = spill_.push(header_bytes, payload);
+
+  if (spilled)
+  { ++num_spilled_; }
+
+  return spilled;
+}
+
+template<typename T>
+void SpillQueue<T>::unspill(std::unique_lock<std::mutex>& lock)
+{
+  is_unspilling_ = true;
+
+  while (!spill_.isEmpty())
+  {
+    // The record is copied out, since the file may be overwritten by pushes once it is popped
+    const auto record = spill_.front();
+    unspilled_.assign(record.data, record.data + record.size);
+    spill_.pop();
+
+    lock.unlock();
+
+    std::optional<Traced<T>> item;
+    SpilledHeader header;
+    std::memcpy(&header, unspilled_.data(), sizeof(header));
+
+    try
+    {
+      item = Traced<T>{
+        Codec<T>::decode(unspilled_.data() + sizeof(header), unspilled_.size() - sizeof(header)),
+        header.trace_id,
+        header.sender,
+        header.stamp
+      };
+    }
+    catch (const std::exception&)
+    {}
+
+    lock.lock();
+
+    if (item)
+    {
+      memory_.push_back(std::move(*item));
+      break;
+    }
+
+    ++num_dropped_;
+  }
+
+  is_unspilling_ = false;
+}
+}
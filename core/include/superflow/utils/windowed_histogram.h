@@ -0,0 +1,86 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include "superflow/utils/latency_histogram.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace flow
+{
+/// \brief Histogram of durations over the whole lifetime, and over the last minute.
+///
+/// The durations of the last `fine_window` are counted in slots of one second each, and those
+/// of the last minute in slots of ten seconds each. Together the slots take about 12 kB, which
+/// are only allocated by the first `record`, so that unused timers stay small.
+/// Durations are recorded by a single thread, and the histograms may be read by any thread
+/// at the same time. All counters are relaxed atomics, so recording costs a bucket lookup
+/// and a few uncontended loads and stores. A reader may see a duration that is being
+/// recorded only partially, which is of no concern for statistics.
+/// \see LatencyHistogram, ProxelTimer
+class WindowedHistogram
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /// The longest window that can be read
+  static constexpr std::chrono::seconds max_window{60};
+
+  /// The longest window that is read with a resolution of one second
+  static constexpr std::chrono::seconds fine_window{10};
+
+  WindowedHistogram() = default;
+
+  ~WindowedHistogram();
+
+  WindowedHistogram(const WindowedHistogram&) = delete;
+
+  WindowedHistogram& operator=(const WindowedHistogram&) = delete;
+
+  /// \brief Record a duration that ended at `now`. Must only be called by one thread.
+  void record(Clock::time_point now, std::chrono::nanoseconds duration);
+
+  /// \brief Get the durations recorded during the last `window` seconds before `now`.
+  /// Whole slots are counted, so the oldest second of a window up to `fine_window` is only
+  /// partially covered, and a longer window may include up to ten seconds before it.
+  /// \throws std::invalid_argument if `window` is outside [1s, max_window]
+  [[nodiscard]] LatencyHistogram getWindow(Clock::time_point now, std::chrono::seconds window) const;
+
+  /// \brief Get all durations recorded since construction.
+  [[nodiscard]] LatencyHistogram getTotal() const;
+
+private:
+  static constexpr std::chrono::seconds fine_slot_duration{1};
+  static constexpr std::chrono::seconds coarse_slot_duration{10};
+
+  /// Enough for the window of each tier, and the slot that is being filled
+  static constexpr size_t num_fine_slots = fine_window / fine_slot_duration + 1;
+  static constexpr size_t num_coarse_slots = max_window / coarse_slot_duration + 1;
+
+  struct Counters
+  {
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> max{0};
+  };
+
+  /// Durations recorded during one period of the duration of the slot
+  struct Slot : Counters
+  {
+    std::atomic<int64_t> period{-1};
+    std::array<std::atomic<uint32_t>, LatencyHistogram::num_buckets> buckets{};
+  };
+
+  struct Slots
+  {
+    std::array<Slot, num_fine_slots> fine;
+    std::array<Slot, num_coarse_slots> coarse;
+  };
+
+  Counters total_;
+  std::array<std::atomic<uint64_t>, LatencyHistogram::num_buckets> total_buckets_{};
+  std::atomic<Slots*> slots_{nullptr}; ///< Allocated and owned by the writer
+};
+}
@@ -0,0 +1,62 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/allocation_counter.h"
+
+namespace flow::allocation
+{
+namespace
+{
+/// Read by the allocation hooks, so it must not be anything that allocates or has a
+/// non-trivial destructor. The counters are kept alive by Registration.
+thread_local Counters* thread_counters = nullptr;
+
+/// Owns the counters of a thread, and stops counting before they may be released.
+struct Registration
+{
+  std::shared_ptr<Counters> counters;
+
+  ~Registration()
+  { thread_counters = nullptr; }
+};
+
+thread_local Registration registration;
+}
+
+namespace detail
+{
+std::atomic<bool> instrumented{false};
+
+void record(const size_t bytes) noexcept
+{
+  if (auto* counters = thread_counters)
+  {
+    counters->count.fetch_add(1, std::memory_order_relaxed);
+    counters->bytes.fetch_add(bytes, std::memory_order_relaxed);
+  }
+}
+}
+
+std::shared_ptr<const Counters> getThreadCounters()
+{
+  if (registration.counters == nullptr)
+  {
+    registration.counters = std::make_shared<Counters>();
+    thread_counters = registration.counters.get();
+  }
+
+  return registration.counters;
+}
+
+AllocationStatistics read(const Counters& counters)
+{
+  AllocationStatistics statistics;
+  statistics.count = counters.count.load(std::memory_order_relaxed);
+  statistics.bytes = counters.bytes.load(std::memory_order_relaxed);
+
+  return statistics;
+}
+
+bool isInstrumented()
+{
+  return detail::instrumented.load(std::memory_order_relaxed);
+}
+}
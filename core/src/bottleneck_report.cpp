@@ -0,0 +1,233 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/bottleneck_report.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <utility>
+
+namespace flow
+{
+namespace
+{
+/// Stages with a busyness this close to the busiest stage are limiting as well
+constexpr double busyness_tolerance = 0.05;
+
+std::string findRoot(std::map<std::string, std::string>& parents, const std::string& proxel)
+{
+  auto& parent = parents[proxel];
+
+  if (parent.empty() || parent == proxel)
+  {
+    parent = proxel;
+    return proxel;
+  }
+
+  parent = findRoot(parents, parent);
+  return parent;
+}
+
+std::vector<std::vector<std::string>> findPipelines(
+  const ProxelStatusMap& statuses,
+  const std::vector<ConnectionSpec>& connections
+)
+{
+  std::map<std::string, std::string> parents;
+
+  for (const auto& kv : statuses)
+  { findRoot(parents, kv.first); }
+
+  for (const auto& connection : connections)
+  {
+    if (statuses.count(connection.lhs_name) == 0 || statuses.count(connection.rhs_name) == 0)
+    { continue; }
+
+    parents[findRoot(parents, connection.lhs_name)] = findRoot(parents, connection.rhs_name);
+  }
+
+  std::map<std::string, std::vector<std::string>> pipelines;
+
+  for (const auto& kv : statuses)
+  { pipelines[findRoot(parents, kv.first)].push_back(kv.first); }
+
+  std::vector<std::vector<std::string>> result;
+
+  for (auto& kv : pipelines)
+  { result.push_back(std::move(kv.second)); }
+
+  return result;
+}
+
+/// The period the busyness of a Proxel is measured over, as in Proxel::getStatus
+double getMeasuredTime(const ProxelStatus& status)
+{
+  double measured_time = 0.;
+
+  for (const auto& kv : status.ports)
+  { measured_time = std::max(measured_time, kv.second.waiting_time + kv.second.processing_time); }
+
+  return measured_time;
+}
+
+BottleneckReport::Stage getStage(
+  const std::string& proxel,
+  const ProxelStatus& status,
+  const std::set<std::string>& input_ports,
+  const double output_blocked_time
+)
+{
+  BottleneckReport::Stage stage;
+  stage.proxel = proxel;
+  stage.output_blocked_time = output_blocked_time;
+  stage.busyness = status.busyness;
+
+  // Time spent blocked by a full downstream buffer is counted as busy, but is caused downstream
+  if (const double measured_time = getMeasuredTime(status); measured_time > 0.)
+  { stage.busyness = std::max(status.busyness - output_blocked_time / measured_time, 0.); }
+
+  for (const auto& port_name : input_ports)
+  {
+    const auto it = status.ports.find(port_name);
+
+    if (it == status.ports.end())
+    { continue; }
+
+    stage.queue_size += it->second.queue_size;
+    stage.num_dropped += it->second.num_dropped;
+    stage.blocked_time += it->second.blocked_time;
+  }
+
+  stage.backpressure = stage.queue_size > 0 || stage.num_dropped > 0 || stage.blocked_time > 0.;
+
+  return stage;
+}
+
+BottleneckReport::Pipeline analyzePipeline(std::vector<BottleneckReport::Stage> stages, const size_t parallelism)
+{
+  BottleneckReport::Pipeline pipeline;
+
+  for (const auto& stage : stages)
+  { pipeline.proxels.push_back(stage.proxel); }
+
+  std::stable_sort(
+    stages.begin(), stages.end(),
+    [](const auto& lhs, const auto& rhs)
+    { return lhs.busyness > rhs.busyness; }
+  );
+
+  const auto is_busy = [](const BottleneckReport::Stage& stage)
+  { return stage.busyness > 0.; };
+
+  const auto is_pressured = [&is_busy](const BottleneckReport::Stage& stage)
+  { return is_busy(stage) && stage.backpressure; };
+
+  const bool any_pressured = std::any_of(stages.begin(), stages.end(), is_pressured);
+  const auto is_candidate = [&](const BottleneckReport::Stage& stage)
+  { return any_pressured ? is_pressured(stage) : is_busy(stage); };
+
+  const auto busiest = std::find_if(stages.begin(), stages.end(), is_candidate);
+
+  if (busiest == stages.end())
+  { return pipeline; }
+
+  const double max_busyness = busiest->busyness;
+  double rest_busyness = 0.;
+
+  for (const auto& stage : stages)
+  {
+    if (is_candidate(stage) && stage.busyness >= max_busyness - busyness_tolerance)
+    { pipeline.limiting_stages.push_back(stage); }
+    else
+    { rest_busyness = std::max(rest_busyness, stage.busyness); }
+  }
+
+  const double parallel_busyness = max_busyness / static_cast<double>(parallelism);
+  pipeline.predicted_speedup = std::max(max_busyness / std::max(parallel_busyness, rest_busyness), 1.);
+
+  return pipeline;
+}
+}
+
+BottleneckReport analyzeBottlenecks(
+  const ProxelStatusMap& statuses,
+  const std::vector<ConnectionSpec>& connections,
+  const size_t parallelism
+)
+{
+  if (parallelism == 0)
+  { throw std::invalid_argument("analyzeBottlenecks: 'parallelism' must be 1 or more"); }
+
+  std::map<std::string, std::set<std::string>> input_ports;
+  std::map<std::pair<std::string, std::string>, size_t> num_producers;
+
+  for (const auto& connection : connections)
+  {
+    input_ports[connection.rhs_name].insert(connection.rhs_port);
+    ++num_producers[{connection.rhs_name, connection.rhs_port}];
+  }
+
+  // A consumer port only counts the total time its producers were blocked, so it is shared among them
+  std::map<std::string, double> output_blocked_time;
+
+  for (const auto& connection : connections)
+  {
+    const auto status = statuses.find(connection.rhs_name);
+
+    if (status == statuses.end())
+    { continue; }
+
+    const auto port = status->second.ports.find(connection.rhs_port);
+
+    if (port == status->second.ports.end())
+    { continue; }
+
+    output_blocked_time[connection.lhs_name] += port->second.blocked_time
+                                                / static_cast<double>(num_producers[{connection.rhs_name, connection.rhs_port}]);
+  }
+
+  BottleneckReport report;
+  report.parallelism = parallelism;
+
+  for (const auto& proxels : findPipelines(statuses, connections))
+  {
+    std::vector<BottleneckReport::Stage> stages;
+
+    for (const auto& proxel : proxels)
+    { stages.push_back(getStage(proxel, statuses.at(proxel), input_ports[proxel], output_blocked_time[proxel])); }
+
+    report.pipelines.push_back(analyzePipeline(std::move(stages), parallelism));
+  }
+
+  return report;
+}
+
+std::ostream& operator<<(std::ostream& os, const BottleneckReport& report)
+{
+  const auto flags = os.flags();
+  const auto precision = os.precision();
+
+  for (const auto& pipeline : report.pipelines)
+  {
+    if (pipeline.limiting_stages.empty())
+    { continue; }
+
+    os << "bottleneck:";
+
+    for (const auto& stage : pipeline.limiting_stages)
+    {
+      os << ' ' << stage.proxel
+         << " (busy " << std::fixed << std::setprecision(2) << stage.busyness << ")";
+    }
+
+    os << " x" << std::setprecision(2) << pipeline.predicted_speedup
+       << " with " << report.parallelism << " instances\n";
+  }
+
+  os.flags(flags);
+  os.precision(precision);
+
+  return os;
+}
+}
@@ -0,0 +1,64 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/codec.h"
+
+namespace flow::codec
+{
+namespace
+{
+constexpr uint64_t fnv_offset_basis = 0xcbf29ce484222325;
+constexpr uint64_t fnv_prime = 0x100000001b3;
+
+uint32_t byteSwap(const uint32_t value)
+{
+  return ((value & 0xff) << 24) | ((value & 0xff00) << 8) | ((value >> 8) & 0xff00) | (value >> 24);
+}
+}
+
+uint64_t hashSchema(const std::string_view schema)
+{
+  uint64_t hash = fnv_offset_basis;
+
+  for (const char c : schema)
+  {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= fnv_prime;
+  }
+
+  return hash;
+}
+
+void checkHeader(
+  const CodecHeader& header,
+  const uint32_t version,
+  const uint64_t schema_hash,
+  const size_t available_size)
+{
+  if (header.magic == byteSwap(CodecHeader::magic_number))
+  { throw std::invalid_argument{"Codec: the message was written by a host with another byte order"}; }
+
+  if (header.magic != CodecHeader::magic_number)
+  { throw std::invalid_argument{"Codec: the message has no valid header"}; }
+
+  if (header.format != CodecHeader::current_format)
+  { throw std::invalid_argument{"Codec: unknown header format " + std::to_string(header.format)}; }
+
+  if (header.version != version)
+  {
+    throw std::invalid_argument{
+      "Codec: the item was encoded by version " + std::to_string(header.version)
+      + ", expected version " + std::to_string(version)
+    };
+  }
+
+  if (header.schema_hash != schema_hash)
+  { throw std::invalid_argument{"Codec: the item was encoded with another schema"}; }
+
+  if (header.payload_size > available_size)
+  {
+    throw std::invalid_argument{
+      "Codec: the message is truncated, expected " + std::to_string(header.payload_size)
+      + " bytes, got " + std::to_string(available_size)
+    };
+  }
+}
+}
@@ -0,0 +1,324 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/utils/fiber.h"
+#include "superflow/trace.h"
+
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+#endif
+
+namespace flow::fiber
+{
+#ifdef __linux__
+namespace
+{
+/// Like the default stack of a thread. The pages are only backed by memory once they are used.
+constexpr size_t stack_size = size_t{8} << 20;
+
+struct Scheduler;
+
+thread_local Scheduler* current_scheduler = nullptr;
+}
+
+class Fiber
+{
+public:
+  /// Why the fiber last switched back to the scheduler
+  enum class Step
+  {
+    Yielded,
+    HandedOff,
+    Parked,
+    Returned
+  };
+
+  Fiber(Scheduler& scheduler, std::function<void()> function);
+
+  ~Fiber();
+
+  Fiber(const Fiber&) = delete;
+  Fiber& operator=(const Fiber&) = delete;
+
+  Scheduler& scheduler;
+  std::function<void()> function;
+  ucontext_t context{};
+  std::byte* stack = nullptr;
+  Step step = Step::Yielded;
+  TraceContext trace{};
+  std::exception_ptr exception;
+
+  // Guarded by the mutex of the scheduler
+  bool is_parked = false;
+  bool is_woken = false;
+};
+
+namespace
+{
+struct Scheduler
+{
+  std::mutex mutex;
+  std::condition_variable ready_condition;
+  std::deque<Fiber*> ready;
+  ucontext_t context{};
+  Fiber* running = nullptr;
+
+  /// The fibers that the running fiber has woken, which are at the front of `ready`
+  size_t num_woken = 0;
+};
+
+void enter()
+{
+  auto* fiber = current_scheduler->running;
+
+  try
+  { fiber->function(); }
+  catch (...)
+  { fiber->exception = std::current_exception(); }
+
+  fiber->step = Fiber::Step::Returned;
+  swapcontext(&fiber->context, &fiber->scheduler.context);
+}
+
+/// Switch from the running fiber back to the scheduler
+void suspend(const Fiber::Step step)
+{
+  auto* fiber = current_scheduler->running;
+  fiber->step = step;
+  swapcontext(&fiber->context, &fiber->scheduler.context);
+}
+}
+
+Fiber::Fiber(Scheduler& scheduler_, std::function<void()> function_)
+  : scheduler{scheduler_}
+  , function{std::move(function_)}
+{
+  void* memory = mmap(
+    nullptr, stack_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_STACK, -1, 0
+  );
+
+  if (memory == MAP_FAILED)
+  { throw std::runtime_error{"Cannot allocate the stack of a fiber"}; }
+
+  stack = static_cast<std::byte*>(memory);
+
+  // A guard page at the end of the stack turns an overflow into a crash instead of corruption
+  mprotect(stack, static_cast<size_t>(sysconf(_SC_PAGESIZE)), PROT_NONE);
+
+  getcontext(&context);
+  context.uc_stack.ss_sp = stack;
+  context.uc_stack.ss_size = stack_size;
+  context.uc_link = nullptr;
+  makecontext(&context, enter, 0);
+}
+
+Fiber::~Fiber()
+{
+  munmap(stack, stack_size);
+}
+
+void run(std::vector<std::function<void()>> functions)
+{
+  if (current_scheduler != nullptr)
+  { throw std::logic_error{"fiber::run cannot be called from a fiber"}; }
+
+  Scheduler scheduler;
+  std::vector<std::unique_ptr<Fiber>> fibers;
+
+  for (auto& function : functions)
+  {
+    fibers.push_back(std::make_unique<Fiber>(scheduler, std::move(function)));
+    scheduler.ready.push_back(fibers.back().get());
+  }
+
+  struct Reset
+  {
+    ~Reset()
+    { current_scheduler = nullptr; }
+  } reset;
+
+  current_scheduler = &scheduler;
+  size_t num_returned = 0;
+
+  while (num_returned < fibers.size())
+  {
+    Fiber* fiber = nullptr;
+
+    {
+      std::unique_lock lock{scheduler.mutex};
+
+      // Timed, since the untimed wait needs a newer libstdc++ (GLIBCXX_3.4.30) than some environments load
+      while (!scheduler.ready_condition.wait_for(lock, std::chrono::seconds{1}, [&scheduler] { return !scheduler.ready.empty(); }))
+      {}
+
+      fiber = scheduler.ready.front();
+      scheduler.ready.pop_front();
+    }
+
+    // Every fiber has its own current trace, like a thread has
+    tracing::setCurrent(fiber->trace);
+    scheduler.running = fiber;
+    swapcontext(&scheduler.context, &fiber->context);
+    scheduler.running = nullptr;
+    fiber->trace = tracing::getCurrent();
+    tracing::setCurrent({});
+
+    switch (fiber->step)
+    {
+      case Fiber::Step::Returned:
+      {
+        if (fiber->exception)
+        { std::rethrow_exception(fiber->exception); }
+
+        ++num_returned;
+        break;
+      }
+      case Fiber::Step::Yielded:
+      {
+        std::scoped_lock lock{scheduler.mutex};
+        scheduler.num_woken = 0;
+        scheduler.ready.push_back(fiber);
+        break;
+      }
+      case Fiber::Step::HandedOff:
+      {
+        // Continue as soon as the woken fibers wait again, like after a call to them
+        std::scoped_lock lock{scheduler.mutex};
+        scheduler.ready.insert(scheduler.ready.begin() + static_cast<std::ptrdiff_t>(scheduler.num_woken), fiber);
+        scheduler.num_woken = 0;
+        break;
+      }
+      case Fiber::Step::Parked:
+      {
+        std::scoped_lock lock{scheduler.mutex};
+        scheduler.num_woken = 0;
+
+        if (fiber->is_woken)
+        {
+          fiber->is_woken = false;
+          scheduler.ready.push_back(fiber);
+        }
+        else
+        { fiber->is_parked = true; }
+
+        break;
+      }
+    }
+  }
+}
+
+Fiber* getCurrent()
+{
+  return current_scheduler == nullptr ? nullptr : current_scheduler->running;
+}
+
+void park(std::unique_lock<std::mutex>& lock)
+{
+  lock.unlock();
+  suspend(Fiber::Step::Parked);
+  lock.lock();
+}
+
+void wake(Fiber* fiber)
+{
+  auto& scheduler = fiber->scheduler;
+
+  {
+    std::scoped_lock lock{scheduler.mutex};
+
+    if (!fiber->is_parked)
+    {
+      fiber->is_woken = true;
+      return;
+    }
+
+    fiber->is_parked = false;
+
+    if (&scheduler == current_scheduler)
+    {
+      scheduler.ready.insert(scheduler.ready.begin() + static_cast<std::ptrdiff_t>(scheduler.num_woken), fiber);
+      ++scheduler.num_woken;
+    }
+    else
+    { scheduler.ready.push_back(fiber); }
+  }
+
+  if (&scheduler == current_scheduler)
+  { detail::has_woken = true; }
+  else
+  { scheduler.ready_condition.notify_one(); }
+}
+
+void yield()
+{
+  if (getCurrent() != nullptr)
+  { suspend(Fiber::Step::Yielded); }
+}
+
+void detail::handOff()
+{
+  if (getCurrent() != nullptr)
+  { suspend(Fiber::Step::HandedOff); }
+}
+#else
+class Fiber
+{};
+
+void run(std::vector<std::function<void()>> functions)
+{
+  std::vector<std::thread> threads;
+  std::exception_ptr exception;
+  std::mutex mutex;
+
+  for (auto& function : functions)
+  {
+    threads.emplace_back(
+      [&exception, &mutex, function = std::move(function)]
+      {
+        try
+        { function(); }
+        catch (...)
+        {
+          std::scoped_lock lock{mutex};
+
+          if (!exception)
+          { exception = std::current_exception(); }
+        }
+      }
+    );
+  }
+
+  for (auto& thread : threads)
+  { thread.join(); }
+
+  if (exception)
+  { std::rethrow_exception(exception); }
+}
+
+Fiber* getCurrent()
+{
+  return nullptr;
+}
+
+void park(std::unique_lock<std::mutex>&)
+{
+  throw std::logic_error{"fiber::park is only available on Linux"};
+}
+
+void wake(Fiber*)
+{}
+
+void yield()
+{}
+
+void detail::handOff()
+{}
+#endif
+}
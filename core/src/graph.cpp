@@ -1,16 +1,107 @@
 // Copyright 2019, Forsvarets forskningsinstitutt. All rights reserved.
 #include "superflow/graph.h"
+#include "superflow/thread_statistics.h"
+#include "superflow/timeline.h"
+#include "superflow/trace.h"
+#include "superflow/utils/fiber.h"
 #include "superflow/utils/metronome.h"
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <optional>
 #include <sstream>
+#include <utility>
 
 namespace flow
 {
+namespace
+{
+bool involves(const ConnectionSpec& connection, const std::string& proxel_id)
+{
+  return connection.lhs_name == proxel_id || connection.rhs_name == proxel_id;
+}
+
+/// The consumer port counts the items of an edge, and it may be on either side of the connection
+EdgeStatus getEdgeStatus(const Port::Ptr& lhs, const Port::Ptr& rhs)
+{
+  for (const auto& [consumer, producer] : {std::pair{rhs, lhs}, std::pair{lhs, rhs}})
+  {
+    const auto edges = consumer->getEdgeStatuses();
+    const auto it = edges.find(producer.get());
+
+    if (it != edges.end())
+    { return it->second; }
+  }
+
+  return {};
+}
+
+AllocationStatistics getAllocationStatistics(
+  const allocation::Counters& counters,
+  const std::map<std::string, PortStatus>& ports
+)
+{
+  auto statistics = allocation::read(counters);
+  size_t num_items = 0;
+
+  // Only consumer ports that are timed by a GetTimer measure consumed items
+  for (const auto& [name, port] : ports)
+  {
+    if (port.waiting_time + port.processing_time > 0.)
+    { num_items += port.num_transactions; }
+  }
+
+  if (num_items > 0)
+  {
+    statistics.count_per_item = static_cast<double>(statistics.count) / static_cast<double>(num_items);
+    statistics.bytes_per_item = static_cast<double>(statistics.bytes) / static_cast<double>(num_items);
+  }
+
+  return statistics;
+}
+
+void joinWithWarning(
+  const std::string& thread_name,
+  std::thread& proc_thread,
+  const Graph::Duration warning_period
+)
+{
+  Metronome repeater{
+    [&thread_name](const auto& duration)
+    {
+      const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(duration);
+
+      std::cerr << "Still waiting for " << thread_name << " to finish after " << seconds.count() << "s of waiting" << std::endl;
+    },
+    warning_period
+  };
+
+  if (proc_thread.joinable())
+  { proc_thread.join(); }
+
+  repeater.stop();
+}
+}
+
 Graph::Graph(std::map<std::string, Proxel::Ptr> proxels)
     : proxels_{std::move(proxels)}
 {}
 
+Graph::Graph(Graph&& other)
+    : proxels_{std::move(other.proxels_)}
+    , supervision_{std::exchange(other.supervision_, std::make_unique<Supervision>())}
+    , restart_policy_{other.restart_policy_}
+    , fused_groups_{std::move(other.fused_groups_)}
+    , fused_members_{std::move(other.fused_members_)}
+    , connections_{std::move(other.connections_)}
+    , connection_times_{std::move(other.connection_times_)}
+    , proxel_threads_{std::move(other.proxel_threads_)}
+    , handle_exceptions_{other.handle_exceptions_}
+    , perf_counters_enabled_{other.perf_counters_enabled_}
+    , crash_logger_{std::move(other.crash_logger_)}
+{}
+
 Graph::~Graph()
 {
   stop();
@@ -18,9 +109,140 @@ Graph::~Graph()
 
 void Graph::add(const std::string& proxel_id, Proxel::Ptr&& proxel)
 {
-  if (proxels_.count(proxel_id) > 0)
+  if (proxels_.count(proxel_id) > 0 || fused_groups_.count(proxel_id) > 0)
   { throw std::invalid_argument(std::string("Proxel '" + proxel_id + "' does already exist")); }
   proxels_.emplace(proxel_id, std::move(proxel));
+
+  if (isRunning())
+  { startProxel(proxel_id); }
+}
+
+void Graph::remove(const std::string& proxel_id)
+{
+  if (proxels_.count(proxel_id) == 0)
+  { throw std::invalid_argument(std::string("Proxel '" + proxel_id + "' does not exist")); }
+
+  if (fused_members_.count(proxel_id) > 0)
+  { throw std::invalid_argument(std::string("Proxel '" + proxel_id + "' is fused and cannot be removed")); }
+
+  // Stopping first deactivates the consumer ports, which releases any producer blocked on them
+  stopProxel(proxel_id, std::chrono::seconds{2});
+  disconnectAll(proxel_id);
+
+  proxels_.erase(proxel_id);
+
+  std::scoped_lock lock{supervision_->mutex};
+  supervision_->crashes.erase(proxel_id);
+  supervision_->records.erase(proxel_id);
+  forgetThread(proxel_id);
+}
+
+Graph::ReplaceResult Graph::replace(
+  const std::string& proxel_id,
+  Proxel::Ptr&& proxel,
+  const Duration latency_budget
+)
+{
+  if (proxels_.count(proxel_id) == 0)
+  { throw std::invalid_argument(std::string("Proxel '" + proxel_id + "' does not exist")); }
+
+  if (fused_members_.count(proxel_id) > 0)
+  { throw std::invalid_argument(std::string("Proxel '" + proxel_id + "' is fused and cannot be replaced")); }
+
+  if (proxel == nullptr)
+  { throw std::invalid_argument(std::string("Cannot replace proxel '" + proxel_id + "' with a nullptr")); }
+
+  const auto connections = getConnections(proxel_id);
+
+  for (const auto& connection : connections)
+  {
+    const bool is_lhs = connection.lhs_name == proxel_id;
+    const auto& port_name = is_lhs
+                            ? connection.lhs_port
+                            : connection.rhs_port;
+
+    const auto port = proxel->getPorts().find(port_name);
+
+    if (port == proxel->getPorts().end())
+    { throw std::invalid_argument("Cannot replace proxel '" + proxel_id + "', new proxel lacks port '" + port_name + "'"); }
+
+    const auto& other = is_lhs
+                        ? getProxel(connection.rhs_name)->getPort(connection.rhs_port)
+                        : getProxel(connection.lhs_name)->getPort(connection.lhs_port);
+
+    if (port->second == nullptr || !port->second->canConnect(other) || !other->canConnect(port->second))
+    { throw std::invalid_argument("Cannot replace proxel '" + proxel_id + "', port '" + port_name + "' of new proxel cannot be connected"); }
+  }
+
+  const auto swap_start = std::chrono::steady_clock::now();
+  const bool was_running = isRunning();
+
+  stopProxel(proxel_id, latency_budget);
+  disconnectAll(proxel_id);
+
+  auto old_proxel = std::exchange(proxels_[proxel_id], std::move(proxel));
+
+  try
+  {
+    for (const auto& connection : connections)
+    { connect(connection.lhs_name, connection.lhs_port, connection.rhs_name, connection.rhs_port); }
+  }
+  catch (...)
+  {
+    // Put the old proxel back, if a port of the new one failed a check that `canConnect` could not make
+    disconnectAll(proxel_id);
+    proxels_[proxel_id] = std::move(old_proxel);
+
+    for (const auto& connection : connections)
+    { connect(connection.lhs_name, connection.lhs_port, connection.rhs_name, connection.rhs_port); }
+
+    if (was_running)
+    { startProxel(proxel_id); }
+
+    throw;
+  }
+
+  {
+    std::scoped_lock lock{supervision_->mutex};
+    supervision_->crashes.erase(proxel_id);
+    supervision_->records.erase(proxel_id);
+    forgetThread(proxel_id);
+  }
+
+  if (was_running)
+  { startProxel(proxel_id); }
+
+  const auto latency = std::chrono::steady_clock::now() - swap_start;
+
+  return {latency, latency > latency_budget};
+}
+
+void Graph::fuse(const std::string& group_name, const std::vector<std::string>& proxel_ids)
+{
+  if (isRunning())
+  { throw std::runtime_error("Cannot fuse proxels when threads are running"); }
+
+  if (proxel_ids.empty())
+  { throw std::invalid_argument("Fused group '" + group_name + "' has no proxels"); }
+
+  if (proxels_.count(group_name) > 0 || fused_groups_.count(group_name) > 0)
+  { throw std::invalid_argument("Fused group '" + group_name + "' is not a unique name"); }
+
+  for (const auto& proxel_id : proxel_ids)
+  {
+    if (proxels_.count(proxel_id) == 0)
+    { throw std::invalid_argument("Proxel '" + proxel_id + "' does not exist"); }
+
+    const auto it = fused_members_.find(proxel_id);
+
+    if (it != fused_members_.end())
+    { throw std::invalid_argument("Proxel '" + proxel_id + "' is already fused in group '" + it->second + "'"); }
+  }
+
+  for (const auto& proxel_id : proxel_ids)
+  { fused_members_[proxel_id] = group_name; }
+
+  fused_groups_.emplace(group_name, proxel_ids);
 }
 
 void Graph::start(
@@ -31,101 +253,92 @@ void Graph::start(
   if (isRunning())
   { throw std::runtime_error("Cannot start Graph when threads are running"); }
 
+  handle_exceptions_ = handle_exceptions;
+  crash_logger_ = crash_logger;
+
+  {
+    std::scoped_lock lock{supervision_->mutex};
+    supervision_->stopping = false;
+  }
+
   for (const auto& kv : proxels_)
   {
     const auto& proxel_name = kv.first;
-    const auto& proxel = kv.second;
 
-    if (handle_exceptions)
-    {
-      proxel_threads_.emplace(
-          proxel_name,
-          [this, proxel_name, proxel, crash_logger]()
-          {
-            try
-            {
-              proxel->start();
-            }
-            catch (const std::exception& e)
-            {
-              crashes_[proxel_name] = e.what();
-
-              if (crash_logger)
-              {
-                crash_logger(proxel_name, e.what());
-              }
-            }
-            catch (...)
-            {
-              crashes_[proxel_name] = "unknown exception";
-
-              if (crash_logger)
-              {
-                crash_logger(proxel_name, "Unknown exception");
-              }
-            }
-          }
-      );
-    }
-    else
+    if (fused_members_.count(proxel_name) > 0)
+    { continue; }
+
+    startProxel(proxel_name);
+  }
+
+  for (const auto& kv : fused_groups_)
+  {
+    const auto& group_name = kv.first;
+    const auto& members = kv.second;
+
+    std::vector<std::function<void()>> group;
+
+    for (auto it = members.rbegin(); it != members.rend(); ++it)
     {
-      proxel_threads_.emplace(
-          proxel_name,
-          [&proxel]()
-          {
-              proxel->start();
-          }
+      group.emplace_back(
+        [this, proxel_name = *it, proxel = proxels_.at(*it)]()
+        { runProxel(proxel_name, proxel, handle_exceptions_, crash_logger_, restart_policy_); }
       );
     }
+
+    proxel_threads_.emplace(
+        group_name,
+        [this, group_name, group = std::move(group)]() mutable
+        {
+          timeline::setThreadName(group_name);
+          fiber::run(std::move(group));
+          forgetThreadId(getCurrentThreadId());
+        }
+    );
   }
 }
 
+void Graph::setRestartPolicy(const RestartPolicy& policy)
+{
+  if (policy.backoff_factor < 1.)
+  { throw std::invalid_argument("RestartPolicy: 'backoff_factor' must be 1 or more."); }
+
+  restart_policy_ = policy;
+}
+
 void Graph::stop()
 {
   if (!isRunning())
   { return; }
 
-  for (auto& proxel : proxels_)
   {
-    proxel.second->stop();
+    // Set before stopping the proxels, so that a crashed proxel is not restarted after its stop
+    std::scoped_lock lock{supervision_->mutex};
+    supervision_->stopping = true;
   }
+  supervision_->cv.notify_all();
 
-  for (const auto& kv : proxels_)
+  for (auto& proxel : proxels_)
   {
-    const auto& proxel_name = kv.first;
-    const auto thread_it = proxel_threads_.find(proxel_name);
-
-    if (thread_it == proxel_threads_.end())
-    {
-      continue;
-    }
-
-    auto& proc_thread = thread_it->second;
-
-    Metronome repeater{
-      [&proxel_name](const auto& duration)
-      {
-        const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(duration);
-
-        std::cerr << "Still waiting for " << proxel_name << " to finish after " << seconds.count() << "s of waiting" << std::endl;
-      },
-      std::chrono::seconds{2}
-    };
-
-    if (proc_thread.joinable())
-    { proc_thread.join(); }
-
-    repeater.stop();
+    proxel.second->stop();
   }
 
+  for (auto& kv : proxel_threads_)
+  { joinWithWarning(kv.first, kv.second, std::chrono::seconds{2}); }
+
   proxel_threads_.clear();
+
+  std::scoped_lock lock{supervision_->mutex};
+  supervision_->thread_ids.clear();
+  supervision_->perf_counters.clear();
+  supervision_->allocation_counters.clear();
 }
 
 void Graph::connect(
     const std::string& proxel1,
     const std::string& proxel1_port,
     const std::string& proxel2,
-    const std::string& proxel2_port) const
+    const std::string& proxel2_port)
 {
   if (proxel1 == proxel2)
   {
@@ -157,41 +370,501 @@ void Graph::connect(
 
     throw std::invalid_argument(ss.str());
   }
+
+  const ConnectionSpec connection{proxel1, proxel1_port, proxel2, proxel2_port};
+
+  if (std::find(connections_.begin(), connections_.end(), connection) == connections_.end())
+  {
+    connections_.push_back(connection);
+    connection_times_[connection] = std::chrono::steady_clock::now();
+  }
+}
+
+void Graph::disconnect(
+    const std::string& proxel1,
+    const std::string& proxel1_port,
+    const std::string& proxel2,
+    const std::string& proxel2_port)
+{
+  // The connection may have been made from either end
+  auto it = std::find(connections_.begin(), connections_.end(), ConnectionSpec{proxel1, proxel1_port, proxel2, proxel2_port});
+
+  if (it == connections_.end())
+  { it = std::find(connections_.begin(), connections_.end(), ConnectionSpec{proxel2, proxel2_port, proxel1, proxel1_port}); }
+
+  if (it == connections_.end())
+  { return; }
+
+  const auto connection = *it;
+  const auto& port1 = getProxel(connection.lhs_name)->getPort(connection.lhs_port);
+  const auto& port2 = getProxel(connection.rhs_name)->getPort(connection.rhs_port);
+
+  port1->disconnect(port2);
+  connections_.erase(it);
+  connection_times_.erase(connection);
+}
+
+const std::vector<ConnectionSpec>& Graph::getConnections() const
+{
+  return connections_;
+}
+
+std::vector<Graph::EdgeStatistics> Graph::getEdgeStatistics() const
+{
+  Sampler sampler;
+  return getEdgeStatistics(sampler);
+}
+
+std::vector<Graph::EdgeStatistics> Graph::getEdgeStatistics(Sampler& sampler) const
+{
+  const auto now = std::chrono::steady_clock::now();
+  std::map<ConnectionSpec, Sampler::EdgeSample> samples;
+  std::vector<EdgeStatistics> statistics;
+
+  for (const auto& connection : connections_)
+  {
+    EdgeStatistics edge;
+    edge.connection = connection;
+    edge.status = getEdgeStatus(
+      proxels_.at(connection.lhs_name)->getPort(connection.lhs_port),
+      proxels_.at(connection.rhs_name)->getPort(connection.rhs_port)
+    );
+
+    // Without an earlier sample, the rates are computed from when the connection was made
+    Sampler::EdgeSample previous{{}, connection_times_.at(connection)};
+    const auto sample = sampler.edge_samples_.find(connection);
+
+    // The totals restart if the ports are reconnected outside of the Graph
+    if (sample != sampler.edge_samples_.end()
+        && sample->second.time >= previous.time
+        && sample->second.status.num_messages <= edge.status.num_messages
+        && sample->second.status.num_timed <= edge.status.num_timed)
+    { previous = sample->second; }
+
+    const double elapsed = std::chrono::duration<double>(now - previous.time).count();
+
+    if (elapsed > 0. && previous.status.num_messages <= edge.status.num_messages)
+    {
+      edge.message_rate = static_cast<double>(edge.status.num_messages - previous.status.num_messages) / elapsed;
+      edge.byte_rate = static_cast<double>(edge.status.num_bytes - previous.status.num_bytes) / elapsed;
+    }
+
+    if (edge.status.num_timed > previous.status.num_timed)
+    {
+      edge.mean_queue_latency = (edge.status.queue_latency - previous.status.queue_latency)
+                                / static_cast<double>(edge.status.num_timed - previous.status.num_timed);
+    }
+
+    samples[connection] = {edge.status, now};
+    statistics.push_back(std::move(edge));
+  }
+
+  sampler.edge_samples_ = std::move(samples);
+
+  return statistics;
 }
 
 std::map<std::string, ProxelStatus> Graph::getProxelStatuses() const
 {
+  Sampler sampler;
+  return getProxelStatuses(sampler);
+}
+
+std::map<std::string, ProxelStatus> Graph::getProxelStatuses(Sampler& sampler) const
+{
+  std::map<std::string, std::string> crashes;
+  std::map<std::string, Supervision::Record> records;
+  std::map<std::string, int64_t> thread_ids;
+  std::map<int64_t, PerfState> perf_counters;
+  std::map<int64_t, std::shared_ptr<const allocation::Counters>> allocation_counters;
+
+  // Copy the bookkeeping, so that the proxel threads are not held up while /proc and the counters are read
+  {
+    std::scoped_lock lock{supervision_->mutex};
+    crashes = supervision_->crashes;
+    records = supervision_->records;
+    thread_ids = supervision_->thread_ids;
+    perf_counters = supervision_->perf_counters;
+    allocation_counters = supervision_->allocation_counters;
+  }
+
+  std::map<int64_t, PerfCounters::Sample> perf_samples;
   std::map<std::string, ProxelStatus> statuses;
+  std::map<int64_t, std::optional<ThreadStatistics>> thread_statistics;
+  std::map<int64_t, PerfCounterRates> perf_rates;
 
   for (const auto& proxel : proxels_)
   {
     const std::string& name = proxel.first;
+    auto status = proxel.second->getStatus();
 
-    auto it = crashes_.find(name);
+    auto it = crashes.find(name);
 
-    if (it != crashes_.end())
+    if (it != crashes.end())
     {
       const std::string& error_message = it->second;
 
-      statuses[name] = ProxelStatus{
+      status = ProxelStatus{
           ProxelStatus::State::Crashed,
           error_message,
           {}
       };
-    } else
+    }
+
+    const auto record_it = records.find(name);
+
+    if (record_it != records.end())
+    {
+      const auto& record = record_it->second;
+      status.num_restarts = record.num_restarts;
+      status.mean_time_between_failures = record.summed_uptime / static_cast<double>(record.num_failures);
+    }
+
+    const auto thread_it = thread_ids.find(name);
+
+    if (thread_it != thread_ids.end())
     {
-      statuses[name] = proxel.second->getStatus();
+      const auto thread_id = thread_it->second;
+
+      if (thread_statistics.count(thread_id) == 0)
+      { thread_statistics[thread_id] = readThreadStatistics(thread_id); }
+
+      if (const auto& statistics = thread_statistics[thread_id])
+      { status.thread = *statistics; }
+
+      const auto perf_it = perf_counters.find(thread_id);
+
+      if (perf_it != perf_counters.end())
+      {
+        if (perf_rates.count(thread_id) == 0)
+        {
+          const auto& perf = perf_it->second;
+          const auto sample = perf.counters->read();
+          auto previous = perf.start;
+          const auto previous_it = sampler.perf_samples_.find(thread_id);
+
+          // Samples from before the thread started were read from other counters
+          if (previous_it != sampler.perf_samples_.end() && previous_it->second.time >= perf.start.time)
+          { previous = previous_it->second; }
+
+          perf_rates[thread_id] = PerfCounters::getRates(previous, sample, perf.counters->hasHardwareCounters());
+          perf_samples[thread_id] = sample;
+        }
+
+        status.perf = perf_rates[thread_id];
+      }
+
+      const auto allocation_it = allocation_counters.find(thread_id);
+
+      if (allocation_it != allocation_counters.end())
+      { status.allocations = getAllocationStatistics(*allocation_it->second, status.ports); }
     }
+
+    statuses[name] = std::move(status);
   }
 
+  sampler.perf_samples_ = std::move(perf_samples);
+
   return statuses;
 }
 
+BottleneckReport Graph::getBottleneckReport(const size_t parallelism) const
+{
+  return analyzeBottlenecks(getProxelStatuses(), connections_, parallelism);
+}
+
+void Graph::enablePerfCounters(const bool enable)
+{
+  perf_counters_enabled_ = enable;
+}
+
+double Graph::getOversubscription() const
+{
+  std::set<int64_t> thread_ids;
+
+  {
+    std::scoped_lock lock{supervision_->mutex};
+
+    for (const auto& kv : supervision_->thread_ids)
+    { thread_ids.insert(kv.second); }
+  }
+
+  size_t num_runnable = 0;
+
+  for (const auto thread_id : thread_ids)
+  {
+    const auto statistics = readThreadStatistics(thread_id);
+
+    if (statistics && statistics->runnable)
+    { ++num_runnable; }
+  }
+
+  return static_cast<double>(num_runnable) / static_cast<double>(getNumAvailableCores());
+}
+
+void Graph::enableTracing(const size_t sample_interval)
+{
+  tracing::enable(sample_interval);
+}
+
+void Graph::disableTracing()
+{
+  tracing::disable();
+}
+
+std::vector<Graph::TraceStatistics> Graph::getTraceStatistics() const
+{
+  std::map<const Port*, std::pair<std::string, std::string>> port_names;
+
+  for (const auto& [proxel_name, proxel] : proxels_)
+  {
+    for (const auto& [port_name, port] : proxel->getPorts())
+    { port_names[port.get()] = {proxel_name, port_name}; }
+  }
+
+  std::vector<TraceStatistics> statistics;
+
+  for (const auto& [path, histogram] : tracing::getStatistics())
+  {
+    const auto source = port_names.find(path.first);
+    const auto sink = port_names.find(path.second);
+
+    if (source == port_names.end() || sink == port_names.end())
+    { continue; }
+
+    statistics.push_back({
+      source->second.first,
+      source->second.second,
+      sink->second.first,
+      sink->second.second,
+      histogram
+    });
+  }
+
+  return statistics;
+}
+
+void Graph::enableTimeline(const size_t events_per_thread)
+{
+  timeline::enable(events_per_thread);
+}
+
+void Graph::disableTimeline()
+{
+  timeline::disable();
+}
+
+void Graph::writeTimeline(std::ostream& os) const
+{
+  timeline::writeChromeTrace(os);
+}
+
 bool Graph::isRunning() const
 {
   return !proxel_threads_.empty();
 }
 
+void Graph::startProxel(const std::string& proxel_id)
+{
+  proxel_threads_.emplace(
+      proxel_id,
+      [this, proxel_id, proxel = proxels_.at(proxel_id)]()
+      {
+        timeline::setThreadName(proxel_id);
+        runProxel(proxel_id, proxel, handle_exceptions_, crash_logger_, restart_policy_);
+        forgetThreadId(getCurrentThreadId());
+      }
+  );
+}
+
+void Graph::stopProxel(const std::string& proxel_id, const Duration warning_period)
+{
+  const auto& proxel = proxels_.at(proxel_id);
+
+  {
+    // Set before stopping the proxel, so that it is not restarted after its stop
+    std::scoped_lock lock{supervision_->mutex};
+    supervision_->cancelled.insert(proxel_id);
+  }
+  supervision_->cv.notify_all();
+
+  proxel->stop();
+
+  const auto thread_it = proxel_threads_.find(proxel_id);
+
+  if (thread_it != proxel_threads_.end())
+  {
+    joinWithWarning(proxel_id, thread_it->second, warning_period);
+    proxel_threads_.erase(thread_it);
+  }
+
+  std::scoped_lock lock{supervision_->mutex};
+  supervision_->cancelled.erase(proxel_id);
+}
+
+void Graph::forgetThread(const std::string& proxel_id)
+{
+  const auto it = supervision_->thread_ids.find(proxel_id);
+
+  if (it == supervision_->thread_ids.end())
+  { return; }
+
+  supervision_->perf_counters.erase(it->second);
+  supervision_->allocation_counters.erase(it->second);
+  supervision_->thread_ids.erase(it);
+}
+
+void Graph::forgetThreadId(const int64_t thread_id)
+{
+  std::scoped_lock lock{supervision_->mutex};
+  auto& thread_ids = supervision_->thread_ids;
+
+  for (auto it = thread_ids.begin(); it != thread_ids.end();)
+  {
+    if (it->second == thread_id)
+    { it = thread_ids.erase(it); }
+    else
+    { ++it; }
+  }
+
+  supervision_->perf_counters.erase(thread_id);
+  supervision_->allocation_counters.erase(thread_id);
+}
+
+void Graph::disconnectAll(const std::string& proxel_id)
+{
+  for (const auto& connection : getConnections(proxel_id))
+  { disconnect(connection.lhs_name, connection.lhs_port, connection.rhs_name, connection.rhs_port); }
+}
+
+std::vector<ConnectionSpec> Graph::getConnections(const std::string& proxel_id) const
+{
+  std::vector<ConnectionSpec> connections;
+
+  std::copy_if(
+    connections_.begin(), connections_.end(),
+    std::back_inserter(connections),
+    [&proxel_id](const ConnectionSpec& connection)
+    { return involves(connection, proxel_id); }
+  );
+
+  return connections;
+}
+
+void Graph::runProxel(
+  const std::string& proxel_name,
+  const Proxel::Ptr& proxel,
+  const bool handle_exceptions,
+  const CrashLogger& crash_logger,
+  const RestartPolicy& restart_policy
+)
+{
+  const auto thread_id = getCurrentThreadId();
+  bool open_perf_counters = false;
+
+  {
+    std::scoped_lock lock{supervision_->mutex};
+    supervision_->thread_ids[proxel_name] = thread_id;
+
+    // Members of a fused group share the counters opened by the first member
+    open_perf_counters = perf_counters_enabled_ && supervision_->perf_counters.count(thread_id) == 0;
+
+    if (allocation::isInstrumented())
+    { supervision_->allocation_counters[thread_id] = allocation::getThreadCounters(); }
+  }
+
+  if (open_perf_counters)
+  {
+    auto perf_counters = std::make_shared<PerfCounters>();
+    const auto sample = perf_counters->read();
+
+    std::scoped_lock lock{supervision_->mutex};
+    supervision_->perf_counters[thread_id] = {std::move(perf_counters), sample};
+  }
+
+  if (!handle_exceptions)
+  {
+    proxel->start();
+    return;
+  }
+
+  auto backoff = restart_policy.initial_backoff;
+
+  while (true)
+  {
+    const auto run_start = std::chrono::steady_clock::now();
+
+    try
+    {
+      proxel->start();
+      return;
+    }
+    catch (const std::exception& e)
+    {
+      reportCrash(proxel_name, e.what(), crash_logger);
+    }
+    catch (...)
+    {
+      reportCrash(proxel_name, "Unknown exception", crash_logger);
+    }
+
+    if (!awaitRestart(proxel_name, run_start, backoff, restart_policy))
+    { return; }
+
+    backoff = std::min(
+      std::chrono::duration_cast<Duration>(backoff * restart_policy.backoff_factor),
+      restart_policy.max_backoff
+    );
+  }
+}
+
+void Graph::reportCrash(
+  const std::string& proxel_name,
+  const std::string& what,
+  const CrashLogger& crash_logger
+)
+{
+  {
+    std::scoped_lock lock{supervision_->mutex};
+    supervision_->crashes[proxel_name] = what;
+  }
+
+  if (crash_logger)
+  {
+    crash_logger(proxel_name, what);
+  }
+}
+
+bool Graph::awaitRestart(
+  const std::string& proxel_name,
+  const std::chrono::steady_clock::time_point run_start,
+  const Duration backoff,
+  const RestartPolicy& restart_policy
+)
+{
+  std::unique_lock lock{supervision_->mutex};
+
+  auto& record = supervision_->records[proxel_name];
+  ++record.num_failures;
+  record.summed_uptime += std::chrono::duration<double>(std::chrono::steady_clock::now() - run_start).count();
+
+  if (record.num_restarts >= restart_policy.max_restarts)
+  { return false; }
+
+  const auto is_cancelled = [this, &proxel_name]()
+  { return supervision_->stopping || supervision_->cancelled.count(proxel_name) > 0; };
+
+  if (supervision_->cv.wait_for(lock, backoff, is_cancelled))
+  { return false; }
+
+  // Decided in the same critical section as the check above. A stop that comes before it
+  // prevents the restart, and a stop that comes after it is the one stop of the restarted run.
+  ++record.num_restarts;
+  supervision_->crashes.erase(proxel_name);
+
+  return true;
+}
+
 const Graph::CrashLogger Graph::quietCrashLogger = nullptr;
 
 void Graph::defaultCrashLogger(const std::string& proxel_name, const std::string& what)
@@ -1,17 +1,52 @@
 #include "superflow/utils/graphviz.h"
 
 #include <algorithm>
+#include <iomanip>
 #include <numeric>
 #include <sstream>
+#include <string_view>
 #include <vector>
 
 namespace flow
 {
 namespace
 {
+/// Escape the characters that structure a record label
+std::string escapeRecord(const std::string& text)
+{
+  std::string escaped;
+
+  for (const char c : text)
+  {
+    if (std::string_view{"{}|<>\"\\"}.find(c) != std::string_view::npos)
+    { escaped += '\\'; }
+
+    escaped += c;
+  }
+
+  return escaped;
+}
+
+/// Quote a node or port name, so that names like "a.out->b.in" are valid IDs
+std::string quote(const std::string& id)
+{
+  std::string quoted{"\""};
+
+  for (const char c : id)
+  {
+    if (c == '"' || c == '\\')
+    { quoted += '\\'; }
+
+    quoted += c;
+  }
+
+  return quoted + '"';
+}
+
 std::string portFormatting(const std::string& port_name)
 {
-  return "<" + port_name + "> " + port_name;
+  const auto escaped = escapeRecord(port_name);
+  return "<" + escaped + "> " + escaped;
 }
 
 std::string strToUpper(std::string str)
@@ -24,6 +59,25 @@ std::string strToUpper(std::string str)
   return str;
 }
 
+/// Format a rate, latency or count with three significant digits
+std::string formatValue(const double value, const std::string& unit)
+{
+  std::ostringstream os;
+  os << std::setprecision(3) << value << unit;
+  return os.str();
+}
+
+std::string formatLatency(const double seconds)
+{
+  if (seconds >= 1.)
+  { return formatValue(seconds, " s"); }
+
+  if (seconds >= 1e-3)
+  { return formatValue(seconds * 1e3, " ms"); }
+
+  return formatValue(seconds * 1e6, " us");
+}
+
 std::string join(const std::set<std::string>& data)
 {
   if (data.empty())
@@ -48,6 +102,47 @@ GraphViz::GraphViz(
   }
 }
 
+GraphViz::GraphViz(
+  const Graph& graph
+)
+  : GraphViz{graph.getConnections()}
+{
+  Graph::Sampler sampler;
+  annotate(graph, sampler);
+}
+
+GraphViz::GraphViz(
+  const Graph& graph,
+  Graph::Sampler& sampler
+)
+  : GraphViz{graph.getConnections()}
+{
+  annotate(graph, sampler);
+}
+
+void GraphViz::annotate(const Graph& graph, Graph::Sampler& sampler)
+{
+  const auto statuses = graph.getProxelStatuses(sampler);
+
+  for (const auto& [proxel_name, status] : statuses)
+  {
+    insert({proxel_name, {}, {}, {}});
+    node_loads[proxel_name].busyness = status.busyness;
+  }
+
+  for (const auto& pipeline : analyzeBottlenecks(statuses, graph.getConnections()).pipelines)
+  {
+    for (const auto& stage : pipeline.limiting_stages)
+    { node_loads[stage.proxel].is_bottleneck = true; }
+  }
+
+  for (const auto& edge : graph.getEdgeStatistics(sampler))
+  {
+    max_message_rate = std::max(max_message_rate, edge.message_rate);
+    edge_loads[edge.connection] = edge;
+  }
+}
+
 void GraphViz::insert(const ConnectionSpec& connection)
 {
   if (connection.lhs_name.empty())
@@ -72,12 +167,17 @@ std::string GraphViz::getNodeDefinitions() const
   {
     std::string out = join(node.lhs_ports);
     std::string in = join(node.rhs_ports);
-    os << "  " << node_name
+    const auto load = node_loads.find(node_name);
+    const std::string busyness = load == node_loads.end()
+                                 ? ""
+                                 : "\\n" + formatValue(100. * load->second.busyness, "% busy");
+
+    os << "  " << quote(node_name)
        << " [label=\"{"
        << "{ " << in << "} | "
-       << strToUpper(node_name) << " | "
+       << escapeRecord(strToUpper(node_name)) << busyness << " | "
        << "{ " << out << "} "
-       << "}\"]\n";
+       << "}\"" << getNodeAttributes(node_name) << "]\n";
   }
 
   return os.str();
@@ -94,12 +194,63 @@ std::string GraphViz::getNodeConnections() const
       if (conn.lhs_port.empty() || conn.rhs_name.empty() || conn.rhs_port.empty())
       { continue; }
 
-      os << "  " << conn.lhs_name << ":" << conn.lhs_port << " -> " << conn.rhs_name << ":" << conn.rhs_port << "\n";
+      os << "  " << quote(conn.lhs_name) << ":" << quote(conn.lhs_port)
+         << " -> " << quote(conn.rhs_name) << ":" << quote(conn.rhs_port)
+         << getEdgeAttributes(conn) << "\n";
     }
   }
   return os.str();
 }
 
+std::string GraphViz::getNodeAttributes(const std::string& node_name) const
+{
+  const auto it = node_loads.find(node_name);
+
+  if (it == node_loads.end())
+  { return {}; }
+
+  const auto& load = it->second;
+  const double hue = (1. - std::clamp(load.busyness, 0., 1.)) / 3.;
+
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(3)
+     << ", style=filled, fillcolor=\"" << hue << " 0.5 1.0\"";
+
+  if (load.is_bottleneck)
+  { os << ", color=red, penwidth=3"; }
+
+  return os.str();
+}
+
+std::string GraphViz::getEdgeAttributes(const ConnectionSpec& connection) const
+{
+  const auto it = edge_loads.find(connection);
+
+  if (it == edge_loads.end())
+  { return {}; }
+
+  const auto& edge = it->second;
+  const double width = max_message_rate > 0. ? 1. + 4. * edge.message_rate / max_message_rate : 1.;
+
+  std::string label = formatValue(edge.message_rate, "/s");
+
+  if (edge.status.num_timed > 0)
+  { label += "\\nqueue " + formatLatency(edge.mean_queue_latency); }
+
+  if (edge.status.num_dropped > 0)
+  { label += "\\n" + std::to_string(edge.status.num_dropped) + " dropped"; }
+
+  std::ostringstream os;
+  os << " [penwidth=" << std::setprecision(3) << width << ", label=\"" << label << "\"";
+
+  if (edge.status.num_dropped > 0)
+  { os << ", color=red"; }
+
+  os << "]";
+
+  return os.str();
+}
+
 std::string GraphViz::employ() const
 {
   std::ostringstream gv;
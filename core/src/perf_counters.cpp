@@ -0,0 +1,142 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/perf_counters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#endif
+
+namespace flow
+{
+namespace
+{
+#ifdef __linux__
+int openCounter(const uint32_t type, const uint64_t config)
+{
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.type = type;
+  attr.size = sizeof(attr);
+  attr.config = config;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+}
+
+uint64_t readCounter(const int fd)
+{
+  if (fd < 0)
+  { return 0; }
+
+  uint64_t data[3] = {0, 0, 0}; // value, time enabled, time running
+
+  if (::read(fd, data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)))
+  { return 0; }
+
+  if (data[2] == 0 || data[2] == data[1])
+  { return data[0]; }
+
+  return static_cast<uint64_t>(static_cast<double>(data[0]) * static_cast<double>(data[1]) / static_cast<double>(data[2]));
+}
+#endif
+
+double getRate(
+  const PerfCounters::Sample& previous,
+  const PerfCounters::Sample& current,
+  const PerfCounters::Counter counter,
+  const double seconds
+)
+{
+  const auto value = current.values[counter];
+  const auto previous_value = previous.values[counter];
+
+  return value > previous_value
+         ? static_cast<double>(value - previous_value) / seconds
+         : 0.;
+}
+}
+
+double PerfCounterRates::getInstructionsPerCycle() const
+{
+  return cycles > 0.
+         ? instructions / cycles
+         : 0.;
+}
+
+PerfCounters::PerfCounters()
+{
+  fds_.fill(-1);
+
+#ifdef __linux__
+  fds_[Cycles] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+  fds_[Instructions] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+  fds_[CacheMisses] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+  fds_[BranchMisses] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+  fds_[PageFaults] = openCounter(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS);
+  fds_[TaskClock] = openCounter(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK);
+#endif
+}
+
+PerfCounters::~PerfCounters()
+{
+#ifdef __linux__
+  for (const auto fd : fds_)
+  {
+    if (fd >= 0)
+    { close(fd); }
+  }
+#endif
+}
+
+PerfCounters::Sample PerfCounters::read() const
+{
+  Sample sample{std::chrono::steady_clock::now(), {}};
+
+#ifdef __linux__
+  for (size_t i = 0; i < fds_.size(); ++i)
+  { sample.values[i] = readCounter(fds_[i]); }
+#endif
+
+  return sample;
+}
+
+bool PerfCounters::isAvailable() const
+{
+  for (const auto fd : fds_)
+  {
+    if (fd >= 0)
+    { return true; }
+  }
+
+  return false;
+}
+
+bool PerfCounters::hasHardwareCounters() const
+{
+  return fds_[Cycles] >= 0 && fds_[Instructions] >= 0;
+}
+
+PerfCounterRates PerfCounters::getRates(const Sample& previous, const Sample& current, const bool hardware)
+{
+  const double seconds = std::chrono::duration<double>(current.time - previous.time).count();
+
+  if (seconds <= 0.)
+  { return {}; }
+
+  PerfCounterRates rates;
+  rates.cycles = getRate(previous, current, Cycles, seconds);
+  rates.instructions = getRate(previous, current, Instructions, seconds);
+  rates.cache_misses = getRate(previous, current, CacheMisses, seconds);
+  rates.branch_misses = getRate(previous, current, BranchMisses, seconds);
+  rates.page_faults = getRate(previous, current, PageFaults, seconds);
+  rates.cpu_utilization = getRate(previous, current, TaskClock, seconds) * 1e-9;
+  rates.hardware = hardware;
+
+  return rates;
+}
+}
@@ -1,8 +1,72 @@
 // Copyright 2019, Forsvarets forskningsinstitutt. All rights reserved.
 #include "superflow/proxel.h"
+#include "superflow/utils/proxel_timer.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
 
 namespace flow
 {
+namespace
+{
+std::string formatStatusFields(const std::map<std::string, StatusField>& fields)
+{
+  std::ostringstream ss;
+  ss << std::fixed << std::setprecision(3);
+
+  for (const auto& [name, field] : fields)
+  {
+    if (ss.tellp() > 0)
+    { ss << '\n'; }
+
+    ss << name << ": ";
+
+    if (field.type == StatusField::Type::Counter)
+    { ss << static_cast<uint64_t>(field.value); }
+    else
+    { ss << field.value; }
+  }
+
+  return ss.str();
+}
+
+/// Combine the get timing of all consumer ports. Waiting in any port is idle time,
+/// and the port that has been timed the longest spans the measured period.
+void setGetTimes(ProxelStatus& status)
+{
+  double waiting_time = 0.;
+  double measured_time = 0.;
+  size_t num_gets = 0;
+
+  for (const auto& [name, port] : status.ports)
+  {
+    const double port_time = port.waiting_time + port.processing_time;
+
+    if (port_time <= 0.)
+    { continue; }
+
+    waiting_time += port.waiting_time;
+
+    if (port_time > measured_time)
+    {
+      measured_time = port_time;
+      num_gets = port.num_transactions;
+    }
+  }
+
+  if (measured_time <= 0.)
+  { return; }
+
+  const double busy_time = std::max(measured_time - waiting_time, 0.);
+  status.busyness = busy_time / measured_time;
+  status.processing_time = num_gets > 1
+                           ? busy_time / static_cast<double>(num_gets - 1)
+                           : busy_time;
+}
+}
+
 const Port::Ptr& Proxel::getPort(const std::string& name) const
 {
   return port_manager_.get(name);
@@ -15,11 +79,25 @@ const PortManager::PortMap& Proxel::getPorts() const
 
 ProxelStatus Proxel::getStatus() const
 {
-  return {
+  ProxelStatus status{
       getState(),
       getStatusInfo(),
       port_manager_.getStatus()
   };
+
+  setGetTimes(status);
+
+  std::scoped_lock lock{status_fields_mutex_};
+
+  for (const auto& [name, reader] : status_field_readers_)
+  { status.fields[name] = reader(); }
+
+  if (status_info_formatter_)
+  { status.info = status_info_formatter_(); }
+  else if (status.info.empty() && !status.fields.empty())
+  { status.info = formatStatusFields(status.fields); }
+
+  return status;
 }
 
 void Proxel::setState(const State state) const
@@ -32,6 +110,97 @@ void Proxel::setStatusInfo(const std::string& status_info) const
   status_info_.store(status_info);
 }
 
+void Proxel::setStatusInfoFormatter(StatusInfoFormatter formatter)
+{
+  std::scoped_lock lock{status_fields_mutex_};
+  status_info_formatter_ = std::move(formatter);
+}
+
+StatusCounter& Proxel::addStatusCounter(const std::string& name)
+{
+  std::scoped_lock lock{status_fields_mutex_};
+  requireNewStatusField(name);
+  auto& counter = status_counters_.emplace_back();
+
+  addStatusField(
+    name,
+    [&counter]()
+    { return StatusField{StatusField::Type::Counter, static_cast<double>(counter.get())}; }
+  );
+
+  return counter;
+}
+
+StatusGauge& Proxel::addStatusGauge(const std::string& name)
+{
+  std::scoped_lock lock{status_fields_mutex_};
+  requireNewStatusField(name);
+  auto& gauge = status_gauges_.emplace_back();
+
+  addStatusField(
+    name,
+    [&gauge]()
+    { return StatusField{StatusField::Type::Gauge, gauge.get()}; }
+  );
+
+  return gauge;
+}
+
+void Proxel::addStatusTimer(const std::string& name, const ProxelTimer& timer)
+{
+  std::scoped_lock lock{status_fields_mutex_};
+
+  for (const auto* suffix : {".busy", ".max", ".p99", ".recent_busy", ".runs", ".time"})
+  { requireNewStatusField(name + suffix); }
+
+  addStatusField(
+    name + ".busy",
+    [&timer]()
+    { return StatusField{StatusField::Type::Gauge, timer.getAverageBusyness()}; }
+  );
+
+  addStatusField(
+    name + ".max",
+    [&timer]()
+    { return StatusField{StatusField::Type::Gauge, timer.getWindowStatistics(std::chrono::seconds{10}).max}; }
+  );
+
+  addStatusField(
+    name + ".p99",
+    [&timer]()
+    { return StatusField{StatusField::Type::Gauge, timer.getWindowStatistics(std::chrono::seconds{10}).p99}; }
+  );
+
+  addStatusField(
+    name + ".recent_busy",
+    [&timer]()
+    { return StatusField{StatusField::Type::Gauge, timer.getBusyness()}; }
+  );
+
+  addStatusField(
+    name + ".runs",
+    [&timer]()
+    { return StatusField{StatusField::Type::Counter, static_cast<double>(timer.getRunCount())}; }
+  );
+
+  addStatusField(
+    name + ".time",
+    [&timer]()
+    { return StatusField{StatusField::Type::Gauge, timer.getAverageProcessingTime()}; }
+  );
+}
+
+void Proxel::requireNewStatusField(const std::string& name) const
+{
+  if (status_field_readers_.count(name) > 0)
+  { throw std::invalid_argument{"Status field '" + name + "' already exists"}; }
+}
+
+void Proxel::addStatusField(const std::string& name, StatusFieldReader&& reader)
+{
+  status_field_readers_.emplace(name, std::move(reader));
+}
+
 Proxel::State Proxel::getState() const
 {
   return state_;
@@ -1,11 +1,21 @@
 // Copyright 2019, Forsvarets forskningsinstitutt. All rights reserved.
 #include "superflow/utils/proxel_timer.h"
+#include "superflow/timeline.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
+#include <stdexcept>
 
 namespace flow
 {
+ProxelTimer::ProxelTimer(const std::chrono::duration<double> ewma_time_constant)
+  : ewma_time_constant_{ewma_time_constant.count()}
+{
+  if (ewma_time_constant_ <= 0.)
+  { throw std::invalid_argument("ProxelTimer EWMA time constant must be positive"); }
+}
+
 void ProxelTimer::start()
 {
   start_ = Clock::now();
@@ -23,12 +33,40 @@ double ProxelTimer::stop()
   const double processing_time = Duration{now - start_}.count();
   summed_processing_time_ += processing_time;
 
+  if (timeline::isEnabled())
+  {
+    using std::chrono::nanoseconds;
+    timeline::record(
+      timeline::Activity::Running,
+      static_cast<uint64_t>(std::chrono::duration_cast<nanoseconds>(start_.time_since_epoch()).count()),
+      static_cast<uint64_t>(std::chrono::duration_cast<nanoseconds>(now.time_since_epoch()).count())
+    );
+  }
+
   ++run_counter_;
   mean_processing_time_ = summed_processing_time_ / static_cast<double>(run_counter_);
 
   const auto uptime = Duration{now - first_time_point_}.count();
   mean_busyness_time_ = summed_processing_time_ / uptime;
 
+  histogram_.record(now, std::chrono::duration_cast<std::chrono::nanoseconds>(now - start_));
+
+  const auto previous_stop = last_stop_.load(std::memory_order_relaxed);
+  const auto interval_begin = previous_stop == 0
+                              ? first_time_point_
+                              : Clock::time_point{Clock::duration{previous_stop}};
+  const double interval = Duration{now - interval_begin}.count();
+
+  if (interval > 0.)
+  {
+    const double busyness = std::min(processing_time / interval, 1.);
+    const double weight = interval / (ewma_time_constant_ + interval);
+    const double ewma = ewma_busyness_.load(std::memory_order_relaxed);
+    ewma_busyness_.store(ewma + weight * (busyness - ewma), std::memory_order_relaxed);
+  }
+
+  last_stop_.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+
   return processing_time;
 }
 
@@ -49,6 +87,38 @@ double ProxelTimer::getAverageBusyness() const
   return mean_busyness_time_;
 }
 
+double ProxelTimer::getBusyness() const
+{
+  const auto last_stop = last_stop_.load(std::memory_order_relaxed);
+
+  if (last_stop == 0)
+  { return 0.; }
+
+  const double idle = std::max(
+    Duration{Clock::now() - Clock::time_point{Clock::duration{last_stop}}}.count(),
+    0.
+  );
+
+  return ewma_busyness_.load(std::memory_order_relaxed) * ewma_time_constant_ / (ewma_time_constant_ + idle);
+}
+
+ProxelTimer::WindowStatistics ProxelTimer::getWindowStatistics(const std::chrono::seconds window) const
+{
+  const auto histogram = histogram_.getWindow(Clock::now(), window);
+
+  return {
+    histogram.getMean(),
+    histogram.getPercentile(0.99),
+    histogram.getMax(),
+    histogram.getCount()
+  };
+}
+
+double ProxelTimer::getPercentileProcessingTime(const double quantile) const
+{
+  return histogram_.getTotal().getPercentile(quantile);
+}
+
 unsigned long long ProxelTimer::getRunCount() const
 {
   return run_counter_;
@@ -60,6 +130,8 @@ std::string ProxelTimer::getStatusInfo() const
   ss << std::fixed << std::setprecision(3)
      << "time: " << getAverageProcessingTime() << "s"
      << "\n"
+     << "p99:  " << getWindowStatistics(std::chrono::seconds{10}).p99 << "s"
+     << "\n"
      << "busy: " << getAverageBusyness();
 
   return ss.str();
@@ -0,0 +1,198 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/utils/spill_file.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+namespace flow
+{
+namespace
+{
+/// Records start with their size, and are padded to a multiple of this
+constexpr size_t record_alignment = sizeof(uint64_t);
+
+/// Written in place of a size at the end of the file, where the next record did not fit
+constexpr uint64_t wrap_marker = std::numeric_limits<uint64_t>::max();
+
+size_t getRecordSize(const size_t size)
+{
+  return (sizeof(uint64_t) + size + record_alignment - 1) / record_alignment * record_alignment;
+}
+
+#ifdef __linux__
+std::runtime_error makeError(const std::string& path, const std::string& what)
+{
+  return std::runtime_error{"SpillFile: " + what + " '" + path + "': " + std::strerror(errno)};
+}
+#endif
+}
+
+SpillFile::SpillFile(const std::string& directory, const size_t max_size)
+  : max_size_{max_size / record_alignment * record_alignment}
+{
+  if (max_size_ < getRecordSize(1))
+  { throw std::invalid_argument{"SpillFile: 'max_size' must be at least " + std::to_string(getRecordSize(1)) + " bytes"}; }
+
+#ifdef __linux__
+  const auto path = (
+    directory.empty()
+    ? std::filesystem::temp_directory_path()
+    : std::filesystem::path{directory}
+  ) / "superflow-spill-XXXXXX";
+
+  std::string name = path.string();
+  fd_ = mkostemp(name.data(), O_CLOEXEC);
+
+  if (fd_ < 0)
+  { throw makeError(name, "could not create"); }
+
+  unlink(name.c_str());
+
+  // Reserve the budget up front, so that a full disk fails here rather than with SIGBUS in a push
+  const int result = posix_fallocate(fd_, 0, static_cast<off_t>(max_size_));
+
+  if (result != 0)
+  {
+    errno = result;
+    const auto error = makeError(name, "could not reserve " + std::to_string(max_size_) + " bytes for");
+    close(fd_);
+    throw error;
+  }
+
+  void* data = mmap(nullptr, max_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+
+  if (data == MAP_FAILED)
+  {
+    const auto error = makeError(name, "could not map");
+    close(fd_);
+    throw error;
+  }
+
+  data_ = static_cast<std::byte*>(data);
+#else
+  (void) directory;
+  throw std::runtime_error{"SpillFile: only available on Linux"};
+#endif
+}
+
+SpillFile::~SpillFile()
+{
+#ifdef __linux__
+  munmap(data_, max_size_);
+  close(fd_);
+#endif
+}
+
+bool SpillFile::push(const ByteView header, const ByteView payload)
+{
+  const uint64_t size = header.size + payload.size;
+  const size_t record_size = getRecordSize(size);
+
+  if (num_records_ == 0)
+  {
+    head_ = 0;
+    tail_ = 0;
+  }
+
+  size_t offset = tail_;
+
+  if (num_records_ > 0 && tail_ <= head_)
+  {
+    if (record_size > head_ - tail_)
+    { return false; }
+  }
+  else if (record_size > max_size_ - tail_)
+  {
+    if (record_size > head_)
+    { return false; }
+
+    if (max_size_ - tail_ >= sizeof(uint64_t))
+    { std::memcpy(data_ + tail_, &wrap_marker, sizeof(uint64_t)); }
+
+    offset = 0;
+  }
+
+  std::memcpy(data_ + offset, &size, sizeof(uint64_t));
+
+  if (header.size > 0)
+  { std::memcpy(data_ + offset + sizeof(uint64_t), header.data, header.size); }
+
+  if (payload.size > 0)
+  { std::memcpy(data_ + offset + sizeof(uint64_t) + header.size, payload.data, payload.size); }
+
+  tail_ = offset + record_size;
+  size_ += record_size;
+  ++num_records_;
+
+  return true;
+}
+
+ByteView SpillFile::front() const
+{
+  if (num_records_ == 0)
+  { throw std::out_of_range{"SpillFile: the queue is empty"}; }
+
+  const auto head = getHead();
+  uint64_t size;
+  std::memcpy(&size, data_ + head, sizeof(uint64_t));
+
+  return {data_ + head + sizeof(uint64_t), static_cast<size_t>(size)};
+}
+
+void SpillFile::pop()
+{
+  const auto record = front();
+  const auto record_size = getRecordSize(record.size);
+
+  head_ = getHead() + record_size;
+  size_ -= record_size;
+  --num_records_;
+
+  if (num_records_ == 0)
+  { clear(); }
+}
+
+void SpillFile::clear()
+{
+  head_ = 0;
+  tail_ = 0;
+  size_ = 0;
+  num_records_ = 0;
+}
+
+bool SpillFile::isEmpty() const
+{ return num_records_ == 0; }
+
+size_t SpillFile::getNumRecords() const
+{ return num_records_; }
+
+size_t SpillFile::getSize() const
+{ return size_; }
+
+size_t SpillFile::getMaxSize() const
+{ return max_size_; }
+
+size_t SpillFile::getHead() const
+{
+  if (max_size_ - head_ < sizeof(uint64_t))
+  { return 0; }
+
+  uint64_t size;
+  std::memcpy(&size, data_ + head_, sizeof(uint64_t));
+
+  return size == wrap_marker
+         ? 0
+         : head_;
+}
+}
@@ -0,0 +1,150 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/thread_statistics.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace flow
+{
+#ifdef __linux__
+namespace
+{
+std::string getTaskPath(const int64_t thread_id)
+{
+  return "/proc/self/task/" + std::to_string(thread_id) + "/";
+}
+
+/// Reads the state, and user and system time from `stat`.
+bool readStat(const std::string& task_path, ThreadStatistics& statistics)
+{
+  std::ifstream file{task_path + "stat"};
+  std::string line;
+
+  if (!std::getline(file, line))
+  { return false; }
+
+  // The thread name, in parentheses, may contain spaces and parentheses itself
+  const auto name_end = line.rfind(')');
+
+  if (name_end == std::string::npos)
+  { return false; }
+
+  std::istringstream fields{line.substr(name_end + 1)};
+  std::string state;
+  fields >> state;
+
+  // Skip to field 14 and 15, utime and stime
+  std::string skipped;
+  for (int i = 4; i < 14; ++i)
+  { fields >> skipped; }
+
+  unsigned long long user_ticks = 0;
+  unsigned long long system_ticks = 0;
+  fields >> user_ticks >> system_ticks;
+
+  if (!fields)
+  { return false; }
+
+  const auto ticks_per_second = static_cast<double>(sysconf(_SC_CLK_TCK));
+  statistics.cpu_time = static_cast<double>(user_ticks + system_ticks) / ticks_per_second;
+  statistics.runnable = state == "R";
+
+  return true;
+}
+
+/// Reads cpu time and run delay from `schedstat`, which is missing if the kernel lacks CONFIG_SCHED_INFO.
+void readSchedStat(const std::string& task_path, ThreadStatistics& statistics)
+{
+  std::ifstream file{task_path + "schedstat"};
+  unsigned long long cpu_ns = 0;
+  unsigned long long run_delay_ns = 0;
+
+  if (!(file >> cpu_ns >> run_delay_ns))
+  { return; }
+
+  // Prefer the nanosecond resolution of schedstat, unless it is not maintained
+  statistics.cpu_time = std::max(statistics.cpu_time, static_cast<double>(cpu_ns) * 1e-9);
+  statistics.run_delay = static_cast<double>(run_delay_ns) * 1e-9;
+}
+
+void readContextSwitches(const std::string& task_path, ThreadStatistics& statistics)
+{
+  std::ifstream file{task_path + "status"};
+  std::string line;
+
+  while (std::getline(file, line))
+  {
+    std::istringstream fields{line};
+    std::string key;
+    size_t value = 0;
+
+    if (!(fields >> key >> value))
+    { continue; }
+
+    if (key == "voluntary_ctxt_switches:")
+    { statistics.voluntary_context_switches = value; }
+    else if (key == "nonvoluntary_ctxt_switches:")
+    { statistics.involuntary_context_switches = value; }
+  }
+}
+}
+
+int64_t getCurrentThreadId()
+{
+  return static_cast<int64_t>(syscall(SYS_gettid));
+}
+
+std::optional<ThreadStatistics> readThreadStatistics(const int64_t thread_id)
+{
+  if (thread_id <= 0)
+  { return std::nullopt; }
+
+  const auto task_path = getTaskPath(thread_id);
+  ThreadStatistics statistics;
+  statistics.thread_id = thread_id;
+
+  if (!readStat(task_path, statistics))
+  { return std::nullopt; }
+
+  readSchedStat(task_path, statistics);
+  readContextSwitches(task_path, statistics);
+
+  return statistics;
+}
+
+size_t getNumAvailableCores()
+{
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+
+  if (sched_getaffinity(0, sizeof(cpus), &cpus) == 0)
+  { return std::max(static_cast<size_t>(CPU_COUNT(&cpus)), size_t{1}); }
+
+  return std::max(static_cast<size_t>(std::thread::hardware_concurrency()), size_t{1});
+}
+#else
+int64_t getCurrentThreadId()
+{
+  return 0;
+}
+
+std::optional<ThreadStatistics> readThreadStatistics(int64_t)
+{
+  return std::nullopt;
+}
+
+size_t getNumAvailableCores()
+{
+  return std::max(static_cast<size_t>(std::thread::hardware_concurrency()), size_t{1});
+}
+#endif
+}
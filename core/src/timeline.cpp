@@ -0,0 +1,275 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/timeline.h"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace flow::timeline
+{
+namespace
+{
+struct Event
+{
+  std::atomic<uint64_t> begin{0};
+  std::atomic<uint64_t> end{0};
+  std::atomic<Activity> activity{Activity::Running};
+};
+
+/// Written by its own thread only, read by writeChromeTrace.
+/// Like a seqlock, `head` is the index of the event being written, so a reader knows that
+/// the event `head - capacity` may be overwritten while it is being read. One extra slot is
+/// allocated for this event, so that `capacity` complete events are always available.
+/// When its thread exits, the ring is handed to the next thread that records, which starts
+/// at `first` under a new `tid`.
+struct Ring
+{
+  explicit Ring(const size_t capacity)
+    : events(capacity + 1)
+  {}
+
+  std::vector<Event> events;
+  std::atomic<uint64_t> head{0};
+  uint64_t first = 0; ///< Guarded by Registry::mutex
+  size_t tid = 0;     ///< Guarded by Registry::mutex
+  std::string name;   ///< Guarded by Registry::mutex
+};
+
+struct Registry
+{
+  std::mutex mutex;
+  std::vector<std::shared_ptr<Ring>> rings;
+  std::vector<std::shared_ptr<Ring>> free_rings; ///< Rings of exited threads, still written by writeChromeTrace
+  size_t next_tid = 1;
+  size_t events_per_thread = 1u << 15;
+  std::atomic<uint64_t> enabled_at{0};
+};
+
+Registry& getRegistry()
+{
+  static Registry registry;
+  return registry;
+}
+
+/// Must be called with the registry mutex locked
+std::shared_ptr<Ring> acquireRing(Registry& registry)
+{
+  while (!registry.free_rings.empty())
+  {
+    auto ring = std::move(registry.free_rings.back());
+    registry.free_rings.pop_back();
+
+    if (ring->events.size() == registry.events_per_thread + 1)
+    {
+      ring->first = ring->head.load(std::memory_order_relaxed);
+      return ring;
+    }
+
+    // Rings sized by an earlier `enable` are dropped
+    registry.rings.erase(std::find(registry.rings.begin(), registry.rings.end(), ring));
+  }
+
+  registry.rings.push_back(std::make_shared<Ring>(registry.events_per_thread));
+
+  return registry.rings.back();
+}
+
+/// Hands the ring of a thread back to the registry when the thread exits
+struct RingOwner
+{
+  RingOwner() = default;
+
+  RingOwner(const RingOwner&) = delete;
+
+  RingOwner& operator=(const RingOwner&) = delete;
+
+  ~RingOwner()
+  {
+    if (ring == nullptr)
+    { return; }
+
+    auto& registry = getRegistry();
+    std::scoped_lock lock{registry.mutex};
+    registry.free_rings.push_back(std::move(ring));
+  }
+
+  std::shared_ptr<Ring> ring;
+};
+
+thread_local RingOwner thread_ring;
+thread_local std::string thread_name;
+
+Ring& getThreadRing()
+{
+  if (thread_ring.ring == nullptr)
+  {
+    auto& registry = getRegistry();
+    std::scoped_lock lock{registry.mutex};
+
+    thread_ring.ring = acquireRing(registry);
+    thread_ring.ring->tid = registry.next_tid++;
+    thread_ring.ring->name = thread_name;
+  }
+
+  return *thread_ring.ring;
+}
+
+const char* toString(const Activity activity)
+{
+  switch (activity)
+  {
+    case Activity::Running:
+      return "running";
+    case Activity::Waiting:
+      return "waiting";
+    case Activity::Blocked:
+      return "blocked";
+  }
+
+  return "unknown";
+}
+
+std::string escape(const std::string& text)
+{
+  std::string escaped;
+
+  for (const char c : text)
+  {
+    if (c == '"' || c == '\\')
+    { escaped += '\\'; }
+
+    escaped += c;
+  }
+
+  return escaped;
+}
+
+void writeMicroseconds(std::ostream& os, const uint64_t nanoseconds)
+{
+  const auto fraction = std::to_string(1000 + nanoseconds % 1000);
+  os << nanoseconds / 1000 << '.' << fraction.substr(1);
+}
+}
+
+void enable(const size_t events_per_thread)
+{
+  if (events_per_thread == 0)
+  { throw std::invalid_argument{"Timeline needs room for at least one event per thread"}; }
+
+  auto& registry = getRegistry();
+
+  {
+    std::scoped_lock lock{registry.mutex};
+    registry.events_per_thread = events_per_thread;
+  }
+
+  registry.enabled_at = now();
+  detail::enabled = true;
+}
+
+void disable()
+{
+  detail::enabled = false;
+}
+
+void setThreadName(const std::string& name)
+{
+  thread_name = name;
+
+  if (thread_ring.ring != nullptr)
+  {
+    std::scoped_lock lock{getRegistry().mutex};
+    thread_ring.ring->name = name;
+  }
+}
+
+void record(const Activity activity, const uint64_t begin, const uint64_t end)
+{
+  if (!isEnabled())
+  { return; }
+
+  auto& ring = getThreadRing();
+  const uint64_t index = ring.head.load(std::memory_order_relaxed);
+  auto& event = ring.events[index % ring.events.size()];
+  std::atomic_thread_fence(std::memory_order_release);
+
+  event.begin.store(begin, std::memory_order_relaxed);
+  event.end.store(end, std::memory_order_relaxed);
+  event.activity.store(activity, std::memory_order_relaxed);
+
+  ring.head.store(index + 1, std::memory_order_release);
+}
+
+void writeChromeTrace(std::ostream& os)
+{
+  struct Snapshot
+  {
+    std::shared_ptr<const Ring> ring;
+    uint64_t first;
+    uint64_t head;
+    size_t tid;
+    std::string name;
+  };
+
+  auto& registry = getRegistry();
+  std::vector<Snapshot> snapshots;
+
+  // A ring may be handed to a new thread after the lock is released, which only writes events from `head` on
+  {
+    std::scoped_lock lock{registry.mutex};
+
+    for (const auto& ring : registry.rings)
+    { snapshots.push_back({ring, ring->first, ring->head.load(std::memory_order_acquire), ring->tid, ring->name}); }
+  }
+
+  const uint64_t enabled_at = registry.enabled_at;
+  const char* separator = "\n";
+
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+  for (const auto& snapshot : snapshots)
+  {
+    const auto& ring = *snapshot.ring;
+    const uint64_t capacity = ring.events.size();
+
+    if (!snapshot.name.empty())
+    {
+      os << separator << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << snapshot.tid
+         << R"(,"args":{"name":")" << escape(snapshot.name) << "\"}}";
+      separator = ",\n";
+    }
+
+    const uint64_t head = snapshot.head;
+    const uint64_t first = std::max(snapshot.first, head > capacity ? head - capacity : 0);
+
+    for (uint64_t i = first; i < head; ++i)
+    {
+      const auto& event = ring.events[i % capacity];
+      const uint64_t begin = event.begin.load(std::memory_order_relaxed);
+      const uint64_t end = event.end.load(std::memory_order_relaxed);
+      const Activity activity = event.activity.load(std::memory_order_relaxed);
+
+      // The owner may have wrapped around and overwritten this slot while we were reading it.
+      std::atomic_thread_fence(std::memory_order_acquire);
+
+      if (i + capacity <= ring.head.load(std::memory_order_relaxed))
+      { continue; }
+
+      if (begin < enabled_at || end < begin)
+      { continue; }
+
+      os << separator << R"({"name":")" << toString(activity) << R"(","ph":"X","pid":1,"tid":)" << snapshot.tid
+         << ",\"ts\":";
+      writeMicroseconds(os, begin - enabled_at);
+      os << ",\"dur\":";
+      writeMicroseconds(os, end - begin);
+      os << '}';
+      separator = ",\n";
+    }
+  }
+
+  os << "\n]}\n";
+}
+}
@@ -0,0 +1,129 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/trace.h"
+
+#include <array>
+#include <mutex>
+#include <stdexcept>
+
+namespace flow::tracing
+{
+namespace
+{
+struct Collector
+{
+  std::mutex mutex;
+  std::map<Path, LatencyHistogram> statistics;
+};
+
+Collector& getCollector()
+{
+  static Collector collector;
+  return collector;
+}
+
+/// A started trace, written like a seqlock: `id` is 0 while the other fields are written
+struct Entry
+{
+  std::atomic<uint64_t> id{0};
+  std::atomic<int64_t> origin{0};
+  std::atomic<const Port*> source{nullptr};
+};
+
+std::array<Entry, max_traces> traces;
+std::atomic<uint64_t> next_id{1};
+}
+
+void enable(const size_t sample_interval)
+{
+  if (sample_interval == 0)
+  { throw std::invalid_argument{"Trace sample interval must be at least 1"}; }
+
+  clearStatistics();
+  detail::sample_interval = sample_interval;
+}
+
+void disable()
+{
+  detail::sample_interval = 0;
+}
+
+void record(const TraceContext& trace, const Port* sink)
+{
+  if (!trace || !isEnabled())
+  { return; }
+
+  const auto latency = std::chrono::steady_clock::now() - trace.origin;
+
+  auto& collector = getCollector();
+  std::scoped_lock lock{collector.mutex};
+  collector.statistics[{trace.source, sink}].record(latency);
+}
+
+std::map<Path, LatencyHistogram> getStatistics()
+{
+  auto& collector = getCollector();
+  std::scoped_lock lock{collector.mutex};
+
+  return collector.statistics;
+}
+
+void clearStatistics()
+{
+  auto& collector = getCollector();
+  std::scoped_lock lock{collector.mutex};
+
+  collector.statistics.clear();
+}
+
+namespace detail
+{
+TraceContext begin(const Port* source)
+{
+  const size_t interval = sample_interval.load(std::memory_order_relaxed);
+
+  if (interval == 0)
+  { return {}; }
+
+  items_until_sample = interval - 1;
+
+  const TraceContext trace{
+    next_id.fetch_add(1, std::memory_order_relaxed),
+    std::chrono::steady_clock::now(),
+    source
+  };
+
+  auto& entry = traces[trace.id % max_traces];
+  entry.id.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  entry.origin.store(trace.origin.time_since_epoch().count(), std::memory_order_relaxed);
+  entry.source.store(source, std::memory_order_relaxed);
+  entry.id.store(trace.id, std::memory_order_release);
+
+  return trace;
+}
+
+TraceContext lookup(const uint64_t id)
+{
+  const auto& entry = traces[id % max_traces];
+
+  if (entry.id.load(std::memory_order_acquire) != id)
+  { return {}; }
+
+  const TraceContext trace{
+    id,
+    std::chrono::steady_clock::time_point{
+      std::chrono::steady_clock::duration{entry.origin.load(std::memory_order_relaxed)}
+    },
+    entry.source.load(std::memory_order_relaxed)
+  };
+
+  // A newer trace may have taken the entry over while it was being read
+  std::atomic_thread_fence(std::memory_order_acquire);
+
+  if (entry.id.load(std::memory_order_relaxed) != id)
+  { return {}; }
+
+  return trace;
+}
+}
+}
@@ -0,0 +1,139 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/utils/windowed_histogram.h"
+
+#include <stdexcept>
+
+namespace flow
+{
+namespace
+{
+constexpr auto relaxed = std::memory_order_relaxed;
+
+/// Only to be called by the single writer, so a load and a store is sufficient.
+template<typename T, typename U>
+void add(std::atomic<T>& counter, const U value)
+{
+  counter.store(counter.load(relaxed) + static_cast<T>(value), relaxed);
+}
+
+void setMax(std::atomic<uint64_t>& counter, const uint64_t value)
+{
+  if (value > counter.load(relaxed))
+  { counter.store(value, relaxed); }
+}
+
+int64_t toPeriod(const WindowedHistogram::Clock::time_point time_point, const std::chrono::seconds slot_duration)
+{
+  return time_point.time_since_epoch() / slot_duration;
+}
+
+template<typename Slots>
+void recordIn(Slots& slots, const int64_t period, const size_t bucket, const uint64_t nanoseconds)
+{
+  auto& slot = slots[static_cast<size_t>(period) % slots.size()];
+
+  if (slot.period.load(relaxed) != period)
+  {
+    slot.period.store(period, relaxed);
+    slot.count.store(0, relaxed);
+    slot.sum.store(0, relaxed);
+    slot.max.store(0, relaxed);
+
+    for (auto& count : slot.buckets)
+    { count.store(0, relaxed); }
+  }
+
+  add(slot.buckets[bucket], 1);
+  add(slot.count, 1);
+  add(slot.sum, nanoseconds);
+  setMax(slot.max, nanoseconds);
+}
+
+template<typename Slots>
+LatencyHistogram readFrom(const Slots& slots, const int64_t first, const int64_t last)
+{
+  std::array<uint64_t, LatencyHistogram::num_buckets> buckets{};
+  uint64_t sum = 0;
+  uint64_t max = 0;
+
+  for (const auto& slot : slots)
+  {
+    const auto period = slot.period.load(relaxed);
+
+    if (period < first || period > last)
+    { continue; }
+
+    for (size_t i = 0; i < buckets.size(); ++i)
+    { buckets[i] += slot.buckets[i].load(relaxed); }
+
+    sum += slot.sum.load(relaxed);
+    max = std::max(max, slot.max.load(relaxed));
+  }
+
+  return LatencyHistogram::fromBuckets(buckets, sum, max);
+}
+}
+
+WindowedHistogram::~WindowedHistogram()
+{
+  delete slots_.load(relaxed);
+}
+
+void WindowedHistogram::record(const Clock::time_point now, const std::chrono::nanoseconds duration)
+{
+  const auto nanoseconds = static_cast<uint64_t>(duration.count() > 0 ? duration.count() : 0);
+  const auto bucket = LatencyHistogram::getBucketIndex(nanoseconds);
+
+  auto* slots = slots_.load(relaxed);
+
+  if (slots == nullptr)
+  {
+    slots = new Slots{};
+    slots_.store(slots, std::memory_order_release);
+  }
+
+  recordIn(slots->fine, toPeriod(now, fine_slot_duration), bucket, nanoseconds);
+  recordIn(slots->coarse, toPeriod(now, coarse_slot_duration), bucket, nanoseconds);
+
+  add(total_buckets_[bucket], 1);
+  add(total_.count, 1);
+  add(total_.sum, nanoseconds);
+  setMax(total_.max, nanoseconds);
+}
+
+LatencyHistogram WindowedHistogram::getWindow(const Clock::time_point now, const std::chrono::seconds window) const
+{
+  if (window.count() < 1 || window > max_window)
+  { throw std::invalid_argument{"WindowedHistogram window must be between 1 and 60 seconds"}; }
+
+  const auto* slots = slots_.load(std::memory_order_acquire);
+
+  if (slots == nullptr)
+  { return {}; }
+
+  if (window <= fine_window)
+  {
+    return readFrom(
+      slots->fine,
+      toPeriod(now - window, fine_slot_duration),
+      toPeriod(now, fine_slot_duration)
+    );
+  }
+
+  return readFrom(
+    slots->coarse,
+    toPeriod(now - window, coarse_slot_duration),
+    toPeriod(now, coarse_slot_duration)
+  );
+}
+
+LatencyHistogram WindowedHistogram::getTotal() const
+{
+  std::array<uint64_t, LatencyHistogram::num_buckets> buckets{};
+
+  for (size_t i = 0; i < buckets.size(); ++i)
+  { buckets[i] = total_buckets_[i].load(relaxed); }
+
+  return LatencyHistogram::fromBuckets(buckets, total_.sum.load(relaxed), total_.max.load(relaxed));
+}
+}
@@ -0,0 +1,108 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include "superflow/buffered_consumer_port.h"
+#include "superflow/producer_port.h"
+#include "superflow/proxel.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace flow
+{
+/// Sends an increasing counter on "outport" until stopped.
+class StreamSourceProxel : public Proxel
+{
+public:
+  explicit StreamSourceProxel(
+    const std::chrono::microseconds period = std::chrono::microseconds{100}
+  )
+      : period_{period}
+      , out_port_{std::make_shared<OutPort>()}
+  {
+    registerPorts({{"outport", out_port_}});
+  }
+
+  void start() override
+  {
+    setState(State::Running);
+
+    for (int i = 0; !stopped_; ++i)
+    {
+      out_port_->send(i);
+      std::this_thread::sleep_for(period_);
+    }
+
+    setState(State::Unavailable);
+  }
+
+  void stop() noexcept override
+  { stopped_ = true; }
+
+private:
+  using OutPort = ProducerPort<int>;
+
+  std::chrono::microseconds period_;
+  std::atomic<bool> stopped_{false};
+  OutPort::Ptr out_port_;
+};
+
+/// Counts the items received on "inport" until stopped.
+class StreamSinkProxel : public Proxel
+{
+public:
+  StreamSinkProxel()
+      : in_port_{std::make_shared<InPort>()}
+  {
+    registerPorts({{"inport", in_port_}});
+  }
+
+  void start() override
+  {
+    setState(State::AwaitingInput);
+
+    for (const auto& item : *in_port_)
+    {
+      setState(State::Running);
+      last_value_ = item;
+      ++num_received_;
+    }
+
+    setState(State::Unavailable);
+  }
+
+  void stop() noexcept override
+  { in_port_->deactivate(); }
+
+  size_t getNumReceived() const
+  { return num_received_; }
+
+  int getLastValue() const
+  { return last_value_; }
+
+  /// Wait until at least `count` more items have been received
+  bool waitForMore(const size_t count, const std::chrono::milliseconds timeout = std::chrono::seconds{5}) const
+  {
+    const auto target = num_received_ + count;
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    while (num_received_ < target)
+    {
+      if (std::chrono::steady_clock::now() > deadline)
+      { return false; }
+
+      std::this_thread::sleep_for(std::chrono::microseconds{100});
+    }
+
+    return true;
+  }
+
+private:
+  using InPort = BufferedConsumerPort<int, ConnectPolicy::Multi>;
+
+  InPort::Ptr in_port_;
+  std::atomic<size_t> num_received_{0};
+  std::atomic<int> last_value_{-1};
+};
+}
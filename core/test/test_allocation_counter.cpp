@@ -0,0 +1,119 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/allocation_hooks.h"
+#include "superflow/buffered_consumer_port.h"
+#include "superflow/graph.h"
+#include "superflow/producer_port.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace flow;
+
+namespace
+{
+class AllocatingProxel : public Proxel
+{
+public:
+  AllocatingProxel()
+  {
+    registerPorts({{"in", input_}});
+  }
+
+  void start() override
+  {
+    for (const auto& item : *input_)
+    {
+      const std::vector<char> copy(static_cast<size_t>(item));
+      ++num_consumed_;
+    }
+  }
+
+  void stop() noexcept override
+  {
+    input_->deactivate();
+  }
+
+  std::shared_ptr<BufferedConsumerPort<int, ConnectPolicy::Single, GetMode::Blocking, LeakPolicy::PushBlocking>> input_ =
+    std::make_shared<BufferedConsumerPort<int, ConnectPolicy::Single, GetMode::Blocking, LeakPolicy::PushBlocking>>(1);
+  std::atomic<int> num_consumed_{0};
+};
+}
+
+TEST(AllocationCounter, countsCurrentThread)
+{
+  ASSERT_TRUE(allocation::isInstrumented());
+
+  const auto counters = allocation::getThreadCounters();
+  EXPECT_EQ(counters, allocation::getThreadCounters());
+
+  const auto before = allocation::read(*counters);
+  const auto ptr = std::make_unique<char[]>(100);
+  const auto after = allocation::read(*counters);
+
+  EXPECT_EQ(before.count + 1, after.count);
+  EXPECT_EQ(before.bytes + 100, after.bytes);
+}
+
+TEST(AllocationCounter, otherThreadsAreNotCounted)
+{
+  const auto counters = allocation::getThreadCounters();
+  const auto before = allocation::read(*counters);
+
+  std::thread{[] { (void)std::make_unique<char[]>(1'000'000); }}.join();
+
+  // Starting the thread allocates a little on this thread, but the large allocation is not counted
+  EXPECT_LT(allocation::read(*counters).bytes, before.bytes + 1'000'000);
+}
+
+TEST(AllocationCounter, sendAndGetNextDoNotAllocatePerItem)
+{
+  auto producer = std::make_shared<ProducerPort<int>>();
+  auto consumer = std::make_shared<BufferedConsumerPort<int>>(1);
+  producer->connect(consumer);
+
+  // Warm up, so that the buffer has allocated its storage
+  producer->send(0);
+  (void)consumer->getNext();
+
+  const auto counters = allocation::getThreadCounters();
+  const auto before = allocation::read(*counters);
+  constexpr int num_items = 10000;
+
+  for (int i = 0; i < num_items; ++i)
+  {
+    producer->send(i);
+    (void)consumer->getNext();
+  }
+
+  EXPECT_EQ(before.count, allocation::read(*counters).count);
+}
+
+TEST(AllocationCounter, graphReportsAllocationsPerItem)
+{
+  auto proxel = std::make_shared<AllocatingProxel>();
+  auto producer = std::make_shared<ProducerPort<int>>();
+  producer->connect(proxel->input_);
+
+  Graph graph{{{"allocator", proxel}}};
+  graph.start();
+
+  constexpr int num_items = 100;
+
+  for (int i = 0; i < num_items; ++i)
+  { producer->send(1000); }
+
+  while (proxel->num_consumed_ < num_items)
+  { std::this_thread::yield(); }
+
+  const auto allocations = graph.getProxelStatuses().at("allocator").allocations;
+  EXPECT_GE(allocations.count, num_items);
+  EXPECT_GE(allocations.bytes, num_items * 1000);
+  EXPECT_GE(allocations.count_per_item, 1.);
+  EXPECT_GE(allocations.bytes_per_item, 1000.);
+
+  graph.stop();
+}
@@ -0,0 +1,144 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/bottleneck_report.h"
+
+#include "gtest/gtest.h"
+
+#include <sstream>
+
+using namespace flow;
+
+namespace
+{
+ProxelStatus makeStatus(const double busyness, const size_t queue_size = 0, const size_t num_dropped = 0)
+{
+  ProxelStatus status{ProxelStatus::State::Running, "", {}};
+  status.busyness = busyness;
+
+  PortStatus input{1, 100};
+  input.queue_size = queue_size;
+  input.num_dropped = num_dropped;
+  status.ports["in"] = input;
+  status.ports["out"] = PortStatus{1, 100};
+
+  return status;
+}
+}
+
+TEST(BottleneckReport, busiestStageWithBackpressureIsLimiting)
+{
+  const ProxelStatusMap statuses{
+    {"source", makeStatus(0.)},
+    {"decode", makeStatus(0.95, 4, 10)},
+    {"filter", makeStatus(0.4)},
+    {"sink", makeStatus(0.2)},
+  };
+
+  const std::vector<ConnectionSpec> connections{
+    {"source", "out", "decode", "in"},
+    {"decode", "out", "filter", "in"},
+    {"filter", "out", "sink", "in"},
+  };
+
+  const auto report = analyzeBottlenecks(statuses, connections);
+  ASSERT_EQ(1, report.pipelines.size());
+
+  const auto& pipeline = report.pipelines.front();
+  EXPECT_EQ((std::vector<std::string>{"decode", "filter", "sink", "source"}), pipeline.proxels);
+  ASSERT_EQ(1, pipeline.limiting_stages.size());
+
+  const auto& stage = pipeline.limiting_stages.front();
+  EXPECT_EQ("decode", stage.proxel);
+  EXPECT_TRUE(stage.backpressure);
+  EXPECT_EQ(4, stage.queue_size);
+  EXPECT_EQ(10, stage.num_dropped);
+
+  // Two instances halve the load of decode, which then is still busier than filter
+  EXPECT_DOUBLE_EQ(2., pipeline.predicted_speedup);
+  EXPECT_DOUBLE_EQ(0.95 / 0.4, analyzeBottlenecks(statuses, connections, 4).pipelines.front().predicted_speedup);
+}
+
+TEST(BottleneckReport, busyStageWithoutBackpressureIsNotLimiting)
+{
+  const ProxelStatusMap statuses{
+    {"a", makeStatus(0.9)},
+    {"b", makeStatus(0.6, 0, 3)},
+  };
+
+  const auto report = analyzeBottlenecks(statuses, {{"a", "out", "b", "in"}});
+  ASSERT_EQ(1, report.pipelines.front().limiting_stages.size());
+  EXPECT_EQ("b", report.pipelines.front().limiting_stages.front().proxel);
+  EXPECT_DOUBLE_EQ(1., report.pipelines.front().predicted_speedup);
+}
+
+TEST(BottleneckReport, pipelinesAreAnalyzedSeparately)
+{
+  const ProxelStatusMap statuses{
+    {"a1", makeStatus(0.5)},
+    {"a2", makeStatus(0.52)},
+    {"b1", makeStatus(0.)},
+    {"b2", makeStatus(0.)},
+  };
+
+  const std::vector<ConnectionSpec> connections{
+    {"a1", "out", "a2", "in"},
+    {"b1", "out", "b2", "in"},
+  };
+
+  const auto report = analyzeBottlenecks(statuses, connections);
+  ASSERT_EQ(2, report.pipelines.size());
+
+  // Equally busy stages are both limiting
+  EXPECT_EQ(2, report.pipelines[0].limiting_stages.size());
+  EXPECT_EQ("a2", report.pipelines[0].limiting_stages.front().proxel);
+  EXPECT_DOUBLE_EQ(2., report.pipelines[0].predicted_speedup);
+
+  EXPECT_TRUE(report.pipelines[1].limiting_stages.empty());
+
+  std::ostringstream ss;
+  ss << report;
+  EXPECT_EQ("bottleneck: a2 (busy 0.52) a1 (busy 0.50) x2.00 with 2 instances\n", ss.str());
+
+  EXPECT_THROW((void)analyzeBottlenecks(statuses, connections, 0), std::invalid_argument);
+}
+
+TEST(BottleneckReport, stagesBlockedBySlowConsumerAreNotLimiting)
+{
+  // a -> b -> c through PushBlocking ports, where c is slow. b is blocked pushing to c most of
+  // the time, which counts as busy, and so is a, which has no input to be measured by.
+  const auto make_status = [](const double waiting_time, const double processing_time, const double blocked_time)
+  {
+    ProxelStatus status{ProxelStatus::State::Running, "", {}};
+    status.busyness = processing_time / (waiting_time + processing_time);
+
+    PortStatus input{1, 100, waiting_time, processing_time};
+    input.blocked_time = blocked_time;
+    status.ports["in"] = input;
+    status.ports["out"] = PortStatus{1, 100};
+
+    return status;
+  };
+
+  ProxelStatusMap statuses{
+    {"a", ProxelStatus{ProxelStatus::State::Running, "", {}}},
+    {"b", make_status(0.1, 9.9, 9.5)},
+    {"c", make_status(0.2, 9.8, 9.4)},
+  };
+  statuses["a"].ports["out"] = PortStatus{1, 100};
+
+  const std::vector<ConnectionSpec> connections{
+    {"a", "out", "b", "in"},
+    {"b", "out", "c", "in"},
+  };
+
+  const auto report = analyzeBottlenecks(statuses, connections);
+  const auto& pipeline = report.pipelines.front();
+  ASSERT_EQ(1, pipeline.limiting_stages.size());
+
+  const auto& stage = pipeline.limiting_stages.front();
+  EXPECT_EQ("c", stage.proxel);
+  EXPECT_DOUBLE_EQ(0.98, stage.busyness);
+  EXPECT_DOUBLE_EQ(0., stage.output_blocked_time);
+
+  // b only does 0.5 s of work, so c can speed up until it is as fast as b
+  EXPECT_DOUBLE_EQ(2., pipeline.predicted_speedup);
+}
@@ -585,3 +585,131 @@ TEST(BufferedConsumer, notLeaky)
   EXPECT_EQ(1984, block_consumer->getNext().value());
   ASSERT_EQ(block_consumer->getQueueSize(), 0);
 }
+
+TEST(BufferedConsumer, getNextIsTimed)
+{
+  using namespace std::chrono_literals;
+  using Producer = ProducerPort<int>;
+  using Consumer = BufferedConsumerPort<int, Single, Blocking>;
+
+  auto producer = std::make_shared<Producer>();
+  auto consumer = std::make_shared<Consumer>(2);
+  producer->connect(consumer);
+
+  EXPECT_EQ(0., consumer->getStatus().waiting_time);
+
+  // How long the consumer waits depends on the scheduling of the threads, so the waiting time
+  // is checked against the measured duration of the gets. The consumer itself sleeps between
+  // the gets, so the processing time has a lower bound.
+  std::promise<void> getting;
+
+  auto sending = std::async(std::launch::async, [&producer, getting = getting.get_future()]
+  {
+    getting.wait();
+    std::this_thread::sleep_for(5ms);
+    producer->send(1);
+    producer->send(2);
+  });
+
+  const auto first_get = std::chrono::steady_clock::now();
+  getting.set_value();
+  ASSERT_TRUE(consumer->getNext());
+  const auto first_wait = std::chrono::steady_clock::now() - first_get;
+
+  sending.get();
+  std::this_thread::sleep_for(5ms);
+
+  const auto second_get = std::chrono::steady_clock::now();
+  ASSERT_TRUE(consumer->getNext());
+  const auto second_wait = std::chrono::steady_clock::now() - second_get;
+
+  const auto status = consumer->getStatus();
+  EXPECT_LT(0., status.waiting_time);
+  EXPECT_GE(std::chrono::duration<double>(first_wait + second_wait).count(), status.waiting_time);
+  EXPECT_LE(5e-3, status.processing_time);
+}
+
+TEST(BufferedConsumer, statusReportsQueueAndDrops)
+{
+  using Producer = ProducerPort<int>;
+  using Consumer = BufferedConsumerPort<int, Single, Blocking>;
+
+  auto producer = std::make_shared<Producer>();
+  auto consumer = std::make_shared<Consumer>(2);
+  producer->connect(consumer);
+
+  for (int i = 0; i < 5; ++i)
+  { producer->send(i); }
+
+  const auto status = consumer->getStatus();
+  EXPECT_EQ(2, status.queue_size);
+  EXPECT_EQ(3, status.num_dropped);
+  EXPECT_EQ(0., status.blocked_time);
+}
+
+TEST(BufferedConsumer, edgeStatusesArePerProducer)
+{
+  using Producer = ProducerPort<std::string>;
+  using Consumer = BufferedConsumerPort<std::string, Multi, Blocking>;
+
+  auto first = std::make_shared<Producer>();
+  auto second = std::make_shared<Producer>();
+  auto consumer = std::make_shared<Consumer>(2);
+  first->connect(consumer);
+  second->connect(consumer);
+
+  first->send("a");
+  first->send("bb");
+  first->send("ccc");
+  second->send("dddd");
+
+  {
+    const auto edges = consumer->getEdgeStatuses();
+    ASSERT_EQ(2, edges.size());
+
+    const auto& from_first = edges.at(first.get());
+    EXPECT_EQ(3, from_first.num_messages);
+    EXPECT_EQ(3 * sizeof(std::string) + 6, from_first.num_bytes);
+    EXPECT_EQ(2, from_first.num_dropped);
+    EXPECT_EQ(0, from_first.num_consumed);
+
+    const auto& from_second = edges.at(second.get());
+    EXPECT_EQ(1, from_second.num_messages);
+    EXPECT_EQ(0, from_second.num_dropped);
+  }
+
+  ASSERT_EQ("ccc", *consumer->getNext());
+  ASSERT_EQ("dddd", *consumer->getNext());
+
+  {
+    const auto edges = consumer->getEdgeStatuses();
+    EXPECT_EQ(1, edges.at(first.get()).num_consumed);
+    EXPECT_EQ(1, edges.at(second.get()).num_consumed);
+
+    // Only the first item from each producer is timed, and "a" was dropped
+    EXPECT_EQ(0, edges.at(first.get()).num_timed);
+    EXPECT_EQ(1, edges.at(second.get()).num_timed);
+    EXPECT_GT(edges.at(second.get()).queue_latency, 0.);
+  }
+
+  first->disconnect(consumer);
+  const auto edges = consumer->getEdgeStatuses();
+  EXPECT_EQ(0, edges.count(first.get()));
+  EXPECT_EQ(1, edges.count(second.get()));
+}
+
+TEST(BufferedConsumer, latchedItemIsConsumedOnce)
+{
+  using Producer = ProducerPort<int>;
+  using Consumer = BufferedConsumerPort<int, Single, Latched>;
+
+  auto producer = std::make_shared<Producer>();
+  auto consumer = std::make_shared<Consumer>();
+  producer->connect(consumer);
+
+  producer->send(42);
+  ASSERT_EQ(42, *consumer->getNext());
+  ASSERT_EQ(42, *consumer->getNext());
+
+  EXPECT_EQ(1, consumer->getEdgeStatuses().at(producer.get()).num_consumed);
+}
@@ -5,6 +5,8 @@
 
 #include "gtest/gtest.h"
 
+#include <atomic>
+#include <chrono>
 #include <future>
 #include <thread>
 
@@ -186,4 +188,54 @@ TEST(CallbackConsumer, numTransactions)
   pusher.wait();
   ASSERT_EQ(value, promise.get_future().get());
   EXPECT_EQ(1, consumer->getStatus().num_transactions);
-}
\ No newline at end of file
+}
+TEST(CallbackConsumer, disconnectWaitsForSendInProgress)
+{
+  std::promise<void> receiving;
+  std::atomic<bool> received{false};
+
+  const auto consumer = std::make_shared<CallbackConsumerPort<int>>(
+    [&receiving, &received](int)
+    {
+      receiving.set_value();
+      std::this_thread::sleep_for(std::chrono::milliseconds{50});
+      received = true;
+    }
+  );
+
+  const auto producer = std::make_shared<ProducerPort<int>>();
+  producer->connect(consumer);
+
+  std::thread sender{[&producer] { producer->send(42); }};
+  receiving.get_future().wait();
+
+  producer->disconnect(consumer);
+  EXPECT_TRUE(received);
+  EXPECT_FALSE(producer->isConnected());
+
+  sender.join();
+}
+
+TEST(CallbackConsumer, callbackMayDisconnectItsProducer)
+{
+  const auto producer = std::make_shared<ProducerPort<int>>();
+  int num_received = 0;
+
+  const auto consumer = std::make_shared<CallbackConsumerPort<int>>(
+    [&producer, &num_received](int)
+    {
+      ++num_received;
+      producer->disconnect();
+    }
+  );
+
+  producer->connect(consumer);
+
+  const auto start = std::chrono::steady_clock::now();
+  producer->send(1);
+  producer->send(2);
+
+  EXPECT_LT(std::chrono::steady_clock::now() - start, ProducerPort<int>::quiesce_timeout);
+  EXPECT_EQ(1, num_received);
+  EXPECT_FALSE(consumer->isConnected());
+}
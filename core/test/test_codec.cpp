@@ -0,0 +1,181 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/codec.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <array>
+
+using namespace flow;
+
+namespace
+{
+struct Pose
+{
+  double x;
+  double y;
+  int64_t timestamp;
+};
+
+struct Detection
+{
+  std::string label;
+  float score;
+};
+
+struct RenamedPose
+{
+  double x;
+  double y;
+  int64_t timestamp;
+};
+}
+
+template<>
+struct flow::SchemaTag<Pose>
+{
+  static std::string name()
+  { return "Pose{float64 x; float64 y; int64 timestamp;}"; }
+};
+
+template<>
+struct flow::SchemaTag<RenamedPose>
+{
+  static std::string name()
+  { return "RenamedPose{float64 x; float64 y; int64 timestamp;}"; }
+};
+
+template<>
+struct flow::Codec<Detection>
+{
+  static constexpr uint32_t version = 2;
+
+  static std::string schema()
+  { return "Detection{string label; float score;}"; }
+
+  static void encode(const Detection& item, std::vector<std::byte>& buffer)
+  {
+    Codec<float>::encode(item.score, buffer);
+    Codec<std::string>::encode(item.label, buffer);
+  }
+
+  static Detection decode(const std::byte* data, const size_t size)
+  {
+    if (size < sizeof(float))
+    { throw std::invalid_argument{"Detection is truncated"}; }
+
+    return {Codec<std::string>::decode(data + sizeof(float), size - sizeof(float)), Codec<float>::decode(data, sizeof(float))};
+  }
+};
+
+TEST(Codec, trivialItemRoundTrip)
+{
+  const Pose pose{1.5, -2.5, 42};
+  std::vector<std::byte> buffer;
+  codec::encodeMessage(pose, buffer);
+
+  EXPECT_EQ(sizeof(CodecHeader) + sizeof(Pose), buffer.size());
+
+  const auto decoded = codec::decodeMessage<Pose>(buffer.data(), buffer.size());
+  EXPECT_EQ(1.5, decoded.x);
+  EXPECT_EQ(-2.5, decoded.y);
+  EXPECT_EQ(42, decoded.timestamp);
+}
+
+TEST(Codec, containersRoundTrip)
+{
+  const std::vector<float> values{1.f, 2.f, 3.f};
+  const std::string text = "superflow";
+  const std::array<int, 3> array{4, 5, 6};
+
+  std::vector<std::byte> buffer;
+  codec::encodeMessage(values, buffer);
+  EXPECT_EQ(values, codec::decodeMessage<std::vector<float>>(buffer.data(), buffer.size()));
+
+  buffer.clear();
+  codec::encodeMessage(text, buffer);
+  EXPECT_EQ(text, codec::decodeMessage<std::string>(buffer.data(), buffer.size()));
+
+  buffer.clear();
+  codec::encodeMessage(array, buffer);
+  EXPECT_EQ(array, (codec::decodeMessage<std::array<int, 3>>(buffer.data(), buffer.size())));
+}
+
+TEST(Codec, trivialTypesAreNamedByTheirSchemaTag)
+{
+  EXPECT_EQ("int32/4", Codec<int32_t>::schema());
+  EXPECT_EQ("uint8/1", Codec<uint8_t>::schema());
+  EXPECT_EQ("float64/8", Codec<double>::schema());
+  EXPECT_EQ("array<int32,3>/12", (Codec<std::array<int32_t, 3>>::schema()));
+  EXPECT_EQ("vector<float32/4>", Codec<std::vector<float>>::schema());
+  EXPECT_EQ("Pose{float64 x; float64 y; int64 timestamp;}/24", Codec<Pose>::schema());
+
+  // A struct without a SchemaTag fails to compile when it is used with the default Codec
+  EXPECT_TRUE(codec::has_schema_tag_v<Pose>);
+  EXPECT_FALSE(codec::has_schema_tag_v<Detection>);
+  EXPECT_FALSE((codec::has_schema_tag_v<std::array<Detection, 2>>));
+}
+
+TEST(Codec, contiguousItemsAreViewedInPlace)
+{
+  const std::vector<float> values{1.f, 2.f, 3.f};
+  const auto view = Codec<std::vector<float>>::view(values);
+
+  EXPECT_EQ(reinterpret_cast<const std::byte*>(values.data()), view.data);
+  EXPECT_EQ(3 * sizeof(float), view.size);
+
+  EXPECT_TRUE(codec::has_view_v<Pose>);
+  EXPECT_TRUE(codec::has_view_v<std::string>);
+  EXPECT_FALSE(codec::has_view_v<Detection>);
+}
+
+TEST(Codec, customCodecRoundTrip)
+{
+  std::vector<std::byte> buffer{std::byte{0xff}};
+  codec::encodeMessage(Detection{"car", 0.75f}, buffer);
+
+  const auto decoded = codec::decodeMessage<Detection>(buffer.data() + 1, buffer.size() - 1);
+  EXPECT_EQ("car", decoded.label);
+  EXPECT_EQ(0.75f, decoded.score);
+
+  CodecHeader header;
+  std::memcpy(&header, buffer.data() + 1, sizeof(header));
+  EXPECT_EQ(2, header.version);
+  EXPECT_EQ(codec::hashSchema(Codec<Detection>::schema()), header.schema_hash);
+  EXPECT_EQ(sizeof(float) + 3, header.payload_size);
+}
+
+TEST(Codec, otherSchemaIsRejected)
+{
+  std::vector<std::byte> buffer;
+  codec::encodeMessage(Pose{}, buffer);
+
+  EXPECT_THROW(codec::decodeMessage<RenamedPose>(buffer.data(), buffer.size()), std::invalid_argument);
+  EXPECT_THROW(codec::decodeMessage<std::vector<Pose>>(buffer.data(), buffer.size()), std::invalid_argument);
+}
+
+TEST(Codec, otherVersionIsRejected)
+{
+  std::vector<std::byte> buffer;
+  codec::encodeMessage(Detection{"car", 0.75f}, buffer);
+  reinterpret_cast<CodecHeader*>(buffer.data())->version = 1;
+
+  EXPECT_THROW(codec::decodeMessage<Detection>(buffer.data(), buffer.size()), std::invalid_argument);
+}
+
+TEST(Codec, corruptMessagesAreRejected)
+{
+  std::vector<std::byte> buffer;
+  codec::encodeMessage(Pose{}, buffer);
+
+  EXPECT_THROW(codec::decodeMessage<Pose>(buffer.data(), sizeof(CodecHeader) - 1), std::invalid_argument);
+  EXPECT_THROW(codec::decodeMessage<Pose>(buffer.data(), buffer.size() - 1), std::invalid_argument);
+
+  auto swapped = buffer;
+  std::reverse(swapped.begin(), swapped.begin() + sizeof(uint32_t));
+  EXPECT_THROW(codec::decodeMessage<Pose>(swapped.data(), swapped.size()), std::invalid_argument);
+
+  auto garbage = buffer;
+  garbage[0] = std::byte{0};
+  EXPECT_THROW(codec::decodeMessage<Pose>(garbage.data(), garbage.size()), std::invalid_argument);
+}
@@ -0,0 +1,72 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/utils/edge_counter.h"
+
+#include "gtest/gtest.h"
+
+using namespace flow;
+
+namespace
+{
+const Port* makeProducer(const int id)
+{ return reinterpret_cast<const Port*>(static_cast<uintptr_t>(id) * 64); }
+}
+
+TEST(EdgeCounter, timesEveryIntervalItem)
+{
+  EdgeCounter counter;
+  const auto* producer = makeProducer(1);
+  counter.add(producer);
+
+  for (uint64_t i = 0; i < 2 * EdgeCounter::timing_interval; ++i)
+  {
+    const auto stamp = counter.received(producer, 8);
+    EXPECT_EQ(i % EdgeCounter::timing_interval == 0, stamp > 0);
+
+    counter.consumed(producer, stamp);
+  }
+
+  const auto status = counter.get().at(producer);
+  EXPECT_EQ(2 * EdgeCounter::timing_interval, status.num_messages);
+  EXPECT_EQ(16 * EdgeCounter::timing_interval, status.num_bytes);
+  EXPECT_EQ(2 * EdgeCounter::timing_interval, status.num_consumed);
+  EXPECT_EQ(2, status.num_timed);
+  EXPECT_GE(status.queue_latency, 0.);
+}
+
+TEST(EdgeCounter, itemConsumedTwiceCountsOnce)
+{
+  EdgeCounter counter;
+  const auto* producer = makeProducer(1);
+
+  const auto timed = counter.received(producer, 1);
+  const auto untimed = counter.received(producer, 1);
+
+  counter.consumed(producer, timed);
+  counter.consumed(producer, timed);
+  counter.consumed(producer, untimed);
+  counter.consumed(producer, untimed);
+
+  const auto status = counter.get().at(producer);
+  EXPECT_EQ(2, status.num_consumed);
+  EXPECT_EQ(1, status.num_timed);
+}
+
+TEST(EdgeCounter, removedEdgeIsReusedFromZero)
+{
+  EdgeCounter counter;
+  const auto* first = makeProducer(1);
+  const auto* second = makeProducer(2);
+
+  (void)counter.received(first, 1);
+  counter.dropped(first);
+  counter.remove(first);
+  EXPECT_TRUE(counter.get().empty());
+
+  counter.add(second);
+  (void)counter.received(nullptr, 1);
+
+  const auto statuses = counter.get();
+  ASSERT_EQ(1, statuses.size());
+  EXPECT_EQ(0, statuses.at(second).num_messages);
+  EXPECT_EQ(0, statuses.at(second).num_dropped);
+}
@@ -1,6 +1,7 @@
 // Copyright 2019, Forsvarets forskningsinstitutt. All rights reserved.
 #include "gtest/gtest.h"
 #include "templated_testproxel.h"
+#include "superflow/callback_consumer_port.h"
 #include "superflow/graph.h"
 
 using namespace flow;
@@ -251,6 +252,50 @@ TEST(Graph, valuePropagates)
   ASSERT_EQ(value, proc_in->getValue());
 }
 
+TEST(Graph, edgeStatisticsCountItemsPerConnection)
+{
+  const std::string value{"forty-two"};
+  auto proc_out = std::make_shared<TemplatedProxel<std::string>>(value);
+  auto proc_in = std::make_shared<TemplatedProxel<std::string>>();
+  auto proc_reversed = std::make_shared<TemplatedProxel<std::string>>();
+
+  Graph flow{{{"out", proc_out}, {"in", proc_in}, {"reversed", proc_reversed}}};
+  flow.connect("out", "outport", "in", "inport");
+  flow.connect("reversed", "inport", "out", "outport");
+
+  flow.start();
+  flow.stop();
+  ASSERT_EQ(value, proc_in->getValue());
+
+  Graph::Sampler sampler;
+  const auto edges = flow.getEdgeStatistics(sampler);
+  ASSERT_EQ(2, edges.size());
+
+  for (const auto& edge : edges)
+  {
+    EXPECT_EQ(1, edge.status.num_messages);
+    EXPECT_EQ(sizeof(std::string) + value.size(), edge.status.num_bytes);
+    EXPECT_GT(edge.message_rate, 0.);
+  }
+
+  EXPECT_EQ("in", edges[0].connection.rhs_name);
+  EXPECT_EQ(1, edges[0].status.num_consumed);
+  EXPECT_EQ(1, edges[0].status.num_timed);
+  EXPECT_GT(edges[0].mean_queue_latency, 0.);
+  EXPECT_EQ(0, edges[1].status.num_consumed);
+
+  const auto later = flow.getEdgeStatistics(sampler);
+  ASSERT_EQ(2, later.size());
+  EXPECT_EQ(0., later[0].message_rate);
+  EXPECT_EQ(0., later[0].mean_queue_latency);
+  EXPECT_EQ(1, later[0].status.num_messages);
+
+  // Other pollers neither see nor move the window of `sampler`
+  const auto since_connected = flow.getEdgeStatistics();
+  EXPECT_GT(since_connected[0].message_rate, 0.);
+  EXPECT_GT(since_connected[0].mean_queue_latency, 0.);
+}
+
 TEST(Graph, connectToSelfThrows)
 {
   Graph flow(
@@ -361,4 +406,361 @@ TEST(Graph, handleExceptionWithExceptionPtr)
   {
     EXPECT_EQ(msg, e.what());
   }
-}
\ No newline at end of file
+}
+namespace
+{
+class ReactiveProxel : public Proxel
+{
+public:
+  ReactiveProxel()
+    : in_port_{std::make_shared<InPort>(
+        [this](const int& value)
+        {
+          value_ = value;
+          receive_thread_id_ = std::this_thread::get_id();
+        })}
+  {
+    registerPorts({{"inport", in_port_}});
+  }
+
+  void start() override
+  { start_thread_id_ = std::this_thread::get_id(); }
+
+  void stop() noexcept override
+  {}
+
+  int getValue() const
+  { return value_; }
+
+  std::thread::id getStartThreadId() const
+  { return start_thread_id_; }
+
+  std::thread::id getReceiveThreadId() const
+  { return receive_thread_id_; }
+
+private:
+  using InPort = CallbackConsumerPort<int>;
+
+  InPort::Ptr in_port_;
+  int value_ = 0;
+  std::thread::id start_thread_id_;
+  std::thread::id receive_thread_id_;
+};
+}
+
+TEST(Graph, fusedProxelsShareThread)
+{
+  TestProxel::Ptr proxel_A{std::make_shared<TestProxel>()};
+  TestProxel::Ptr proxel_B{std::make_shared<TestProxel>()};
+  TestProxel::Ptr proxel_C{std::make_shared<TestProxel>()};
+
+  Graph flow{{{"a", proxel_A}, {"b", proxel_B}, {"c", proxel_C}}};
+  flow.fuse("group", {"a", "b"});
+
+  flow.start();
+  flow.stop();
+
+  EXPECT_NE(std::thread::id{}, proxel_A->getThreadId());
+  EXPECT_NE(std::this_thread::get_id(), proxel_A->getThreadId());
+  EXPECT_EQ(proxel_A->getThreadId(), proxel_B->getThreadId());
+  EXPECT_NE(proxel_A->getThreadId(), proxel_C->getThreadId());
+  EXPECT_TRUE(proxel_A->stopWasCalled());
+  EXPECT_TRUE(proxel_B->stopWasCalled());
+}
+
+TEST(Graph, fusedConnectionIsSynchronous)
+{
+  constexpr int value{42};
+  auto head = std::make_shared<TemplatedProxel<int>>(value);
+  auto stage = std::make_shared<ReactiveProxel>();
+
+  Graph flow{{{"head", head}, {"stage", stage}}};
+  flow.connect("head", "outport", "stage", "inport");
+  flow.fuse("group", {"head", "stage"});
+
+  flow.start();
+  flow.stop();
+
+  EXPECT_EQ(value, stage->getValue());
+  EXPECT_EQ(stage->getStartThreadId(), stage->getReceiveThreadId());
+}
+
+TEST(Graph, fuseInvalidProxelsThrows)
+{
+  Graph flow{{{"a", std::make_shared<TestProxel>()}, {"b", std::make_shared<TestProxel>()}}};
+
+  EXPECT_THROW(flow.fuse("group", {}), std::invalid_argument);
+  EXPECT_THROW(flow.fuse("group", {"a", "nonexisting"}), std::invalid_argument);
+  EXPECT_THROW(flow.fuse("a", {"b"}), std::invalid_argument);
+
+  ASSERT_NO_THROW(flow.fuse("group", {"a", "b"}));
+  EXPECT_THROW(flow.fuse("other_group", {"a"}), std::invalid_argument);
+}
+
+namespace
+{
+class CountingProxel : public Proxel
+{
+public:
+  explicit CountingProxel(const int count)
+    : count_{count}
+  {
+    registerPorts({{"outport", out_port_}});
+  }
+
+  void start() override
+  {
+    for (int i = 0; i < count_; ++i)
+    { out_port_->send(i); }
+  }
+
+  void stop() noexcept override
+  {}
+
+private:
+  int count_;
+  std::shared_ptr<ProducerPort<int>> out_port_ = std::make_shared<ProducerPort<int>>();
+};
+
+class IncrementingProxel : public Proxel
+{
+public:
+  IncrementingProxel()
+  {
+    registerPorts({{"inport", in_port_}, {"outport", out_port_}});
+  }
+
+  void start() override
+  {
+    thread_id_ = std::this_thread::get_id();
+
+    for (int value; *in_port_ >> value;)
+    {
+      values_.push_back(value);
+      out_port_->send(value + 1);
+    }
+  }
+
+  void stop() noexcept override
+  { in_port_->deactivate(); }
+
+  /// Only read after the Graph is stopped
+  const std::vector<int>& getValues() const
+  { return values_; }
+
+  std::thread::id getThreadId() const
+  { return thread_id_; }
+
+  size_t getNumDropped() const
+  { return in_port_->getStatus().num_dropped; }
+
+private:
+  std::shared_ptr<BufferedConsumerPort<int>> in_port_ = std::make_shared<BufferedConsumerPort<int>>(1);
+  std::shared_ptr<ProducerPort<int>> out_port_ = std::make_shared<ProducerPort<int>>();
+  std::vector<int> values_;
+  std::thread::id thread_id_;
+};
+}
+
+TEST(Graph, fusedBufferedChainHandsOffEveryItem)
+{
+  constexpr int count = 1000;
+  auto head = std::make_shared<CountingProxel>(count);
+  auto stage = std::make_shared<IncrementingProxel>();
+  auto sink = std::make_shared<IncrementingProxel>();
+
+  Graph flow{{{"head", head}, {"stage", stage}, {"sink", sink}}};
+  flow.connect("head", "outport", "stage", "inport");
+  flow.connect("stage", "outport", "sink", "inport");
+  flow.fuse("chain", {"head", "stage", "sink"});
+
+  flow.start();
+
+  // The buffers hold a single item, so the stages would drop items if they ran behind
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+
+  while (flow.getProxelStatuses().at("sink").ports.at("inport").num_transactions < count
+         && std::chrono::steady_clock::now() < deadline)
+  { std::this_thread::sleep_for(std::chrono::milliseconds{1}); }
+
+  flow.stop();
+
+  ASSERT_EQ(count, sink->getValues().size());
+
+  for (int i = 0; i < count; ++i)
+  { ASSERT_EQ(i + 1, sink->getValues()[i]); }
+
+  EXPECT_EQ(0, stage->getNumDropped());
+  EXPECT_EQ(0, sink->getNumDropped());
+  EXPECT_EQ(stage->getThreadId(), sink->getThreadId());
+}
+
+TEST(Graph, crashInFusedGroupIsReported)
+{
+  TestProxel::Ptr proxel_A{std::make_shared<TestProxel>()};
+  TestProxel::Ptr proxel_B{std::make_shared<TestProxel>()};
+  proxel_B->setException("mayday");
+
+  Graph flow{{{"a", proxel_A}, {"b", proxel_B}}};
+  flow.fuse("group", {"a", "b"});
+
+  flow.start(true, Graph::quietCrashLogger);
+  flow.stop();
+
+  const auto statuses = flow.getProxelStatuses();
+  EXPECT_EQ(ProxelStatus::State::Crashed, statuses.at("b").state);
+  EXPECT_NE(std::thread::id{}, proxel_A->getThreadId());
+}
+
+namespace
+{
+class FlakyProxel : public Proxel
+{
+public:
+  explicit FlakyProxel(const int num_crashes)
+    : num_crashes_{num_crashes}
+  {}
+
+  void start() override
+  {
+    ++num_starts_;
+
+    if (num_starts_ <= num_crashes_)
+    { throw std::runtime_error("glitch"); }
+  }
+
+  void stop() noexcept override
+  {}
+
+  int getNumStarts() const
+  { return num_starts_; }
+
+private:
+  int num_crashes_;
+  std::atomic<int> num_starts_{0};
+};
+}
+
+TEST(Graph, crashedProxelIsRestartedWithBackoff)
+{
+  auto proxel = std::make_shared<FlakyProxel>(2);
+
+  Graph flow{{{"flaky", proxel}}};
+  flow.setRestartPolicy({3, std::chrono::milliseconds{1}, std::chrono::milliseconds{10}, 2.});
+
+  flow.start(true, Graph::quietCrashLogger);
+
+  for (int i = 0; i < 1000 && proxel->getNumStarts() < 3; ++i)
+  { std::this_thread::sleep_for(std::chrono::milliseconds{1}); }
+
+  flow.stop();
+
+  EXPECT_EQ(3, proxel->getNumStarts());
+
+  const auto status = flow.getProxelStatuses().at("flaky");
+  EXPECT_NE(ProxelStatus::State::Crashed, status.state);
+  EXPECT_EQ(2, status.num_restarts);
+  EXPECT_GE(status.mean_time_between_failures, 0.);
+}
+
+TEST(Graph, proxelStaysCrashedAfterMaxRestarts)
+{
+  auto proxel = std::make_shared<FlakyProxel>(10);
+
+  Graph flow{{{"flaky", proxel}}};
+  flow.setRestartPolicy({2, std::chrono::milliseconds{1}, std::chrono::milliseconds{1}, 1.});
+
+  flow.start(true, Graph::quietCrashLogger);
+
+  for (int i = 0; i < 1000 && proxel->getNumStarts() < 3; ++i)
+  { std::this_thread::sleep_for(std::chrono::milliseconds{1}); }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds{10});
+  flow.stop();
+
+  EXPECT_EQ(3, proxel->getNumStarts());
+
+  const auto status = flow.getProxelStatuses().at("flaky");
+  EXPECT_EQ(ProxelStatus::State::Crashed, status.state);
+  EXPECT_EQ(2, status.num_restarts);
+}
+
+namespace
+{
+/// Crashes once, and runs until stopped when restarted
+class RestartedProxel : public Proxel
+{
+public:
+  void start() override
+  {
+    if (++num_starts_ == 1)
+    { throw std::runtime_error("glitch"); }
+
+    while (num_stops_ == 0)
+    { std::this_thread::sleep_for(std::chrono::milliseconds{1}); }
+  }
+
+  void stop() noexcept override
+  { ++num_stops_; }
+
+  int getNumStarts() const
+  { return num_starts_; }
+
+  int getNumStops() const
+  { return num_stops_; }
+
+private:
+  std::atomic<int> num_starts_{0};
+  std::atomic<int> num_stops_{0};
+};
+}
+
+TEST(Graph, restartedProxelIsStoppedOnce)
+{
+  auto proxel = std::make_shared<RestartedProxel>();
+
+  Graph flow{{{"restarted", proxel}}};
+  flow.setRestartPolicy({1, std::chrono::milliseconds{1}, std::chrono::milliseconds{1}, 1.});
+
+  flow.start(true, Graph::quietCrashLogger);
+
+  for (int i = 0; i < 1000 && proxel->getNumStarts() < 2; ++i)
+  { std::this_thread::sleep_for(std::chrono::milliseconds{1}); }
+
+  const auto stop_start = std::chrono::steady_clock::now();
+  flow.stop();
+
+  EXPECT_EQ(2, proxel->getNumStarts());
+  EXPECT_EQ(1, proxel->getNumStops());
+  EXPECT_LT(std::chrono::steady_clock::now() - stop_start, std::chrono::seconds{1});
+}
+
+TEST(Graph, movedFromGraphIsEmpty)
+{
+  Graph flow{{{"flaky", std::make_shared<FlakyProxel>(0)}}};
+  Graph moved{std::move(flow)};
+
+  EXPECT_TRUE(flow.getProxelStatuses().empty());
+  EXPECT_NO_THROW(flow.start());
+  EXPECT_NO_THROW(flow.stop());
+  EXPECT_EQ(1, moved.getProxelStatuses().size());
+}
+
+TEST(Graph, stopInterruptsRestartBackoff)
+{
+  auto proxel = std::make_shared<FlakyProxel>(10);
+
+  Graph flow{{{"flaky", proxel}}};
+  flow.setRestartPolicy({5, std::chrono::hours{1}, std::chrono::hours{1}, 1.});
+
+  flow.start(true, Graph::quietCrashLogger);
+
+  for (int i = 0; i < 1000 && proxel->getNumStarts() < 1; ++i)
+  { std::this_thread::sleep_for(std::chrono::milliseconds{1}); }
+
+  const auto stop_start = std::chrono::steady_clock::now();
+  flow.stop();
+
+  EXPECT_LT(std::chrono::steady_clock::now() - stop_start, std::chrono::seconds{1});
+  EXPECT_EQ(1, proxel->getNumStarts());
+}
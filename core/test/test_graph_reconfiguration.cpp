@@ -0,0 +1,236 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "streaming_proxels.h"
+#include "templated_testproxel.h"
+#include "superflow/callback_consumer_port.h"
+#include "superflow/graph.h"
+
+#include "gtest/gtest.h"
+
+using namespace flow;
+
+namespace
+{
+/// Never reads its PushBlocking "inport", so that a producer blocks on it until it is stopped
+class StuckSinkProxel : public Proxel
+{
+public:
+  StuckSinkProxel()
+      : in_port_{std::make_shared<InPort>(1)}
+  {
+    registerPorts({{"inport", in_port_}});
+  }
+
+  void start() override
+  {
+    while (*in_port_)
+    { std::this_thread::sleep_for(std::chrono::milliseconds{1}); }
+  }
+
+  void stop() noexcept override
+  { in_port_->deactivate(); }
+
+private:
+  using InPort = BufferedConsumerPort<int, ConnectPolicy::Single, GetMode::Blocking, LeakPolicy::PushBlocking>;
+
+  InPort::Ptr in_port_;
+};
+
+/// Has an "inport" of another type than StreamSourceProxel sends
+class StringSinkProxel : public Proxel
+{
+public:
+  StringSinkProxel()
+  {
+    registerPorts({{"inport", std::make_shared<BufferedConsumerPort<std::string, ConnectPolicy::Multi>>()}});
+  }
+
+  void start() override
+  {}
+
+  void stop() noexcept override
+  {}
+};
+}
+
+TEST(GraphReconfiguration, connectionsAreRegistered)
+{
+  Graph graph{{{"source", std::make_shared<StreamSourceProxel>()}, {"sink", std::make_shared<StreamSinkProxel>()}}};
+  graph.connect("source", "outport", "sink", "inport");
+  graph.connect("source", "outport", "sink", "inport");
+
+  ASSERT_EQ(1, graph.getConnections().size());
+  EXPECT_EQ("source", graph.getConnections().front().lhs_name);
+  EXPECT_EQ("inport", graph.getConnections().front().rhs_port);
+
+  graph.disconnect("source", "outport", "sink", "inport");
+  EXPECT_TRUE(graph.getConnections().empty());
+  EXPECT_FALSE(graph.getProxel("sink")->getPort("inport")->isConnected());
+}
+
+TEST(GraphReconfiguration, disconnectMatchesEitherOrder)
+{
+  Graph graph{{{"source", std::make_shared<StreamSourceProxel>()}, {"sink", std::make_shared<StreamSinkProxel>()}}};
+  graph.connect("source", "outport", "sink", "inport");
+
+  graph.disconnect("sink", "inport", "source", "outport");
+  EXPECT_TRUE(graph.getConnections().empty());
+  EXPECT_FALSE(graph.getProxel("sink")->getPort("inport")->isConnected());
+}
+
+TEST(GraphReconfiguration, addWhileRunningStartsProxel)
+{
+  auto sink = std::make_shared<StreamSinkProxel>();
+  Graph graph{{{"sink", sink}}};
+  graph.start();
+
+  graph.add("source", std::make_shared<StreamSourceProxel>());
+  graph.connect("source", "outport", "sink", "inport");
+
+  EXPECT_TRUE(sink->waitForMore(10));
+  graph.stop();
+}
+
+TEST(GraphReconfiguration, removeWhileRunningKeepsRestOfGraphRunning)
+{
+  auto sink = std::make_shared<StreamSinkProxel>();
+  Graph graph{
+    {
+      {"source1", std::make_shared<StreamSourceProxel>()},
+      {"source2", std::make_shared<StreamSourceProxel>()},
+      {"sink", sink}
+    }
+  };
+  graph.connect("source1", "outport", "sink", "inport");
+  graph.connect("source2", "outport", "sink", "inport");
+  graph.start();
+
+  ASSERT_TRUE(sink->waitForMore(10));
+  graph.remove("source1");
+
+  EXPECT_EQ(1, graph.getConnections().size());
+  EXPECT_THROW(graph.getProxel("source1"), std::invalid_argument);
+  EXPECT_TRUE(sink->waitForMore(10));
+
+  graph.stop();
+}
+
+TEST(GraphReconfiguration, replaceWhileRunningKeepsConnections)
+{
+  auto old_sink = std::make_shared<StreamSinkProxel>();
+  auto new_sink = std::make_shared<StreamSinkProxel>();
+
+  Graph graph{{{"source", std::make_shared<StreamSourceProxel>()}, {"sink", old_sink}}};
+  graph.connect("source", "outport", "sink", "inport");
+  graph.start();
+
+  ASSERT_TRUE(old_sink->waitForMore(10));
+
+  const auto result = graph.replace("sink", new_sink);
+  const auto num_received_by_old = old_sink->getNumReceived();
+
+  EXPECT_GT(result.latency, Graph::Duration::zero());
+  EXPECT_FALSE(result.is_over_budget);
+  EXPECT_EQ(new_sink, graph.getProxel("sink"));
+  EXPECT_TRUE(new_sink->waitForMore(10));
+  EXPECT_EQ(num_received_by_old, old_sink->getNumReceived());
+
+  graph.stop();
+}
+
+TEST(GraphReconfiguration, replaceWithIncompatibleProxelThrows)
+{
+  auto sink = std::make_shared<StreamSinkProxel>();
+
+  Graph graph{{{"source", std::make_shared<StreamSourceProxel>()}, {"sink", sink}}};
+  graph.connect("source", "outport", "sink", "inport");
+
+  EXPECT_THROW(graph.replace("sink", std::make_shared<StreamSourceProxel>()), std::invalid_argument);
+  EXPECT_THROW(graph.replace("nonexisting", std::make_shared<StreamSinkProxel>()), std::invalid_argument);
+  EXPECT_EQ(sink, graph.getProxel("sink"));
+  EXPECT_EQ(1, graph.getConnections().size());
+}
+
+TEST(GraphReconfiguration, removeReleasesProducerBlockedOnFullPort)
+{
+  auto sink = std::make_shared<StuckSinkProxel>();
+  Graph graph{{{"source", std::make_shared<StreamSourceProxel>()}, {"sink", sink}}};
+  graph.connect("source", "outport", "sink", "inport");
+  graph.start();
+
+  // Let the source fill the buffer and block in send
+  std::this_thread::sleep_for(std::chrono::milliseconds{20});
+  graph.remove("sink");
+
+  EXPECT_TRUE(graph.getConnections().empty());
+  graph.stop();
+}
+
+TEST(GraphReconfiguration, replaceWithOtherPortTypeLeavesGraphUntouched)
+{
+  auto sink = std::make_shared<StreamSinkProxel>();
+
+  Graph graph{{{"source", std::make_shared<StreamSourceProxel>()}, {"sink", sink}}};
+  graph.connect("source", "outport", "sink", "inport");
+  graph.start();
+
+  ASSERT_TRUE(sink->waitForMore(10));
+  EXPECT_THROW(graph.replace("sink", std::make_shared<StringSinkProxel>()), std::invalid_argument);
+
+  EXPECT_EQ(sink, graph.getProxel("sink"));
+  EXPECT_EQ(1, graph.getConnections().size());
+  EXPECT_TRUE(sink->waitForMore(10));
+
+  graph.stop();
+}
+
+TEST(GraphReconfiguration, consumerMaySendOrDisconnectFromReceive)
+{
+  auto producer = std::make_shared<ProducerPort<int>>();
+  std::shared_ptr<CallbackConsumerPort<int>> consumer;
+  int num_received = 0;
+
+  consumer = std::make_shared<CallbackConsumerPort<int>>(
+    [&](const int item)
+    {
+      ++num_received;
+
+      if (item == 0)
+      { producer->send(1); }
+      else
+      { producer->disconnect(consumer); }
+    }
+  );
+
+  producer->connect(consumer);
+  producer->send(0);
+
+  EXPECT_EQ(2, num_received);
+  EXPECT_FALSE(producer->isConnected());
+}
+
+TEST(GraphReconfiguration, producerPortIsSafeToRewireWhileSending)
+{
+  auto producer = std::make_shared<ProducerPort<int>>();
+  auto consumer = std::make_shared<BufferedConsumerPort<int>>(16);
+
+  std::atomic<bool> done{false};
+  std::thread sender{
+    [&producer, &done]
+    {
+      for (int i = 0; !done; ++i)
+      { producer->send(i); }
+    }
+  };
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    producer->connect(consumer);
+    producer->disconnect(consumer);
+  }
+
+  done = true;
+  sender.join();
+
+  EXPECT_FALSE(producer->isConnected());
+  EXPECT_FALSE(consumer->isConnected());
+}
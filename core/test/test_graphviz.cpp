@@ -0,0 +1,74 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/utils/graphviz.h"
+
+#include "templated_testproxel.h"
+
+#include "gtest/gtest.h"
+
+using namespace flow;
+
+namespace
+{
+bool contains(const std::string& text, const std::string& part)
+{
+  return text.find(part) != std::string::npos;
+}
+}
+
+TEST(GraphViz, rendersConnections)
+{
+  const auto dot = GraphViz{{{"a", "out", "b", "in"}, {"c", {}, {}, {}}}}.employ();
+
+  EXPECT_TRUE(contains(dot, "digraph superflow {"));
+  EXPECT_TRUE(contains(dot, "  \"a\":\"out\" -> \"b\":\"in\"\n"));
+  EXPECT_TRUE(contains(dot, "  \"c\" [label="));
+  EXPECT_FALSE(contains(dot, "fillcolor"));
+}
+
+TEST(GraphViz, annotatesLiveGraph)
+{
+  Graph graph{{
+    {"source", std::make_shared<TemplatedProxel<int>>(42)},
+    {"sink", std::make_shared<TemplatedProxel<int>>()},
+    {"idle", std::make_shared<TemplatedProxel<int>>()}
+  }};
+  graph.connect("source", "outport", "sink", "inport");
+
+  graph.start();
+  graph.stop();
+
+  const auto dot = GraphViz{graph}.employ();
+
+  EXPECT_TRUE(contains(dot, "  \"idle\" [label="));
+  EXPECT_TRUE(contains(dot, "SINK\\n0% busy"));
+  EXPECT_TRUE(contains(dot, R"(style=filled, fillcolor="0.333 0.5 1.0")"));
+  EXPECT_TRUE(contains(dot, "  \"source\":\"outport\" -> \"sink\":\"inport\" [penwidth=5, label=\""));
+}
+
+TEST(GraphViz, quotesBridgeNames)
+{
+  const auto dot = GraphViz{{{"a.out->b.in", "out", "b", "in|put"}}}.employ();
+
+  EXPECT_TRUE(contains(dot, "  \"a.out->b.in\" [label=\"{{ } | A.OUT-\\>B.IN | { <out> out} }\"]\n"));
+  EXPECT_TRUE(contains(dot, "{ <in\\|put> in\\|put}"));
+  EXPECT_TRUE(contains(dot, "  \"a.out->b.in\":\"out\" -> \"b\":\"in|put\"\n"));
+}
+
+TEST(GraphViz, samplerKeepsItsOwnWindow)
+{
+  Graph graph{{
+    {"source", std::make_shared<TemplatedProxel<int>>(42)},
+    {"sink", std::make_shared<TemplatedProxel<int>>()}
+  }};
+  graph.connect("source", "outport", "sink", "inport");
+
+  graph.start();
+  graph.stop();
+
+  Graph::Sampler sampler;
+  (void)GraphViz{graph, sampler}.employ();
+  (void)GraphViz{graph}.employ();
+
+  // Nothing was sent since the previous rendering with `sampler`
+  EXPECT_TRUE(contains(GraphViz{graph, sampler}.employ(), "[penwidth=1, label=\"0/s\"]"));
+}
@@ -75,6 +75,28 @@ TEST(LockQueue, PopReturnsInsertedValue)
   EXPECT_EQ(val + 1, res);
 }
 
+TEST(LockQueue, KeepsOrderWhenGrowingAndWrappingAround)
+{
+  LockQueue<int> impl(3);
+
+  impl.push(0);
+  impl.push(1);
+  impl.push(2);
+  EXPECT_EQ(0, impl.pop());
+
+  // Leaky, so the oldest item is dropped when the queue is full
+  impl.push(3);
+  impl.push(4);
+  EXPECT_EQ(3u, impl.getQueueSize());
+  EXPECT_EQ(2, impl.pop());
+
+  impl.push(5);
+  EXPECT_EQ(3, impl.pop());
+  EXPECT_EQ(4, impl.pop());
+  EXPECT_EQ(5, impl.pop());
+  EXPECT_TRUE(impl.isEmpty());
+}
+
 TEST(LockQueue, PopDecreasesQueueSize)
 {
   LockQueue<int> impl(10);
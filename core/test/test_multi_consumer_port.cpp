@@ -308,4 +308,36 @@ TEST(MultiConsumer, numTransactions)
     ASSERT_EQ(i+1, consumer->getStatus().num_transactions);
     ASSERT_EQ(1, producers[i]->getStatus().num_transactions);
   }
-}
\ No newline at end of file
+}
+TEST(MultiConsumer, edgeStatusesArePerProducer)
+{
+  using Producer = ProducerPort<int>;
+  using Consumer = MultiConsumerPort<int, flow::GetMode::Latched>;
+
+  auto first = std::make_shared<Producer>();
+  auto second = std::make_shared<Producer>();
+  auto consumer = std::make_shared<Consumer>();
+  first->connect(consumer);
+  second->connect(consumer);
+
+  first->send(1);
+  first->send(2);
+  second->send(3);
+
+  ASSERT_EQ(2, consumer->get().size());
+  ASSERT_EQ(2, consumer->get().size());
+
+  const auto edges = consumer->getEdgeStatuses();
+  ASSERT_EQ(2, edges.size());
+
+  const auto& from_first = edges.at(first.get());
+  EXPECT_EQ(2, from_first.num_messages);
+  EXPECT_EQ(2 * sizeof(int), from_first.num_bytes);
+  EXPECT_EQ(1, from_first.num_dropped);
+  EXPECT_EQ(1, from_first.num_consumed);
+
+  const auto& from_second = edges.at(second.get());
+  EXPECT_EQ(1, from_second.num_messages);
+  EXPECT_EQ(0, from_second.num_dropped);
+  EXPECT_EQ(1, from_second.num_consumed);
+}
@@ -0,0 +1,200 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/graph.h"
+#include "superflow/perf_counters.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace flow;
+
+namespace
+{
+class SpinningProxel : public Proxel
+{
+public:
+  void start() override
+  {
+    while (!stopped_)
+    {}
+  }
+
+  void stop() noexcept override
+  {
+    stopped_ = true;
+  }
+
+private:
+  std::atomic<bool> stopped_{false};
+};
+
+/// Spins until it is told to idle
+class PausingProxel : public Proxel
+{
+public:
+  void start() override
+  {
+    while (!paused_ && !stopped_)
+    {}
+
+    std::unique_lock lock{mutex_};
+    cv_.wait(lock, [this] { return stopped_.load(); });
+  }
+
+  void stop() noexcept override
+  {
+    {
+      std::scoped_lock lock{mutex_};
+      stopped_ = true;
+    }
+    cv_.notify_all();
+  }
+
+  void pause()
+  { paused_ = true; }
+
+private:
+  std::atomic<bool> paused_{false};
+  std::atomic<bool> stopped_{false};
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+/// Spins for a while, and returns
+class FinishingProxel : public Proxel
+{
+public:
+  void start() override
+  {
+    const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds{20};
+
+    while (std::chrono::steady_clock::now() < end)
+    {}
+
+    finished_ = true;
+  }
+
+  void stop() noexcept override
+  {}
+
+  bool isFinished() const
+  { return finished_; }
+
+private:
+  std::atomic<bool> finished_{false};
+};
+}
+
+TEST(PerfCounters, ratesFromSamples)
+{
+  using namespace std::chrono_literals;
+
+  PerfCounters::Sample previous{std::chrono::steady_clock::time_point{1s}, {}};
+  PerfCounters::Sample current{std::chrono::steady_clock::time_point{3s}, {}};
+  current.values[PerfCounters::Cycles] = 4000;
+  current.values[PerfCounters::Instructions] = 2000;
+  current.values[PerfCounters::PageFaults] = 10;
+  current.values[PerfCounters::TaskClock] = 1'000'000'000;
+
+  const auto rates = PerfCounters::getRates(previous, current, true);
+  EXPECT_DOUBLE_EQ(2000., rates.cycles);
+  EXPECT_DOUBLE_EQ(1000., rates.instructions);
+  EXPECT_DOUBLE_EQ(5., rates.page_faults);
+  EXPECT_DOUBLE_EQ(0.5, rates.cpu_utilization);
+  EXPECT_DOUBLE_EQ(0.5, rates.getInstructionsPerCycle());
+  EXPECT_TRUE(rates.hardware);
+
+  EXPECT_EQ(0., PerfCounters::getRates(current, current, true).cycles);
+}
+
+TEST(PerfCounters, countersOfCurrentThread)
+{
+  const PerfCounters counters;
+
+  if (!counters.isAvailable())
+  { GTEST_SKIP() << "perf_event_open is not permitted"; }
+
+  const auto before = counters.read();
+
+  volatile double sum = 0.;
+  for (int i = 0; i < 1'000'000; ++i)
+  { sum = sum + i; }
+
+  const auto after = counters.read();
+  EXPECT_GT(after.values[PerfCounters::TaskClock], before.values[PerfCounters::TaskClock]);
+
+  if (counters.hasHardwareCounters())
+  { EXPECT_GT(after.values[PerfCounters::Instructions], before.values[PerfCounters::Instructions]); }
+}
+
+TEST(PerfCounters, graphReportsRates)
+{
+  if (!PerfCounters{}.isAvailable())
+  { GTEST_SKIP() << "perf_event_open is not permitted"; }
+
+  Graph graph{{{"spinner", std::make_shared<SpinningProxel>()}}};
+  graph.enablePerfCounters();
+  graph.start();
+
+  std::this_thread::sleep_for(std::chrono::milliseconds{50});
+
+  const auto perf = graph.getProxelStatuses().at("spinner").perf;
+  EXPECT_GT(perf.cpu_utilization, 0.);
+
+  graph.stop();
+  EXPECT_EQ(0., graph.getProxelStatuses().at("spinner").perf.cpu_utilization);
+}
+
+TEST(PerfCounters, exitedThreadsAreForgotten)
+{
+  if (!PerfCounters{}.isAvailable())
+  { GTEST_SKIP() << "perf_event_open is not permitted"; }
+
+  auto proxel = std::make_shared<FinishingProxel>();
+  Graph graph{{{"proxel", proxel}}};
+  graph.enablePerfCounters();
+  graph.start();
+
+  bool forgotten = false;
+
+  for (int i = 0; i < 1000 && !forgotten; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    forgotten = proxel->isFinished() && graph.getProxelStatuses().at("proxel").perf.cpu_utilization == 0.;
+  }
+
+  EXPECT_TRUE(forgotten);
+  graph.stop();
+}
+
+TEST(PerfCounters, samplersKeepSeparateWindows)
+{
+  if (!PerfCounters{}.isAvailable())
+  { GTEST_SKIP() << "perf_event_open is not permitted"; }
+
+  auto proxel = std::make_shared<PausingProxel>();
+  Graph graph{{{"proxel", proxel}}};
+  graph.enablePerfCounters();
+  graph.start();
+
+  Graph::Sampler slow;
+  Graph::Sampler fast;
+
+  std::this_thread::sleep_for(std::chrono::milliseconds{20});
+  (void)graph.getProxelStatuses(slow);
+  std::this_thread::sleep_for(std::chrono::milliseconds{50});
+  proxel->pause();
+  (void)graph.getProxelStatuses(fast);
+  std::this_thread::sleep_for(std::chrono::milliseconds{50});
+
+  // The window of `slow` covers the spinning, even though `fast` sampled in between
+  const auto idle = graph.getProxelStatuses(fast).at("proxel").perf;
+  const auto busy = graph.getProxelStatuses(slow).at("proxel").perf;
+  EXPECT_GT(busy.cpu_utilization, idle.cpu_utilization);
+
+  graph.stop();
+}
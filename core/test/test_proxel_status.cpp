@@ -1,8 +1,13 @@
 // Copyright 2019, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/buffered_consumer_port.h"
+#include "superflow/producer_port.h"
 #include "superflow/proxel.h"
+#include "superflow/utils/proxel_timer.h"
 
 #include "gtest/gtest.h"
 
+#include <thread>
+
 using namespace flow;
 
 class MyProxel : public Proxel
@@ -86,3 +91,115 @@ TEST(ProxelStatus, setStatusInfo_works_from_ctor)
   proxel.pushStatusInfo(other_info);
   ASSERT_EQ(proxel.getStatus().info, other_info);
 }
+
+namespace
+{
+class FieldProxel : public Proxel
+{
+public:
+  FieldProxel()
+    : items{addStatusCounter("items")}
+    , queue{addStatusGauge("queue")}
+  {
+    addStatusTimer("processing", timer);
+  }
+
+  void start() override {};
+
+  void stop() noexcept override {};
+
+  void useFormatter()
+  {
+    setStatusInfoFormatter([this]() { return "items: " + std::to_string(items.get()); });
+  }
+
+  void addDuplicate()
+  {
+    addStatusGauge("items");
+  }
+
+  StatusCounter& items;
+  StatusGauge& queue;
+  ProxelTimer timer;
+};
+}
+
+TEST(ProxelStatus, status_fields_are_read_when_requested)
+{
+  FieldProxel proxel;
+  ++proxel.items;
+  proxel.items.increment(2);
+  proxel.queue.set(1.5);
+
+  const auto status = proxel.getStatus();
+  ASSERT_EQ(8, status.fields.size());
+  EXPECT_EQ(StatusField::Type::Counter, status.fields.at("items").type);
+  EXPECT_EQ(3., status.fields.at("items").value);
+  EXPECT_EQ(StatusField::Type::Gauge, status.fields.at("queue").type);
+  EXPECT_EQ(1.5, status.fields.at("queue").value);
+  EXPECT_EQ(0., status.fields.at("processing.runs").value);
+
+  proxel.timer.start();
+  proxel.timer.stop();
+  EXPECT_EQ(1., proxel.getStatus().fields.at("processing.runs").value);
+}
+
+TEST(ProxelStatus, status_fields_are_formatted_as_info)
+{
+  FieldProxel proxel;
+  proxel.items.increment(7);
+
+  const auto info = proxel.getStatus().info;
+  EXPECT_NE(std::string::npos, info.find("items: 7\n"));
+  EXPECT_NE(std::string::npos, info.find("queue: 0.000"));
+
+  proxel.useFormatter();
+  EXPECT_EQ("items: 7", proxel.getStatus().info);
+}
+
+TEST(ProxelStatus, duplicate_status_field_throws)
+{
+  FieldProxel proxel;
+  EXPECT_THROW(proxel.addDuplicate(), std::invalid_argument);
+}
+
+namespace
+{
+class ConsumingProxel : public Proxel
+{
+public:
+  ConsumingProxel()
+  {
+    registerPorts({{"in", input_}});
+  }
+
+  void start() override {};
+
+  void stop() noexcept override {};
+
+  std::shared_ptr<BufferedConsumerPort<int>> input_ = std::make_shared<BufferedConsumerPort<int>>(2);
+};
+}
+
+TEST(ProxelStatus, busyness_is_measured_by_consumer_ports)
+{
+  using namespace std::chrono_literals;
+
+  ConsumingProxel proxel;
+  auto producer = std::make_shared<ProducerPort<int>>();
+  producer->connect(proxel.input_);
+
+  EXPECT_EQ(0., proxel.getStatus().busyness);
+
+  producer->send(1);
+  producer->send(2);
+
+  (void)proxel.input_->getNext();
+  std::this_thread::sleep_for(5ms);
+  (void)proxel.input_->getNext();
+
+  const auto status = proxel.getStatus();
+  EXPECT_LT(0.5, status.busyness);
+  EXPECT_LE(status.busyness, 1.);
+  EXPECT_LE(4e-3, status.processing_time);
+}
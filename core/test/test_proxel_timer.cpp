@@ -1,5 +1,6 @@
 // Copyright 2019, Forsvarets forskningsinstitutt. All rights reserved.
 #include "superflow/utils/proxel_timer.h"
+#include "superflow/utils/windowed_histogram.h"
 
 #include "gtest/gtest.h"
 
@@ -105,3 +106,114 @@ TEST(ProxelTimer, get_status_info)
   EXPECT_NO_FATAL_FAILURE(info = timer.getStatusInfo());
   EXPECT_EQ(info.back(), '0');
 }
+
+TEST(ProxelTimer, window_statistics)
+{
+  using namespace std::chrono_literals;
+  ProxelTimer timer;
+
+  EXPECT_EQ(0, timer.getWindowStatistics(1s).count);
+
+  for (int i = 0; i < 3; ++i)
+  {
+    timer.start();
+    std::this_thread::sleep_for(1ms);
+    timer.stop();
+  }
+
+  const auto statistics = timer.getWindowStatistics(10s);
+  EXPECT_EQ(3, statistics.count);
+  EXPECT_LE(0.8e-3, statistics.mean);
+  EXPECT_LE(statistics.mean, statistics.max);
+  EXPECT_LE(0.8e-3, statistics.p99);
+  EXPECT_LE(statistics.p99, statistics.max);
+
+  EXPECT_THROW((void)timer.getWindowStatistics(0s), std::invalid_argument);
+  EXPECT_THROW((void)timer.getWindowStatistics(61s), std::invalid_argument);
+}
+
+TEST(ProxelTimer, percentile_processing_time)
+{
+  using namespace std::chrono_literals;
+  ProxelTimer timer;
+  EXPECT_EQ(0., timer.getPercentileProcessingTime(0.99));
+
+  timer.start();
+  std::this_thread::sleep_for(2ms);
+  const auto elapsed = timer.stop();
+
+  EXPECT_NEAR(elapsed, timer.getPercentileProcessingTime(0.5), 0.125 * elapsed);
+}
+
+TEST(ProxelTimer, ewma_busyness_follows_recent_load)
+{
+  using namespace std::chrono_literals;
+  ProxelTimer timer{10ms};
+  EXPECT_EQ(0., timer.getBusyness());
+
+  for (int i = 0; i < 20; ++i)
+  {
+    timer.start();
+    std::this_thread::sleep_for(1ms);
+    timer.stop();
+  }
+
+  EXPECT_LT(0.5, timer.getBusyness());
+
+  std::this_thread::sleep_for(50ms);
+  EXPECT_GT(0.2, timer.getBusyness());
+
+  EXPECT_THROW(ProxelTimer{0s}, std::invalid_argument);
+}
+
+TEST(WindowedHistogram, old_seconds_leave_the_window)
+{
+  using namespace std::chrono_literals;
+  WindowedHistogram histogram;
+  const WindowedHistogram::Clock::time_point t0{100s};
+
+  histogram.record(t0, 1ms);
+  histogram.record(t0 + 5s, 2ms);
+  histogram.record(t0 + 70s, 3ms);
+
+  EXPECT_EQ(1, histogram.getWindow(t0 + 70s, 1s).getCount());
+  EXPECT_EQ(3, histogram.getTotal().getCount());
+  EXPECT_DOUBLE_EQ(3e-3, histogram.getTotal().getMax());
+
+  histogram.record(t0 + 71s, 1ms);
+  EXPECT_EQ(2, histogram.getWindow(t0 + 71s, 10s).getCount());
+  EXPECT_DOUBLE_EQ(3e-3, histogram.getWindow(t0 + 71s, 10s).getMax());
+}
+
+TEST(WindowedHistogram, short_windows_have_a_resolution_of_one_second)
+{
+  using namespace std::chrono_literals;
+  WindowedHistogram histogram;
+  const WindowedHistogram::Clock::time_point t0{100s};
+
+  histogram.record(t0, 1ms);
+  histogram.record(t0 + 3s, 2ms);
+  histogram.record(t0 + 5s, 3ms);
+
+  EXPECT_EQ(1, histogram.getWindow(t0 + 5s, 1s).getCount());
+  EXPECT_EQ(2, histogram.getWindow(t0 + 5s, 2s).getCount());
+  EXPECT_EQ(3, histogram.getWindow(t0 + 5s, 5s).getCount());
+
+  // Longer windows are counted in slots of ten seconds
+  EXPECT_EQ(3, histogram.getWindow(t0 + 15s, 11s).getCount());
+  EXPECT_EQ(0, histogram.getWindow(t0 + 25s, 11s).getCount());
+  EXPECT_EQ(3, histogram.getWindow(t0 + 25s, 60s).getCount());
+}
+
+TEST(WindowedHistogram, slots_are_allocated_by_the_first_record)
+{
+  using namespace std::chrono_literals;
+  WindowedHistogram histogram;
+  const WindowedHistogram::Clock::time_point t0{100s};
+
+  EXPECT_GT(2048u, sizeof(WindowedHistogram));
+  EXPECT_EQ(0, histogram.getWindow(t0, 10s).getCount());
+
+  histogram.record(t0, 1ms);
+  EXPECT_EQ(1, histogram.getWindow(t0, 10s).getCount());
+}
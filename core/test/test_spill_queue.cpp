@@ -0,0 +1,209 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/buffered_consumer_port.h"
+#include "superflow/producer_port.h"
+#include "superflow/utils/spill_file.h"
+#include "superflow/utils/spill_queue.h"
+
+#include "gtest/gtest.h"
+
+#include <future>
+#include <string>
+
+using namespace flow;
+
+namespace
+{
+ByteView toView(const std::string& text)
+{ return {reinterpret_cast<const std::byte*>(text.data()), text.size()}; }
+
+std::string toString(const ByteView view)
+{ return {reinterpret_cast<const char*>(view.data), view.size}; }
+
+Traced<std::string> makeItem(const std::string& text)
+{ return {text, {}, nullptr, {}}; }
+
+/// Has no view, so it is encoded when spilled, and fails to decode when `is_valid` is false
+struct Checked
+{
+  int value;
+  bool is_valid;
+};
+}
+
+template<>
+struct flow::Codec<Checked>
+{
+  static constexpr uint32_t version = 0;
+
+  static std::string schema()
+  { return "Checked"; }
+
+  static void encode(const Checked& item, std::vector<std::byte>& buffer)
+  { Codec<std::string>::encode((item.is_valid ? "+" : "-") + std::to_string(item.value), buffer); }
+
+  static Checked decode(const std::byte* data, const size_t size)
+  {
+    const auto text = Codec<std::string>::decode(data, size);
+
+    if (text.front() != '+')
+    { throw std::invalid_argument{"Codec<Checked>: invalid item " + text}; }
+
+    return {std::stoi(text.substr(1)), true};
+  }
+};
+
+TEST(SpillFile, recordsWrapAroundInOrder)
+{
+  SpillFile file{"", 256};
+  size_t next_pop = 0;
+  size_t next_push = 0;
+
+  for (int round = 0; round < 50; ++round)
+  {
+    while (file.push(toView("header-"), toView(std::string(next_push % 37, 'x') + std::to_string(next_push))))
+    { ++next_push; }
+
+    ASSERT_GT(file.getNumRecords(), 0);
+    ASSERT_LE(file.getSize(), file.getMaxSize());
+
+    for (int i = 0; i < 2 && !file.isEmpty(); ++i)
+    {
+      EXPECT_EQ("header-" + std::string(next_pop % 37, 'x') + std::to_string(next_pop), toString(file.front()));
+      file.pop();
+      ++next_pop;
+    }
+  }
+
+  while (!file.isEmpty())
+  {
+    EXPECT_EQ("header-" + std::string(next_pop % 37, 'x') + std::to_string(next_pop), toString(file.front()));
+    file.pop();
+    ++next_pop;
+  }
+
+  EXPECT_EQ(next_push, next_pop);
+  EXPECT_EQ(0, file.getSize());
+  EXPECT_THROW(file.pop(), std::out_of_range);
+}
+
+TEST(SpillFile, invalidArgumentsThrow)
+{
+  EXPECT_THROW((SpillFile{"", 8}), std::invalid_argument);
+  EXPECT_THROW((SpillFile{"/nonexistent/superflow", 4096}), std::runtime_error);
+
+  // More than any disk holds, so the budget cannot be reserved
+  EXPECT_THROW((SpillFile{"", size_t{1} << 60}), std::runtime_error);
+
+  SpillFile file{"", 64};
+  EXPECT_FALSE(file.push(toView(std::string(64, 'x')), {}));
+  EXPECT_TRUE(file.isEmpty());
+}
+
+TEST(SpillQueue, itemsLeaveInOrderAcrossMemoryAndDisk)
+{
+  SpillQueue<std::string> queue{4};
+
+  for (int i = 0; i < 100; ++i)
+  { EXPECT_FALSE(queue.push(makeItem(std::to_string(i))).has_value()); }
+
+  EXPECT_EQ(100, queue.getQueueSize());
+  EXPECT_EQ(96, queue.getNumSpilled());
+  EXPECT_LT(0, queue.getSpilledBytes());
+
+  for (int i = 0; i < 50; ++i)
+  { EXPECT_EQ(std::to_string(i), queue.pop().item); }
+
+  queue.push(makeItem("100"));
+
+  for (int i = 50; i <= 100; ++i)
+  { EXPECT_EQ(std::to_string(i), queue.pop().item); }
+
+  EXPECT_TRUE(queue.isEmpty());
+  EXPECT_EQ(0, queue.getSpilledBytes());
+  EXPECT_EQ(0, queue.getNumDropped());
+}
+
+TEST(SpillQueue, newestItemIsDroppedWhenBudgetIsUsedUp)
+{
+  SpillQueue<int> queue{1, {"", 256}};
+  size_t num_pushed = 0;
+
+  while (!queue.push({static_cast<int>(num_pushed), {}, nullptr, {}}))
+  { ++num_pushed; }
+
+  EXPECT_EQ(num_pushed, queue.getQueueSize());
+  EXPECT_EQ(1, queue.getNumDropped());
+
+  for (size_t i = 0; i < num_pushed; ++i)
+  { EXPECT_EQ(static_cast<int>(i), queue.pop().item); }
+}
+
+TEST(SpillQueue, itemThatCannotBeUnspilledIsDropped)
+{
+  SpillQueue<Checked> queue{1};
+
+  for (const auto& item : {Checked{0, true}, Checked{1, false}, Checked{2, false}, Checked{3, true}})
+  { EXPECT_FALSE(queue.push({item, {}, nullptr, {}}).has_value()); }
+
+  EXPECT_EQ(3, queue.getNumSpilled());
+  EXPECT_EQ(0, queue.pop().item.value);
+  EXPECT_EQ(2, queue.getNumDropped());
+  EXPECT_EQ(1, queue.getQueueSize());
+  EXPECT_EQ(3, queue.pop().item.value);
+  EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(SpillQueue, spilledItemsKeepTheirMetadata)
+{
+  SpillQueue<std::string> queue{1};
+  const uint64_t trace_id = 42;
+  const int64_t stamp = -7;
+  const auto sender = reinterpret_cast<const Port*>(&queue);
+
+  queue.push(makeItem("in memory"));
+  queue.push({"on disk", trace_id, sender, stamp});
+  queue.pop();
+
+  const auto item = queue.pop();
+  EXPECT_EQ("on disk", item.item);
+  EXPECT_EQ(trace_id, item.trace_id);
+  EXPECT_EQ(sender, item.sender);
+  EXPECT_EQ(stamp, item.stamp);
+}
+
+TEST(SpillQueue, terminateReleasesWaitingConsumer)
+{
+  SpillQueue<int> queue{1};
+  auto popping = std::async(std::launch::async, [&queue]() { return queue.pop(); });
+
+  queue.terminate();
+  EXPECT_THROW(popping.get(), TerminatedException);
+  EXPECT_THROW(queue.push({1, {}, nullptr, {}}), TerminatedException);
+}
+
+TEST(BufferedConsumer, spillingPortKeepsBurstAndReportsIt)
+{
+  using Producer = ProducerPort<std::string>;
+  using Consumer = BufferedConsumerPort<std::string, ConnectPolicy::Single, GetMode::Blocking, LeakPolicy::Spill>;
+
+  auto producer = std::make_shared<Producer>();
+  auto consumer = std::make_shared<Consumer>(2, SpillOptions{"", size_t{1} << 20});
+  producer->connect(consumer);
+
+  for (int i = 0; i < 100; ++i)
+  { producer->send(std::to_string(i)); }
+
+  auto status = consumer->getStatus();
+  EXPECT_EQ(100, status.queue_size);
+  EXPECT_EQ(0, status.num_dropped);
+  EXPECT_EQ(98, status.num_spilled);
+  EXPECT_LT(0, status.spilled_bytes);
+
+  for (int i = 0; i < 100; ++i)
+  { EXPECT_EQ(std::to_string(i), consumer->getNext()); }
+
+  status = consumer->getStatus();
+  EXPECT_EQ(0, status.queue_size);
+  EXPECT_EQ(0, status.spilled_bytes);
+  EXPECT_EQ(100, consumer->getEdgeStatuses().at(producer.get()).num_consumed);
+}
@@ -0,0 +1,90 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/graph.h"
+#include "superflow/thread_statistics.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace flow;
+
+namespace
+{
+class SpinningProxel : public Proxel
+{
+public:
+  void start() override
+  {
+    while (!stopped_)
+    { std::this_thread::yield(); }
+  }
+
+  void stop() noexcept override
+  {
+    stopped_ = true;
+  }
+
+private:
+  std::atomic<bool> stopped_{false};
+};
+
+void spinFor(const std::chrono::milliseconds duration)
+{
+  const auto end = std::chrono::steady_clock::now() + duration;
+
+  while (std::chrono::steady_clock::now() < end)
+  {}
+}
+}
+
+#ifdef __linux__
+TEST(ThreadStatistics, readCurrentThread)
+{
+  const auto thread_id = getCurrentThreadId();
+  ASSERT_GT(thread_id, 0);
+
+  spinFor(std::chrono::milliseconds{50});
+
+  const auto statistics = readThreadStatistics(thread_id);
+  ASSERT_TRUE(statistics.has_value());
+  EXPECT_EQ(thread_id, statistics->thread_id);
+  EXPECT_GT(statistics->cpu_time, 0.);
+  EXPECT_TRUE(statistics->runnable);
+}
+
+TEST(ThreadStatistics, graphReportsProxelThreads)
+{
+  Graph graph{{
+    {"a", std::make_shared<SpinningProxel>()},
+    {"b", std::make_shared<SpinningProxel>()}
+  }};
+
+  graph.start();
+  std::this_thread::sleep_for(std::chrono::milliseconds{50});
+
+  const auto statuses = graph.getProxelStatuses();
+  const auto& a = statuses.at("a").thread;
+  const auto& b = statuses.at("b").thread;
+
+  EXPECT_GT(a.thread_id, 0);
+  EXPECT_GT(b.thread_id, 0);
+  EXPECT_NE(a.thread_id, b.thread_id);
+  EXPECT_NE(getCurrentThreadId(), a.thread_id);
+  EXPECT_GT(a.cpu_time, 0.);
+
+  EXPECT_GE(graph.getOversubscription(), 0.);
+  EXPECT_LE(graph.getOversubscription(), 2.);
+
+  graph.stop();
+  EXPECT_EQ(0., graph.getOversubscription());
+  EXPECT_EQ(0, graph.getProxelStatuses().at("a").thread.thread_id);
+}
+#endif
+
+TEST(ThreadStatistics, unknownThreadHasNoStatistics)
+{
+  EXPECT_FALSE(readThreadStatistics(0).has_value());
+  EXPECT_GE(getNumAvailableCores(), 1u);
+}
@@ -0,0 +1,141 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "streaming_proxels.h"
+#include "superflow/buffered_consumer_port.h"
+#include "superflow/graph.h"
+#include "superflow/producer_port.h"
+#include "superflow/timeline.h"
+#include "superflow/utils/proxel_timer.h"
+
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <thread>
+
+using namespace flow;
+
+namespace
+{
+size_t countOccurrences(const std::string& text, const std::string& pattern)
+{
+  size_t count = 0;
+
+  for (auto pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1))
+  { ++count; }
+
+  return count;
+}
+
+std::string writeTimeline()
+{
+  std::ostringstream ss;
+  timeline::writeChromeTrace(ss);
+
+  return ss.str();
+}
+
+struct TimelineTest : public ::testing::Test
+{
+  void TearDown() override
+  { timeline::disable(); }
+};
+}
+
+TEST_F(TimelineTest, nothingIsRecordedWhenDisabled)
+{
+  timeline::enable();
+  timeline::disable();
+
+  ProxelTimer timer;
+  timer.start();
+  timer.stop();
+
+  const auto json = writeTimeline();
+  EXPECT_EQ(0, countOccurrences(json, R"("ph":"X")"));
+  EXPECT_EQ(0, json.find(R"({"displayTimeUnit":"ms","traceEvents":[)"));
+}
+
+TEST_F(TimelineTest, timerAndPortsRecordSpans)
+{
+  timeline::enable();
+
+  auto producer = std::make_shared<ProducerPort<int>>();
+  auto consumer = std::make_shared<BufferedConsumerPort<int, ConnectPolicy::Single, GetMode::Blocking, LeakPolicy::PushBlocking>>();
+  producer->connect(consumer);
+
+  std::thread worker{[&consumer]
+                     {
+                       timeline::setThreadName("worker \"1\"");
+                       ProxelTimer timer;
+
+                       for (int i = 0; i < 2; ++i)
+                       {
+                         ASSERT_TRUE(consumer->getNext().has_value());
+                         timer.start();
+                         timer.stop();
+                       }
+                     }};
+
+  producer->send(1);
+  producer->send(2);
+  worker.join();
+
+  const auto json = writeTimeline();
+  EXPECT_EQ(2, countOccurrences(json, R"("name":"running")"));
+  EXPECT_EQ(2, countOccurrences(json, R"("name":"waiting")"));
+  EXPECT_EQ(2, countOccurrences(json, R"("name":"blocked")"));
+  EXPECT_NE(std::string::npos, json.find(R"("args":{"name":"worker \"1\""})"));
+}
+
+TEST_F(TimelineTest, ringKeepsMostRecentSpans)
+{
+  timeline::enable(4);
+
+  std::thread{[]
+              {
+                for (int i = 0; i < 10; ++i)
+                {
+                  const auto begin = timeline::now();
+                  timeline::record(timeline::Activity::Running, begin, timeline::now());
+                }
+              }}.join();
+
+  EXPECT_EQ(4, countOccurrences(writeTimeline(), R"("ph":"X")"));
+}
+
+TEST_F(TimelineTest, ringsOfExitedThreadsAreReused)
+{
+  timeline::enable();
+
+  for (const auto* name : {"first", "second"})
+  {
+    std::thread{[name]
+                {
+                  timeline::setThreadName(name);
+                  const auto begin = timeline::now();
+                  timeline::record(timeline::Activity::Running, begin, timeline::now());
+                }}.join();
+  }
+
+  const auto json = writeTimeline();
+  EXPECT_EQ(std::string::npos, json.find(R"("args":{"name":"first"})"));
+  EXPECT_NE(std::string::npos, json.find(R"("args":{"name":"second"})"));
+}
+
+TEST_F(TimelineTest, graphNamesThreadsAfterProxels)
+{
+  auto sink = std::make_shared<StreamSinkProxel>();
+  Graph graph{{{"source", std::make_shared<StreamSourceProxel>()}, {"sink", sink}}};
+  graph.connect("source", "outport", "sink", "inport");
+
+  graph.enableTimeline();
+  graph.start();
+  ASSERT_TRUE(sink->waitForMore(10));
+  graph.stop();
+  graph.disableTimeline();
+
+  std::ostringstream ss;
+  graph.writeTimeline(ss);
+
+  EXPECT_NE(std::string::npos, ss.str().find(R"("args":{"name":"sink"})"));
+  EXPECT_GT(countOccurrences(ss.str(), R"("name":"waiting")"), 0);
+}
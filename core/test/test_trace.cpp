@@ -0,0 +1,234 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "streaming_proxels.h"
+#include "superflow/buffered_consumer_port.h"
+#include "superflow/callback_consumer_port.h"
+#include "superflow/graph.h"
+#include "superflow/multi_consumer_port.h"
+#include "superflow/producer_port.h"
+#include "superflow/trace.h"
+#include "superflow/utils/latency_histogram.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <thread>
+
+using namespace flow;
+
+namespace
+{
+/// Forwards every item from "inport" to "outport", on the proxel thread.
+class RelayProxel : public Proxel
+{
+public:
+  RelayProxel()
+      : in_port_{std::make_shared<InPort>()}
+      , out_port_{std::make_shared<OutPort>()}
+  {
+    registerPorts({{"inport", in_port_}, {"outport", out_port_}});
+  }
+
+  void start() override
+  {
+    for (const auto& item : *in_port_)
+    { out_port_->send(item); }
+  }
+
+  void stop() noexcept override
+  { in_port_->deactivate(); }
+
+private:
+  using InPort = BufferedConsumerPort<int>;
+  using OutPort = ProducerPort<int>;
+
+  InPort::Ptr in_port_;
+  OutPort::Ptr out_port_;
+};
+
+uint64_t getCount(const Port::Ptr& source, const Port::Ptr& sink)
+{
+  const auto statistics = tracing::getStatistics();
+  const auto it = statistics.find({source.get(), sink.get()});
+
+  return it == statistics.end() ? 0 : it->second.getCount();
+}
+
+struct TraceTest : public ::testing::Test
+{
+  void TearDown() override
+  {
+    tracing::disable();
+    tracing::clearStatistics();
+    tracing::setCurrent({});
+  }
+};
+}
+
+TEST(LatencyHistogram, bucketsCoverAllDurations)
+{
+  for (uint64_t ns : {0ull, 1ull, 7ull, 8ull, 9ull, 15ull, 16ull, 1000ull, 123456789ull})
+  {
+    const auto bucket = LatencyHistogram::getBucketIndex(ns);
+    EXPECT_LT(ns, LatencyHistogram::getBucketUpperBound(bucket));
+
+    if (bucket > 0)
+    { EXPECT_GE(ns, LatencyHistogram::getBucketUpperBound(bucket - 1)); }
+  }
+
+  EXPECT_EQ(LatencyHistogram::num_buckets - 1, LatencyHistogram::getBucketIndex(UINT64_MAX));
+}
+
+TEST(LatencyHistogram, percentiles)
+{
+  LatencyHistogram histogram;
+  EXPECT_EQ(0., histogram.getPercentile(0.5));
+
+  for (int i = 1; i <= 100; ++i)
+  { histogram.record(std::chrono::microseconds{i}); }
+
+  EXPECT_EQ(100, histogram.getCount());
+  EXPECT_NEAR(50.5e-6, histogram.getMean(), 1e-9);
+  EXPECT_NEAR(100e-6, histogram.getMax(), 1e-9);
+  EXPECT_NEAR(50e-6, histogram.getPercentile(0.5), 50e-6 * 0.125);
+  EXPECT_NEAR(99e-6, histogram.getPercentile(0.99), 99e-6 * 0.125);
+  EXPECT_LE(histogram.getPercentile(1.), histogram.getMax());
+
+  LatencyHistogram other;
+  other.record(std::chrono::milliseconds{1});
+  histogram.merge(other);
+  EXPECT_EQ(101, histogram.getCount());
+  EXPECT_NEAR(1e-3, histogram.getMax(), 1e-9);
+
+  histogram.clear();
+  EXPECT_EQ(0, histogram.getCount());
+}
+
+TEST_F(TraceTest, nothingIsRecordedWhenDisabled)
+{
+  auto producer = std::make_shared<ProducerPort<int>>();
+  auto consumer = std::make_shared<BufferedConsumerPort<int>>();
+  producer->connect(consumer);
+
+  producer->send(1);
+  ASSERT_TRUE(consumer->getNext().has_value());
+
+  EXPECT_FALSE(tracing::getCurrent());
+  EXPECT_TRUE(tracing::getStatistics().empty());
+}
+
+TEST_F(TraceTest, traceFollowsItemsDownstream)
+{
+  tracing::enable(1);
+
+  auto source = std::make_shared<ProducerPort<int>>();
+  auto relay_in = std::make_shared<BufferedConsumerPort<int>>();
+  auto relay_out = std::make_shared<ProducerPort<int>>();
+  auto sink = std::make_shared<BufferedConsumerPort<int>>();
+  source->connect(relay_in);
+  relay_out->connect(sink);
+
+  source->send(1);
+  EXPECT_FALSE(tracing::getCurrent());
+
+  ASSERT_TRUE(relay_in->getNext().has_value());
+  const auto trace = tracing::getCurrent();
+  ASSERT_TRUE(trace);
+  EXPECT_EQ(source.get(), trace.source);
+
+  relay_out->send(2);
+  ASSERT_TRUE(sink->getNext().has_value());
+  EXPECT_EQ(trace.id, tracing::getCurrent().id);
+
+  EXPECT_EQ(1, getCount(source, relay_in));
+  EXPECT_EQ(1, getCount(source, sink));
+  EXPECT_EQ(0, getCount(relay_out, sink));
+}
+
+TEST_F(TraceTest, onlyRecentTracesAreFound)
+{
+  tracing::enable(1);
+
+  const auto first = tracing::propagate(nullptr);
+  const auto found = tracing::find(first.id);
+  EXPECT_EQ(first.id, found.id);
+  EXPECT_EQ(first.origin, found.origin);
+
+  for (size_t i = 0; i < tracing::max_traces; ++i)
+  { (void)tracing::propagate(nullptr); }
+
+  EXPECT_FALSE(tracing::find(first.id));
+  EXPECT_FALSE(tracing::find(0));
+}
+
+TEST_F(TraceTest, callbackAndMultiConsumersRecord)
+{
+  tracing::enable(1);
+
+  auto source = std::make_shared<ProducerPort<int>>();
+  TraceContext callback_trace;
+  auto callback = std::make_shared<CallbackConsumerPort<int>>(
+    [&callback_trace](const int&) { callback_trace = tracing::getCurrent(); }
+  );
+  auto multi = std::make_shared<MultiConsumerPort<int>>();
+  source->connect(callback);
+  source->connect(multi);
+
+  source->send(1);
+  ASSERT_EQ(1, multi->get().size());
+
+  EXPECT_TRUE(callback_trace);
+  EXPECT_EQ(callback_trace.id, tracing::getCurrent().id);
+  EXPECT_EQ(1, getCount(source, callback));
+  EXPECT_EQ(1, getCount(source, multi));
+}
+
+TEST_F(TraceTest, itemsAreSampled)
+{
+  tracing::enable(10);
+
+  auto producer = std::make_shared<ProducerPort<int>>();
+  auto consumer = std::make_shared<BufferedConsumerPort<int, ConnectPolicy::Single, GetMode::Blocking, LeakPolicy::Leaky>>(100);
+  producer->connect(consumer);
+
+  std::thread{[&producer]
+              {
+                for (int i = 0; i < 100; ++i)
+                { producer->send(i); }
+              }}.join();
+
+  for (int i = 0; i < 100; ++i)
+  { ASSERT_TRUE(consumer->getNext().has_value()); }
+
+  EXPECT_EQ(10, getCount(producer, consumer));
+}
+
+TEST_F(TraceTest, graphReportsPathsByName)
+{
+  auto sink = std::make_shared<StreamSinkProxel>();
+  Graph graph{{
+    {"source", std::make_shared<StreamSourceProxel>()},
+    {"relay", std::make_shared<RelayProxel>()},
+    {"sink", sink}
+  }};
+  graph.connect("source", "outport", "relay", "inport");
+  graph.connect("relay", "outport", "sink", "inport");
+
+  graph.enableTracing(1);
+  graph.start();
+  ASSERT_TRUE(sink->waitForMore(20));
+  graph.stop();
+  graph.disableTracing();
+
+  const auto statistics = graph.getTraceStatistics();
+  const auto it = std::find_if(
+    statistics.begin(), statistics.end(),
+    [](const Graph::TraceStatistics& path)
+    { return path.source_proxel == "source" && path.sink_proxel == "sink"; }
+  );
+
+  ASSERT_NE(statistics.end(), it);
+  EXPECT_EQ("outport", it->source_port);
+  EXPECT_EQ("inport", it->sink_port);
+  EXPECT_GT(it->latency.getCount(), 0);
+  EXPECT_GT(it->latency.getMean(), 0.);
+}
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "superflow/curses/proxel_window.h"
+#include "superflow/bottleneck_report.h"
 #include "superflow/graph.h"
 
 #include <map>
@@ -35,12 +36,16 @@ private:
 
   ProxelSet last_proxels_;
   WindowSet windows_;
+  Graph::Sampler sampler_;
 
   size_t max_ports_shown_;
   int width_ = -1;
   int height_ = -1;
   int minimum_window_width_ = 0;
 
+  /// Show the limiting stages of the first two pipelines above the proxel windows
+  void renderBottlenecks(const BottleneckReport& report) const;
+
   [[nodiscard]] bool guiSizeHasChanged() const;
 
   [[nodiscard]] bool proxelSetHasChanged(const ProxelSet& proxels) const;
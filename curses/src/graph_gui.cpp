@@ -6,6 +6,7 @@
 #include "ncursescpp/ncursescpp.hpp"
 
 #include <chrono>
+#include <sstream>
 #include <thread>
 
 namespace flow::curses
@@ -21,6 +22,7 @@ namespace
 /// (even if they are blacklisted)
 std::map<std::string, ProxelStatus> getProxelStatuses(
   const Graph& graph,
+  Graph::Sampler& sampler,
   const std::unordered_set<std::string>& blacklisted_proxels
 );
 }
@@ -49,7 +51,7 @@ void GraphGUI::spinOnce(
   const std::unordered_set<std::string>& blacklisted_proxels
 )
 {
-  const auto statuses = getProxelStatuses(graph, blacklisted_proxels);
+  const auto statuses = getProxelStatuses(graph, sampler_, blacklisted_proxels);
   const auto proxels = getProxelSet(graph, statuses);
 
   const auto minimum_window_width = getMinimumWindowWidth(static_cast<int>(getMaxNumPorts(statuses)));
@@ -95,10 +97,34 @@ void GraphGUI::spinOnce(
     windows_[name].renderStatus(name, status);
   }
 
+  renderBottlenecks(analyzeBottlenecks(statuses, graph.getConnections()));
+
   nccpp::ncurses().move(height_ - 1, width_ - 1);
   nccpp::ncurses().refresh();
 }
 
+void GraphGUI::renderBottlenecks(const BottleneckReport& report) const
+{
+  std::istringstream lines{[&report]()
+  {
+    std::ostringstream ss;
+    ss << report;
+    return ss.str();
+  }()};
+
+  std::string line;
+
+  for (int row = 1; row < window_v_padding - 1; ++row)
+  {
+    if (!std::getline(lines, line))
+    { line.clear(); }
+
+    const auto max_length = static_cast<size_t>(std::max(width_ - 2 * window_h_padding, 0));
+    line.resize(max_length, ' ');
+    mvprintw(row, window_h_padding, "%s", line.c_str());
+  }
+}
+
 bool GraphGUI::guiSizeHasChanged() const
 {
   int width;
@@ -252,10 +278,11 @@ std::map<std::string, Proxel::Ptr> getProxelSet(
 
 std::map<std::string, ProxelStatus> getProxelStatuses(
   const Graph& graph,
+  Graph::Sampler& sampler,
   const std::unordered_set<std::string>& blacklisted_proxels
 )
 {
-  auto statuses = graph.getProxelStatuses();
+  auto statuses = graph.getProxelStatuses(sampler);
 
   for (auto it = statuses.begin(); it != statuses.end();)
   {
@@ -38,8 +38,40 @@ void ProxelWindow::renderStatus(
     lines.push_back(ss.str());
   }
 
+  if (status.num_restarts > 0)
   {
-    const size_t max_info = 5;
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1)
+       << "restarts: " << status.num_restarts
+       << " mtbf: " << status.mean_time_between_failures << "s";
+
+    lines.push_back(ss.str());
+  }
+
+  if (status.perf.hardware)
+  {
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(2)
+       << "ipc: " << status.perf.getInstructionsPerCycle()
+       << std::setprecision(1)
+       << " cm: " << status.perf.cache_misses * 1e-6 << "M/s"
+       << " bm: " << status.perf.branch_misses * 1e-6 << "M/s";
+
+    lines.push_back(ss.str());
+  }
+  else if (status.perf.cpu_utilization > 0.)
+  {
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(2)
+       << "cpu: " << status.perf.cpu_utilization
+       << std::setprecision(0)
+       << " pf: " << status.perf.page_faults << "/s";
+
+    lines.push_back(ss.str());
+  }
+
+  {
+    const size_t max_info = inner_height - lines.size();
 
     const auto max_line_length = static_cast<size_t>(width_ - 2);
     std::vector<std::string> info_lines = getLines(status.info, max_line_length);
@@ -0,0 +1,194 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include "superflow/io/file_writer.h"
+#include "superflow/buffered_consumer_port.h"
+#include "superflow/codec.h"
+#include "superflow/factory_map.h"
+#include "superflow/proxel.h"
+#include "superflow/value.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace flow::io
+{
+/// \brief Writes the bytes of the items received on its "in" port to a file, \see FileWriter.
+///
+/// Each item is written as the bytes of flow::Codec<T>, without any framing, e.g. the raw data of
+/// `std::vector<std::byte>` buffers. Items with a ByteView are copied once, into the aligned buffers
+/// of the writer. The writes are asynchronous, so a latency spike on the disk only fills the write
+/// queue and the buffer of the port. Choose the LeakPolicy of the port for when both are full:
+/// Leaky drops the oldest items, PushBlocking holds back the producers, and Spill moves the burst
+/// to another disk.
+///
+/// Data that does not fill a block stays in memory until more data arrives, or until the Proxel
+/// stops. The Proxel reports the status fields `bytes` (counter), `write_rate` in bytes per second,
+/// `write_latency.p99` and `write_latency.max` over the last 10 seconds, in seconds, and
+/// `pending_writes` (gauges).
+/// \tparam T The type of data to write
+/// \tparam L LeakPolicy of the "in" port
+template<typename T, LeakPolicy L = LeakPolicy::Leaky>
+class FileSinkProxel final : public Proxel
+{
+public:
+  /// \param path The file to write, which is truncated if it exists
+  /// \param options \see FileWriter::Options
+  /// \param buffer_size Number of items the "in" port can hold
+  explicit FileSinkProxel(
+    const std::string& path,
+    const FileWriter::Options& options = FileWriter::Options{},
+    unsigned int buffer_size = 16
+  );
+
+  void start() override;
+
+  void stop() noexcept override;
+
+  [[nodiscard]] const FileWriter& getWriter() const;
+
+private:
+  using InPort = BufferedConsumerPort<T, ConnectPolicy::Multi, GetMode::Blocking, L>;
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr std::chrono::milliseconds status_period{100};
+
+  FileWriter writer_;
+  typename InPort::Ptr in_port_;
+  std::vector<std::byte> encoded_;
+
+  StatusCounter& bytes_;
+  StatusGauge& write_rate_;
+  StatusGauge& latency_p99_;
+  StatusGauge& latency_max_;
+  StatusGauge& pending_writes_;
+
+  FileWriter::Status reported_;
+  Clock::time_point reported_time_{};
+
+  void write(const T& item);
+
+  void updateStatus(Clock::time_point now);
+};
+
+/// \brief Factory for FileSinkProxel of `T`, named `<type_name>FileSink`.
+///
+/// The proxel takes the properties `path`, `buffer_size` (default 16), and the FileWriter::Options
+/// `block_size`, `queue_depth`, `direct` and `io_uring`.
+template<typename T, typename PropertyList, LeakPolicy L = LeakPolicy::Leaky>
+FactoryMap<PropertyList> createFileSinkFactory(const std::string& type_name);
+
+// ----- Implementation -----
+template<typename T, LeakPolicy L>
+FileSinkProxel<T, L>::FileSinkProxel(
+  const std::string& path,
+  const FileWriter::Options& options,
+  const unsigned int buffer_size
+)
+  : writer_{path, options}
+  , in_port_{std::make_shared<InPort>(buffer_size)}
+  , bytes_{addStatusCounter("bytes")}
+  , write_rate_{addStatusGauge("write_rate")}
+  , latency_p99_{addStatusGauge("write_latency.p99")}
+  , latency_max_{addStatusGauge("write_latency.max")}
+  , pending_writes_{addStatusGauge("pending_writes")}
+{
+  registerPorts({{"in", in_port_}});
+}
+
+template<typename T, LeakPolicy L>
+void FileSinkProxel<T, L>::start()
+{
+  setState(State::AwaitingInput);
+  reported_time_ = Clock::now();
+
+  for (const auto& item : *in_port_)
+  {
+    setState(State::Running);
+    write(item);
+
+    const auto now = Clock::now();
+
+    if (now - reported_time_ >= status_period)
+    { updateStatus(now); }
+
+    setState(State::AwaitingInput);
+  }
+
+  writer_.flush();
+  updateStatus(Clock::now());
+  setState(State::Unavailable);
+}
+
+template<typename T, LeakPolicy L>
+void FileSinkProxel<T, L>::stop() noexcept
+{
+  in_port_->deactivate();
+}
+
+template<typename T, LeakPolicy L>
+const FileWriter& FileSinkProxel<T, L>::getWriter() const
+{
+  return writer_;
+}
+
+template<typename T, LeakPolicy L>
+void FileSinkProxel<T, L>::write(const T& item)
+{
+  if constexpr (codec::has_view_v<T>)
+  { writer_.write(Codec<T>::view(item)); }
+  else
+  {
+    encoded_.clear();
+    Codec<T>::encode(item, encoded_);
+    writer_.write({encoded_.data(), encoded_.size()});
+  }
+}
+
+template<typename T, LeakPolicy L>
+void FileSinkProxel<T, L>::updateStatus(const Clock::time_point now)
+{
+  const auto current = writer_.getStatus();
+  const auto latency = writer_.getLatency(std::chrono::seconds{10});
+  const auto period = std::chrono::duration<double>(now - reported_time_).count();
+
+  bytes_.increment(current.num_bytes - reported_.num_bytes);
+
+  if (period > 0.)
+  { write_rate_.set(static_cast<double>(current.num_bytes - reported_.num_bytes) / period); }
+
+  latency_p99_.set(latency.getPercentile(0.99));
+  latency_max_.set(latency.getMax());
+  pending_writes_.set(static_cast<double>(current.pending_writes));
+
+  reported_ = current;
+  reported_time_ = now;
+}
+
+template<typename T, typename PropertyList, LeakPolicy L>
+FactoryMap<PropertyList> createFileSinkFactory(const std::string& type_name)
+{
+  return FactoryMap<PropertyList>{
+    {
+      {
+        type_name + "FileSink",
+        [](const PropertyList& properties)
+        {
+          FileWriter::Options options;
+          options.block_size = value<size_t>(properties, "block_size", options.block_size);
+          options.queue_depth = value<unsigned int>(properties, "queue_depth", options.queue_depth);
+          options.direct = value<bool>(properties, "direct", options.direct);
+          options.io_uring = value<bool>(properties, "io_uring", options.io_uring);
+
+          return std::make_shared<FileSinkProxel<T, L>>(
+            value<std::string>(properties, "path"),
+            options,
+            value<unsigned int>(properties, "buffer_size", 16u)
+          );
+        }
+      }
+    }
+  };
+}
+}
@@ -0,0 +1,141 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include "superflow/codec.h"
+#include "superflow/utils/latency_histogram.h"
+#include "superflow/utils/windowed_histogram.h"
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace flow::io
+{
+/// \brief Writes a stream of bytes to a file through a pool of aligned buffers, with several writes in flight.
+///
+/// `write` copies the data into the current buffer. Each full buffer is queued as one write, and the
+/// writes queued by one call are submitted together, so that the disk sees few, large writes no matter
+/// the size of the data. Up to `queue_depth` writes are in flight while the next buffer is filled;
+/// `write` only waits for the disk when all buffers are in flight.
+///
+/// The writes are submitted through io_uring. On kernels without io_uring, or where it is disabled,
+/// each buffer is written with `pwrite` instead, which is synchronous. The file is opened with `O_DIRECT`
+/// to bypass the page cache, unless the file system does not support it. With `O_DIRECT`, the last
+/// block is padded when it is written, and the file is truncated to the size of the data.
+/// Not thread safe, except for `getLatency`.
+class FileWriter
+{
+public:
+  /// Alignment of the buffers, and of the sizes and offsets of the writes with `O_DIRECT`
+  static constexpr size_t alignment = 4096;
+
+  struct Options
+  {
+    size_t block_size = size_t{1} << 20; ///< Size of each pooled buffer and of each write, a multiple of `alignment`
+    unsigned int queue_depth = 8;        ///< Maximum number of writes in flight
+    bool direct = true;                  ///< Bypass the page cache with `O_DIRECT`, if the file system supports it
+    bool io_uring = true;                ///< Use io_uring if the kernel supports it, or else `pwrite`
+  };
+
+  enum class Backend
+  {
+    IoUring,
+    Pwrite
+  };
+
+  struct Status
+  {
+    size_t num_bytes = 0;      ///< Bytes written to the file by completed writes, including padding
+    size_t num_writes = 0;     ///< Completed writes
+    size_t pending_writes = 0; ///< Writes in flight
+  };
+
+  /// \brief Create or truncate the file at `path`
+  /// \throws std::invalid_argument if `block_size` is not a positive multiple of `alignment`, or `queue_depth` is 0
+  /// \throws std::runtime_error if the file cannot be opened
+  FileWriter(const std::string& path, const Options& options);
+
+  explicit FileWriter(const std::string& path);
+
+  /// \brief Closes the file, ignoring any errors. Call `close` to detect them.
+  ~FileWriter();
+
+  FileWriter(const FileWriter&) = delete;
+  FileWriter& operator=(const FileWriter&) = delete;
+
+  /// \brief Append `data` to the file
+  /// \throws std::runtime_error if a write has failed
+  void write(ByteView data);
+
+  /// \brief Write the data that is not yet in a full buffer, and wait until all writes are completed
+  /// \throws std::runtime_error if a write has failed
+  void flush();
+
+  /// \brief Flush and close the file. Does nothing if it is closed.
+  /// \throws std::runtime_error if a write has failed
+  void close();
+
+  [[nodiscard]] Status getStatus() const;
+
+  /// \brief The time from writes were submitted until they completed, during the last `window`
+  [[nodiscard]] LatencyHistogram getLatency(std::chrono::seconds window) const;
+
+  [[nodiscard]] Backend getBackend() const;
+
+  /// \return true if the file is opened with `O_DIRECT`
+  [[nodiscard]] bool isDirect() const;
+
+  /// \brief Number of bytes appended to the file
+  [[nodiscard]] size_t getSize() const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  class Ring;
+
+  struct AlignedDeleter
+  {
+    void operator()(std::byte* data) const;
+  };
+
+  struct Buffer
+  {
+    std::unique_ptr<std::byte, AlignedDeleter> data;
+    size_t size = 0;     ///< Bytes of data in the buffer
+    size_t length = 0;   ///< Bytes being written, with padding
+    uint64_t offset = 0; ///< Position in the file
+    Clock::time_point submitted{};
+  };
+
+  std::string path_;
+  Options options_;
+  int fd_ = -1;
+  bool direct_ = false;
+  std::unique_ptr<Ring> ring_;
+
+  std::vector<Buffer> buffers_;
+  std::vector<size_t> free_buffers_;
+  std::optional<size_t> current_;
+  uint64_t file_offset_ = 0;
+  size_t size_ = 0;
+  Status status_;
+  int error_ = 0;
+  WindowedHistogram latency_;
+
+  [[nodiscard]] size_t acquireBuffer();
+
+  /// \brief Queue a write of the data in a buffer
+  void submit(size_t buffer);
+
+  /// \brief The buffer has been written with the given result, a size or a negated errno
+  void complete(size_t buffer, int64_t result);
+
+  /// \brief Submit the queued writes, and wait for `min_complete` of the writes in flight
+  void reap(unsigned int min_complete);
+
+  void throwOnError() const;
+};
+}
@@ -0,0 +1,61 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace flow::io
+{
+/// \brief The layout of a recording, as written by LogWriter and read by LogReader.
+///
+/// A recording is a directory of segment files, `segment-000000.log`, `segment-000001.log`, ...,
+/// and one `index` file. Each segment starts with a SegmentHeader, followed by the records.
+/// A record is a RecordHeader followed by a message, i.e. a CodecHeader and the encoded item,
+/// padded to a multiple of `record_alignment` bytes. A segment ends at the end of the file,
+/// or at a RecordHeader with size 0. The index holds an IndexEntry for the first record of each
+/// segment, and for every record that is more than the index interval later than the previous entry.
+/// All numbers are in the byte order of the host that wrote the recording.
+namespace log_format
+{
+constexpr uint64_t magic_number = 0x474f4c574f4c4653; ///< "SFLOWLOG" in little endian
+constexpr uint32_t current_format = 1;
+constexpr size_t record_alignment = 8;
+
+constexpr const char* index_file_name = "index";
+
+struct SegmentHeader
+{
+  uint64_t magic = magic_number;
+  uint32_t format = current_format;
+  uint32_t segment = 0;   ///< Sequence number of the segment in the recording
+};
+
+struct RecordHeader
+{
+  int64_t timestamp = 0;  ///< When the item was recorded, in nanoseconds since the epoch of the system clock
+  uint64_t size = 0;      ///< Size of the message, without padding
+};
+
+struct IndexEntry
+{
+  int64_t timestamp = 0;  ///< RecordHeader::timestamp of the record
+  uint32_t segment = 0;   ///< Sequence number of the segment holding the record
+  uint32_t reserved = 0;
+  uint64_t offset = 0;    ///< Offset of the RecordHeader in the segment, in bytes
+};
+
+static_assert(sizeof(SegmentHeader) == 16 && sizeof(RecordHeader) == 16 && sizeof(IndexEntry) == 24,
+              "The log format must have the same layout on all hosts");
+
+/// \brief Size of a record with a message of `message_size` bytes, including the header and padding
+constexpr size_t getRecordSize(const size_t message_size)
+{
+  return sizeof(RecordHeader)
+         + (message_size + record_alignment - 1) / record_alignment * record_alignment;
+}
+
+/// \brief The file name of a segment, e.g. "segment-000042.log"
+[[nodiscard]] std::string getSegmentFileName(uint32_t segment);
+}
+}
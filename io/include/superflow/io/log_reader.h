@@ -0,0 +1,76 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include "superflow/io/log_format.h"
+#include "superflow/codec.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace flow::io
+{
+/// \brief Reads the records of a recording written by LogWriter, in order, from memory-mapped segments.
+///
+/// The messages are returned as views into the mapped segment, without being copied. A view is valid
+/// until the reader moves to another segment, i.e. until the next call to `next` or `seek` that
+/// crosses a segment boundary, or until the reader is destroyed. Decode the message with
+/// codec::decodeMessage before that. \see log_format for the layout of the recording.
+class LogReader
+{
+public:
+  struct Record
+  {
+    int64_t timestamp = 0; ///< \see log_format::RecordHeader::timestamp
+    ByteView message;      ///< CodecHeader and encoded item
+  };
+
+  /// \brief Open a recording
+  /// \throws std::runtime_error if the directory does not hold a recording
+  explicit LogReader(const std::string& directory);
+
+  ~LogReader();
+
+  LogReader(const LogReader&) = delete;
+  LogReader& operator=(const LogReader&) = delete;
+
+  /// \brief Read the next record
+  /// \return The record, or nothing at the end of the recording
+  /// \throws std::runtime_error if a segment is corrupt
+  std::optional<Record> next();
+
+  /// \brief Position the reader at the first record that is not earlier than `timestamp`.
+  /// The index is searched for the closest earlier entry, and the records from there are skipped.
+  void seek(int64_t timestamp);
+
+  /// \brief Position the reader at the first record
+  void rewind();
+
+  /// \brief The timestamp of the first record, or 0 if the recording is empty
+  [[nodiscard]] int64_t getStartTime() const;
+
+  [[nodiscard]] size_t getNumSegments() const;
+
+  [[nodiscard]] const std::vector<log_format::IndexEntry>& getIndex() const;
+
+private:
+  std::string directory_;
+  std::vector<log_format::IndexEntry> index_;
+  uint32_t num_segments_ = 0;
+
+  uint32_t segment_ = 0;
+  const std::byte* data_ = nullptr;
+  size_t size_ = 0;
+  size_t offset_ = 0;
+
+  /// \return false if the segment does not exist
+  bool openSegment(uint32_t segment);
+
+  void closeSegment();
+
+  /// \return The header of the record at the current offset, moving on to the next segment at the end of one
+  std::optional<log_format::RecordHeader> peek();
+};
+}
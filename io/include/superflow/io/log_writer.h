@@ -0,0 +1,108 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include "superflow/codec.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace flow::io
+{
+/// \brief Appends messages to a recording of memory-mapped segment files, on a background thread.
+///
+/// `append` copies the message into an in-memory batch, and never waits for the disk. The thread
+/// takes the whole batch at once, copies it into the mapped segment, and adds index entries, while
+/// new messages are appended to the next batch. When the batch is full, because the disk cannot
+/// keep up, new messages are dropped and counted, so that recording never holds back the graph.
+/// Segments are created with their full size, and truncated to the size used when they are
+/// finished. \see log_format for the layout of the recording.
+class LogWriter
+{
+public:
+  struct Options
+  {
+    size_t segment_size = size_t{64} << 20;     ///< Size of each segment file, in bytes
+    size_t max_batch_size = size_t{16} << 20;   ///< Bytes waiting to be written, beyond which messages are dropped
+    double index_interval = 0.01;               ///< Minimum time between index entries, in seconds
+  };
+
+  struct Status
+  {
+    size_t num_records = 0;     ///< Records written to the segments
+    size_t num_bytes = 0;       ///< Bytes written to the segments, including headers and padding
+    size_t num_dropped = 0;     ///< Messages dropped because the batch was full
+    size_t num_segments = 0;    ///< Segment files created
+    size_t pending_bytes = 0;   ///< Bytes appended, but not yet written to the segments
+    double lag = 0.;            ///< Age of the oldest message not yet written to the segments, in seconds
+    bool failed = false;        ///< True if a segment could not be created, e.g. because the disk is full
+  };
+
+  /// \brief Create a new recording
+  /// \param directory Directory of the recording, which is created if it does not exist
+  /// \param options \see Options
+  /// \throws std::invalid_argument if the directory already holds a recording, or the options are invalid
+  /// \throws std::runtime_error if the recording cannot be created
+  explicit LogWriter(const std::string& directory, const Options& options);
+
+  explicit LogWriter(const std::string& directory);
+
+  /// \brief Write the remaining messages, and close the recording
+  ~LogWriter();
+
+  LogWriter(const LogWriter&) = delete;
+  LogWriter& operator=(const LogWriter&) = delete;
+
+  /// \brief Append a message, made up of a header and a payload, stamped with the current time.
+  /// Thread safe, and never waits for the disk.
+  /// \return false if the message was dropped, because the batch is full or the writer is closed
+  bool append(ByteView header, ByteView payload);
+
+  /// \brief Wait until all appended messages are written to the segments
+  void flush();
+
+  /// \brief Write the remaining messages, stop the thread, and truncate the last segment.
+  /// Later messages are dropped.
+  void close();
+
+  [[nodiscard]] Status getStatus() const;
+
+  [[nodiscard]] const std::string& getDirectory() const;
+
+private:
+  using Clock = std::chrono::system_clock;
+
+  struct Segment;
+
+  std::string directory_;
+  Options options_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable has_batch_;
+  std::condition_variable is_written_;
+  std::vector<std::byte> batch_;
+  int64_t oldest_pending_ = 0;
+  int64_t oldest_writing_ = 0;
+  size_t writing_size_ = 0;
+  bool closing_ = false;
+  bool closed_ = false;
+  Status status_;
+
+  std::unique_ptr<Segment> segment_;
+  int index_file_ = -1;
+  int64_t last_indexed_ = 0;
+  std::thread thread_;
+
+  void run();
+
+  /// \return false if a new segment could not be created
+  bool write(const std::vector<std::byte>& batch);
+};
+}
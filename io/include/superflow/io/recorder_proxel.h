@@ -0,0 +1,164 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include "superflow/io/log_writer.h"
+#include "superflow/callback_consumer_port.h"
+#include "superflow/codec.h"
+#include "superflow/proxel.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace flow::io
+{
+/// \brief Records the items sent on any number of producer ports into a recording, \see LogWriter.
+///
+/// Connect its "in" port to the ProducerPort of an edge as an extra consumer. Each item is encoded
+/// by flow::Codec<T> and appended to the LogWriter on the thread of the producer, which never waits
+/// for the disk. Items with a ByteView are copied once, straight into the batch of the writer.
+/// If the disk cannot keep up, items are dropped rather than holding back the graph.
+///
+/// While running, the Proxel reports the status fields `records` and `dropped` (counters),
+/// `write_rate` in bytes per second, `lag` in seconds and `pending_bytes` (gauges).
+/// The recording is closed when the Proxel is destroyed.
+/// \tparam T The type of data to record
+/// \see LogReader
+template<typename T>
+class RecorderProxel final : public Proxel
+{
+public:
+  /// \param directory Directory of the recording, \see LogWriter
+  /// \param options \see LogWriter::Options
+  /// \param status_period How often the status fields are updated
+  explicit RecorderProxel(
+    const std::string& directory,
+    const LogWriter::Options& options = LogWriter::Options{},
+    std::chrono::milliseconds status_period = std::chrono::milliseconds{100}
+  );
+
+  void start() override;
+
+  void stop() noexcept override;
+
+  [[nodiscard]] LogWriter& getWriter();
+
+private:
+  using InPort = CallbackConsumerPort<T, ConnectPolicy::Multi>;
+
+  LogWriter writer_;
+  std::chrono::milliseconds status_period_;
+  typename InPort::Ptr in_port_;
+
+  StatusCounter& records_;
+  StatusCounter& dropped_;
+  StatusGauge& write_rate_;
+  StatusGauge& lag_;
+  StatusGauge& pending_bytes_;
+
+  std::mutex mutex_;
+  std::condition_variable stop_requested_;
+  bool stopped_ = false;
+  LogWriter::Status reported_;
+
+  void record(const T& item);
+
+  void updateStatus(double period);
+};
+
+// ----- Implementation -----
+template<typename T>
+RecorderProxel<T>::RecorderProxel(
+  const std::string& directory,
+  const LogWriter::Options& options,
+  const std::chrono::milliseconds status_period
+)
+  : writer_{directory, options}
+  , status_period_{status_period}
+  , in_port_{std::make_shared<InPort>([this](const T& item) { record(item); })}
+  , records_{addStatusCounter("records")}
+  , dropped_{addStatusCounter("dropped")}
+  , write_rate_{addStatusGauge("write_rate")}
+  , lag_{addStatusGauge("lag")}
+  , pending_bytes_{addStatusGauge("pending_bytes")}
+{
+  registerPorts({{"in", in_port_}});
+}
+
+template<typename T>
+void RecorderProxel<T>::start()
+{
+  {
+    std::scoped_lock lock{mutex_};
+    stopped_ = false;
+  }
+
+  setState(State::Running);
+
+  auto previous_time = std::chrono::steady_clock::now();
+  std::unique_lock lock{mutex_};
+
+  while (!stop_requested_.wait_for(lock, status_period_, [this]() { return stopped_; }))
+  {
+    const auto now = std::chrono::steady_clock::now();
+    updateStatus(std::chrono::duration<double>(now - previous_time).count());
+    previous_time = now;
+  }
+
+  setState(State::Unavailable);
+}
+
+template<typename T>
+void RecorderProxel<T>::stop() noexcept
+{
+  {
+    std::scoped_lock lock{mutex_};
+    stopped_ = true;
+  }
+
+  stop_requested_.notify_all();
+}
+
+template<typename T>
+LogWriter& RecorderProxel<T>::getWriter()
+{
+  return writer_;
+}
+
+template<typename T>
+void RecorderProxel<T>::record(const T& item)
+{
+  if constexpr (codec::has_view_v<T>)
+  {
+    const auto payload = Codec<T>::view(item);
+    const auto header = codec::makeHeader<T>(payload.size);
+
+    writer_.append({reinterpret_cast<const std::byte*>(&header), sizeof(header)}, payload);
+  }
+  else
+  {
+    std::vector<std::byte> message;
+    codec::encodeMessage(item, message);
+
+    writer_.append({message.data(), message.size()}, {});
+  }
+}
+
+template<typename T>
+void RecorderProxel<T>::updateStatus(const double period)
+{
+  const auto current = writer_.getStatus();
+
+  records_.increment(current.num_records - reported_.num_records);
+  dropped_.increment(current.num_dropped - reported_.num_dropped);
+
+  if (period > 0.)
+  { write_rate_.set(static_cast<double>(current.num_bytes - reported_.num_bytes) / period); }
+
+  lag_.set(current.lag);
+  pending_bytes_.set(static_cast<double>(current.pending_bytes));
+  reported_ = current;
+}
+}
@@ -0,0 +1,213 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include "superflow/io/log_reader.h"
+#include "superflow/codec.h"
+#include "superflow/factory_map.h"
+#include "superflow/producer_port.h"
+#include "superflow/proxel.h"
+#include "superflow/value.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace flow::io
+{
+/// \brief Sends the items of a recording on its "out" port, with the timing they were recorded with.
+///
+/// The recording is read from memory-mapped segments, \see LogReader, and each item is decoded by
+/// flow::Codec<T> right before it is sent. The time between items is the recorded time divided by
+/// `speed`, so that 2 replays twice as fast as recorded. With a `speed` of 0 the items are sent as
+/// fast as the consumers accept them: give the consumers a PushBlocking buffer to replay every item
+/// without drops, for deterministic and repeatable throughput measurements of a graph.
+///
+/// `start` returns at the end of the recording, unless `loop` is set and the recording is not empty.
+/// A `stop` that comes after `start` has thrown, e.g. while the Proxel is restarted after a crash,
+/// makes the next `start` return right away. The Proxel reports the status
+/// fields `records` and `errors` (counters), and `lag` (gauge), the time the last item was sent
+/// behind schedule, in seconds.
+/// \tparam T The type of data that was recorded, \see RecorderProxel
+template<typename T>
+class ReplayProxel final : public Proxel
+{
+public:
+  struct Options
+  {
+    double speed = 1.; ///< Replay speed relative to the recording, or 0 to send as fast as possible
+    bool loop = false; ///< Start over at the end of the recording
+  };
+
+  /// \param directory Directory of the recording
+  /// \param options \see Options
+  /// \throws std::runtime_error if the directory does not hold a recording
+  /// \throws std::invalid_argument if `speed` is negative
+  explicit ReplayProxel(const std::string& directory, const Options& options = Options{});
+
+  void start() override;
+
+  void stop() noexcept override;
+
+private:
+  using OutPort = ProducerPort<T>;
+  using Clock = std::chrono::steady_clock;
+
+  LogReader reader_;
+  Options options_;
+  typename OutPort::Ptr out_port_;
+
+  StatusCounter& records_;
+  StatusCounter& errors_;
+  StatusGauge& lag_;
+
+  std::mutex mutex_;
+  std::condition_variable stop_requested_;
+  std::atomic<bool> stopped_{false};
+  bool returned_ = false; ///< `start` returned rather than threw, so there is nothing to stop until the next
+
+  /// \return false if stopped while waiting
+  bool waitUntil(Clock::time_point time);
+
+  void send(const LogReader::Record& record);
+};
+
+/// \brief Factory for ReplayProxel of `T`, named `<type_name>Replay`.
+///
+/// The proxel takes the properties `directory`, `speed` (default 1) and `loop` (default false).
+template<typename T, typename PropertyList>
+FactoryMap<PropertyList> createReplayFactory(const std::string& type_name);
+
+// ----- Implementation -----
+template<typename T>
+ReplayProxel<T>::ReplayProxel(const std::string& directory, const Options& options)
+  : reader_{directory}
+  , options_{options}
+  , out_port_{std::make_shared<OutPort>()}
+  , records_{addStatusCounter("records")}
+  , errors_{addStatusCounter("errors")}
+  , lag_{addStatusGauge("lag")}
+{
+  if (!(options_.speed >= 0.))
+  { throw std::invalid_argument("ReplayProxel: 'speed' must be 0 or more"); }
+
+  registerPorts({{"out", out_port_}});
+}
+
+template<typename T>
+void ReplayProxel<T>::start()
+{
+  {
+    std::scoped_lock lock{mutex_};
+    returned_ = false;
+  }
+
+  setState(State::Running);
+  size_t num_records = 0;
+
+  do
+  {
+    reader_.rewind();
+    num_records = 0;
+
+    const auto start_time = Clock::now();
+    const auto recording_start = reader_.getStartTime();
+
+    while (!stopped_)
+    {
+      const auto record = reader_.next();
+
+      if (!record)
+      { break; }
+
+      ++num_records;
+
+      if (options_.speed > 0.)
+      {
+        const auto offset = std::chrono::duration<double>(
+          static_cast<double>(record->timestamp - recording_start) * 1e-9 / options_.speed
+        );
+        const auto due = start_time + std::chrono::duration_cast<Clock::duration>(offset);
+
+        if (!waitUntil(due))
+        { break; }
+
+        lag_.set(std::chrono::duration<double>(Clock::now() - due).count());
+      }
+
+      send(*record);
+    }
+  } while (options_.loop && num_records > 0 && !stopped_);
+
+  {
+    // Any stop that ended this run has been served, so the next `start` replays again
+    std::scoped_lock lock{mutex_};
+    returned_ = true;
+    stopped_ = false;
+  }
+
+  setState(State::Unavailable);
+}
+
+template<typename T>
+void ReplayProxel<T>::stop() noexcept
+{
+  {
+    std::scoped_lock lock{mutex_};
+
+    if (returned_)
+    { return; }
+
+    stopped_ = true;
+  }
+
+  stop_requested_.notify_all();
+}
+
+template<typename T>
+bool ReplayProxel<T>::waitUntil(const Clock::time_point time)
+{
+  std::unique_lock lock{mutex_};
+  return !stop_requested_.wait_until(lock, time, [this]() { return stopped_.load(); });
+}
+
+template<typename T>
+void ReplayProxel<T>::send(const LogReader::Record& record)
+{
+  std::optional<T> item;
+
+  try
+  { item.emplace(codec::decodeMessage<T>(record.message.data, record.message.size)); }
+  catch (const std::invalid_argument&)
+  {
+    ++errors_;
+    return;
+  }
+
+  ++records_;
+  out_port_->send(*item);
+}
+
+template<typename T, typename PropertyList>
+FactoryMap<PropertyList> createReplayFactory(const std::string& type_name)
+{
+  return FactoryMap<PropertyList>{
+    {
+      {
+        type_name + "Replay",
+        [](const PropertyList& properties)
+        {
+          typename ReplayProxel<T>::Options options;
+          options.speed = value<double>(properties, "speed", options.speed);
+          options.loop = value<bool>(properties, "loop", options.loop);
+
+          return std::make_shared<ReplayProxel<T>>(value<std::string>(properties, "directory"), options);
+        }
+      }
+    }
+  };
+}
+}
@@ -0,0 +1,483 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/io/file_writer.h"
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+namespace flow::io
+{
+namespace
+{
+std::runtime_error makeError(const std::string& path, const std::string& what, const int error)
+{
+  return std::runtime_error{"FileWriter '" + path + "': " + what + ": " + std::strerror(error)};
+}
+
+size_t roundUp(const size_t size, const size_t multiple)
+{
+  return (size + multiple - 1) / multiple * multiple;
+}
+
+/// \return The number of bytes written, or the negated errno
+int64_t writeAll(const int fd, const std::byte* data, const size_t size, const uint64_t offset)
+{
+  size_t written = 0;
+
+  while (written < size)
+  {
+    const auto result = pwrite(fd, data + written, size - written, static_cast<off_t>(offset + written));
+
+    if (result < 0 && errno == EINTR)
+    { continue; }
+
+    if (result < 0)
+    { return -errno; }
+
+    if (result == 0)
+    { break; }
+
+    written += static_cast<size_t>(result);
+  }
+
+  return static_cast<int64_t>(written);
+}
+}
+
+/// A minimal io_uring, with the system calls made directly, so that liburing is not needed
+class FileWriter::Ring
+{
+public:
+  /// \return The ring, or nothing if io_uring is not available
+  static std::unique_ptr<Ring> create(const unsigned int entries, const size_t num_buffers)
+  {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+
+    const auto fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+
+    if (fd < 0)
+    { return nullptr; }
+
+    std::unique_ptr<Ring> ring{new Ring{fd, num_buffers}};
+
+    if (!ring->map(params))
+    { return nullptr; }
+
+    return ring;
+  }
+
+  ~Ring()
+  {
+    if (sqes_ != nullptr)
+    { munmap(sqes_, sqes_size_); }
+
+    if (cq_ptr_ != nullptr && cq_ptr_ != sq_ptr_)
+    { munmap(cq_ptr_, cq_size_); }
+
+    if (sq_ptr_ != nullptr)
+    { munmap(sq_ptr_, sq_size_); }
+
+    ::close(fd_);
+  }
+
+  Ring(const Ring&) = delete;
+  Ring& operator=(const Ring&) = delete;
+
+  /// \brief Queue a write, submitting the queued writes first if the submission queue is full
+  /// \return false, with errno set, if the queued writes could not be submitted
+  bool queueWrite(const int fd, const size_t buffer, std::byte* data, const size_t length, const uint64_t offset)
+  {
+    if (to_submit_ == sq_entries_ && !enter(0))
+    { return false; }
+
+    iovecs_[buffer] = {data, length};
+
+    const unsigned int tail = *sq_tail_;
+    const unsigned int index = tail & *sq_mask_;
+    auto& sqe = sqes_[index];
+
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_WRITEV;
+    sqe.fd = fd;
+    sqe.addr = reinterpret_cast<uint64_t>(&iovecs_[buffer]);
+    sqe.len = 1;
+    sqe.off = offset;
+    sqe.user_data = buffer;
+
+    sq_array_[index] = index;
+    __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+    ++to_submit_;
+
+    return true;
+  }
+
+  /// \brief Submit the queued writes, and wait for `min_complete` completions
+  /// \return false, with errno set, if the system call failed
+  bool enter(unsigned int min_complete)
+  {
+    while (to_submit_ > 0 || min_complete > 0)
+    {
+      const auto result = syscall(
+        __NR_io_uring_enter, fd_, to_submit_, min_complete,
+        min_complete > 0 ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0
+      );
+
+      if (result < 0 && errno == EINTR)
+      { continue; }
+
+      if (result < 0)
+      { return false; }
+
+      to_submit_ -= static_cast<unsigned int>(result);
+      min_complete = 0;
+    }
+
+    return true;
+  }
+
+  /// \brief Call `handle(buffer, result)` for each completed write
+  template<typename Handler>
+  void forEachCompletion(Handler&& handle)
+  {
+    unsigned int head = *cq_head_;
+    const unsigned int tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+
+    for (; head != tail; ++head)
+    {
+      const auto& cqe = cqes_[head & *cq_mask_];
+      handle(static_cast<size_t>(cqe.user_data), static_cast<int64_t>(cqe.res));
+    }
+
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  }
+
+private:
+  int fd_;
+  std::vector<iovec> iovecs_;
+  unsigned int to_submit_ = 0;
+  unsigned int sq_entries_ = 0;
+
+  void* sq_ptr_ = nullptr;
+  size_t sq_size_ = 0;
+  void* cq_ptr_ = nullptr;
+  size_t cq_size_ = 0;
+  io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  unsigned int* sq_tail_ = nullptr;
+  unsigned int* sq_mask_ = nullptr;
+  unsigned int* sq_array_ = nullptr;
+  unsigned int* cq_head_ = nullptr;
+  unsigned int* cq_tail_ = nullptr;
+  unsigned int* cq_mask_ = nullptr;
+  io_uring_cqe* cqes_ = nullptr;
+
+  Ring(const int fd, const size_t num_buffers)
+    : fd_{fd}
+    , iovecs_(num_buffers)
+  {}
+
+  bool map(const io_uring_params& params)
+  {
+    sq_entries_ = params.sq_entries;
+    sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+
+    if (single_mmap)
+    { sq_size_ = cq_size_ = std::max(sq_size_, cq_size_); }
+
+    sq_ptr_ = mapRing(sq_size_, IORING_OFF_SQ_RING);
+
+    if (sq_ptr_ == nullptr)
+    { return false; }
+
+    cq_ptr_ = single_mmap
+              ? sq_ptr_
+              : mapRing(cq_size_, IORING_OFF_CQ_RING);
+
+    if (cq_ptr_ == nullptr)
+    { return false; }
+
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = static_cast<io_uring_sqe*>(mapRing(sqes_size_, IORING_OFF_SQES));
+
+    if (sqes_ == nullptr)
+    { return false; }
+
+    auto* sq = static_cast<std::byte*>(sq_ptr_);
+    auto* cq = static_cast<std::byte*>(cq_ptr_);
+
+    sq_tail_ = reinterpret_cast<unsigned int*>(sq + params.sq_off.tail);
+    sq_mask_ = reinterpret_cast<unsigned int*>(sq + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned int*>(sq + params.sq_off.array);
+    cq_head_ = reinterpret_cast<unsigned int*>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned int*>(cq + params.cq_off.tail);
+    cq_mask_ = reinterpret_cast<unsigned int*>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    return true;
+  }
+
+  [[nodiscard]] void* mapRing(const size_t size, const off_t offset) const
+  {
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, offset);
+
+    return data == MAP_FAILED
+           ? nullptr
+           : data;
+  }
+};
+
+void FileWriter::AlignedDeleter::operator()(std::byte* data) const
+{ std::free(data); }
+
+FileWriter::FileWriter(const std::string& path)
+  : FileWriter{path, Options{}}
+{}
+
+FileWriter::FileWriter(const std::string& path, const Options& options)
+  : path_{path}
+  , options_{options}
+{
+  if (options_.block_size == 0 || options_.block_size % alignment != 0)
+  { throw std::invalid_argument{"FileWriter: 'block_size' must be a positive multiple of " + std::to_string(alignment)}; }
+
+  if (options_.queue_depth == 0)
+  { throw std::invalid_argument{"FileWriter: 'queue_depth' must be 1 or more"}; }
+
+  // One buffer is filled while the others are in flight
+  buffers_.resize(options_.queue_depth + 1);
+
+  for (size_t i = buffers_.size(); i-- > 0;)
+  {
+    buffers_[i].data.reset(static_cast<std::byte*>(std::aligned_alloc(alignment, options_.block_size)));
+
+    if (!buffers_[i].data)
+    { throw std::bad_alloc{}; }
+
+    free_buffers_.push_back(i);
+  }
+
+  // Every buffer may be in flight at once, e.g. when one write spans more than `queue_depth` blocks
+  if (options_.io_uring)
+  { ring_ = Ring::create(static_cast<unsigned int>(buffers_.size()), buffers_.size()); }
+
+  constexpr int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+
+  if (options_.direct)
+  {
+    fd_ = open(path_.c_str(), flags | O_DIRECT, 0644);
+    direct_ = fd_ >= 0;
+  }
+
+  if (fd_ < 0)
+  { fd_ = open(path_.c_str(), flags, 0644); }
+
+  if (fd_ < 0)
+  { throw makeError(path_, "could not open", errno); }
+}
+
+FileWriter::~FileWriter()
+{
+  try
+  { close(); }
+  catch (...)
+  {}
+}
+
+void FileWriter::write(const ByteView data)
+{
+  if (fd_ < 0)
+  { throw std::runtime_error{"FileWriter '" + path_ + "': the file is closed"}; }
+
+  throwOnError();
+
+  const auto* bytes = data.data;
+  size_t remaining = data.size;
+
+  while (remaining > 0)
+  {
+    if (!current_)
+    { current_ = acquireBuffer(); }
+
+    auto& buffer = buffers_[*current_];
+    const auto size = std::min(options_.block_size - buffer.size, remaining);
+
+    std::memcpy(buffer.data.get() + buffer.size, bytes, size);
+    buffer.size += size;
+    bytes += size;
+    remaining -= size;
+    size_ += size;
+
+    if (buffer.size == options_.block_size)
+    {
+      const auto full = *current_;
+      current_.reset();
+      file_offset_ += options_.block_size;
+      submit(full);
+    }
+  }
+
+  reap(0);
+  throwOnError();
+}
+
+void FileWriter::flush()
+{
+  if (fd_ < 0)
+  { return; }
+
+  throwOnError();
+
+  if (current_ && buffers_[*current_].size > 0)
+  { submit(*current_); }
+
+  while (status_.pending_writes > 0 && error_ == 0)
+  { reap(1); }
+
+  if (direct_ && ftruncate(fd_, static_cast<off_t>(size_)) != 0 && error_ == 0)
+  { error_ = errno; }
+
+  throwOnError();
+}
+
+void FileWriter::close()
+{
+  if (fd_ < 0)
+  { return; }
+
+  try
+  { flush(); }
+  catch (...)
+  {
+    ring_.reset();
+    ::close(fd_);
+    fd_ = -1;
+    throw;
+  }
+
+  ring_.reset();
+  ::close(fd_);
+  fd_ = -1;
+}
+
+FileWriter::Status FileWriter::getStatus() const
+{ return status_; }
+
+LatencyHistogram FileWriter::getLatency(const std::chrono::seconds window) const
+{ return latency_.getWindow(Clock::now(), window); }
+
+FileWriter::Backend FileWriter::getBackend() const
+{
+  return ring_
+         ? Backend::IoUring
+         : Backend::Pwrite;
+}
+
+bool FileWriter::isDirect() const
+{ return direct_; }
+
+size_t FileWriter::getSize() const
+{ return size_; }
+
+size_t FileWriter::acquireBuffer()
+{
+  while (free_buffers_.empty())
+  {
+    reap(1);
+    throwOnError();
+  }
+
+  const auto index = free_buffers_.back();
+  free_buffers_.pop_back();
+
+  auto& buffer = buffers_[index];
+  buffer.size = 0;
+  buffer.offset = file_offset_;
+
+  return index;
+}
+
+void FileWriter::submit(const size_t index)
+{
+  auto& buffer = buffers_[index];
+  buffer.length = direct_
+                  ? roundUp(buffer.size, alignment)
+                  : buffer.size;
+
+  if (buffer.length > buffer.size)
+  { std::memset(buffer.data.get() + buffer.size, 0, buffer.length - buffer.size); }
+
+  buffer.submitted = Clock::now();
+  ++status_.pending_writes;
+
+  if (ring_)
+  {
+    if (!ring_->queueWrite(fd_, index, buffer.data.get(), buffer.length, buffer.offset))
+    { complete(index, -errno); }
+  }
+  else
+  { complete(index, writeAll(fd_, buffer.data.get(), buffer.length, buffer.offset)); }
+}
+
+void FileWriter::complete(const size_t index, const int64_t result)
+{
+  const auto& buffer = buffers_[index];
+  const auto now = Clock::now();
+
+  --status_.pending_writes;
+  latency_.record(now, now - buffer.submitted);
+
+  if (result < 0)
+  {
+    if (error_ == 0)
+    { error_ = static_cast<int>(-result); }
+  }
+  else if (static_cast<size_t>(result) != buffer.length)
+  {
+    if (error_ == 0)
+    { error_ = ENOSPC; }
+  }
+  else
+  {
+    status_.num_bytes += buffer.length;
+    ++status_.num_writes;
+  }
+
+  // A flushed buffer that is not full stays current, and is written again when it has more data
+  if (!current_ || *current_ != index)
+  { free_buffers_.push_back(index); }
+}
+
+void FileWriter::reap(const unsigned int min_complete)
+{
+  if (!ring_)
+  { return; }
+
+  if (!ring_->enter(min_complete) && error_ == 0)
+  { error_ = errno; }
+
+  ring_->forEachCompletion(
+    [this](const size_t buffer, const int64_t result)
+    { complete(buffer, result); }
+  );
+}
+
+void FileWriter::throwOnError() const
+{
+  if (error_ != 0)
+  { throw makeError(path_, "write failed", error_); }
+}
+}
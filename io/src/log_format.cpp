@@ -0,0 +1,15 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/io/log_format.h"
+
+#include <cstdio>
+
+namespace flow::io::log_format
+{
+std::string getSegmentFileName(const uint32_t segment)
+{
+  char name[32];
+  std::snprintf(name, sizeof(name), "segment-%06u.log", segment);
+
+  return name;
+}
+}
@@ -0,0 +1,191 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/io/log_reader.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace flow::io
+{
+namespace
+{
+std::runtime_error makeError(const std::string& path, const std::string& what)
+{
+  return std::runtime_error{"LogReader '" + path + "': " + what};
+}
+}
+
+LogReader::LogReader(const std::string& directory)
+  : directory_{directory}
+{
+  const auto index_path = fs::path{directory} / log_format::index_file_name;
+  std::ifstream index_file{index_path, std::ios::binary};
+
+  if (!index_file)
+  { throw makeError(directory, "no recording found"); }
+
+  log_format::IndexEntry entry;
+
+  while (index_file.read(reinterpret_cast<char*>(&entry), sizeof(entry)))
+  { index_.push_back(entry); }
+
+  while (fs::exists(fs::path{directory} / log_format::getSegmentFileName(num_segments_)))
+  { ++num_segments_; }
+
+  rewind();
+}
+
+LogReader::~LogReader()
+{
+  closeSegment();
+}
+
+std::optional<LogReader::Record> LogReader::next()
+{
+  const auto header = peek();
+
+  if (!header)
+  { return std::nullopt; }
+
+  const Record record{header->timestamp, {data_ + offset_ + sizeof(*header), static_cast<size_t>(header->size)}};
+  offset_ += log_format::getRecordSize(header->size);
+
+  return record;
+}
+
+void LogReader::seek(const int64_t timestamp)
+{
+  const auto later = std::lower_bound(
+    index_.begin(), index_.end(), timestamp,
+    [](const log_format::IndexEntry& entry, const int64_t value)
+    { return entry.timestamp < value; }
+  );
+
+  if (later == index_.begin())
+  {
+    rewind();
+    return;
+  }
+
+  const auto& entry = *std::prev(later);
+
+  if (entry.segment != segment_ || data_ == nullptr)
+  { openSegment(entry.segment); }
+
+  offset_ = entry.offset;
+
+  for (auto header = peek(); header && header->timestamp < timestamp; header = peek())
+  { offset_ += log_format::getRecordSize(header->size); }
+}
+
+void LogReader::rewind()
+{
+  if (segment_ != 0 || data_ == nullptr)
+  { openSegment(0); }
+
+  offset_ = sizeof(log_format::SegmentHeader);
+}
+
+int64_t LogReader::getStartTime() const
+{
+  return index_.empty() ? 0 : index_.front().timestamp;
+}
+
+size_t LogReader::getNumSegments() const
+{
+  return num_segments_;
+}
+
+const std::vector<log_format::IndexEntry>& LogReader::getIndex() const
+{
+  return index_;
+}
+
+bool LogReader::openSegment(const uint32_t segment)
+{
+  closeSegment();
+  segment_ = segment;
+
+  if (segment >= num_segments_)
+  { return false; }
+
+  const auto path = (fs::path{directory_} / log_format::getSegmentFileName(segment)).string();
+  const int file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  struct stat file_status{};
+
+  if (file < 0 || ::fstat(file, &file_status) != 0)
+  {
+    if (file >= 0)
+    { ::close(file); }
+
+    throw makeError(path, std::string{"cannot open segment: "} + std::strerror(errno));
+  }
+
+  const auto size = static_cast<size_t>(file_status.st_size);
+  void* mapping = size > 0 ? ::mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0) : MAP_FAILED;
+  ::close(file);
+
+  if (mapping == MAP_FAILED)
+  { throw makeError(path, std::string{"cannot map segment: "} + std::strerror(errno)); }
+
+  data_ = static_cast<const std::byte*>(mapping);
+  size_ = size;
+
+  log_format::SegmentHeader header;
+
+  if (size_ < sizeof(header))
+  { throw makeError(path, "the segment is truncated"); }
+
+  std::memcpy(&header, data_, sizeof(header));
+
+  if (header.magic != log_format::magic_number || header.format != log_format::current_format
+      || header.segment != segment)
+  { throw makeError(path, "the segment has no valid header"); }
+
+  ::madvise(const_cast<std::byte*>(data_), size_, MADV_SEQUENTIAL);
+  offset_ = sizeof(header);
+
+  return true;
+}
+
+void LogReader::closeSegment()
+{
+  if (data_ != nullptr)
+  { ::munmap(const_cast<std::byte*>(data_), size_); }
+
+  data_ = nullptr;
+  size_ = 0;
+  offset_ = 0;
+}
+
+std::optional<log_format::RecordHeader> LogReader::peek()
+{
+  while (data_ != nullptr)
+  {
+    log_format::RecordHeader header;
+
+    if (offset_ + sizeof(header) <= size_)
+    {
+      std::memcpy(&header, data_ + offset_, sizeof(header));
+
+      // A record of size 0 marks the end of a segment that was not truncated
+      if (header.size > 0 && offset_ + log_format::getRecordSize(header.size) <= size_)
+      { return header; }
+    }
+
+    openSegment(segment_ + 1);
+  }
+
+  return std::nullopt;
+}
+}
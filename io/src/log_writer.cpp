@@ -0,0 +1,387 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/io/log_writer.h"
+#include "superflow/io/log_format.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace flow::io
+{
+namespace
+{
+std::runtime_error makeError(const std::string& path, const std::string& what)
+{
+  return std::runtime_error{"LogWriter '" + path + "': " + what + ": " + std::strerror(errno)};
+}
+
+int64_t getTimestamp()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::system_clock::now().time_since_epoch()
+  ).count();
+}
+
+bool writeAll(const int file, const void* data, const size_t size)
+{
+  const auto* bytes = static_cast<const std::byte*>(data);
+  size_t written = 0;
+
+  while (written < size)
+  {
+    const auto result = ::write(file, bytes + written, size - written);
+
+    if (result < 0 && errno == EINTR)
+    { continue; }
+
+    if (result <= 0)
+    { return false; }
+
+    written += static_cast<size_t>(result);
+  }
+
+  return true;
+}
+
+size_t countRecords(const std::vector<std::byte>& batch)
+{
+  size_t num_records = 0;
+
+  for (size_t offset = 0; offset < batch.size(); ++num_records)
+  {
+    log_format::RecordHeader record;
+    std::memcpy(&record, batch.data() + offset, sizeof(record));
+    offset += log_format::getRecordSize(record.size);
+  }
+
+  return num_records;
+}
+}
+
+struct LogWriter::Segment
+{
+  uint32_t number = 0;
+  int file = -1;
+  std::byte* data = nullptr;
+  size_t size = 0;
+  size_t used = 0;
+
+  /// Create the segment file with its full size, and map it
+  Segment(const std::string& directory, const uint32_t segment_number, const size_t segment_size)
+    : number{segment_number}
+    , size{segment_size}
+  {
+    const auto path = (fs::path{directory} / log_format::getSegmentFileName(number)).string();
+    file = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+    if (file < 0)
+    { throw makeError(path, "cannot create segment"); }
+
+    // Reserve the blocks up front, so that a full disk fails here rather than with SIGBUS in a write
+    const int result = ::posix_fallocate(file, 0, static_cast<off_t>(size));
+
+    if (result != 0 && (result != EOPNOTSUPP || ::ftruncate(file, static_cast<off_t>(size)) != 0))
+    {
+      errno = result;
+      const auto error = makeError(path, "cannot allocate segment");
+      ::close(file);
+      ::unlink(path.c_str());
+
+      throw error;
+    }
+
+    void* mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+
+    if (mapping == MAP_FAILED)
+    {
+      const auto error = makeError(path, "cannot map segment");
+      ::close(file);
+
+      throw error;
+    }
+
+    data = static_cast<std::byte*>(mapping);
+
+    const log_format::SegmentHeader header{log_format::magic_number, log_format::current_format, number};
+    std::memcpy(data, &header, sizeof(header));
+    used = sizeof(header);
+  }
+
+  /// Unmap the segment, and truncate it to the size used
+  ~Segment()
+  {
+    ::munmap(data, size);
+
+    if (::ftruncate(file, static_cast<off_t>(used)) != 0)
+    { std::cerr << "LogWriter: cannot truncate segment " << number << ": " << std::strerror(errno) << std::endl; }
+
+    ::close(file);
+  }
+
+  Segment(const Segment&) = delete;
+  Segment& operator=(const Segment&) = delete;
+};
+
+LogWriter::LogWriter(const std::string& directory)
+  : LogWriter{directory, Options{}}
+{}
+
+LogWriter::LogWriter(const std::string& directory, const Options& options)
+  : directory_{directory}
+  , options_{options}
+{
+  if (options.segment_size <= sizeof(log_format::SegmentHeader) || options.max_batch_size == 0)
+  { throw std::invalid_argument{"LogWriter '" + directory + "': the segment and batch sizes are too small"}; }
+
+  const auto index_path = fs::path{directory} / log_format::index_file_name;
+
+  if (fs::exists(index_path))
+  { throw std::invalid_argument{"LogWriter '" + directory + "': the directory already holds a recording"}; }
+
+  std::error_code error;
+  fs::create_directories(directory, error);
+
+  if (error)
+  { throw std::runtime_error{"LogWriter '" + directory + "': cannot create directory: " + error.message()}; }
+
+  index_file_ = ::open(index_path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+
+  if (index_file_ < 0)
+  { throw makeError(index_path.string(), "cannot create index"); }
+
+  try
+  { segment_ = std::make_unique<Segment>(directory_, 0, options_.segment_size); }
+  catch (...)
+  {
+    ::close(index_file_);
+    throw;
+  }
+
+  status_.num_segments = 1;
+  last_indexed_ = std::numeric_limits<int64_t>::min();
+  thread_ = std::thread{[this]() { run(); }};
+}
+
+LogWriter::~LogWriter()
+{
+  close();
+}
+
+bool LogWriter::append(const ByteView header, const ByteView payload)
+{
+  const size_t message_size = header.size + payload.size;
+  const size_t record_size = log_format::getRecordSize(message_size);
+  bool was_empty;
+
+  {
+    std::scoped_lock lock{mutex_};
+
+    if (closing_ || batch_.size() + record_size > options_.max_batch_size)
+    {
+      ++status_.num_dropped;
+      return false;
+    }
+
+    const log_format::RecordHeader record{getTimestamp(), message_size};
+    was_empty = batch_.empty();
+
+    if (was_empty)
+    { oldest_pending_ = record.timestamp; }
+
+    const auto offset = batch_.size();
+    batch_.resize(offset + record_size);
+
+    auto* data = batch_.data() + offset;
+    std::memcpy(data, &record, sizeof(record));
+    data += sizeof(record);
+
+    if (header.size > 0)
+    { std::memcpy(data, header.data, header.size); }
+
+    if (payload.size > 0)
+    { std::memcpy(data + header.size, payload.data, payload.size); }
+  }
+
+  // The thread only waits when the batch is empty
+  if (was_empty)
+  { has_batch_.notify_one(); }
+
+  return true;
+}
+
+void LogWriter::flush()
+{
+  std::unique_lock lock{mutex_};
+  is_written_.wait(lock, [this]() { return closed_ || (batch_.empty() && writing_size_ == 0); });
+}
+
+void LogWriter::close()
+{
+  {
+    std::scoped_lock lock{mutex_};
+
+    if (closing_)
+    { return; }
+
+    closing_ = true;
+  }
+
+  has_batch_.notify_one();
+
+  if (thread_.joinable())
+  { thread_.join(); }
+
+  segment_.reset();
+
+  if (index_file_ >= 0)
+  {
+    ::close(index_file_);
+    index_file_ = -1;
+  }
+}
+
+LogWriter::Status LogWriter::getStatus() const
+{
+  std::scoped_lock lock{mutex_};
+  auto status = status_;
+  status.pending_bytes = batch_.size() + writing_size_;
+
+  const auto oldest = writing_size_ > 0 ? oldest_writing_ : batch_.empty() ? 0 : oldest_pending_;
+
+  if (oldest != 0)
+  { status.lag = std::max(static_cast<double>(getTimestamp() - oldest) * 1e-9, 0.); }
+
+  return status;
+}
+
+const std::string& LogWriter::getDirectory() const
+{
+  return directory_;
+}
+
+void LogWriter::run()
+{
+  std::vector<std::byte> writing;
+
+  while (true)
+  {
+    {
+      std::unique_lock lock{mutex_};
+      has_batch_.wait(lock, [this]() { return closing_ || !batch_.empty(); });
+
+      if (batch_.empty())
+      { break; }
+
+      writing.swap(batch_);
+      writing_size_ = writing.size();
+      oldest_writing_ = oldest_pending_;
+    }
+
+    const bool ok = write(writing);
+    writing.clear();
+
+    {
+      std::scoped_lock lock{mutex_};
+      writing_size_ = 0;
+
+      if (!ok)
+      {
+        status_.failed = true;
+        status_.num_dropped += countRecords(batch_);
+        closing_ = true;
+        batch_.clear();
+      }
+    }
+
+    is_written_.notify_all();
+  }
+
+  {
+    std::scoped_lock lock{mutex_};
+    closed_ = true;
+  }
+
+  is_written_.notify_all();
+}
+
+bool LogWriter::write(const std::vector<std::byte>& batch)
+{
+  const auto index_interval = static_cast<int64_t>(options_.index_interval * 1e9);
+  std::vector<log_format::IndexEntry> index_entries;
+  size_t num_records = 0;
+  size_t num_bytes = 0;
+  size_t num_segments = 0;
+  size_t num_lost = 0;
+  bool ok = true;
+
+  for (size_t offset = 0; offset < batch.size();)
+  {
+    log_format::RecordHeader record;
+    std::memcpy(&record, batch.data() + offset, sizeof(record));
+    const auto record_size = log_format::getRecordSize(record.size);
+
+    if (!ok)
+    {
+      ++num_lost;
+      offset += record_size;
+      continue;
+    }
+
+    if (segment_->used + record_size > segment_->size)
+    {
+      const auto number = segment_->number + 1;
+      segment_.reset();
+
+      try
+      {
+        segment_ = std::make_unique<Segment>(
+          directory_, number, std::max(options_.segment_size, sizeof(log_format::SegmentHeader) + record_size)
+        );
+        ++num_segments;
+      }
+      catch (const std::exception& e)
+      {
+        std::cerr << e.what() << std::endl;
+        ok = false;
+        continue;
+      }
+    }
+
+    const bool is_first = segment_->used == sizeof(log_format::SegmentHeader);
+
+    if (is_first || record.timestamp - last_indexed_ >= index_interval)
+    {
+      index_entries.push_back({record.timestamp, segment_->number, 0, segment_->used});
+      last_indexed_ = record.timestamp;
+    }
+
+    std::memcpy(segment_->data + segment_->used, batch.data() + offset, record_size);
+    segment_->used += record_size;
+    offset += record_size;
+    ++num_records;
+    num_bytes += record_size;
+  }
+
+  if (!index_entries.empty()
+      && !writeAll(index_file_, index_entries.data(), index_entries.size() * sizeof(log_format::IndexEntry)))
+  { std::cerr << "LogWriter '" << directory_ << "': cannot write index: " << std::strerror(errno) << std::endl; }
+
+  std::scoped_lock lock{mutex_};
+  status_.num_records += num_records;
+  status_.num_bytes += num_bytes;
+  status_.num_segments += num_segments;
+  status_.num_dropped += num_lost;
+
+  return ok;
+}
+}
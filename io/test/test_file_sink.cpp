@@ -0,0 +1,206 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/io/file_sink_proxel.h"
+#include "superflow/io/file_writer.h"
+
+#include "superflow/graph.h"
+#include "superflow/producer_port.h"
+
+#include "gtest/gtest.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+namespace fs = std::filesystem;
+using namespace flow;
+using namespace flow::io;
+
+namespace
+{
+/// Removes the file of the test when it goes out of scope
+class TempFile
+{
+public:
+  TempFile()
+    : path_{fs::temp_directory_path() / ("superflow-test-" + std::to_string(getpid()) + '-' + getTestName())}
+  {}
+
+  ~TempFile()
+  { fs::remove(path_); }
+
+  std::string string() const
+  { return path_.string(); }
+
+  std::string read() const
+  {
+    std::ifstream file{path_, std::ios::binary};
+    return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+  }
+
+private:
+  fs::path path_;
+
+  static std::string getTestName()
+  {
+    std::string name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    std::replace(name.begin(), name.end(), '/', '-');
+
+    return name;
+  }
+};
+
+ByteView toView(const std::string& text)
+{ return {reinterpret_cast<const std::byte*>(text.data()), text.size()}; }
+
+std::string makeData(const size_t size, const char seed)
+{
+  std::string data(size, '\0');
+
+  for (size_t i = 0; i < size; ++i)
+  { data[i] = static_cast<char>(seed + static_cast<char>(i % 61)); }
+
+  return data;
+}
+
+class SourceProxel : public Proxel
+{
+public:
+  SourceProxel()
+    : out_port_{std::make_shared<ProducerPort<std::string>>()}
+  {
+    registerPorts({{"out", out_port_}});
+  }
+
+  void start() override
+  {}
+
+  void stop() noexcept override
+  {}
+
+  void send(const std::string& item)
+  { out_port_->send(item); }
+
+private:
+  ProducerPort<std::string>::Ptr out_port_;
+};
+}
+
+class FileWriterTest : public ::testing::TestWithParam<std::tuple<bool, bool>>
+{};
+
+TEST_P(FileWriterTest, dataIsWrittenInOrder)
+{
+  const TempFile file;
+  FileWriter::Options options;
+  options.block_size = 4 * FileWriter::alignment;
+  options.queue_depth = 2;
+  options.io_uring = std::get<0>(GetParam());
+  options.direct = std::get<1>(GetParam());
+
+  std::string expected;
+  FileWriter writer{file.string(), options};
+
+  for (size_t i = 0; i < 40; ++i)
+  {
+    const auto data = makeData(i * 97 % 5000, static_cast<char>('a' + i % 20));
+    writer.write(toView(data));
+    expected += data;
+
+    if (i == 13)
+    {
+      writer.flush();
+      EXPECT_EQ(expected, file.read());
+    }
+  }
+
+  writer.close();
+
+  EXPECT_EQ(expected.size(), writer.getSize());
+  EXPECT_EQ(expected, file.read());
+  EXPECT_EQ(0, writer.getStatus().pending_writes);
+  EXPECT_LE(expected.size(), writer.getStatus().num_bytes);
+  EXPECT_LT(0, writer.getLatency(std::chrono::seconds{10}).getCount());
+  EXPECT_THROW(writer.write(toView("closed")), std::runtime_error);
+
+  if (!options.io_uring)
+  { EXPECT_EQ(FileWriter::Backend::Pwrite, writer.getBackend()); }
+
+  if (!options.direct)
+  { EXPECT_FALSE(writer.isDirect()); }
+}
+
+TEST_P(FileWriterTest, writeSpanningMoreBlocksThanQueueDepth)
+{
+  const TempFile file;
+  FileWriter::Options options;
+  options.block_size = FileWriter::alignment;
+  options.queue_depth = 1;
+  options.io_uring = std::get<0>(GetParam());
+  options.direct = std::get<1>(GetParam());
+
+  const auto data = makeData(5 * FileWriter::alignment + 100, 'a');
+  FileWriter writer{file.string(), options};
+
+  writer.write(toView(data));
+  writer.close();
+
+  EXPECT_EQ(data, file.read());
+  EXPECT_EQ(0, writer.getStatus().pending_writes);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  Backends,
+  FileWriterTest,
+  ::testing::Combine(::testing::Bool(), ::testing::Bool())
+);
+
+TEST(FileWriter, invalidArgumentsThrow)
+{
+  const TempFile file;
+  FileWriter::Options options;
+
+  options.block_size = FileWriter::alignment + 1;
+  EXPECT_THROW((FileWriter{file.string(), options}), std::invalid_argument);
+
+  options.block_size = FileWriter::alignment;
+  options.queue_depth = 0;
+  EXPECT_THROW((FileWriter{file.string(), options}), std::invalid_argument);
+
+  EXPECT_THROW(FileWriter{"/nonexistent/superflow/file"}, std::runtime_error);
+}
+
+TEST(FileSinkProxel, writesReceivedItems)
+{
+  const TempFile file;
+  FileWriter::Options options;
+  options.block_size = FileWriter::alignment;
+
+  const auto source = std::make_shared<SourceProxel>();
+  const auto sink = std::make_shared<FileSinkProxel<std::string, LeakPolicy::PushBlocking>>(file.string(), options);
+
+  Graph graph{{{"source", source}, {"sink", sink}}};
+  graph.connect("source", "out", "sink", "in");
+  graph.start();
+
+  std::string expected;
+
+  for (int i = 0; i < 100; ++i)
+  {
+    const auto data = makeData(100 + i, 'a');
+    source->send(data);
+    expected += data;
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds{20});
+  graph.stop();
+
+  EXPECT_EQ(expected, file.read());
+
+  const auto status = graph.getProxelStatuses().at("sink");
+  EXPECT_LE(static_cast<double>(expected.size()), status.fields.at("bytes").value);
+  EXPECT_EQ(0., status.fields.at("pending_writes").value);
+}
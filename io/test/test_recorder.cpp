@@ -0,0 +1,239 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/io/log_reader.h"
+#include "superflow/io/log_writer.h"
+#include "superflow/io/recorder_proxel.h"
+
+#include "superflow/graph.h"
+#include "superflow/producer_port.h"
+
+#include "gtest/gtest.h"
+
+#include <unistd.h>
+
+#include <filesystem>
+#include <thread>
+
+namespace fs = std::filesystem;
+using namespace flow;
+using namespace flow::io;
+
+namespace
+{
+/// Removes the recording directory of the test when it goes out of scope
+class TempDirectory
+{
+public:
+  TempDirectory()
+    : path_{
+        fs::temp_directory_path() / ("superflow-test-" + std::to_string(getpid()) + '-'
+                                     + ::testing::UnitTest::GetInstance()->current_test_info()->name())
+      }
+  { fs::remove_all(path_); }
+
+  ~TempDirectory()
+  { fs::remove_all(path_); }
+
+  std::string string() const
+  { return path_.string(); }
+
+private:
+  fs::path path_;
+};
+
+class SourceProxel : public Proxel
+{
+public:
+  SourceProxel()
+    : out_port_{std::make_shared<ProducerPort<int>>()}
+  {
+    registerPorts({{"out", out_port_}});
+  }
+
+  void start() override
+  {}
+
+  void stop() noexcept override
+  {}
+
+  void send(const int item)
+  { out_port_->send(item); }
+
+private:
+  ProducerPort<int>::Ptr out_port_;
+};
+
+void append(LogWriter& writer, const int item)
+{
+  std::vector<std::byte> message;
+  codec::encodeMessage(item, message);
+  writer.append({message.data(), message.size()}, {});
+}
+
+int decode(const LogReader::Record& record)
+{
+  return codec::decodeMessage<int>(record.message.data, record.message.size);
+}
+}
+
+TEST(LogWriter, recordsAreReadBackInOrder)
+{
+  const TempDirectory directory;
+  constexpr int num_items = 1000;
+
+  {
+    LogWriter writer{directory.string()};
+
+    for (int i = 0; i < num_items; ++i)
+    { append(writer, i); }
+
+    writer.flush();
+
+    const auto status = writer.getStatus();
+    EXPECT_EQ(num_items, status.num_records);
+    EXPECT_EQ(0, status.num_dropped);
+    EXPECT_EQ(0, status.pending_bytes);
+    EXPECT_EQ(num_items * log_format::getRecordSize(sizeof(CodecHeader) + sizeof(int)), status.num_bytes);
+  }
+
+  LogReader reader{directory.string()};
+  int64_t previous = 0;
+
+  for (int i = 0; i < num_items; ++i)
+  {
+    const auto record = reader.next();
+    ASSERT_TRUE(record.has_value());
+    EXPECT_EQ(i, decode(*record));
+    EXPECT_GE(record->timestamp, previous);
+    previous = record->timestamp;
+  }
+
+  EXPECT_FALSE(reader.next().has_value());
+}
+
+TEST(LogWriter, recordingIsSplitIntoSegments)
+{
+  const TempDirectory directory;
+  LogWriter::Options options;
+  options.segment_size = 4096;
+
+  {
+    LogWriter writer{directory.string(), options};
+    const std::vector<std::byte> large(10000);
+
+    for (int i = 0; i < 100; ++i)
+    { append(writer, i); }
+
+    writer.append({large.data(), large.size()}, {});
+    append(writer, 100);
+  }
+
+  LogReader reader{directory.string()};
+  EXPECT_GT(reader.getNumSegments(), 2);
+  EXPECT_EQ(reader.getNumSegments(), reader.getIndex().size());
+
+  for (int i = 0; i < 100; ++i)
+  { EXPECT_EQ(i, decode(*reader.next())); }
+
+  EXPECT_EQ(10000, reader.next()->message.size);
+  EXPECT_EQ(100, decode(*reader.next()));
+  EXPECT_FALSE(reader.next().has_value());
+
+  reader.rewind();
+  EXPECT_EQ(0, decode(*reader.next()));
+}
+
+TEST(LogWriter, seekUsesTimeIndex)
+{
+  const TempDirectory directory;
+  LogWriter::Options options;
+  options.segment_size = 4096;
+  options.index_interval = 0.;
+
+  {
+    LogWriter writer{directory.string(), options};
+
+    for (int i = 0; i < 200; ++i)
+    {
+      append(writer, i);
+
+      if (i % 50 == 49)
+      { std::this_thread::sleep_for(std::chrono::milliseconds{2}); }
+    }
+  }
+
+  LogReader reader{directory.string()};
+  std::vector<std::pair<int64_t, int>> records;
+
+  while (const auto record = reader.next())
+  { records.emplace_back(record->timestamp, decode(*record)); }
+
+  ASSERT_EQ(200, records.size());
+
+  for (const size_t i : {0, 49, 50, 120, 199})
+  {
+    reader.seek(records[i].first);
+    const auto record = reader.next();
+    ASSERT_TRUE(record.has_value());
+    EXPECT_EQ(records[i].first, record->timestamp);
+    EXPECT_LE(decode(*record), records[i].second);
+  }
+
+  reader.seek(records.back().first + 1);
+  EXPECT_FALSE(reader.next().has_value());
+}
+
+TEST(LogWriter, fullBatchDropsInsteadOfBlocking)
+{
+  const TempDirectory directory;
+  LogWriter::Options options;
+  options.max_batch_size = log_format::getRecordSize(sizeof(CodecHeader) + sizeof(int));
+
+  LogWriter writer{directory.string(), options};
+  const std::vector<std::byte> large(options.max_batch_size);
+
+  EXPECT_FALSE(writer.append({large.data(), large.size()}, {}));
+  EXPECT_EQ(1, writer.getStatus().num_dropped);
+
+  writer.close();
+  EXPECT_FALSE(writer.append({large.data(), 1}, {}));
+}
+
+TEST(LogWriter, existingRecordingThrows)
+{
+  const TempDirectory directory;
+  LogWriter writer{directory.string()};
+
+  EXPECT_THROW(LogWriter{directory.string()}, std::invalid_argument);
+  EXPECT_THROW(LogReader{directory.string() + "/missing"}, std::runtime_error);
+}
+
+TEST(RecorderProxel, recordsConnectedEdge)
+{
+  const TempDirectory directory;
+  const auto source = std::make_shared<SourceProxel>();
+  const auto recorder = std::make_shared<io::RecorderProxel<int>>(
+    directory.string(), LogWriter::Options{}, std::chrono::milliseconds{1}
+  );
+
+  Graph graph{{{"source", source}, {"recorder", recorder}}};
+  graph.connect("source", "out", "recorder", "in");
+  graph.start();
+
+  for (int i = 0; i < 100; ++i)
+  { source->send(i); }
+
+  recorder->getWriter().flush();
+  std::this_thread::sleep_for(std::chrono::milliseconds{50});
+
+  const auto status = graph.getProxelStatuses().at("recorder");
+  EXPECT_EQ(100., status.fields.at("records").value);
+  EXPECT_EQ(0., status.fields.at("dropped").value);
+  EXPECT_EQ(0., status.fields.at("pending_bytes").value);
+
+  graph.stop();
+
+  LogReader reader{directory.string()};
+
+  for (int i = 0; i < 100; ++i)
+  { EXPECT_EQ(i, decode(*reader.next())); }
+}
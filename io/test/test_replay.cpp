@@ -0,0 +1,182 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/io/log_writer.h"
+#include "superflow/io/replay_proxel.h"
+
+#include "superflow/buffered_consumer_port.h"
+#include "superflow/graph.h"
+
+#include "gtest/gtest.h"
+
+#include <unistd.h>
+
+#include <filesystem>
+#include <future>
+#include <numeric>
+#include <thread>
+
+namespace fs = std::filesystem;
+using namespace flow;
+using namespace flow::io;
+
+namespace
+{
+constexpr int num_items = 11;
+constexpr std::chrono::milliseconds item_period{10};
+
+/// Writes a recording of `size` ints, `item_period` apart, and removes it when it goes out of scope
+class TestRecording
+{
+public:
+  explicit TestRecording(const int size = num_items)
+    : path_{
+        fs::temp_directory_path() / ("superflow-test-" + std::to_string(getpid()) + '-'
+                                     + ::testing::UnitTest::GetInstance()->current_test_info()->name())
+      }
+  {
+    fs::remove_all(path_);
+    LogWriter writer{path_.string()};
+
+    for (int i = 0; i < size; ++i)
+    {
+      if (i > 0)
+      { std::this_thread::sleep_for(item_period); }
+
+      std::vector<std::byte> message;
+      codec::encodeMessage(i, message);
+      writer.append({message.data(), message.size()}, {});
+    }
+  }
+
+  ~TestRecording()
+  { fs::remove_all(path_); }
+
+  std::string string() const
+  { return path_.string(); }
+
+private:
+  fs::path path_;
+};
+
+using InPort = BufferedConsumerPort<int, ConnectPolicy::Single, GetMode::Blocking, LeakPolicy::PushBlocking>;
+
+class SinkProxel : public Proxel
+{
+public:
+  SinkProxel()
+    : in_port_{std::make_shared<InPort>(1)}
+  {
+    registerPorts({{"in", in_port_}});
+  }
+
+  void start() override
+  {
+    for (const auto item : *in_port_)
+    {
+      std::scoped_lock lock{mutex_};
+      items_.push_back(item);
+    }
+  }
+
+  void stop() noexcept override
+  { in_port_->deactivate(); }
+
+  std::vector<int> getItems()
+  {
+    std::scoped_lock lock{mutex_};
+    return items_;
+  }
+
+private:
+  InPort::Ptr in_port_;
+  std::mutex mutex_;
+  std::vector<int> items_;
+};
+
+std::chrono::duration<double> timeReplay(const std::string& directory, const double speed)
+{
+  ReplayProxel<int> replay{directory, {speed, false}};
+
+  const auto start_time = std::chrono::steady_clock::now();
+  replay.start();
+
+  return std::chrono::steady_clock::now() - start_time;
+}
+}
+
+TEST(ReplayProxel, fastReplayDeliversEveryItemThroughPushBlocking)
+{
+  const TestRecording recording;
+  const auto replay = std::make_shared<ReplayProxel<int>>(recording.string(), ReplayProxel<int>::Options{0., false});
+  const auto sink = std::make_shared<SinkProxel>();
+
+  Graph graph{{{"replay", replay}, {"sink", sink}}};
+  graph.connect("replay", "out", "sink", "in");
+  graph.start();
+
+  for (int i = 0; i < 100 && sink->getItems().size() < num_items; ++i)
+  { std::this_thread::sleep_for(std::chrono::milliseconds{5}); }
+
+  graph.stop();
+
+  std::vector<int> expected(num_items);
+  std::iota(expected.begin(), expected.end(), 0);
+  EXPECT_EQ(expected, sink->getItems());
+}
+
+TEST(ReplayProxel, speedScalesRecordedTiming)
+{
+  const TestRecording recording;
+  const auto recorded = (num_items - 1) * item_period;
+
+  EXPECT_GE(timeReplay(recording.string(), 1.), recorded);
+  EXPECT_LT(timeReplay(recording.string(), 10.), recorded / 2);
+  EXPECT_LT(timeReplay(recording.string(), 0.), recorded / 2);
+}
+
+TEST(ReplayProxel, stopInterruptsWait)
+{
+  const TestRecording recording;
+  ReplayProxel<int> replay{recording.string(), {0.001, true}};
+
+  auto done = std::async(std::launch::async, [&replay]() { replay.start(); });
+  std::this_thread::sleep_for(std::chrono::milliseconds{10});
+  replay.stop();
+
+  EXPECT_EQ(std::future_status::ready, done.wait_for(std::chrono::seconds{1}));
+}
+
+TEST(ReplayProxel, emptyRecordingIsNotLooped)
+{
+  const TestRecording recording{0};
+  ReplayProxel<int> replay{recording.string(), {1., true}};
+
+  auto done = std::async(std::launch::async, [&replay]() { replay.start(); });
+
+  EXPECT_EQ(std::future_status::ready, done.wait_for(std::chrono::seconds{1}));
+  replay.stop();
+}
+
+TEST(ReplayProxel, stopBeforeStartIsKept)
+{
+  const TestRecording recording;
+  ReplayProxel<int> replay{recording.string(), {0., false}};
+  const auto consumer = std::make_shared<InPort>(2 * num_items);
+  replay.getPort("out")->connect(consumer);
+
+  replay.stop();
+  replay.start();
+  EXPECT_EQ(0, consumer->getQueueSize());
+
+  replay.start();
+  replay.stop();
+  replay.start();
+  EXPECT_EQ(2 * num_items, consumer->getQueueSize());
+}
+
+TEST(ReplayProxel, invalidArgumentsThrow)
+{
+  const TestRecording recording;
+
+  EXPECT_THROW((ReplayProxel<int>{recording.string(), {-1., false}}), std::invalid_argument);
+  EXPECT_THROW(ReplayProxel<int>{recording.string() + "/missing"}, std::runtime_error);
+}
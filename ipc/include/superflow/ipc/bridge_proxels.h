@@ -0,0 +1,201 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include "superflow/ipc/shm_consumer_port.h"
+#include "superflow/ipc/shm_producer_port.h"
+#include "superflow/ipc/socket_consumer_port.h"
+#include "superflow/ipc/socket_producer_port.h"
+
+#include "superflow/callback_consumer_port.h"
+#include "superflow/factory_map.h"
+#include "superflow/producer_port.h"
+#include "superflow/proxel.h"
+#include "superflow/value.h"
+
+#include <memory>
+#include <string>
+
+namespace flow::ipc
+{
+/// \brief Sends the items received on its "in" port to another process, through a transport port.
+///
+/// Stands in for the consumer of an edge whose consumer runs in another process, where a
+/// BridgeSourceProxel passes the items on. The items are sent on the thread of the producer,
+/// so the bridge adds no thread and no buffer of its own. The transport port is registered as
+/// "transport", so that its status is reported with the Proxel.
+/// \tparam T The type of data to send
+/// \tparam Transport ShmProducerPort or SocketProducerPort of T
+/// \see createShmBridgeFactories, createSocketBridgeFactories
+template<typename T, typename Transport>
+class BridgeSinkProxel final : public Proxel
+{
+public:
+  explicit BridgeSinkProxel(std::shared_ptr<Transport> transport)
+    : transport_{std::move(transport)}
+    , in_port_{std::make_shared<InPort>([transport = transport_](const T& item) { transport->send(item); })}
+  {
+    registerPorts({{"in", in_port_}, {"transport", transport_}});
+  }
+
+  void start() override
+  { setState(State::Running); }
+
+  void stop() noexcept override
+  {
+    transport_->deactivate();
+    setState(State::Unavailable);
+  }
+
+private:
+  using InPort = CallbackConsumerPort<T, ConnectPolicy::Multi>;
+
+  std::shared_ptr<Transport> transport_;
+  typename InPort::Ptr in_port_;
+};
+
+/// \brief Sends the items received from another process through a transport port on its "out" port.
+///
+/// Stands in for the producer of an edge whose producer runs in another process, where a
+/// BridgeSinkProxel sends the items. The transport port is registered as "transport", so that
+/// its status, and the busyness of the bridge, is reported with the Proxel.
+/// \tparam T The type of data to receive
+/// \tparam Transport ShmConsumerPort or SocketConsumerPort of T
+/// \see createShmBridgeFactories, createSocketBridgeFactories
+template<typename T, typename Transport>
+class BridgeSourceProxel final : public Proxel
+{
+public:
+  explicit BridgeSourceProxel(std::shared_ptr<Transport> transport)
+    : transport_{std::move(transport)}
+    , out_port_{std::make_shared<OutPort>()}
+  {
+    registerPorts({{"out", out_port_}, {"transport", transport_}});
+  }
+
+  void start() override
+  {
+    setState(State::AwaitingInput);
+
+    for (const auto& item : *transport_)
+    {
+      setState(State::Running);
+      out_port_->send(item);
+    }
+
+    setState(State::Unavailable);
+  }
+
+  void stop() noexcept override
+  { transport_->deactivate(); }
+
+private:
+  using OutPort = ProducerPort<T>;
+
+  std::shared_ptr<Transport> transport_;
+  typename OutPort::Ptr out_port_;
+};
+
+/// \brief The name of the ShmRing of a shared memory bridge on `channel`
+inline std::string getShmRingName(const std::string& channel)
+{
+  return "/" + channel;
+}
+
+/// \brief Factories for the bridge proxels of `T` over shared memory, named
+/// `<type_name>ShmSink` and `<type_name>ShmSource`.
+///
+/// Both proxels take the properties `channel`, which names the ShmRing, and
+/// `buffer_size` (default 1). The ring blocks when it is full, so that the
+/// LeakPolicy of the consumer on the other side decides whether items are dropped.
+/// \see flow::yaml::createPartitionGraph
+template<typename T, typename PropertyList>
+FactoryMap<PropertyList> createShmBridgeFactories(const std::string& type_name)
+{
+  using Sink = BridgeSinkProxel<T, ShmProducerPort<T, LeakPolicy::PushBlocking>>;
+  using Source = BridgeSourceProxel<T, ShmConsumerPort<T>>;
+
+  const auto get_name = [](const PropertyList& properties)
+  { return getShmRingName(value<std::string>(properties, "channel")); };
+
+  return FactoryMap<PropertyList>{
+    {
+      {
+        type_name + "ShmSink",
+        [get_name](const PropertyList& properties)
+        {
+          return std::make_shared<Sink>(
+            std::make_shared<ShmProducerPort<T, LeakPolicy::PushBlocking>>(
+              get_name(properties), value<size_t>(properties, "buffer_size", size_t{1})
+            )
+          );
+        }
+      },
+      {
+        type_name + "ShmSource",
+        [get_name](const PropertyList& properties)
+        {
+          return std::make_shared<Source>(
+            std::make_shared<ShmConsumerPort<T>>(
+              get_name(properties), value<size_t>(properties, "buffer_size", size_t{1})
+            )
+          );
+        }
+      }
+    }
+  };
+}
+
+/// \brief Factories for the bridge proxels of `T` over sockets, named
+/// `<type_name>SocketSink` and `<type_name>SocketSource`.
+///
+/// The sink connects to the property `address`, and the source listens on `listen_address`
+/// if given, or else on `address`, \see SocketAddress. Without an `address`, both use the Unix
+/// domain socket `/tmp/<channel>.sock`. The buffer of both ports holds `buffer_size` items
+/// (default 1). The sink blocks when its buffer is full, so that the LeakPolicy of the consumer
+/// on the other side decides whether items are dropped.
+/// \see flow::yaml::createPartitionGraph
+template<typename T, typename PropertyList>
+FactoryMap<PropertyList> createSocketBridgeFactories(const std::string& type_name)
+{
+  using Sink = BridgeSinkProxel<T, SocketProducerPort<T, LeakPolicy::PushBlocking>>;
+  using Source = BridgeSourceProxel<T, SocketConsumerPort<T>>;
+
+  const auto get_address = [](const PropertyList& properties)
+  {
+    return properties.hasKey("address")
+           ? value<std::string>(properties, "address")
+           : "unix:/tmp/" + value<std::string>(properties, "channel") + ".sock";
+  };
+
+  return FactoryMap<PropertyList>{
+    {
+      {
+        type_name + "SocketSink",
+        [get_address](const PropertyList& properties)
+        {
+          return std::make_shared<Sink>(
+            std::make_shared<SocketProducerPort<T, LeakPolicy::PushBlocking>>(
+              get_address(properties), value<size_t>(properties, "buffer_size", size_t{1})
+            )
+          );
+        }
+      },
+      {
+        type_name + "SocketSource",
+        [get_address](const PropertyList& properties)
+        {
+          const auto address = properties.hasKey("listen_address")
+                               ? value<std::string>(properties, "listen_address")
+                               : get_address(properties);
+
+          return std::make_shared<Source>(
+            std::make_shared<SocketConsumerPort<T>>(
+              address, value<unsigned int>(properties, "buffer_size", 1u)
+            )
+          );
+        }
+      }
+    }
+  };
+}
+}
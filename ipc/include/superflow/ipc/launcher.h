@@ -0,0 +1,45 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace flow::ipc
+{
+/// \brief Run each partition of a graph in a process of its own, and wait until all of them exit.
+///
+/// One child process is forked per partition, which calls `run_partition` with the name of the
+/// partition and exits with the returned status. Typically, `run_partition` creates the graph of
+/// the partition with flow::yaml::createPartitionGraph, starts it and waits for a signal:
+/// \code{.cpp}
+/// return flow::ipc::launchPartitions(
+///   flow::yaml::getPartitions(config),
+///   [&](const std::string& partition)
+///   {
+///     auto graph = flow::yaml::createPartitionGraph(config, partition, factory_map);
+///     graph.start();
+///     flow::waitForSignal();
+///     graph.stop();
+///     return 0;
+///   },
+///   flow::yaml::getBridgeChannels(config)
+/// );
+/// \endcode
+/// SIGINT and SIGTERM sent to the launcher are forwarded to all children. When a child fails,
+/// by a non-zero exit status, an exception or a signal, the other children are sent SIGTERM.
+/// The ShmRing of each of the `channels` is removed before the children are forked, so that
+/// they do not attach to a ring left behind by a previous run, and again after they have exited.
+/// Call this before starting any threads, since the children are forked from the calling process.
+/// \param partitions Names of the partitions
+/// \param run_partition Called in each child process
+/// \param channels The `channel` names of the shared memory bridges, \see flow::yaml::getBridgeChannels
+/// \return 0 if all children exit with 0, or else the status of the first child that failed,
+///         which is 128 + the signal number if it was killed by a signal
+/// \throws std::runtime_error if a child process cannot be forked
+int launchPartitions(
+  const std::vector<std::string>& partitions,
+  const std::function<int(const std::string& partition)>& run_partition,
+  const std::vector<std::string>& channels = {}
+);
+}
@@ -0,0 +1,211 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include "superflow/ipc/shm_ring.h"
+#include "superflow/policy.h"
+#include "superflow/port.h"
+#include "superflow/timeline.h"
+#include "superflow/utils/data_stream.h"
+#include "superflow/utils/get_timer.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace flow::ipc
+{
+/// \brief Receives data from a ShmProducerPort in another process, through a ShmRing.
+///
+/// Used by a Proxel in place of a BufferedConsumerPort, when the producer runs in another process.
+/// Both ports must be created with the same name and buffer size, and the LeakPolicy of the
+/// ring is chosen by the ShmProducerPort. The items are stored in the shared memory as they are,
+/// so `T` must be trivially copyable. `getNext` copies an item out of its slot, and `getNextView`
+/// lends out the slot for the item to be used in place. Like the in-process consumer ports,
+/// the port times its gets, so that the busyness of the Proxel is reported.
+/// The port is connected through the ring rather than to other ports, so `connect` throws.
+/// \tparam T The type of data to receive
+/// \tparam M GetMode, Blocking or Latched
+/// \see ShmProducerPort
+template<typename T, GetMode M = GetMode::Blocking>
+class ShmConsumerPort final :
+  public Port,
+  public DataStream<T>
+{
+public:
+  static_assert(std::is_trivially_copyable_v<T>, "ShmConsumerPort<T> requires a trivially copyable T");
+  static_assert(alignof(T) <= 64, "ShmConsumerPort<T> requires a T aligned to at most a cache line");
+  static_assert(M == GetMode::Blocking || M == GetMode::Latched, "Selected GetMode is not available for this Port");
+
+  using Ptr = std::shared_ptr<ShmConsumerPort>;
+
+  /// \brief An item in its slot of the ring, which is released for new items when the View is destroyed
+  class View
+  {
+  public:
+    const T& operator*() const
+    { return *item_; }
+
+    const T* operator->() const
+    { return item_; }
+
+  private:
+    friend class ShmConsumerPort;
+
+    explicit View(ShmRing::View&& view)
+      : view_{std::move(view)}
+      , item_{static_cast<const T*>(view_.data())}
+    {}
+
+    ShmRing::View view_;
+    const T* item_;
+  };
+
+  /// \param name Name of the shared memory ring, e.g. "/superflow-camera"
+  /// \param buffer_size Maximum number of items in the ring
+  explicit ShmConsumerPort(const std::string& name, size_t buffer_size = 1);
+
+  /// \brief Get the oldest item in the ring, waiting until there is one.
+  /// In Latched mode, the latest item is returned again if the ring is empty.
+  /// \return The item, or nothing if the port is deactivated
+  std::optional<T> getNext() override;
+
+  /// \brief Get the oldest item in the ring, in place, waiting until there is one.
+  /// The View must be destroyed before the next get. Only available in Blocking mode,
+  /// since a latched item would have to outlive its slot.
+  /// \return The item, or nothing if the port is deactivated
+  std::optional<View> getNextView();
+
+  /// \brief Returns true if there is an item in the ring
+  bool hasNext() const;
+
+  /// \return False if the port is deactivated
+  operator bool() const override;
+
+  /// \brief Make a blocked `getNext` return, and stop receiving
+  void deactivate();
+
+  /// \throws std::invalid_argument always
+  void connect(const Port::Ptr& ptr) override;
+
+  void disconnect() noexcept override
+  {}
+
+  void disconnect(const Port::Ptr&) noexcept override
+  {}
+
+  /// \brief Always true, since the port is connected to the ring
+  bool isConnected() const override;
+
+  PortStatus getStatus() const override;
+
+private:
+  ShmRing ring_;
+  GetTimer get_timer_;
+  std::atomic<size_t> num_transactions_{0};
+  std::optional<T> latched_;
+};
+
+// ----- Implementation -----
+template<typename T, GetMode M>
+ShmConsumerPort<T, M>::ShmConsumerPort(const std::string& name, const size_t buffer_size)
+  : ring_{name, buffer_size, sizeof(T), ShmRing::Side::Reader}
+{}
+
+template<typename T, GetMode M>
+std::optional<T> ShmConsumerPort<T, M>::getNext()
+{
+  const GetTimer::Scope timing{get_timer_};
+  const timeline::Span span{timeline::Activity::Waiting};
+
+  if constexpr (M == GetMode::Latched)
+  {
+    if (latched_.has_value() && !ring_.isTerminated())
+    {
+      if (const auto view = ring_.tryAcquire())
+      { latched_ = *static_cast<const T*>(view->data()); }
+
+      ++num_transactions_;
+      return latched_;
+    }
+  }
+
+  const auto view = ring_.acquire();
+
+  if (!view)
+  { return std::nullopt; }
+
+  ++num_transactions_;
+
+  if constexpr (M == GetMode::Latched)
+  {
+    latched_ = *static_cast<const T*>(view->data());
+    return latched_;
+  }
+  else
+  { return *static_cast<const T*>(view->data()); }
+}
+
+template<typename T, GetMode M>
+std::optional<typename ShmConsumerPort<T, M>::View> ShmConsumerPort<T, M>::getNextView()
+{
+  static_assert(M == GetMode::Blocking, "ShmConsumerPort::getNextView is only available in Blocking mode");
+
+  auto view = [this]
+  {
+    const GetTimer::Scope timing{get_timer_};
+    const timeline::Span span{timeline::Activity::Waiting};
+
+    return ring_.acquire();
+  }();
+
+  if (!view)
+  { return std::nullopt; }
+
+  ++num_transactions_;
+
+  return View{std::move(*view)};
+}
+
+template<typename T, GetMode M>
+bool ShmConsumerPort<T, M>::hasNext() const
+{
+  return ring_.getQueueSize() > 0;
+}
+
+template<typename T, GetMode M>
+ShmConsumerPort<T, M>::operator bool() const
+{
+  return !ring_.isTerminated();
+}
+
+template<typename T, GetMode M>
+void ShmConsumerPort<T, M>::deactivate()
+{
+  ring_.terminate();
+}
+
+template<typename T, GetMode M>
+void ShmConsumerPort<T, M>::connect(const Port::Ptr&)
+{
+  throw std::invalid_argument{"ShmConsumerPort is connected through shared memory, and cannot connect to other ports"};
+}
+
+template<typename T, GetMode M>
+bool ShmConsumerPort<T, M>::isConnected() const
+{
+  return true;
+}
+
+template<typename T, GetMode M>
+PortStatus ShmConsumerPort<T, M>::getStatus() const
+{
+  PortStatus status{1, num_transactions_};
+  status.waiting_time = get_timer_.getWaitingTime();
+  status.processing_time = get_timer_.getProcessingTime();
+  status.queue_size = ring_.getQueueSize();
+  status.num_dropped = ring_.getNumDropped();
+
+  return status;
+}
+}
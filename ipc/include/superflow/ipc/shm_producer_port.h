@@ -0,0 +1,185 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include "superflow/ipc/shm_ring.h"
+#include "superflow/policy.h"
+#include "superflow/port.h"
+#include "superflow/timeline.h"
+
+#include <atomic>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace flow::ipc
+{
+/// \brief Sends data to a ShmConsumerPort in another process, through a ShmRing.
+///
+/// Used by a Proxel in place of a ProducerPort, when the consumer runs in another process.
+/// Both ports must be created with the same name and buffer size. The items are stored
+/// in the shared memory as they are, so `T` must be trivially copyable. `send` copies an item into
+/// a slot of the ring, and `loan` lends out a slot for an item to be built in place and sent without copying.
+/// The producer owns the ring, so the items that a previous producer left in it are dropped.
+/// The port is connected through the ring rather than to other ports, so `connect` throws.
+/// \tparam T The type of data to send
+/// \tparam L LeakPolicy, whether to drop the oldest item or block when the buffer is full
+/// \see ShmConsumerPort
+template<typename T, LeakPolicy L = LeakPolicy::Leaky>
+class ShmProducerPort final : public Port
+{
+public:
+  static_assert(std::is_trivially_copyable_v<T>, "ShmProducerPort<T> requires a trivially copyable T");
+  static_assert(alignof(T) <= 64, "ShmProducerPort<T> requires a T aligned to at most a cache line");
+  static_assert(L == LeakPolicy::Leaky || L == LeakPolicy::PushBlocking, "Selected LeakPolicy is not available for this Port");
+
+  using Ptr = std::shared_ptr<ShmProducerPort>;
+
+  /// \brief An item in a slot of the ring, sent by `commit`.
+  /// The slot is returned unused if the Loan is destroyed without being committed.
+  class Loan
+  {
+  public:
+    T& operator*() const
+    { return *item_; }
+
+    T* operator->() const
+    { return item_; }
+
+    /// \brief Send the item
+    void commit();
+
+  private:
+    friend class ShmProducerPort;
+
+    Loan(ShmProducerPort& port, ShmRing::Loan&& loan);
+
+    ShmProducerPort* port_;
+    ShmRing::Loan loan_;
+    T* item_;
+  };
+
+  /// \param name Name of the shared memory ring, e.g. "/superflow-camera"
+  /// \param buffer_size Maximum number of items in the ring
+  explicit ShmProducerPort(const std::string& name, size_t buffer_size = 1);
+
+  /// \brief Copy an item into the ring.
+  /// Does nothing if the port is deactivated, including while blocked by a full PushBlocking ring.
+  void send(const T& item);
+
+  /// \brief Borrow a slot of the ring, with a default-initialized item to be filled in place.
+  /// Other threads cannot send until the Loan is committed or destroyed.
+  /// \return The item, or nothing if the port is deactivated, including while blocked by a full PushBlocking ring
+  std::optional<Loan> loan();
+
+  /// \throws std::invalid_argument always
+  void connect(const Port::Ptr& ptr) override;
+
+  void disconnect() noexcept override
+  {}
+
+  void disconnect(const Port::Ptr&) noexcept override
+  {}
+
+  /// \brief Always true, since the port is connected to the ring
+  bool isConnected() const override;
+
+  PortStatus getStatus() const override;
+
+  /// \brief Make a blocked `send` return, and stop sending
+  void deactivate();
+
+private:
+  ShmRing ring_;
+  std::atomic<size_t> num_transactions_{0};
+
+  std::optional<ShmRing::Loan> loanSlot();
+};
+
+// ----- Implementation -----
+template<typename T, LeakPolicy L>
+ShmProducerPort<T, L>::ShmProducerPort(const std::string& name, const size_t buffer_size)
+  : ring_{name, buffer_size, sizeof(T), ShmRing::Side::Writer}
+{}
+
+template<typename T, LeakPolicy L>
+void ShmProducerPort<T, L>::send(const T& item)
+{
+  auto slot = loanSlot();
+
+  if (!slot)
+  { return; }
+
+  new(slot->data()) T(item);
+  slot->commit(sizeof(T));
+  ++num_transactions_;
+}
+
+template<typename T, LeakPolicy L>
+std::optional<typename ShmProducerPort<T, L>::Loan> ShmProducerPort<T, L>::loan()
+{
+  static_assert(std::is_default_constructible_v<T>, "ShmProducerPort<T>::loan requires a default constructible T");
+
+  auto slot = loanSlot();
+
+  if (!slot)
+  { return std::nullopt; }
+
+  return Loan{*this, std::move(*slot)};
+}
+
+template<typename T, LeakPolicy L>
+std::optional<ShmRing::Loan> ShmProducerPort<T, L>::loanSlot()
+{
+  if constexpr (L == LeakPolicy::PushBlocking)
+  {
+    const timeline::Span span{timeline::Activity::Blocked};
+    return ring_.loan(L);
+  }
+  else
+  { return ring_.loan(L); }
+}
+
+template<typename T, LeakPolicy L>
+ShmProducerPort<T, L>::Loan::Loan(ShmProducerPort& port, ShmRing::Loan&& loan)
+  : port_{&port}
+  , loan_{std::move(loan)}
+  , item_{new(loan_.data()) T}
+{}
+
+template<typename T, LeakPolicy L>
+void ShmProducerPort<T, L>::Loan::commit()
+{
+  loan_.commit(sizeof(T));
+  ++port_->num_transactions_;
+}
+
+template<typename T, LeakPolicy L>
+void ShmProducerPort<T, L>::connect(const Port::Ptr&)
+{
+  throw std::invalid_argument{"ShmProducerPort is connected through shared memory, and cannot connect to other ports"};
+}
+
+template<typename T, LeakPolicy L>
+bool ShmProducerPort<T, L>::isConnected() const
+{
+  return true;
+}
+
+template<typename T, LeakPolicy L>
+PortStatus ShmProducerPort<T, L>::getStatus() const
+{
+  PortStatus status{1, num_transactions_};
+  status.queue_size = ring_.getQueueSize();
+  status.num_dropped = ring_.getNumDropped();
+
+  return status;
+}
+
+template<typename T, LeakPolicy L>
+void ShmProducerPort<T, L>::deactivate()
+{
+  ring_.terminate();
+}
+}
@@ -0,0 +1,204 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include "superflow/policy.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace flow::ipc
+{
+/// \brief A bounded queue of messages in POSIX shared memory, from one writing to one reading process.
+///
+/// Both processes open the ring by the same name, capacity and slot size. The first one creates
+/// and initializes the shared memory object, and the other one attaches to it. The object outlives
+/// the processes, so a process that restarts attaches to the same ring, until it is `remove`d.
+/// The writing side owns the messages: when it attaches, the messages left by a previous writer
+/// are dropped, so they are not mistaken for new ones.
+///
+/// The messages are kept in a pool of `capacity + 2` fixed size slots, so that the writer can fill
+/// one slot and the reader use another while the ring is full. A writer `loan`s a slot, writes the
+/// message straight into it and commits it, and the reader `acquire`s a View of the oldest message
+/// that it uses in place and releases, so no message is copied by the ring. `push` and `pop` copy
+/// a message into and out of a slot, for callers that have it elsewhere.
+///
+/// Several threads of the writing process may write, one at a time, but only one thread
+/// of the reading process may read. A full ring either drops its oldest message, like a Leaky
+/// LockQueue, or makes the writer wait for space, like a PushBlocking LockQueue. A message that
+/// is being read is never dropped or overwritten. Waiting readers and writers sleep on futexes
+/// in the shared memory, so uncontended writes and reads make no system calls.
+/// Only available on Linux.
+class ShmRing
+{
+public:
+  enum class Side
+  {
+    Writer,
+    Reader
+  };
+
+  class Loan;
+  class View;
+
+  /// \brief Create or attach to a ring
+  /// \param name Name of the shared memory object, e.g. "/superflow-camera"
+  /// \param capacity Maximum number of messages in the ring
+  /// \param slot_size Maximum size of a message, in bytes
+  /// \param side Whether this process writes to or reads from the ring
+  /// \throws std::invalid_argument if `capacity` or `slot_size` is 0, or if an existing ring
+  /// with the same name has a different capacity or slot size
+  /// \throws std::runtime_error if the shared memory object cannot be opened
+  ShmRing(const std::string& name, size_t capacity, size_t slot_size, Side side);
+
+  ~ShmRing();
+
+  ShmRing(const ShmRing&) = delete;
+  ShmRing& operator=(const ShmRing&) = delete;
+
+  /// \brief Borrow a free slot to write a message into.
+  /// Other threads of the process cannot write until the Loan is committed or destroyed.
+  /// \param policy Whether to drop the oldest message when committing, or wait here for space, if the ring is full
+  /// \return The slot, or nothing if the ring was terminated while waiting
+  std::optional<Loan> loan(LeakPolicy policy);
+
+  /// \brief Copy a message into the ring
+  /// \param data The message
+  /// \param size Size of the message, in bytes
+  /// \param policy Whether to drop the oldest message or wait if the ring is full
+  /// \return false if the ring was terminated while waiting
+  /// \throws std::invalid_argument if `size` is larger than the slot size
+  bool push(const void* data, size_t size, LeakPolicy policy);
+
+  /// \brief Take the oldest message out of the ring, waiting until there is one.
+  /// The message stays in its slot until the View is destroyed, and there can be only one View at a time.
+  /// \return The message, or nothing if the ring was terminated while waiting
+  /// \throws std::logic_error if there already is a View
+  std::optional<View> acquire();
+
+  /// \brief Take the oldest message out of the ring, if there is one.
+  /// \return The message, or nothing if the ring is empty
+  /// \throws std::logic_error if there already is a View
+  /// \see acquire
+  std::optional<View> tryAcquire();
+
+  /// \brief Copy the oldest message out of the ring, waiting until there is one.
+  /// \param data Buffer for the message, of at least the slot size
+  /// \return The size of the message, or nothing if the ring was terminated while waiting
+  std::optional<size_t> pop(void* data);
+
+  /// \brief Copy the oldest message out of the ring, if there is one.
+  /// \param data Buffer for the message, of at least the slot size
+  /// \return The size of the message, or nothing if the ring is empty
+  std::optional<size_t> tryPop(void* data);
+
+  /// \brief Make the calls to `loan`, `push`, `acquire` and `pop` in this process return instead of waiting.
+  /// The ring itself is left as it is, for the other process.
+  void terminate();
+
+  [[nodiscard]] bool isTerminated() const;
+
+  /// \brief Number of messages in the ring
+  [[nodiscard]] size_t getQueueSize() const;
+
+  /// \brief Number of messages dropped from the full ring, since it was created
+  [[nodiscard]] size_t getNumDropped() const;
+
+  [[nodiscard]] size_t getCapacity() const;
+
+  [[nodiscard]] size_t getSlotSize() const;
+
+  /// \brief Remove the shared memory object, so that the name can be reused for a new ring.
+  /// Processes that have the ring open keep using the old one. Does nothing if it does not exist.
+  static void remove(const std::string& name);
+
+private:
+  struct Header;
+  struct SlotState;
+
+  Header* header_ = nullptr;
+  std::atomic<uint32_t>* entries_ = nullptr; ///< The slot of each message in the queue
+  SlotState* slot_states_ = nullptr;
+  std::byte* slots_ = nullptr;
+  size_t capacity_;
+  size_t num_slots_;
+  size_t slot_size_;
+  size_t slot_stride_;
+  size_t mapped_size_;
+  std::atomic<bool> terminated_{false};
+  std::mutex writer_mutex_;
+  uint32_t next_free_ = 0; ///< Where the writer starts looking for a free slot
+  bool has_view_ = false;
+
+  [[nodiscard]] std::byte* getSlot(uint32_t slot) const;
+
+  /// Make the slots held by a previous process on `side` free, and drop the messages of a previous writer
+  void reclaim(Side side);
+
+  void commit(uint32_t slot, size_t size, LeakPolicy policy);
+
+  /// Move the tail past the oldest message, and return its slot, unless the ring is empty
+  std::optional<uint32_t> takeOldest();
+
+  void release(uint32_t slot);
+};
+
+/// \brief A slot of the ring that the writer fills in place, and sends with `commit`.
+/// The slot is returned unused if the Loan is destroyed without being committed.
+class ShmRing::Loan
+{
+public:
+  Loan(Loan&& other) noexcept;
+  Loan& operator=(Loan&&) = delete;
+  ~Loan();
+
+  /// \return The slot, of `size()` bytes, aligned to a cache line
+  [[nodiscard]] void* data() const;
+
+  /// \return The slot size of the ring
+  [[nodiscard]] size_t size() const;
+
+  /// \brief Send the first `size` bytes of the slot as a message
+  /// \throws std::invalid_argument if `size` is larger than the slot size
+  void commit(size_t size);
+
+private:
+  friend class ShmRing;
+
+  Loan(ShmRing& ring, std::unique_lock<std::mutex> lock, uint32_t slot, LeakPolicy policy);
+
+  ShmRing* ring_;
+  std::unique_lock<std::mutex> lock_;
+  uint32_t slot_;
+  LeakPolicy policy_;
+  bool committed_ = false;
+};
+
+/// \brief A message that the reader has taken out of the ring, in its slot.
+/// The slot is released for new messages when the View is destroyed.
+class ShmRing::View
+{
+public:
+  View(View&& other) noexcept;
+  View& operator=(View&&) = delete;
+  ~View();
+
+  /// \return The message, aligned to a cache line
+  [[nodiscard]] const void* data() const;
+
+  /// \return The size of the message, in bytes
+  [[nodiscard]] size_t size() const;
+
+private:
+  friend class ShmRing;
+
+  View(ShmRing& ring, uint32_t slot, size_t size);
+
+  ShmRing* ring_;
+  uint32_t slot_;
+  size_t size_;
+};
+}
@@ -0,0 +1,55 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace flow::ipc
+{
+/// \brief The address of a Unix domain socket, `unix:<path>`, or a TCP socket, `tcp:<host>:<port>`.
+///
+/// The host of a TCP address may be a name or an IPv4 address. Listening on port 0 picks a free port.
+class SocketAddress
+{
+public:
+  /// \throws std::invalid_argument if the address is malformed
+  explicit SocketAddress(const std::string& address);
+
+  /// \brief Open a socket that listens on the address.
+  /// A stale Unix domain socket file at the path is replaced.
+  /// \return The file descriptor of the socket
+  /// \throws std::runtime_error if the socket cannot be opened
+  [[nodiscard]] int listen() const;
+
+  /// \brief Connect a new socket to the address.
+  /// TCP sockets are connected with `TCP_NODELAY`, since messages are batched by the sender.
+  /// The connection is made without blocking, so an unresponsive host costs at most `timeout`,
+  /// and `is_cancelled`, if given, is checked every few milliseconds while waiting.
+  /// The returned socket is in blocking mode.
+  /// \param timeout How long to wait for the connection to be established
+  /// \param is_cancelled Give up as soon as this returns true
+  /// \return The file descriptor of the socket, or -1 if the connection failed, timed out or was cancelled
+  [[nodiscard]] int connect(
+    std::chrono::milliseconds timeout = std::chrono::seconds{1},
+    const std::function<bool()>& is_cancelled = {}
+  ) const;
+
+  /// \brief The address a listening socket is bound to, with the actual port of a TCP socket
+  [[nodiscard]] std::string getBoundAddress(int socket) const;
+
+  /// \brief Remove the socket file of a Unix domain socket that has been listened on.
+  /// Does nothing for TCP.
+  void unlink() const;
+
+  [[nodiscard]] const std::string& toString() const;
+
+private:
+  std::string address_;
+  bool is_unix_ = false;
+  std::string path_;
+  std::string host_;
+  uint16_t port_ = 0;
+};
+}
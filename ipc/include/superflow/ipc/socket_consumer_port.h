@@ -0,0 +1,195 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include "superflow/ipc/socket_receiver.h"
+#include "superflow/codec.h"
+#include "superflow/policy.h"
+#include "superflow/port.h"
+#include "superflow/timeline.h"
+#include "superflow/utils/data_stream.h"
+#include "superflow/utils/get_timer.h"
+#include "superflow/utils/lock_queue.h"
+
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+#include <string>
+
+namespace flow::ipc
+{
+/// \brief Receives data from a SocketProducerPort in another process or on another host.
+///
+/// Used by a Proxel in place of a BufferedConsumerPort, when the producer runs elsewhere. The port
+/// listens on its address with a SocketReceiver, and decodes the items with flow::Codec<T> into its buffer.
+/// When the buffer is full, the port stops reading from the socket, so that the producer's buffer
+/// fills up and its LeakPolicy applies. Items that cannot be decoded, e.g. because the producer
+/// was built with another version of the Codec, are counted as dropped.
+/// Like the in-process consumer ports, the port times its gets, so that the busyness of the Proxel
+/// is reported. The port is connected through the socket rather than to other ports, so `connect` throws.
+/// \tparam T The type of data to receive
+/// \tparam M GetMode, Blocking or Latched
+/// \see SocketProducerPort, SocketAddress
+template<typename T, GetMode M = GetMode::Blocking>
+class SocketConsumerPort final :
+  public Port,
+  public DataStream<T>
+{
+public:
+  static_assert(M == GetMode::Blocking || M == GetMode::Latched, "Selected GetMode is not available for this Port");
+
+  using Ptr = std::shared_ptr<SocketConsumerPort>;
+
+  /// \param address Address to listen on, e.g. "tcp:0.0.0.0:5000" or "unix:/tmp/camera.sock"
+  /// \param buffer_size Maximum number of received items waiting to be consumed
+  /// \throws std::runtime_error if the port cannot listen on the address
+  explicit SocketConsumerPort(const std::string& address, unsigned int buffer_size = 1);
+
+  ~SocketConsumerPort() override;
+
+  /// \brief Get the oldest received item, waiting until there is one.
+  /// In Latched mode, the latest item is returned again if the buffer is empty.
+  /// \return The item, or nothing if the port is deactivated
+  std::optional<T> getNext() override;
+
+  /// \brief Returns true if there is a received item in the buffer
+  bool hasNext() const;
+
+  /// \return False if the port is deactivated
+  operator bool() const override;
+
+  /// \brief Make a blocked `getNext` return, and stop receiving
+  void deactivate();
+
+  /// \brief The address the port listens on, with the actual port if it was 0
+  const std::string& getAddress() const;
+
+  /// \throws std::invalid_argument always
+  void connect(const Port::Ptr& ptr) override;
+
+  void disconnect() noexcept override
+  {}
+
+  void disconnect(const Port::Ptr&) noexcept override
+  {}
+
+  /// \brief Returns true if a producer is connected to the socket
+  bool isConnected() const override;
+
+  PortStatus getStatus() const override;
+
+private:
+  LockQueue<T, LeakPolicy::PushBlocking> buffer_;
+  GetTimer get_timer_;
+  std::atomic<size_t> num_transactions_{0};
+  std::atomic<size_t> num_dropped_{0};
+  std::optional<T> latched_;
+  SocketReceiver receiver_;
+
+  bool receive(const std::byte* data, size_t size);
+};
+
+// ----- Implementation -----
+template<typename T, GetMode M>
+SocketConsumerPort<T, M>::SocketConsumerPort(const std::string& address, const unsigned int buffer_size)
+  : buffer_{buffer_size}
+  , receiver_{address, [this](const std::byte* data, const size_t size) { return receive(data, size); }}
+{}
+
+template<typename T, GetMode M>
+SocketConsumerPort<T, M>::~SocketConsumerPort()
+{
+  deactivate();
+}
+
+template<typename T, GetMode M>
+std::optional<T> SocketConsumerPort<T, M>::getNext()
+{
+  try
+  {
+    const GetTimer::Scope timing{get_timer_};
+    const timeline::Span span{timeline::Activity::Waiting};
+
+    if constexpr (M == GetMode::Latched)
+    {
+      if (!latched_.has_value() || !buffer_.isEmpty())
+      { latched_ = buffer_.pop(); }
+
+      ++num_transactions_;
+      return latched_;
+    }
+    else
+    {
+      auto item = buffer_.pop();
+      ++num_transactions_;
+
+      return item;
+    }
+  }
+  catch (const TerminatedException&)
+  { return std::nullopt; }
+}
+
+template<typename T, GetMode M>
+bool SocketConsumerPort<T, M>::hasNext() const
+{
+  return !buffer_.isEmpty();
+}
+
+template<typename T, GetMode M>
+SocketConsumerPort<T, M>::operator bool() const
+{
+  return !buffer_.isTerminated();
+}
+
+template<typename T, GetMode M>
+void SocketConsumerPort<T, M>::deactivate()
+{
+  buffer_.terminate();
+  receiver_.stop();
+}
+
+template<typename T, GetMode M>
+const std::string& SocketConsumerPort<T, M>::getAddress() const
+{
+  return receiver_.getAddress();
+}
+
+template<typename T, GetMode M>
+void SocketConsumerPort<T, M>::connect(const Port::Ptr&)
+{
+  throw std::invalid_argument{"SocketConsumerPort is connected through a socket, and cannot connect to other ports"};
+}
+
+template<typename T, GetMode M>
+bool SocketConsumerPort<T, M>::isConnected() const
+{
+  return receiver_.isConnected();
+}
+
+template<typename T, GetMode M>
+PortStatus SocketConsumerPort<T, M>::getStatus() const
+{
+  PortStatus status{isConnected() ? 1u : 0u, num_transactions_};
+  status.waiting_time = get_timer_.getWaitingTime();
+  status.processing_time = get_timer_.getProcessingTime();
+  status.queue_size = buffer_.getQueueSize();
+  status.num_dropped = num_dropped_;
+
+  return status;
+}
+
+template<typename T, GetMode M>
+bool SocketConsumerPort<T, M>::receive(const std::byte* data, const size_t size)
+{
+  try
+  {
+    buffer_.push(codec::decodeMessage<T>(data, size));
+  }
+  catch (const TerminatedException&)
+  { return false; }
+  catch (const std::exception&)
+  { ++num_dropped_; }
+
+  return true;
+}
+}
@@ -0,0 +1,116 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include "superflow/ipc/socket_sender.h"
+#include "superflow/codec.h"
+#include "superflow/policy.h"
+#include "superflow/port.h"
+#include "superflow/timeline.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace flow::ipc
+{
+/// \brief Sends data to a SocketConsumerPort in another process or on another host.
+///
+/// Used by a Proxel in place of a ProducerPort, when the consumer runs elsewhere. The items
+/// are encoded by flow::Codec<T> with a CodecHeader, and sent by a SocketSender over a Unix domain socket or TCP,
+/// batched and reconnecting whenever the connection breaks. The buffer of the port holds
+/// encoded items while they wait to be sent, and the LeakPolicy decides what happens when
+/// it is full, either because the consumer is slow or because it is not connected.
+/// The port is connected through the socket rather than to other ports, so `connect` throws.
+/// \tparam T The type of data to send
+/// \tparam L LeakPolicy, whether to drop the oldest item or block when the buffer is full
+/// \see SocketConsumerPort, SocketAddress
+template<typename T, LeakPolicy L = LeakPolicy::Leaky>
+class SocketProducerPort final : public Port
+{
+public:
+  static_assert(L == LeakPolicy::Leaky || L == LeakPolicy::PushBlocking, "Selected LeakPolicy is not available for this Port");
+
+  using Ptr = std::shared_ptr<SocketProducerPort>;
+
+  /// \param address Address of the SocketConsumerPort, e.g. "tcp:localhost:5000" or "unix:/tmp/camera.sock"
+  /// \param buffer_size Maximum number of items waiting to be sent
+  explicit SocketProducerPort(const std::string& address, size_t buffer_size = 1);
+
+  /// \brief Encode an item, and queue it for sending.
+  /// Does nothing if the port is deactivated, including while blocked by a full PushBlocking buffer.
+  void send(const T& item);
+
+  /// \throws std::invalid_argument always
+  void connect(const Port::Ptr& ptr) override;
+
+  void disconnect() noexcept override
+  {}
+
+  void disconnect(const Port::Ptr&) noexcept override
+  {}
+
+  /// \brief Returns true if the socket is connected to the consumer
+  bool isConnected() const override;
+
+  PortStatus getStatus() const override;
+
+  /// \brief Make a blocked `send` return, and stop sending
+  void deactivate();
+
+private:
+  SocketSender sender_;
+  std::atomic<size_t> num_transactions_{0};
+};
+
+// ----- Implementation -----
+template<typename T, LeakPolicy L>
+SocketProducerPort<T, L>::SocketProducerPort(const std::string& address, const size_t buffer_size)
+  : sender_{address, buffer_size, L}
+{}
+
+template<typename T, LeakPolicy L>
+void SocketProducerPort<T, L>::send(const T& item)
+{
+  std::vector<std::byte> message;
+  codec::encodeMessage(item, message);
+
+  if constexpr (L == LeakPolicy::PushBlocking)
+  {
+    const timeline::Span span{timeline::Activity::Blocked};
+
+    if (sender_.send(std::move(message)))
+    { ++num_transactions_; }
+  }
+  else if (sender_.send(std::move(message)))
+  { ++num_transactions_; }
+}
+
+template<typename T, LeakPolicy L>
+void SocketProducerPort<T, L>::connect(const Port::Ptr&)
+{
+  throw std::invalid_argument{"SocketProducerPort is connected through a socket, and cannot connect to other ports"};
+}
+
+template<typename T, LeakPolicy L>
+bool SocketProducerPort<T, L>::isConnected() const
+{
+  return sender_.isConnected();
+}
+
+template<typename T, LeakPolicy L>
+PortStatus SocketProducerPort<T, L>::getStatus() const
+{
+  PortStatus status{isConnected() ? 1u : 0u, num_transactions_};
+  status.queue_size = sender_.getQueueSize();
+  status.num_dropped = sender_.getNumDropped();
+
+  return status;
+}
+
+template<typename T, LeakPolicy L>
+void SocketProducerPort<T, L>::deactivate()
+{
+  sender_.terminate();
+}
+}
@@ -0,0 +1,65 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include "superflow/ipc/socket_address.h"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace flow::ipc
+{
+/// \brief Receives messages from a SocketSender on a background thread.
+///
+/// The receiver listens on its address, and reads from one sender at a time. A new
+/// connection replaces the current one, so that a sender that restarts takes over.
+/// Each message is passed to the handler on the thread of the receiver, and nothing more is
+/// read until the handler returns. A handler that waits thus makes the sender's queue fill up.
+/// \see SocketConsumerPort
+class SocketReceiver
+{
+public:
+  /// \brief Called with each message. Return false to stop receiving.
+  using Handler = std::function<bool(const std::byte* data, size_t size)>;
+
+  /// Messages larger than this are taken as corrupt, and close the connection
+  static constexpr size_t max_message_size = size_t{1} << 30;
+
+  /// \param address \see SocketAddress
+  /// \param handler Called with each message
+  /// \throws std::invalid_argument if `address` is malformed
+  /// \throws std::runtime_error if the receiver cannot listen on the address
+  SocketReceiver(const std::string& address, Handler handler);
+
+  ~SocketReceiver();
+
+  SocketReceiver(const SocketReceiver&) = delete;
+  SocketReceiver& operator=(const SocketReceiver&) = delete;
+
+  /// \brief Stop the thread, and close the sockets.
+  /// Blocks until the handler returns, if it is being called.
+  void stop();
+
+  /// \brief The address the receiver listens on, with the actual port if it was 0
+  [[nodiscard]] const std::string& getAddress() const;
+
+  [[nodiscard]] bool isConnected() const;
+
+  /// \brief Number of connections accepted since start
+  [[nodiscard]] size_t getNumConnections() const;
+
+private:
+  SocketAddress address_;
+  Handler handler_;
+  int server_socket_ = -1;
+  std::string bound_address_;
+  std::atomic<bool> stopping_{false};
+  std::atomic<bool> connected_{false};
+  std::atomic<size_t> num_connections_{0};
+  std::thread thread_;
+
+  void run();
+};
+}
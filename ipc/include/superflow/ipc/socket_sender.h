@@ -0,0 +1,92 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include "superflow/ipc/socket_address.h"
+#include "superflow/policy.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace flow::ipc
+{
+/// \brief Sends messages to a SocketReceiver from a background thread.
+///
+/// Messages are queued by `send`, and written by the thread in batches of up to
+/// `max_batch_size` bytes, each message prefixed by its size as a 32 bit unsigned
+/// integer in network byte order. A full queue either drops its oldest message, like a
+/// Leaky LockQueue, or makes `send` wait, like a PushBlocking LockQueue. A receiver that
+/// reads slowly thus makes the queue fill up, which either drops or blocks.
+///
+/// The thread connects to the receiver, and reconnects whenever the connection breaks,
+/// waiting from `min_backoff` to `max_backoff` between attempts. The batch that was
+/// being written when the connection broke is counted as dropped. An attempt to connect
+/// gives up after `connect_timeout`, or as soon as the sender is terminated.
+/// \see SocketProducerPort
+class SocketSender
+{
+public:
+  static constexpr size_t max_batch_size = 64 * 1024;
+  static constexpr std::chrono::milliseconds min_backoff{10};
+  static constexpr std::chrono::milliseconds max_backoff{1000};
+  static constexpr std::chrono::milliseconds connect_timeout{1000};
+
+  /// \param address \see SocketAddress
+  /// \param buffer_size Maximum number of queued messages
+  /// \param policy Whether to drop the oldest message or wait if the queue is full
+  /// \throws std::invalid_argument if `address` is malformed, or `buffer_size` is 0
+  SocketSender(const std::string& address, size_t buffer_size, LeakPolicy policy);
+
+  ~SocketSender();
+
+  SocketSender(const SocketSender&) = delete;
+  SocketSender& operator=(const SocketSender&) = delete;
+
+  /// \brief Queue a message
+  /// \return false if the sender is terminated
+  bool send(std::vector<std::byte>&& message);
+
+  /// \brief Stop the thread, and make `send` return instead of waiting.
+  /// Queued messages are discarded.
+  void terminate();
+
+  [[nodiscard]] bool isTerminated() const;
+
+  [[nodiscard]] bool isConnected() const;
+
+  /// \brief Number of queued messages
+  [[nodiscard]] size_t getQueueSize() const;
+
+  /// \brief Number of messages dropped from the full queue, or lost with a broken connection
+  [[nodiscard]] size_t getNumDropped() const;
+
+private:
+  SocketAddress address_;
+  size_t buffer_size_;
+  LeakPolicy policy_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable has_message_;
+  std::condition_variable has_space_;
+  std::deque<std::vector<std::byte>> queue_;
+  bool terminated_ = false;
+  size_t num_dropped_ = 0;
+  int socket_ = -1;
+  std::atomic<bool> connected_{false};
+  std::thread thread_;
+
+  void run();
+
+  /// \return The number of messages in the batch, or 0 if terminated
+  size_t takeBatch(std::vector<std::byte>& batch);
+
+  /// \brief Wait for `duration`, or until terminated
+  void waitFor(std::chrono::milliseconds duration);
+};
+}
@@ -0,0 +1,120 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include "superflow/graph.h"
+#include "superflow/proxel_status.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace flow::ipc
+{
+/// Layout of the start of the shared memory object of a StatusBoard
+struct StatusBoardHeader;
+
+/// \brief Publishes the ProxelStatus of every Proxel in a Graph to a named shared memory object,
+/// where other processes can read it with StatusBoardReader.
+///
+/// The Graph is snapshotted by `update`, which must be called from the thread that owns the Graph,
+/// like MetricsExporter::update. The snapshot is encoded before it is copied into the shared memory
+/// under a sequence lock, so the readers never take a lock, and neither slow down the Proxels nor
+/// the publisher, no matter how often they read. A curses view, an exporter or a command line tool
+/// can then watch the Graph without being compiled into the application.
+///
+/// The shared memory object is created by the constructor, replacing any object with the same name,
+/// and removed by the destructor.
+/// \code{.cpp}
+/// flow::ipc::StatusBoard board{"/superflow-status"};
+///
+/// graph.start();
+/// board.spin(graph); // until SIGINT or SIGTERM
+/// graph.stop();
+/// \endcode
+/// Only available on Linux.
+class StatusBoard
+{
+public:
+  /// \param name Name of the shared memory object, e.g. "/superflow-status"
+  /// \param max_size Size of the board, which must hold the encoded statuses, in bytes
+  /// \throws std::runtime_error if the shared memory object cannot be created
+  explicit StatusBoard(const std::string& name, size_t max_size = size_t{1} << 20);
+
+  ~StatusBoard();
+
+  StatusBoard(const StatusBoard&) = delete;
+  StatusBoard& operator=(const StatusBoard&) = delete;
+
+  /// \brief Take a new snapshot of the Graph, with rates averaged since the previous snapshot, and publish it
+  ///
+  /// Unlike reading the board, taking the snapshot is not free for the Proxels: it goes through
+  /// Graph::getProxelStatuses, which briefly locks the status info string, the status fields and
+  /// the ports of every Proxel, and so may hold up a Proxel that calls `setStatusInfo` or sends at
+  /// the same time. Updating every 100 ms, as `spin` does by default, or less often, keeps this
+  /// negligible. Readers that want a higher rate gain nothing from it, since they only see the
+  /// latest snapshot.
+  /// \throws std::runtime_error if the statuses do not fit in the board
+  void update(const Graph& graph);
+
+  /// \brief Publish the given statuses
+  /// \throws std::runtime_error if the statuses do not fit in the board
+  void publish(const ProxelStatusMap& statuses);
+
+  /// \brief Call `update` periodically until SIGINT or SIGTERM is received.
+  /// \param period Time between updates, which should not be much shorter than the default
+  /// \see update
+  void spin(const Graph& graph, std::chrono::milliseconds period = std::chrono::milliseconds{100});
+
+  [[nodiscard]] const std::string& getName() const;
+
+private:
+  std::string name_;
+  StatusBoardHeader* header_ = nullptr;
+  std::byte* body_ = nullptr;
+  size_t mapped_size_;
+  std::vector<std::byte> encoded_;
+  Graph::Sampler sampler_;
+};
+
+/// \brief Reads the statuses published by a StatusBoard in another process.
+///
+/// Reading never blocks the publisher: if the board is updated while it is being copied,
+/// the copy is simply retried.
+/// Only available on Linux.
+class StatusBoardReader
+{
+public:
+  struct Snapshot
+  {
+    uint64_t num_updates = 0;                   ///< Number of times the board has been published
+    std::chrono::system_clock::time_point time; ///< When the board was published
+    int64_t pid = 0;                            ///< Process id of the publisher
+    ProxelStatusMap statuses;
+  };
+
+  /// \param name Name of the shared memory object of the StatusBoard
+  /// \throws std::runtime_error if the board does not exist, or has another format
+  explicit StatusBoardReader(const std::string& name);
+
+  ~StatusBoardReader();
+
+  StatusBoardReader(const StatusBoardReader&) = delete;
+  StatusBoardReader& operator=(const StatusBoardReader&) = delete;
+
+  /// \brief Copy and decode the latest snapshot
+  /// \return The snapshot, or nothing if the board has never been published, or if it was
+  /// updated during every attempt to copy it
+  /// \throws std::runtime_error if the snapshot cannot be decoded
+  [[nodiscard]] std::optional<Snapshot> read() const;
+
+private:
+  std::string name_;
+  const StatusBoardHeader* header_ = nullptr;
+  const std::byte* body_ = nullptr;
+  size_t mapped_size_ = 0;
+  mutable std::vector<std::byte> copy_;
+};
+}
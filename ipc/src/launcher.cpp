@@ -0,0 +1,158 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/ipc/launcher.h"
+#include "superflow/ipc/bridge_proxels.h"
+#include "superflow/ipc/shm_ring.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+
+namespace flow::ipc
+{
+namespace
+{
+constexpr int exception_status = 1;
+
+void signalAll(const std::map<pid_t, std::string>& children, const int signal)
+{
+  for (const auto& [pid, partition] : children)
+  { ::kill(pid, signal); }
+}
+
+int getExitStatus(const int wait_status)
+{
+  if (WIFEXITED(wait_status))
+  { return WEXITSTATUS(wait_status); }
+
+  if (WIFSIGNALED(wait_status))
+  { return 128 + WTERMSIG(wait_status); }
+
+  return exception_status;
+}
+
+void removeRings(const std::vector<std::string>& channels)
+{
+  for (const auto& channel : channels)
+  { ShmRing::remove(getShmRingName(channel)); }
+}
+
+[[noreturn]] void runChild(
+  const std::string& partition,
+  const std::function<int(const std::string&)>& run_partition,
+  const sigset_t& original_mask)
+{
+  ::sigprocmask(SIG_SETMASK, &original_mask, nullptr);
+  int status = exception_status;
+
+  try
+  { status = run_partition(partition); }
+  catch (const std::exception& e)
+  { std::cerr << "Partition '" << partition << "' failed: " << e.what() << std::endl; }
+  catch (...)
+  { std::cerr << "Partition '" << partition << "' failed" << std::endl; }
+
+  std::fflush(nullptr);
+  ::_exit(status);
+}
+}
+
+int launchPartitions(
+  const std::vector<std::string>& partitions,
+  const std::function<int(const std::string& partition)>& run_partition,
+  const std::vector<std::string>& channels
+)
+{
+  // Rings left behind by a previous run, which may have crashed, would otherwise be reused as they are
+  removeRings(channels);
+
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  sigaddset(&signals, SIGCHLD);
+
+  // Block the signals before forking, so that none are lost before the launcher waits for them
+  sigset_t original_mask;
+  ::sigprocmask(SIG_BLOCK, &signals, &original_mask);
+
+  std::map<pid_t, std::string> children;
+  std::fflush(nullptr);
+
+  for (const auto& partition : partitions)
+  {
+    const pid_t pid = ::fork();
+
+    if (pid == 0)
+    { runChild(partition, run_partition, original_mask); }
+
+    if (pid < 0)
+    {
+      const auto error = std::runtime_error{
+        "launchPartitions: cannot fork partition '" + partition + "': " + std::strerror(errno)
+      };
+
+      signalAll(children, SIGTERM);
+
+      for (const auto& child : children)
+      { ::waitpid(child.first, nullptr, 0); }
+
+      removeRings(channels);
+      ::sigprocmask(SIG_SETMASK, &original_mask, nullptr);
+
+      throw error;
+    }
+
+    children.emplace(pid, partition);
+  }
+
+  int result = 0;
+
+  while (!children.empty())
+  {
+    int signal = 0;
+
+    if (::sigwait(&signals, &signal) != 0)
+    { continue; }
+
+    if (signal != SIGCHLD)
+    {
+      signalAll(children, signal);
+      continue;
+    }
+
+    // Only reap the children of the launcher, and leave any other children of the process alone
+    for (auto it = children.begin(); it != children.end();)
+    {
+      int wait_status = 0;
+
+      if (::waitpid(it->first, &wait_status, WNOHANG) != it->first)
+      {
+        ++it;
+        continue;
+      }
+
+      it = children.erase(it);
+      const int status = getExitStatus(wait_status);
+
+      if (status != 0 && result == 0)
+      {
+        result = status;
+        signalAll(children, SIGTERM);
+      }
+    }
+  }
+
+  removeRings(channels);
+  ::sigprocmask(SIG_SETMASK, &original_mask, nullptr);
+
+  return result;
+}
+}
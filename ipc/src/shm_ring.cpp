@@ -0,0 +1,558 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/ipc/shm_ring.h"
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace flow::ipc
+{
+namespace
+{
+constexpr size_t cache_line_size = 64;
+constexpr uint32_t ready_state = 1;
+
+/// Owners of a slot
+constexpr uint32_t free_slot = 0;
+constexpr uint32_t loaned_slot = 1; ///< Being written
+constexpr uint32_t queued_slot = 2;
+constexpr uint32_t viewed_slot = 3; ///< Being read
+constexpr auto attach_timeout = std::chrono::seconds{1};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+              "ShmRing requires lock free atomics, since they are shared between processes");
+
+size_t roundUp(const size_t size, const size_t alignment)
+{
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+std::runtime_error makeError(const std::string& name, const std::string& what)
+{
+  return std::runtime_error{"ShmRing '" + name + "': " + what + ": " + std::strerror(errno)};
+}
+
+uint32_t* getFutexWord(std::atomic<uint32_t>& word)
+{
+  return reinterpret_cast<uint32_t*>(&word);
+}
+
+/// Sleep until `word` is woken, unless it no longer has the `expected` value
+void futexWait(std::atomic<uint32_t>& word, const uint32_t expected)
+{
+  syscall(SYS_futex, getFutexWord(word), FUTEX_WAIT, expected, nullptr, nullptr, 0);
+}
+
+void futexWakeAll(std::atomic<uint32_t>& word)
+{
+  syscall(SYS_futex, getFutexWord(word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+/// Open the shared memory object, and tell whether this process created it
+std::pair<int, bool> openObject(const std::string& name)
+{
+  const auto deadline = std::chrono::steady_clock::now() + attach_timeout;
+
+  while (std::chrono::steady_clock::now() < deadline)
+  {
+    const int created_fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+
+    if (created_fd >= 0)
+    { return {created_fd, true}; }
+
+    if (errno != EEXIST)
+    { throw makeError(name, "cannot create shared memory"); }
+
+    const int fd = shm_open(name.c_str(), O_RDWR, 0600);
+
+    if (fd >= 0)
+    { return {fd, false}; }
+
+    // The object was removed in between, so try to create it again
+    if (errno != ENOENT)
+    { throw makeError(name, "cannot open shared memory"); }
+  }
+
+  throw makeError(name, "cannot open shared memory");
+}
+
+/// Wait for the creator to set the size of the object
+size_t awaitSize(const std::string& name, const int fd)
+{
+  const auto deadline = std::chrono::steady_clock::now() + attach_timeout;
+
+  for (;;)
+  {
+    struct stat status{};
+
+    if (fstat(fd, &status) != 0)
+    { throw makeError(name, "cannot stat shared memory"); }
+
+    if (status.st_size > 0)
+    { return static_cast<size_t>(status.st_size); }
+
+    if (std::chrono::steady_clock::now() > deadline)
+    { throw std::runtime_error{"ShmRing '" + name + "' was never initialized. Remove it, and try again."}; }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+}
+}
+
+struct ShmRing::Header
+{
+  std::atomic<uint32_t> state{0};
+  uint64_t capacity = 0;
+  uint64_t slot_size = 0;
+
+  alignas(cache_line_size) std::atomic<uint64_t> head{0}; ///< Index of the next message to write
+  std::atomic<uint32_t> data_sequence{0};                 ///< Futex word, bumped by every commit
+  std::atomic<uint32_t> num_waiting_readers{0};
+  std::atomic<uint64_t> num_dropped{0};
+
+  alignas(cache_line_size) std::atomic<uint64_t> tail{0}; ///< Index of the oldest message
+  std::atomic<uint32_t> space_sequence{0};                ///< Futex word, bumped by every message taken out
+  std::atomic<uint32_t> num_waiting_writers{0};
+};
+
+struct ShmRing::SlotState
+{
+  std::atomic<uint32_t> owner{free_slot};
+  uint64_t size = 0; ///< Size of the message in the slot, written before it is queued
+};
+
+ShmRing::ShmRing(const std::string& name, const size_t capacity, const size_t slot_size, const Side side)
+  : capacity_{capacity}
+  , num_slots_{capacity + 2}
+  , slot_size_{slot_size}
+  , slot_stride_{roundUp(slot_size, cache_line_size)}
+  , mapped_size_{
+    roundUp(sizeof(Header), cache_line_size)
+    + roundUp(capacity * sizeof(std::atomic<uint32_t>), cache_line_size)
+    + roundUp(num_slots_ * sizeof(SlotState), cache_line_size)
+    + num_slots_ * slot_stride_
+  }
+{
+  if (capacity == 0 || slot_size == 0)
+  { throw std::invalid_argument{"ShmRing '" + name + "': capacity and slot size must be 1 or more"}; }
+
+  const auto [fd, is_creator] = openObject(name);
+
+  if (is_creator && ftruncate(fd, static_cast<off_t>(mapped_size_)) != 0)
+  {
+    close(fd);
+    throw makeError(name, "cannot size shared memory");
+  }
+
+  const size_t existing_size = is_creator ? mapped_size_ : awaitSize(name, fd);
+
+  if (existing_size != mapped_size_)
+  {
+    close(fd);
+    throw std::invalid_argument{"ShmRing '" + name + "' exists with a different capacity or slot size"};
+  }
+
+  void* memory = mmap(nullptr, mapped_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+
+  if (memory == MAP_FAILED)
+  { throw makeError(name, "cannot map shared memory"); }
+
+  auto* bytes = static_cast<std::byte*>(memory);
+  bytes += roundUp(sizeof(Header), cache_line_size);
+  entries_ = reinterpret_cast<std::atomic<uint32_t>*>(bytes);
+  bytes += roundUp(capacity * sizeof(std::atomic<uint32_t>), cache_line_size);
+  slot_states_ = reinterpret_cast<SlotState*>(bytes);
+  bytes += roundUp(num_slots_ * sizeof(SlotState), cache_line_size);
+  slots_ = bytes;
+
+  if (is_creator)
+  {
+    for (size_t i = 0; i < capacity; ++i)
+    { new(entries_ + i) std::atomic<uint32_t>{0}; }
+
+    for (size_t i = 0; i < num_slots_; ++i)
+    { new(slot_states_ + i) SlotState{}; }
+
+    header_ = new(memory) Header{};
+    header_->capacity = capacity;
+    header_->slot_size = slot_size;
+    header_->state.store(ready_state, std::memory_order_release);
+    return;
+  }
+
+  header_ = static_cast<Header*>(memory);
+  const auto deadline = std::chrono::steady_clock::now() + attach_timeout;
+
+  while (header_->state.load(std::memory_order_acquire) != ready_state)
+  {
+    if (std::chrono::steady_clock::now() > deadline)
+    {
+      munmap(memory, mapped_size_);
+      throw std::runtime_error{"ShmRing '" + name + "' was never initialized. Remove it, and try again."};
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+
+  if (header_->capacity != capacity || header_->slot_size != slot_size)
+  {
+    munmap(memory, mapped_size_);
+    throw std::invalid_argument{"ShmRing '" + name + "' exists with a different capacity or slot size"};
+  }
+
+  reclaim(side);
+}
+
+ShmRing::~ShmRing()
+{
+  munmap(header_, mapped_size_);
+}
+
+std::optional<ShmRing::Loan> ShmRing::loan(const LeakPolicy policy)
+{
+  std::unique_lock lock{writer_mutex_};
+  auto& header = *header_;
+
+  // Only this process writes, and only under the mutex
+  const uint64_t head = header.head.load(std::memory_order_relaxed);
+
+  for (;;)
+  {
+    const uint32_t sequence = header.space_sequence.load();
+
+    if (terminated_)
+    { return std::nullopt; }
+
+    // A Leaky writer makes space when it commits
+    if (policy == LeakPolicy::Leaky || head - header.tail.load(std::memory_order_acquire) < capacity_)
+    { break; }
+
+    header.num_waiting_writers.fetch_add(1);
+
+    if (head - header.tail.load() >= capacity_)
+    { futexWait(header.space_sequence, sequence); }
+
+    header.num_waiting_writers.fetch_sub(1);
+  }
+
+  // At most `capacity` slots are queued, one viewed, and none loaned, so one of them is free
+  for (size_t i = 0; i < num_slots_; ++i)
+  {
+    const auto slot = static_cast<uint32_t>((next_free_ + i) % num_slots_);
+    uint32_t owner = free_slot;
+
+    if (slot_states_[slot].owner.compare_exchange_strong(owner, loaned_slot))
+    {
+      next_free_ = static_cast<uint32_t>((slot + 1) % num_slots_);
+      return Loan{*this, std::move(lock), slot, policy};
+    }
+  }
+
+  throw std::runtime_error{"ShmRing: no free slot. Is more than one process writing to or reading from the ring?"};
+}
+
+bool ShmRing::push(const void* data, const size_t size, const LeakPolicy policy)
+{
+  if (size > slot_size_)
+  {
+    throw std::invalid_argument{
+      "ShmRing: message of " + std::to_string(size) + " bytes does not fit in slots of " + std::to_string(slot_size_)
+    };
+  }
+
+  auto slot = loan(policy);
+
+  if (!slot)
+  { return false; }
+
+  std::memcpy(slot->data(), data, size);
+  slot->commit(size);
+
+  return true;
+}
+
+std::optional<ShmRing::View> ShmRing::acquire()
+{
+  if (has_view_)
+  { throw std::logic_error{"ShmRing: the previous View must be destroyed before the next message is acquired"}; }
+
+  auto& header = *header_;
+
+  for (;;)
+  {
+    const uint32_t sequence = header.data_sequence.load();
+
+    if (terminated_)
+    { return std::nullopt; }
+
+    if (auto view = tryAcquire())
+    { return view; }
+
+    header.num_waiting_readers.fetch_add(1);
+
+    if (header.head.load() == header.tail.load())
+    { futexWait(header.data_sequence, sequence); }
+
+    header.num_waiting_readers.fetch_sub(1);
+  }
+}
+
+std::optional<ShmRing::View> ShmRing::tryAcquire()
+{
+  if (has_view_)
+  { throw std::logic_error{"ShmRing: the previous View must be destroyed before the next message is acquired"}; }
+
+  const auto slot = takeOldest();
+
+  if (!slot)
+  { return std::nullopt; }
+
+  auto& state = slot_states_[*slot];
+  state.owner.store(viewed_slot);
+  has_view_ = true;
+
+  return View{*this, *slot, static_cast<size_t>(state.size)};
+}
+
+std::optional<size_t> ShmRing::pop(void* data)
+{
+  const auto view = acquire();
+
+  if (!view)
+  { return std::nullopt; }
+
+  std::memcpy(data, view->data(), view->size());
+  return view->size();
+}
+
+std::optional<size_t> ShmRing::tryPop(void* data)
+{
+  const auto view = tryAcquire();
+
+  if (!view)
+  { return std::nullopt; }
+
+  std::memcpy(data, view->data(), view->size());
+  return view->size();
+}
+
+void ShmRing::terminate()
+{
+  terminated_ = true;
+
+  // Bumping the sequences makes sure that a thread about to wait does not miss the wakeup
+  header_->data_sequence.fetch_add(1);
+  header_->space_sequence.fetch_add(1);
+  futexWakeAll(header_->data_sequence);
+  futexWakeAll(header_->space_sequence);
+}
+
+bool ShmRing::isTerminated() const
+{
+  return terminated_;
+}
+
+size_t ShmRing::getQueueSize() const
+{
+  const uint64_t tail = header_->tail.load();
+  const uint64_t head = header_->head.load();
+
+  return head > tail ? static_cast<size_t>(head - tail) : 0;
+}
+
+size_t ShmRing::getNumDropped() const
+{
+  return header_->num_dropped.load(std::memory_order_relaxed);
+}
+
+size_t ShmRing::getCapacity() const
+{
+  return capacity_;
+}
+
+size_t ShmRing::getSlotSize() const
+{
+  return slot_size_;
+}
+
+void ShmRing::remove(const std::string& name)
+{
+  if (shm_unlink(name.c_str()) != 0 && errno != ENOENT)
+  { throw makeError(name, "cannot remove shared memory"); }
+}
+
+std::byte* ShmRing::getSlot(const uint32_t slot) const
+{
+  return slots_ + slot * slot_stride_;
+}
+
+void ShmRing::reclaim(const Side side)
+{
+  if (side == Side::Writer)
+  {
+    while (const auto slot = takeOldest())
+    {
+      slot_states_[*slot].owner.store(free_slot);
+      header_->num_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // A message is taken before its slot is marked as viewed, so a queued slot is never reclaimed
+  const uint32_t stale_owner = side == Side::Writer ? loaned_slot : viewed_slot;
+
+  for (size_t i = 0; i < num_slots_; ++i)
+  {
+    uint32_t owner = stale_owner;
+    slot_states_[i].owner.compare_exchange_strong(owner, free_slot);
+  }
+}
+
+void ShmRing::commit(const uint32_t slot, const size_t size, const LeakPolicy policy)
+{
+  auto& header = *header_;
+  const uint64_t head = header.head.load(std::memory_order_relaxed);
+
+  // A PushBlocking loan waited for space, which only this writer could take back
+  while (policy == LeakPolicy::Leaky && head - header.tail.load(std::memory_order_acquire) >= capacity_)
+  {
+    if (const auto dropped = takeOldest())
+    {
+      slot_states_[*dropped].owner.store(free_slot);
+      header.num_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  auto& state = slot_states_[slot];
+  state.size = size;
+  state.owner.store(queued_slot);
+  entries_[head % capacity_].store(slot);
+  header.head.store(head + 1, std::memory_order_release);
+
+  header.data_sequence.fetch_add(1);
+
+  if (header.num_waiting_readers.load() > 0)
+  { futexWakeAll(header.data_sequence); }
+}
+
+std::optional<uint32_t> ShmRing::takeOldest()
+{
+  auto& header = *header_;
+
+  for (;;)
+  {
+    uint64_t tail = header.tail.load(std::memory_order_acquire);
+
+    if (tail == header.head.load(std::memory_order_acquire))
+    { return std::nullopt; }
+
+    // The writer may drop the message and reuse the entry meanwhile. Then the tail has moved.
+    const uint32_t slot = entries_[tail % capacity_].load();
+
+    if (header.tail.compare_exchange_strong(tail, tail + 1, std::memory_order_acq_rel))
+    {
+      header.space_sequence.fetch_add(1);
+
+      if (header.num_waiting_writers.load() > 0)
+      { futexWakeAll(header.space_sequence); }
+
+      return slot;
+    }
+  }
+}
+
+void ShmRing::release(const uint32_t slot)
+{
+  has_view_ = false;
+  slot_states_[slot].owner.store(free_slot, std::memory_order_release);
+}
+
+ShmRing::Loan::Loan(ShmRing& ring, std::unique_lock<std::mutex> lock, const uint32_t slot, const LeakPolicy policy)
+  : ring_{&ring}
+  , lock_{std::move(lock)}
+  , slot_{slot}
+  , policy_{policy}
+{}
+
+ShmRing::Loan::Loan(Loan&& other) noexcept
+  : ring_{std::exchange(other.ring_, nullptr)}
+  , lock_{std::move(other.lock_)}
+  , slot_{other.slot_}
+  , policy_{other.policy_}
+  , committed_{other.committed_}
+{}
+
+ShmRing::Loan::~Loan()
+{
+  if (ring_ != nullptr && !committed_)
+  { ring_->slot_states_[slot_].owner.store(free_slot); }
+}
+
+void* ShmRing::Loan::data() const
+{
+  return ring_->getSlot(slot_);
+}
+
+size_t ShmRing::Loan::size() const
+{
+  return ring_->slot_size_;
+}
+
+void ShmRing::Loan::commit(const size_t size)
+{
+  if (size > ring_->slot_size_)
+  {
+    throw std::invalid_argument{
+      "ShmRing: message of " + std::to_string(size) + " bytes does not fit in slots of " + std::to_string(ring_->slot_size_)
+    };
+  }
+
+  if (committed_)
+  { throw std::logic_error{"ShmRing: a Loan can only be committed once"}; }
+
+  ring_->commit(slot_, size, policy_);
+  committed_ = true;
+  lock_.unlock();
+}
+
+ShmRing::View::View(ShmRing& ring, const uint32_t slot, const size_t size)
+  : ring_{&ring}
+  , slot_{slot}
+  , size_{size}
+{}
+
+ShmRing::View::View(View&& other) noexcept
+  : ring_{std::exchange(other.ring_, nullptr)}
+  , slot_{other.slot_}
+  , size_{other.size_}
+{}
+
+ShmRing::View::~View()
+{
+  if (ring_ != nullptr)
+  { ring_->release(slot_); }
+}
+
+const void* ShmRing::View::data() const
+{
+  return ring_->getSlot(slot_);
+}
+
+size_t ShmRing::View::size() const
+{
+  return size_;
+}
+}
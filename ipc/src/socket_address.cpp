@@ -0,0 +1,240 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/ipc/socket_address.h"
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+namespace flow::ipc
+{
+namespace
+{
+constexpr int listen_backlog = 8;
+constexpr std::chrono::milliseconds connect_poll_interval{10};
+
+std::runtime_error makeError(const std::string& address, const std::string& what)
+{
+  return std::runtime_error{"SocketAddress '" + address + "': " + what + ": " + std::strerror(errno)};
+}
+
+sockaddr_un makeUnixAddress(const std::string& path)
+{
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+  return addr;
+}
+
+using AddrInfoPtr = std::unique_ptr<addrinfo, decltype(&::freeaddrinfo)>;
+
+AddrInfoPtr resolve(const std::string& host, const uint16_t port, const int flags)
+{
+  addrinfo hints{};
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags = flags;
+
+  addrinfo* result = nullptr;
+
+  if (::getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &result) != 0 || result == nullptr)
+  { return {nullptr, &::freeaddrinfo}; }
+
+  return {result, &::freeaddrinfo};
+}
+
+/// Wait for a non-blocking `connect` in progress on `socket` to complete
+/// \return true if the socket is connected
+bool awaitConnection(
+    const int socket,
+    const std::chrono::milliseconds timeout,
+    const std::function<bool()>& is_cancelled)
+{
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+  while (!is_cancelled || !is_cancelled())
+  {
+    const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+      deadline - std::chrono::steady_clock::now()
+    );
+
+    if (remaining.count() <= 0)
+    {
+      errno = ETIMEDOUT;
+      return false;
+    }
+
+    pollfd fd{socket, POLLOUT, 0};
+    const int ready = ::poll(&fd, 1, static_cast<int>(std::min(remaining, connect_poll_interval).count()));
+
+    if (ready < 0 && errno != EINTR)
+    { return false; }
+
+    if (ready > 0)
+    {
+      int error = 0;
+      socklen_t error_size = sizeof(error);
+
+      if (::getsockopt(socket, SOL_SOCKET, SO_ERROR, &error, &error_size) != 0)
+      { return false; }
+
+      errno = error;
+      return error == 0;
+    }
+  }
+
+  errno = ECANCELED;
+  return false;
+}
+}
+
+SocketAddress::SocketAddress(const std::string& address)
+  : address_{address}
+{
+  const auto invalid = [&address](const std::string& what)
+  {
+    return std::invalid_argument{
+      "SocketAddress '" + address + "': " + what + ", expected 'unix:<path>' or 'tcp:<host>:<port>'"
+    };
+  };
+
+  if (address.rfind("unix:", 0) == 0)
+  {
+    is_unix_ = true;
+    path_ = address.substr(5);
+
+    if (path_.empty())
+    { throw invalid("the path is empty"); }
+
+    if (path_.size() >= sizeof(sockaddr_un::sun_path))
+    { throw invalid("the path is too long"); }
+
+    return;
+  }
+
+  if (address.rfind("tcp:", 0) != 0)
+  { throw invalid("unknown protocol"); }
+
+  const auto separator = address.rfind(':');
+  host_ = address.substr(4, separator - 4);
+  const auto port = address.substr(separator + 1);
+
+  if (separator < 4 || host_.empty())
+  { throw invalid("the host is empty"); }
+
+  if (port.empty() || port.size() > 5 || port.find_first_not_of("0123456789") != std::string::npos
+      || std::stoul(port) > UINT16_MAX)
+  { throw invalid("the port is not a number from 0 to 65535"); }
+
+  port_ = static_cast<uint16_t>(std::stoul(port));
+}
+
+int SocketAddress::listen() const
+{
+  const int socket = ::socket(is_unix_ ? AF_UNIX : AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+  if (socket < 0)
+  { throw makeError(address_, "socket"); }
+
+  int result = -1;
+
+  if (is_unix_)
+  {
+    ::unlink(path_.c_str());
+    const auto addr = makeUnixAddress(path_);
+    result = ::bind(socket, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+  }
+  else if (const auto info = resolve(host_, port_, AI_PASSIVE))
+  {
+    const int reuse = 1;
+    ::setsockopt(socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    result = ::bind(socket, info->ai_addr, info->ai_addrlen);
+  }
+  else
+  { errno = EADDRNOTAVAIL; }
+
+  if (result != 0 || ::listen(socket, listen_backlog) != 0)
+  {
+    const auto error = makeError(address_, "cannot listen");
+    ::close(socket);
+
+    throw error;
+  }
+
+  return socket;
+}
+
+int SocketAddress::connect(
+    const std::chrono::milliseconds timeout,
+    const std::function<bool()>& is_cancelled) const
+{
+  const int socket = ::socket(is_unix_ ? AF_UNIX : AF_INET, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+
+  if (socket < 0)
+  { return -1; }
+
+  int result = -1;
+
+  if (is_unix_)
+  {
+    const auto addr = makeUnixAddress(path_);
+    result = ::connect(socket, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+  }
+  else if (const auto info = resolve(host_, port_, 0))
+  {
+    result = ::connect(socket, info->ai_addr, info->ai_addrlen);
+
+    const int no_delay = 1;
+    ::setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+  }
+
+  if (result != 0 && errno == EINPROGRESS && awaitConnection(socket, timeout, is_cancelled))
+  { result = 0; }
+
+  // The sender writes whole batches, so the connected socket is made blocking again
+  if (result != 0 || ::fcntl(socket, F_SETFL, ::fcntl(socket, F_GETFL) & ~O_NONBLOCK) != 0)
+  {
+    ::close(socket);
+    return -1;
+  }
+
+  return socket;
+}
+
+std::string SocketAddress::getBoundAddress(const int socket) const
+{
+  if (is_unix_)
+  { return address_; }
+
+  sockaddr_in addr{};
+  socklen_t addr_size = sizeof(addr);
+
+  if (::getsockname(socket, reinterpret_cast<sockaddr*>(&addr), &addr_size) != 0)
+  { throw makeError(address_, "getsockname"); }
+
+  return "tcp:" + host_ + ":" + std::to_string(ntohs(addr.sin_port));
+}
+
+void SocketAddress::unlink() const
+{
+  if (is_unix_)
+  { ::unlink(path_.c_str()); }
+}
+
+const std::string& SocketAddress::toString() const
+{
+  return address_;
+}
+}
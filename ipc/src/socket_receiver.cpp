@@ -0,0 +1,164 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/ipc/socket_receiver.h"
+
+#include <arpa/inet.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace flow::ipc
+{
+namespace
+{
+constexpr int poll_timeout_ms = 100;
+constexpr size_t read_size = 64 * 1024;
+
+/// Pass each complete message in `buffer` to `handler`, and erase them from it
+/// \return false if a message is too large, or the handler asked to stop
+bool handleMessages(
+  std::vector<std::byte>& buffer,
+  const SocketReceiver::Handler& handler,
+  std::atomic<bool>& stopping
+)
+{
+  size_t offset = 0;
+  bool ok = true;
+
+  while (buffer.size() - offset >= sizeof(uint32_t))
+  {
+    uint32_t size;
+    std::memcpy(&size, buffer.data() + offset, sizeof(size));
+    size = ntohl(size);
+
+    if (size > SocketReceiver::max_message_size)
+    {
+      ok = false;
+      break;
+    }
+
+    if (buffer.size() - offset - sizeof(size) < size)
+    { break; }
+
+    offset += sizeof(size);
+
+    if (!handler(buffer.data() + offset, size))
+    {
+      stopping = true;
+      ok = false;
+      break;
+    }
+
+    offset += size;
+  }
+
+  buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(offset));
+
+  return ok;
+}
+}
+
+SocketReceiver::SocketReceiver(const std::string& address, Handler handler)
+  : address_{address}
+  , handler_{std::move(handler)}
+  , server_socket_{address_.listen()}
+  , bound_address_{address_.getBoundAddress(server_socket_)}
+  , thread_{[this]() { run(); }}
+{}
+
+SocketReceiver::~SocketReceiver()
+{
+  stop();
+}
+
+void SocketReceiver::stop()
+{
+  stopping_ = true;
+
+  if (thread_.joinable())
+  { thread_.join(); }
+
+  if (server_socket_ >= 0)
+  {
+    ::close(server_socket_);
+    server_socket_ = -1;
+    address_.unlink();
+  }
+}
+
+const std::string& SocketReceiver::getAddress() const
+{
+  return bound_address_;
+}
+
+bool SocketReceiver::isConnected() const
+{
+  return connected_;
+}
+
+size_t SocketReceiver::getNumConnections() const
+{
+  return num_connections_;
+}
+
+void SocketReceiver::run()
+{
+  int client_socket = -1;
+  std::vector<std::byte> buffer;
+
+  const auto disconnect = [&]()
+  {
+    if (client_socket >= 0)
+    { ::close(client_socket); }
+
+    client_socket = -1;
+    connected_ = false;
+    buffer.clear();
+  };
+
+  while (!stopping_)
+  {
+    pollfd polls[2] = {{server_socket_, POLLIN, 0}, {client_socket, POLLIN, 0}};
+
+    if (::poll(polls, client_socket >= 0 ? 2 : 1, poll_timeout_ms) <= 0)
+    { continue; }
+
+    if (polls[0].revents & POLLIN)
+    {
+      const int socket = ::accept4(server_socket_, nullptr, nullptr, SOCK_CLOEXEC);
+
+      if (socket >= 0)
+      {
+        disconnect();
+        client_socket = socket;
+        connected_ = true;
+        ++num_connections_;
+        continue;
+      }
+    }
+
+    if (client_socket < 0 || polls[1].revents == 0)
+    { continue; }
+
+    const auto old_size = buffer.size();
+    buffer.resize(old_size + read_size);
+    const auto result = ::recv(client_socket, buffer.data() + old_size, read_size, 0);
+
+    if (result <= 0)
+    {
+      disconnect();
+      continue;
+    }
+
+    buffer.resize(old_size + static_cast<size_t>(result));
+
+    if (!handleMessages(buffer, handler_, stopping_))
+    { disconnect(); }
+  }
+
+  disconnect();
+}
+}
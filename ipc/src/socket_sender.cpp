@@ -0,0 +1,219 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/ipc/socket_sender.h"
+
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+namespace flow::ipc
+{
+namespace
+{
+void appendFrame(std::vector<std::byte>& batch, const std::vector<std::byte>& message)
+{
+  const uint32_t size = htonl(static_cast<uint32_t>(message.size()));
+  const auto* size_bytes = reinterpret_cast<const std::byte*>(&size);
+
+  batch.insert(batch.end(), size_bytes, size_bytes + sizeof(size));
+  batch.insert(batch.end(), message.begin(), message.end());
+}
+
+bool sendAll(const int socket, const std::vector<std::byte>& data)
+{
+  size_t sent = 0;
+
+  while (sent < data.size())
+  {
+    const auto result = ::send(socket, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+
+    if (result <= 0)
+    { return false; }
+
+    sent += static_cast<size_t>(result);
+  }
+
+  return true;
+}
+}
+
+SocketSender::SocketSender(const std::string& address, const size_t buffer_size, const LeakPolicy policy)
+  : address_{address}
+  , buffer_size_{buffer_size}
+  , policy_{policy}
+{
+  if (buffer_size == 0)
+  { throw std::invalid_argument{"SocketSender '" + address + "': 'buffer_size' must be 1 or more"}; }
+
+  thread_ = std::thread{[this]() { run(); }};
+}
+
+SocketSender::~SocketSender()
+{
+  terminate();
+
+  if (thread_.joinable())
+  { thread_.join(); }
+}
+
+bool SocketSender::send(std::vector<std::byte>&& message)
+{
+  if (message.size() > UINT32_MAX)
+  { throw std::invalid_argument{"SocketSender '" + address_.toString() + "': the message is too large"}; }
+
+  {
+    std::unique_lock lock{mutex_};
+
+    if (policy_ == LeakPolicy::PushBlocking)
+    { has_space_.wait(lock, [this]() { return terminated_ || queue_.size() < buffer_size_; }); }
+
+    if (terminated_)
+    { return false; }
+
+    if (queue_.size() >= buffer_size_)
+    {
+      queue_.pop_front();
+      ++num_dropped_;
+    }
+
+    queue_.push_back(std::move(message));
+  }
+
+  has_message_.notify_one();
+
+  return true;
+}
+
+void SocketSender::terminate()
+{
+  {
+    std::scoped_lock lock{mutex_};
+    terminated_ = true;
+    queue_.clear();
+
+    // Wake the thread if it is blocked by a slow receiver
+    if (socket_ >= 0)
+    { ::shutdown(socket_, SHUT_RDWR); }
+  }
+
+  has_message_.notify_all();
+  has_space_.notify_all();
+}
+
+bool SocketSender::isTerminated() const
+{
+  std::scoped_lock lock{mutex_};
+  return terminated_;
+}
+
+bool SocketSender::isConnected() const
+{
+  return connected_;
+}
+
+size_t SocketSender::getQueueSize() const
+{
+  std::scoped_lock lock{mutex_};
+  return queue_.size();
+}
+
+size_t SocketSender::getNumDropped() const
+{
+  std::scoped_lock lock{mutex_};
+  return num_dropped_;
+}
+
+void SocketSender::run()
+{
+  std::vector<std::byte> batch;
+  auto backoff = min_backoff;
+
+  while (!isTerminated())
+  {
+    if (!connected_)
+    {
+      const int socket = address_.connect(connect_timeout, [this]() { return isTerminated(); });
+
+      if (socket < 0)
+      {
+        waitFor(backoff);
+        backoff = std::min(2 * backoff, max_backoff);
+        continue;
+      }
+
+      std::unique_lock lock{mutex_};
+
+      if (terminated_)
+      {
+        ::close(socket);
+        break;
+      }
+
+      socket_ = socket;
+      connected_ = true;
+      backoff = min_backoff;
+    }
+
+    const size_t num_messages = takeBatch(batch);
+
+    if (num_messages == 0)
+    { break; }
+
+    if (sendAll(socket_, batch))
+    { continue; }
+
+    std::scoped_lock lock{mutex_};
+    ::close(socket_);
+    socket_ = -1;
+    connected_ = false;
+
+    if (!terminated_)
+    { num_dropped_ += num_messages; }
+  }
+
+  std::scoped_lock lock{mutex_};
+
+  if (socket_ >= 0)
+  {
+    ::close(socket_);
+    socket_ = -1;
+  }
+
+  connected_ = false;
+}
+
+size_t SocketSender::takeBatch(std::vector<std::byte>& batch)
+{
+  batch.clear();
+  size_t num_messages = 0;
+
+  {
+    std::unique_lock lock{mutex_};
+    has_message_.wait(lock, [this]() { return terminated_ || !queue_.empty(); });
+
+    if (terminated_)
+    { return 0; }
+
+    while (!queue_.empty()
+           && (num_messages == 0 || batch.size() + sizeof(uint32_t) + queue_.front().size() <= max_batch_size))
+    {
+      appendFrame(batch, queue_.front());
+      queue_.pop_front();
+      ++num_messages;
+    }
+  }
+
+  has_space_.notify_all();
+
+  return num_messages;
+}
+
+void SocketSender::waitFor(const std::chrono::milliseconds duration)
+{
+  std::unique_lock lock{mutex_};
+  has_message_.wait_for(lock, duration, [this]() { return terminated_; });
+}
+}
@@ -0,0 +1,488 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/ipc/status_board.h"
+#include "superflow/utils/signal_waiter.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+
+namespace flow::ipc
+{
+namespace
+{
+constexpr size_t cache_line_size = 64;
+
+/// Attempts to copy a snapshot before giving up, when the board is updated during each of them
+constexpr int max_read_attempts = 100;
+
+size_t roundUp(const size_t size, const size_t alignment)
+{
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+std::runtime_error makeError(const std::string& name, const std::string& what)
+{
+  return std::runtime_error{"StatusBoard '" + name + "': " + what + ": " + std::strerror(errno)};
+}
+
+/// Structs are written field by field, so that their layout never becomes part of the format
+template<typename T>
+void put(std::vector<std::byte>& buffer, const T& value)
+{
+  static_assert(std::is_arithmetic_v<T>, "Only numbers are written as they are");
+
+  const auto* bytes = reinterpret_cast<const std::byte*>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+void putString(std::vector<std::byte>& buffer, const std::string& text)
+{
+  put(buffer, static_cast<uint32_t>(text.size()));
+
+  const auto* bytes = reinterpret_cast<const std::byte*>(text.data());
+  buffer.insert(buffer.end(), bytes, bytes + text.size());
+}
+
+void putSize(std::vector<std::byte>& buffer, const size_t size)
+{
+  put(buffer, static_cast<uint64_t>(size));
+}
+
+void putBool(std::vector<std::byte>& buffer, const bool value)
+{
+  put(buffer, static_cast<uint8_t>(value));
+}
+
+void putThread(std::vector<std::byte>& buffer, const ThreadStatistics& thread)
+{
+  put(buffer, thread.thread_id);
+  put(buffer, thread.cpu_time);
+  put(buffer, thread.run_delay);
+  putSize(buffer, thread.voluntary_context_switches);
+  putSize(buffer, thread.involuntary_context_switches);
+  putBool(buffer, thread.runnable);
+}
+
+void putPerf(std::vector<std::byte>& buffer, const PerfCounterRates& perf)
+{
+  put(buffer, perf.cycles);
+  put(buffer, perf.instructions);
+  put(buffer, perf.cache_misses);
+  put(buffer, perf.branch_misses);
+  put(buffer, perf.page_faults);
+  put(buffer, perf.cpu_utilization);
+  putBool(buffer, perf.hardware);
+}
+
+void putAllocations(std::vector<std::byte>& buffer, const AllocationStatistics& allocations)
+{
+  put(buffer, allocations.count);
+  put(buffer, allocations.bytes);
+  put(buffer, allocations.count_per_item);
+  put(buffer, allocations.bytes_per_item);
+}
+
+void putPort(std::vector<std::byte>& buffer, const PortStatus& port)
+{
+  putSize(buffer, port.num_connections);
+  putSize(buffer, port.num_transactions);
+  put(buffer, port.waiting_time);
+  put(buffer, port.processing_time);
+  putSize(buffer, port.queue_size);
+  putSize(buffer, port.num_dropped);
+  put(buffer, port.blocked_time);
+  putSize(buffer, port.spilled_bytes);
+  putSize(buffer, port.num_spilled);
+}
+
+void putField(std::vector<std::byte>& buffer, const StatusField& field)
+{
+  put(buffer, static_cast<uint32_t>(field.type));
+  put(buffer, field.value);
+}
+
+/// Reads the values written by the `put` functions, throwing if they run past the end
+class Decoder
+{
+public:
+  Decoder(const std::byte* data, const size_t size)
+    : data_{data}
+    , size_{size}
+  {}
+
+  template<typename T>
+  T get()
+  {
+    T value;
+    std::memcpy(&value, take(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  std::string getString()
+  {
+    const auto size = get<uint32_t>();
+    return {reinterpret_cast<const char*>(take(size)), size};
+  }
+
+  size_t getSize()
+  { return static_cast<size_t>(get<uint64_t>()); }
+
+  bool getBool()
+  { return get<uint8_t>() != 0; }
+
+  ThreadStatistics getThread()
+  {
+    ThreadStatistics thread;
+    thread.thread_id = get<int64_t>();
+    thread.cpu_time = get<double>();
+    thread.run_delay = get<double>();
+    thread.voluntary_context_switches = getSize();
+    thread.involuntary_context_switches = getSize();
+    thread.runnable = getBool();
+    return thread;
+  }
+
+  PerfCounterRates getPerf()
+  {
+    PerfCounterRates perf;
+    perf.cycles = get<double>();
+    perf.instructions = get<double>();
+    perf.cache_misses = get<double>();
+    perf.branch_misses = get<double>();
+    perf.page_faults = get<double>();
+    perf.cpu_utilization = get<double>();
+    perf.hardware = getBool();
+    return perf;
+  }
+
+  AllocationStatistics getAllocations()
+  {
+    AllocationStatistics allocations;
+    allocations.count = get<uint64_t>();
+    allocations.bytes = get<uint64_t>();
+    allocations.count_per_item = get<double>();
+    allocations.bytes_per_item = get<double>();
+    return allocations;
+  }
+
+  PortStatus getPort()
+  {
+    PortStatus port{getSize(), 0};
+    port.num_transactions = getSize();
+    port.waiting_time = get<double>();
+    port.processing_time = get<double>();
+    port.queue_size = getSize();
+    port.num_dropped = getSize();
+    port.blocked_time = get<double>();
+    port.spilled_bytes = getSize();
+    port.num_spilled = getSize();
+    return port;
+  }
+
+  StatusField getField()
+  {
+    const auto type = static_cast<StatusField::Type>(get<uint32_t>());
+    return {type, get<double>()};
+  }
+
+private:
+  const std::byte* data_;
+  size_t size_;
+  size_t offset_ = 0;
+
+  const std::byte* take(const size_t size)
+  {
+    if (size > size_ - offset_)
+    { throw std::runtime_error{"StatusBoard: the snapshot is corrupt"}; }
+
+    const auto* data = data_ + offset_;
+    offset_ += size;
+    return data;
+  }
+};
+
+void encode(const ProxelStatusMap& statuses, std::vector<std::byte>& buffer)
+{
+  put(buffer, static_cast<uint32_t>(statuses.size()));
+
+  for (const auto& [proxel_name, status] : statuses)
+  {
+    putString(buffer, proxel_name);
+    put(buffer, static_cast<uint32_t>(status.state));
+    putString(buffer, status.info);
+    putSize(buffer, status.num_restarts);
+    put(buffer, status.mean_time_between_failures);
+    put(buffer, status.busyness);
+    put(buffer, status.processing_time);
+    putThread(buffer, status.thread);
+    putPerf(buffer, status.perf);
+    putAllocations(buffer, status.allocations);
+
+    put(buffer, static_cast<uint32_t>(status.ports.size()));
+
+    for (const auto& [port_name, port_status] : status.ports)
+    {
+      putString(buffer, port_name);
+      putPort(buffer, port_status);
+    }
+
+    put(buffer, static_cast<uint32_t>(status.fields.size()));
+
+    for (const auto& [field_name, field] : status.fields)
+    {
+      putString(buffer, field_name);
+      putField(buffer, field);
+    }
+  }
+}
+
+ProxelStatusMap decode(const std::byte* data, const size_t size)
+{
+  Decoder decoder{data, size};
+  ProxelStatusMap statuses;
+
+  for (auto num_proxels = decoder.get<uint32_t>(); num_proxels > 0; --num_proxels)
+  {
+    const auto proxel_name = decoder.getString();
+    ProxelStatus status{};
+
+    status.state = static_cast<ProxelStatus::State>(decoder.get<uint32_t>());
+    status.info = decoder.getString();
+    status.num_restarts = decoder.getSize();
+    status.mean_time_between_failures = decoder.get<double>();
+    status.busyness = decoder.get<double>();
+    status.processing_time = decoder.get<double>();
+    status.thread = decoder.getThread();
+    status.perf = decoder.getPerf();
+    status.allocations = decoder.getAllocations();
+
+    for (auto num_ports = decoder.get<uint32_t>(); num_ports > 0; --num_ports)
+    {
+      auto port_name = decoder.getString();
+      status.ports.emplace(std::move(port_name), decoder.getPort());
+    }
+
+    for (auto num_fields = decoder.get<uint32_t>(); num_fields > 0; --num_fields)
+    {
+      auto field_name = decoder.getString();
+      status.fields.emplace(std::move(field_name), decoder.getField());
+    }
+
+    statuses.emplace(proxel_name, std::move(status));
+  }
+
+  return statuses;
+}
+}
+
+struct StatusBoardHeader
+{
+  static constexpr uint32_t magic_number = 0x42534653; ///< "SFSB" in little endian
+  static constexpr uint32_t current_format = 2; ///< Increment whenever `encode` changes
+
+  uint32_t magic = magic_number;
+  uint32_t format = current_format;
+  uint64_t capacity = 0; ///< Size of the body, in bytes
+  int64_t pid = 0;
+
+  alignas(cache_line_size) std::atomic<uint64_t> sequence{0}; ///< Odd while the body is being written
+  std::atomic<int64_t> timestamp{0};                          ///< Nanoseconds since the system clock epoch
+  std::atomic<uint64_t> body_size{0};
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<int64_t>::is_always_lock_free,
+              "StatusBoard requires lock free atomics, since they are shared between processes");
+
+StatusBoard::StatusBoard(const std::string& name, const size_t max_size)
+  : name_{name}
+  , mapped_size_{roundUp(sizeof(StatusBoardHeader), cache_line_size) + max_size}
+{
+  // Readers that still have a previous board mapped keep it, and see that it is no longer updated
+  shm_unlink(name_.c_str());
+
+  const int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+
+  if (fd < 0)
+  { throw makeError(name_, "cannot create shared memory"); }
+
+  if (ftruncate(fd, static_cast<off_t>(mapped_size_)) != 0)
+  {
+    const auto error = makeError(name_, "cannot size shared memory");
+    close(fd);
+    shm_unlink(name_.c_str());
+    throw error;
+  }
+
+  void* memory = mmap(nullptr, mapped_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+
+  if (memory == MAP_FAILED)
+  {
+    const auto error = makeError(name_, "cannot map shared memory");
+    shm_unlink(name_.c_str());
+    throw error;
+  }
+
+  header_ = new(memory) StatusBoardHeader{};
+  header_->capacity = max_size;
+  header_->pid = getpid();
+  body_ = static_cast<std::byte*>(memory) + roundUp(sizeof(StatusBoardHeader), cache_line_size);
+}
+
+StatusBoard::~StatusBoard()
+{
+  munmap(header_, mapped_size_);
+  shm_unlink(name_.c_str());
+}
+
+void StatusBoard::update(const Graph& graph)
+{
+  publish(graph.getProxelStatuses(sampler_));
+}
+
+void StatusBoard::publish(const ProxelStatusMap& statuses)
+{
+  encoded_.clear();
+  encode(statuses, encoded_);
+
+  if (encoded_.size() > header_->capacity)
+  {
+    throw std::runtime_error{
+      "StatusBoard '" + name_ + "': the statuses take " + std::to_string(encoded_.size())
+      + " bytes, but the board only holds " + std::to_string(header_->capacity)
+    };
+  }
+
+  const auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::system_clock::now().time_since_epoch()
+  ).count();
+  const auto sequence = header_->sequence.load(std::memory_order_relaxed);
+
+  header_->sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  std::memcpy(body_, encoded_.data(), encoded_.size());
+  header_->body_size.store(encoded_.size(), std::memory_order_relaxed);
+  header_->timestamp.store(timestamp, std::memory_order_relaxed);
+
+  header_->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void StatusBoard::spin(const Graph& graph, const std::chrono::milliseconds period)
+{
+  SignalWaiter waiter{{SIGINT, SIGTERM}};
+  const auto signal = waiter.getFuture();
+
+  do
+  { update(graph); }
+  while (signal.wait_for(period) != std::future_status::ready);
+}
+
+const std::string& StatusBoard::getName() const
+{
+  return name_;
+}
+
+StatusBoardReader::StatusBoardReader(const std::string& name)
+  : name_{name}
+{
+  const int fd = shm_open(name_.c_str(), O_RDONLY, 0);
+
+  if (fd < 0)
+  { throw makeError(name_, "cannot open shared memory"); }
+
+  struct stat status{};
+
+  if (fstat(fd, &status) != 0)
+  {
+    const auto error = makeError(name_, "cannot stat shared memory");
+    close(fd);
+    throw error;
+  }
+
+  mapped_size_ = static_cast<size_t>(status.st_size);
+  const auto body_offset = roundUp(sizeof(StatusBoardHeader), cache_line_size);
+
+  if (mapped_size_ < body_offset)
+  {
+    close(fd);
+    throw std::runtime_error{"StatusBoard '" + name_ + "' is not a status board"};
+  }
+
+  void* memory = mmap(nullptr, mapped_size_, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+
+  if (memory == MAP_FAILED)
+  { throw makeError(name_, "cannot map shared memory"); }
+
+  header_ = static_cast<const StatusBoardHeader*>(memory);
+  body_ = static_cast<const std::byte*>(memory) + body_offset;
+
+  if (header_->magic != StatusBoardHeader::magic_number
+      || header_->format != StatusBoardHeader::current_format
+      || header_->capacity > mapped_size_ - body_offset)
+  {
+    munmap(memory, mapped_size_);
+    throw std::runtime_error{"StatusBoard '" + name_ + "' is not a status board of format "
+                             + std::to_string(StatusBoardHeader::current_format)};
+  }
+}
+
+StatusBoardReader::~StatusBoardReader()
+{
+  munmap(const_cast<StatusBoardHeader*>(header_), mapped_size_);
+}
+
+std::optional<StatusBoardReader::Snapshot> StatusBoardReader::read() const
+{
+  for (int attempt = 0; attempt < max_read_attempts; ++attempt)
+  {
+    const auto sequence = header_->sequence.load(std::memory_order_acquire);
+
+    if (sequence == 0)
+    { return std::nullopt; }
+
+    if (sequence % 2 != 0)
+    {
+      std::this_thread::yield();
+      continue;
+    }
+
+    const auto size = header_->body_size.load(std::memory_order_relaxed);
+    const auto timestamp = header_->timestamp.load(std::memory_order_relaxed);
+
+    if (size <= header_->capacity)
+    { copy_.assign(body_, body_ + size); }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (header_->sequence.load(std::memory_order_relaxed) != sequence || size > header_->capacity)
+    {
+      std::this_thread::yield();
+      continue;
+    }
+
+    Snapshot snapshot;
+    snapshot.num_updates = sequence / 2;
+    snapshot.time = std::chrono::system_clock::time_point{
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds{timestamp})
+    };
+    snapshot.pid = header_->pid;
+    snapshot.statuses = decode(copy_.data(), copy_.size());
+
+    return snapshot;
+  }
+
+  return std::nullopt;
+}
+}
@@ -0,0 +1,228 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/ipc/bridge_proxels.h"
+#include "superflow/ipc/launcher.h"
+#include "superflow/ipc/shm_ring.h"
+
+#include "superflow/graph.h"
+
+#include "gtest/gtest.h"
+
+#include <unistd.h>
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+
+using namespace flow;
+
+namespace
+{
+/// A minimal PropertyList, \see flow::value
+class Properties
+{
+public:
+  Properties(std::initializer_list<std::pair<const std::string, std::string>> values)
+    : values_{values}
+  {}
+
+  bool hasKey(const std::string& key) const
+  { return values_.count(key) > 0; }
+
+  template<typename T>
+  T convertValue(const std::string& key) const
+  {
+    if constexpr (std::is_same_v<T, std::string>)
+    { return values_.at(key); }
+    else
+    { return static_cast<T>(std::stoul(values_.at(key))); }
+  }
+
+private:
+  std::map<std::string, std::string> values_;
+};
+
+class CounterProxel : public Proxel
+{
+public:
+  CounterProxel()
+    : out_port_{std::make_shared<ProducerPort<int>>()}
+  {
+    registerPorts({{"out", out_port_}});
+  }
+
+  void start() override
+  {
+    for (int i = 0; i < num_items && !stopped_; ++i)
+    { out_port_->send(i); }
+  }
+
+  void stop() noexcept override
+  { stopped_ = true; }
+
+  static constexpr int num_items = 100;
+
+private:
+  ProducerPort<int>::Ptr out_port_;
+  std::atomic<bool> stopped_{false};
+};
+
+class CollectorProxel : public Proxel
+{
+public:
+  CollectorProxel()
+    : in_port_{std::make_shared<CallbackConsumerPort<int>>([this](const int item) { collect(item); })}
+  {
+    registerPorts({{"in", in_port_}});
+  }
+
+  void start() override
+  {}
+
+  void stop() noexcept override
+  {}
+
+  std::vector<int> getItems() const
+  {
+    std::scoped_lock lock{mutex_};
+    return items_;
+  }
+
+  bool waitFor(const size_t num_items) const
+  {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+
+    while (getItems().size() < num_items)
+    {
+      if (std::chrono::steady_clock::now() > deadline)
+      { return false; }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    return true;
+  }
+
+private:
+  CallbackConsumerPort<int>::Ptr in_port_;
+  mutable std::mutex mutex_;
+  std::vector<int> items_;
+
+  void collect(const int item)
+  {
+    std::scoped_lock lock{mutex_};
+    items_.push_back(item);
+  }
+};
+
+std::string getChannel()
+{
+  return "superflow-test-" + std::to_string(getpid()) + '-'
+         + ::testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+
+void expectBridged(const FactoryMap<Properties>& factories, const std::string& type, const Properties& properties)
+{
+  const auto collector = std::make_shared<CollectorProxel>();
+
+  Graph graph{
+    {
+      {"counter", std::make_shared<CounterProxel>()},
+      {"sink", factories.get(type + "Sink")(properties)},
+      {"source", factories.get(type + "Source")(properties)},
+      {"collector", collector}
+    }
+  };
+
+  graph.connect("counter", "out", "sink", "in");
+  graph.connect("source", "out", "collector", "in");
+  graph.start();
+
+  EXPECT_TRUE(collector->waitFor(CounterProxel::num_items));
+  graph.stop();
+
+  const auto items = collector->getItems();
+  ASSERT_EQ(CounterProxel::num_items, items.size());
+
+  for (int i = 0; i < CounterProxel::num_items; ++i)
+  { EXPECT_EQ(i, items[static_cast<size_t>(i)]); }
+}
+}
+
+TEST(Bridges, shmBridgeCarriesItems)
+{
+  const auto channel = getChannel();
+  expectBridged(ipc::createShmBridgeFactories<int, Properties>("Int"), "IntShm", {{"channel", channel}, {"buffer_size", "8"}});
+  ipc::ShmRing::remove(ipc::getShmRingName(channel));
+}
+
+TEST(Bridges, socketBridgeCarriesItems)
+{
+  expectBridged(ipc::createSocketBridgeFactories<int, Properties>("Int"), "IntSocket", {{"channel", getChannel()}});
+}
+
+TEST(Launcher, runsEachPartitionInAProcess)
+{
+  const auto parent = getpid();
+
+  const auto status = ipc::launchPartitions(
+    {"a", "b"},
+    [parent](const std::string& partition)
+    { return getpid() != parent && (partition == "a" || partition == "b") ? 0 : 1; }
+  );
+
+  EXPECT_EQ(0, status);
+}
+
+TEST(Launcher, returnsStatusOfFailedPartition)
+{
+  const auto status = ipc::launchPartitions(
+    {"ok", "failing", "waiting"},
+    [](const std::string& partition)
+    {
+      if (partition == "failing")
+      { return 3; }
+
+      if (partition == "waiting")
+      { ::pause(); }
+
+      return 0;
+    }
+  );
+
+  EXPECT_EQ(3, status);
+}
+
+TEST(Launcher, exceptionFailsPartition)
+{
+  const auto status = ipc::launchPartitions(
+    {"throwing"},
+    [](const std::string&) -> int
+    { throw std::runtime_error{"expected"}; }
+  );
+
+  EXPECT_EQ(1, status);
+}
+
+TEST(Launcher, removesRingsOfChannels)
+{
+  const auto channel = getChannel();
+  const auto name = ipc::getShmRingName(channel);
+
+  // A stale ring of another size, which the partition could not attach to
+  { ipc::ShmRing stale{name, 2, sizeof(int), ipc::ShmRing::Side::Writer}; }
+
+  const auto status = ipc::launchPartitions(
+    {"a"},
+    [&name](const std::string&)
+    {
+      ipc::ShmRing ring{name, 4, sizeof(int), ipc::ShmRing::Side::Writer};
+      return 0;
+    },
+    {channel}
+  );
+
+  EXPECT_EQ(0, status);
+  EXPECT_NO_THROW((ipc::ShmRing{name, 8, sizeof(int), ipc::ShmRing::Side::Writer}));
+  ipc::ShmRing::remove(name);
+}
@@ -0,0 +1,147 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/ipc/shm_consumer_port.h"
+#include "superflow/ipc/shm_producer_port.h"
+
+#include "gtest/gtest.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace flow;
+
+namespace
+{
+struct Pose
+{
+  double x;
+  double y;
+  int64_t timestamp;
+};
+
+std::string getRingName()
+{
+  return "/superflow-test-" + std::to_string(getpid()) + '-'
+         + ::testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+}
+
+TEST(ShmPorts, transferAcrossProcesses)
+{
+  const auto name = getRingName();
+  constexpr int num_items = 1000;
+
+  ipc::ShmConsumerPort<Pose> consumer{name, 16};
+
+  const pid_t child = fork();
+  ASSERT_GE(child, 0);
+
+  if (child == 0)
+  {
+    ipc::ShmProducerPort<Pose, LeakPolicy::PushBlocking> producer{name, 16};
+
+    for (int i = 0; i < num_items; ++i)
+    { producer.send({0.5 * i, -0.5 * i, i}); }
+
+    _exit(0);
+  }
+
+  for (int i = 0; i < num_items; ++i)
+  {
+    const auto pose = consumer.getNext();
+    ASSERT_TRUE(pose);
+    ASSERT_EQ(i, pose->timestamp);
+    ASSERT_EQ(0.5 * i, pose->x);
+  }
+
+  int child_status = 0;
+  waitpid(child, &child_status, 0);
+  EXPECT_EQ(0, child_status);
+
+  const auto status = consumer.getStatus();
+  EXPECT_EQ(num_items, status.num_transactions);
+  EXPECT_EQ(0, status.num_dropped);
+  EXPECT_GT(status.waiting_time, 0.);
+
+  ipc::ShmRing::remove(name);
+}
+
+TEST(ShmPorts, latchedConsumerRepeatsLatestItem)
+{
+  const auto name = getRingName();
+  ipc::ShmProducerPort<int> producer{name, 4};
+  ipc::ShmConsumerPort<int, GetMode::Latched> consumer{name, 4};
+
+  producer.send(1);
+  producer.send(2);
+
+  EXPECT_EQ(1, consumer.getNext());
+  EXPECT_EQ(2, consumer.getNext());
+  EXPECT_EQ(2, consumer.getNext());
+  EXPECT_FALSE(consumer.hasNext());
+
+  consumer.deactivate();
+  EXPECT_FALSE(consumer);
+  EXPECT_FALSE(consumer.getNext());
+
+  ipc::ShmRing::remove(name);
+}
+
+TEST(ShmPorts, cannotConnectToOtherPorts)
+{
+  const auto name = getRingName();
+  auto producer = std::make_shared<ipc::ShmProducerPort<int>>(name);
+  auto consumer = std::make_shared<ipc::ShmConsumerPort<int>>(name);
+
+  EXPECT_THROW(producer->connect(consumer), std::invalid_argument);
+  EXPECT_THROW(consumer->connect(producer), std::invalid_argument);
+  EXPECT_TRUE(producer->isConnected());
+
+  ipc::ShmRing::remove(name);
+}
+
+TEST(ShmPorts, itemsAreUsedInPlace)
+{
+  const auto name = getRingName();
+  ipc::ShmProducerPort<Pose> producer{name, 2};
+  ipc::ShmConsumerPort<Pose> consumer{name, 2};
+
+  {
+    auto pose = producer.loan();
+    ASSERT_TRUE(pose);
+    (*pose)->timestamp = 42;
+    pose->commit();
+  }
+
+  {
+    const auto pose = consumer.getNextView();
+    ASSERT_TRUE(pose);
+    EXPECT_EQ(42, (*pose)->timestamp);
+  }
+
+  EXPECT_EQ(1, producer.getStatus().num_transactions);
+  EXPECT_EQ(1, consumer.getStatus().num_transactions);
+
+  consumer.deactivate();
+  EXPECT_FALSE(consumer.getNextView());
+
+  ipc::ShmRing::remove(name);
+}
+
+TEST(ShmPorts, producerDropsItemsOfPreviousProducer)
+{
+  const auto name = getRingName();
+  ipc::ShmConsumerPort<int> consumer{name, 4};
+
+  {
+    ipc::ShmProducerPort<int> previous{name, 4};
+    previous.send(1);
+  }
+
+  ipc::ShmProducerPort<int> producer{name, 4};
+  producer.send(2);
+
+  EXPECT_EQ(2, consumer.getNext());
+  EXPECT_FALSE(consumer.hasNext());
+
+  ipc::ShmRing::remove(name);
+}
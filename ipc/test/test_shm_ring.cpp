@@ -0,0 +1,228 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/ipc/shm_ring.h"
+
+#include "gtest/gtest.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <future>
+#include <thread>
+
+using namespace flow;
+
+namespace
+{
+/// A ring name that is unique to the test and the process, removed at the end of the test
+struct RingName
+{
+  std::string name = "/superflow-test-" + std::to_string(getpid()) + '-'
+                     + ::testing::UnitTest::GetInstance()->current_test_info()->name();
+
+  ~RingName()
+  { ipc::ShmRing::remove(name); }
+};
+
+void push(ipc::ShmRing& ring, const int value, const LeakPolicy policy = LeakPolicy::Leaky)
+{
+  ASSERT_TRUE(ring.push(&value, sizeof(value), policy));
+}
+
+int pop(ipc::ShmRing& ring)
+{
+  int value = 0;
+  EXPECT_EQ(sizeof(value), ring.pop(&value));
+  return value;
+}
+}
+
+TEST(ShmRing, transfersMessagesInOrder)
+{
+  const RingName ring_name;
+  ipc::ShmRing writer{ring_name.name, 4, sizeof(int), ipc::ShmRing::Side::Writer};
+  ipc::ShmRing reader{ring_name.name, 4, sizeof(int), ipc::ShmRing::Side::Reader};
+
+  push(writer, 1);
+  push(writer, 2);
+  EXPECT_EQ(2, reader.getQueueSize());
+
+  EXPECT_EQ(1, pop(reader));
+  EXPECT_EQ(2, pop(reader));
+
+  int value = 0;
+  EXPECT_FALSE(reader.tryPop(&value));
+}
+
+TEST(ShmRing, leakyRingDropsOldest)
+{
+  const RingName ring_name;
+  ipc::ShmRing writer{ring_name.name, 2, sizeof(int), ipc::ShmRing::Side::Writer};
+  ipc::ShmRing reader{ring_name.name, 2, sizeof(int), ipc::ShmRing::Side::Reader};
+
+  for (int i = 0; i < 5; ++i)
+  { push(writer, i); }
+
+  EXPECT_EQ(2, reader.getQueueSize());
+  EXPECT_EQ(3, reader.getNumDropped());
+  EXPECT_EQ(3, pop(reader));
+  EXPECT_EQ(4, pop(reader));
+}
+
+TEST(ShmRing, pushBlockingWaitsForSpace)
+{
+  const RingName ring_name;
+  ipc::ShmRing writer{ring_name.name, 1, sizeof(int), ipc::ShmRing::Side::Writer};
+  ipc::ShmRing reader{ring_name.name, 1, sizeof(int), ipc::ShmRing::Side::Reader};
+
+  push(writer, 1, LeakPolicy::PushBlocking);
+  auto pushed = std::async(std::launch::async, [&writer] { push(writer, 2, LeakPolicy::PushBlocking); });
+
+  EXPECT_EQ(std::future_status::timeout, pushed.wait_for(std::chrono::milliseconds{20}));
+  EXPECT_EQ(1, pop(reader));
+  pushed.get();
+  EXPECT_EQ(2, pop(reader));
+  EXPECT_EQ(0, reader.getNumDropped());
+}
+
+TEST(ShmRing, terminateWakesWaitingReader)
+{
+  const RingName ring_name;
+  ipc::ShmRing reader{ring_name.name, 1, sizeof(int), ipc::ShmRing::Side::Reader};
+
+  auto popped = std::async(std::launch::async, [&reader] { int value; return reader.pop(&value); });
+  EXPECT_EQ(std::future_status::timeout, popped.wait_for(std::chrono::milliseconds{20}));
+
+  reader.terminate();
+  EXPECT_FALSE(popped.get());
+  EXPECT_TRUE(reader.isTerminated());
+}
+
+TEST(ShmRing, invalidParametersThrow)
+{
+  const RingName ring_name;
+  ipc::ShmRing ring{ring_name.name, 2, sizeof(int), ipc::ShmRing::Side::Writer};
+
+  EXPECT_THROW((ipc::ShmRing{ring_name.name, 3, sizeof(int), ipc::ShmRing::Side::Reader}), std::invalid_argument);
+  EXPECT_THROW((ipc::ShmRing{ring_name.name + "-empty", 0, sizeof(int), ipc::ShmRing::Side::Reader}), std::invalid_argument);
+
+  const int64_t too_large = 0;
+  EXPECT_THROW(ring.push(&too_large, sizeof(too_large), LeakPolicy::Leaky), std::invalid_argument);
+}
+
+TEST(ShmRing, readerSkipsDroppedMessages)
+{
+  const RingName ring_name;
+  ipc::ShmRing writer{ring_name.name, 2, sizeof(uint64_t), ipc::ShmRing::Side::Writer};
+  ipc::ShmRing reader{ring_name.name, 2, sizeof(uint64_t), ipc::ShmRing::Side::Reader};
+
+  constexpr uint64_t num_messages = 100000;
+  std::thread writing{[&writer]
+  {
+    for (uint64_t i = 1; i <= num_messages; ++i)
+    { writer.push(&i, sizeof(i), LeakPolicy::Leaky); }
+  }};
+
+  uint64_t previous = 0;
+  uint64_t value = 0;
+
+  while (previous < num_messages)
+  {
+    ASSERT_TRUE(reader.pop(&value));
+    ASSERT_GT(value, previous);
+    previous = value;
+  }
+
+  writing.join();
+}
+
+TEST(ShmRing, loanedSlotIsWrittenInPlace)
+{
+  const RingName ring_name;
+  ipc::ShmRing writer{ring_name.name, 1, 16, ipc::ShmRing::Side::Writer};
+  ipc::ShmRing reader{ring_name.name, 1, 16, ipc::ShmRing::Side::Reader};
+
+  {
+    auto slot = writer.loan(LeakPolicy::Leaky);
+    ASSERT_TRUE(slot);
+    EXPECT_EQ(16, slot->size());
+    std::memcpy(slot->data(), "abc", 3);
+    slot->commit(3);
+  }
+
+  // An uncommitted loan is given back without sending anything
+  { ASSERT_TRUE(writer.loan(LeakPolicy::Leaky)); }
+
+  const auto view = reader.tryAcquire();
+  ASSERT_TRUE(view);
+  ASSERT_EQ(3, view->size());
+  EXPECT_EQ(0, std::memcmp("abc", view->data(), 3));
+  EXPECT_EQ(0, reader.getQueueSize());
+  EXPECT_THROW((void)reader.tryAcquire(), std::logic_error);
+}
+
+TEST(ShmRing, viewedMessageIsNotOverwritten)
+{
+  const RingName ring_name;
+  ipc::ShmRing writer{ring_name.name, 1, sizeof(int), ipc::ShmRing::Side::Writer};
+  ipc::ShmRing reader{ring_name.name, 1, sizeof(int), ipc::ShmRing::Side::Reader};
+
+  push(writer, 1);
+
+  {
+    const auto view = reader.acquire();
+    ASSERT_TRUE(view);
+
+    for (int i = 2; i < 10; ++i)
+    { push(writer, i); }
+
+    int value = 0;
+    std::memcpy(&value, view->data(), sizeof(value));
+    EXPECT_EQ(1, value);
+  }
+
+  EXPECT_EQ(9, pop(reader));
+  EXPECT_EQ(7, reader.getNumDropped());
+}
+
+TEST(ShmRing, writerDropsMessagesOfPreviousWriter)
+{
+  const RingName ring_name;
+  ipc::ShmRing reader{ring_name.name, 4, sizeof(int), ipc::ShmRing::Side::Reader};
+
+  const pid_t child = fork();
+  ASSERT_GE(child, 0);
+
+  if (child == 0)
+  {
+    ipc::ShmRing previous{ring_name.name, 4, sizeof(int), ipc::ShmRing::Side::Writer};
+    const int values[] = {1, 2};
+    previous.push(&values[0], sizeof(int), LeakPolicy::Leaky);
+    previous.push(&values[1], sizeof(int), LeakPolicy::Leaky);
+
+    // Exits with a slot loaned, like a writer that crashes while writing
+    const auto slot = previous.loan(LeakPolicy::Leaky);
+    _exit(slot ? 0 : 1);
+  }
+
+  int child_status = 0;
+  waitpid(child, &child_status, 0);
+  ASSERT_EQ(0, child_status);
+  ASSERT_EQ(2, reader.getQueueSize());
+
+  ipc::ShmRing writer{ring_name.name, 4, sizeof(int), ipc::ShmRing::Side::Writer};
+  EXPECT_EQ(0, reader.getQueueSize());
+  EXPECT_EQ(2, reader.getNumDropped());
+
+  // All the slots are free again, so the ring can be filled while a message is viewed
+  for (int i = 0; i < 5; ++i)
+  { push(writer, i); }
+
+  const auto view = reader.acquire();
+  ASSERT_TRUE(view);
+
+  for (int i = 5; i < 9; ++i)
+  { push(writer, i); }
+
+  EXPECT_EQ(4, reader.getQueueSize());
+}
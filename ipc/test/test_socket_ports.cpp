@@ -0,0 +1,218 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/ipc/socket_consumer_port.h"
+#include "superflow/ipc/socket_producer_port.h"
+
+#include "gtest/gtest.h"
+
+#include <unistd.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace flow;
+
+namespace
+{
+struct Pose
+{
+  double x;
+  double y;
+  int64_t timestamp;
+};
+}
+
+template<>
+struct flow::SchemaTag<Pose>
+{
+  static std::string name()
+  { return "Pose{float64 x; float64 y; int64 timestamp;}"; }
+};
+
+namespace
+{
+std::string getUnixAddress()
+{
+  return "unix:/tmp/superflow-test-" + std::to_string(getpid()) + '-'
+         + ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".sock";
+}
+
+template<typename Predicate>
+bool waitUntil(const Predicate& predicate)
+{
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+
+  while (!predicate())
+  {
+    if (std::chrono::steady_clock::now() > deadline)
+    { return false; }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+
+  return true;
+}
+}
+
+TEST(SocketPorts, transferOverTcp)
+{
+  constexpr int num_items = 1000;
+
+  ipc::SocketConsumerPort<Pose> consumer{"tcp:127.0.0.1:0", 16};
+  ipc::SocketProducerPort<Pose, LeakPolicy::PushBlocking> producer{consumer.getAddress(), 16};
+
+  std::thread sender{
+    [&producer]()
+    {
+      for (int i = 0; i < num_items; ++i)
+      { producer.send({i * 0.5, -i * 0.5, i}); }
+    }
+  };
+
+  for (int i = 0; i < num_items; ++i)
+  {
+    const auto pose = consumer.getNext();
+    ASSERT_TRUE(pose.has_value());
+    EXPECT_EQ(i, pose->timestamp);
+    EXPECT_DOUBLE_EQ(i * 0.5, pose->x);
+  }
+
+  sender.join();
+
+  EXPECT_TRUE(consumer.isConnected());
+  EXPECT_EQ(num_items, consumer.getStatus().num_transactions);
+  EXPECT_EQ(num_items, producer.getStatus().num_transactions);
+  EXPECT_EQ(0, producer.getStatus().num_dropped);
+}
+
+TEST(SocketPorts, transferContainersOverUnixSocket)
+{
+  ipc::SocketConsumerPort<std::vector<float>> vectors{getUnixAddress(), 4};
+  ipc::SocketProducerPort<std::vector<float>, LeakPolicy::PushBlocking> producer{vectors.getAddress(), 4};
+
+  producer.send({});
+  producer.send({1.f, 2.f, 3.f});
+
+  EXPECT_EQ(std::vector<float>{}, vectors.getNext());
+  EXPECT_EQ((std::vector<float>{1.f, 2.f, 3.f}), vectors.getNext());
+}
+
+TEST(SocketPorts, reconnectsWhenConsumerRestarts)
+{
+  const auto address = getUnixAddress();
+  ipc::SocketProducerPort<int> producer{address};
+
+  for (int run = 0; run < 2; ++run)
+  {
+    ipc::SocketConsumerPort<int> consumer{address};
+    std::atomic<bool> received{false};
+
+    std::thread sender{
+      [&]()
+      {
+        while (!received)
+        {
+          producer.send(run);
+          std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+      }
+    };
+
+    EXPECT_EQ(run, consumer.getNext());
+    received = true;
+    sender.join();
+
+    EXPECT_EQ(1, consumer.getStatus().num_connections);
+  }
+}
+
+TEST(SocketPorts, leakyProducerDropsWhileDisconnected)
+{
+  ipc::SocketProducerPort<int> producer{getUnixAddress(), 2};
+
+  for (int i = 0; i < 10; ++i)
+  { producer.send(i); }
+
+  const auto status = producer.getStatus();
+  EXPECT_FALSE(producer.isConnected());
+  EXPECT_EQ(0, status.num_connections);
+  EXPECT_EQ(10, status.num_transactions);
+  EXPECT_EQ(2, status.queue_size);
+  EXPECT_EQ(8, status.num_dropped);
+}
+
+TEST(SocketPorts, undecodableItemsAreDropped)
+{
+  ipc::SocketConsumerPort<int> consumer{getUnixAddress()};
+  ipc::SocketProducerPort<Pose, LeakPolicy::PushBlocking> producer{consumer.getAddress()};
+
+  producer.send({});
+
+  EXPECT_TRUE(waitUntil([&consumer]() { return consumer.getStatus().num_dropped == 1; }));
+  EXPECT_FALSE(consumer.hasNext());
+}
+
+TEST(SocketPorts, deactivateUnblocksGetNext)
+{
+  ipc::SocketConsumerPort<int> consumer{getUnixAddress()};
+
+  std::thread deactivator{
+    [&consumer]()
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds{10});
+      consumer.deactivate();
+    }
+  };
+
+  EXPECT_FALSE(consumer.getNext().has_value());
+  EXPECT_FALSE(consumer);
+  deactivator.join();
+}
+
+TEST(SocketPorts, cannotConnectToOtherPorts)
+{
+  ipc::SocketConsumerPort<int>::Ptr consumer = std::make_shared<ipc::SocketConsumerPort<int>>(getUnixAddress());
+  ipc::SocketProducerPort<int>::Ptr producer = std::make_shared<ipc::SocketProducerPort<int>>(consumer->getAddress());
+
+  EXPECT_THROW(producer->connect(consumer), std::invalid_argument);
+  EXPECT_THROW(consumer->connect(producer), std::invalid_argument);
+}
+
+TEST(SocketPorts, malformedAddressThrows)
+{
+  EXPECT_THROW(ipc::SocketAddress{"udp:localhost:5000"}, std::invalid_argument);
+  EXPECT_THROW(ipc::SocketAddress{"tcp:localhost"}, std::invalid_argument);
+  EXPECT_THROW(ipc::SocketAddress{"tcp:localhost:65536"}, std::invalid_argument);
+  EXPECT_THROW(ipc::SocketAddress{"unix:"}, std::invalid_argument);
+  EXPECT_NO_THROW(ipc::SocketAddress{"tcp:localhost:0"});
+}
+
+TEST(SocketPorts, connectGivesUpWhenCancelled)
+{
+  const ipc::SocketAddress address{"tcp:127.0.0.1:0"};
+  const int listener = address.listen();
+  const ipc::SocketAddress bound{address.getBoundAddress(listener)};
+
+  // Fill the accept queue, so that further connections are left in progress
+  std::vector<int> sockets;
+
+  for (int i = 0; i < 64; ++i)
+  {
+    const int socket = bound.connect(std::chrono::milliseconds{50});
+
+    if (socket < 0)
+    { break; }
+
+    sockets.push_back(socket);
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_LT(bound.connect(std::chrono::seconds{10}, []() { return true; }), 0);
+  EXPECT_LT(bound.connect(std::chrono::milliseconds{50}), 0);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds{5});
+
+  for (const int socket : sockets)
+  { ::close(socket); }
+
+  ::close(listener);
+}
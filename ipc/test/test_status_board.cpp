@@ -0,0 +1,148 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/ipc/status_board.h"
+
+#include "gtest/gtest.h"
+
+#include <unistd.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace flow;
+
+namespace
+{
+std::string getBoardName()
+{
+  return "/superflow-test-" + std::to_string(getpid()) + '-'
+         + ::testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+
+ProxelStatusMap makeStatuses(const double value)
+{
+  ProxelStatus status{};
+  status.state = ProxelStatus::State::Running;
+  status.info = "processing";
+  status.num_restarts = 2;
+  status.busyness = 0.5;
+  status.ports["in"] = PortStatus{1, 42};
+  status.ports["in"].num_dropped = 3;
+  status.ports["in"].blocked_time = 0.25;
+  status.ports["in"].num_spilled = 4;
+  status.fields["items"] = {StatusField::Type::Counter, value};
+  status.thread.thread_id = 1234;
+  status.thread.run_delay = 0.125;
+  status.thread.involuntary_context_switches = 5;
+  status.thread.runnable = true;
+  status.perf.cpu_utilization = 0.75;
+  status.perf.hardware = true;
+  status.allocations.bytes = 4096;
+  status.allocations.bytes_per_item = 64.;
+
+  ProxelStatus other{};
+  other.state = ProxelStatus::State::AwaitingInput;
+
+  return {{"camera", status}, {"sink", other}};
+}
+}
+
+TEST(StatusBoard, readerGetsPublishedStatuses)
+{
+  ipc::StatusBoard board{getBoardName()};
+  const ipc::StatusBoardReader reader{board.getName()};
+
+  board.publish(makeStatuses(7.));
+  const auto snapshot = reader.read();
+
+  ASSERT_TRUE(snapshot);
+  EXPECT_EQ(1, snapshot->num_updates);
+  EXPECT_EQ(getpid(), snapshot->pid);
+  ASSERT_EQ(2, snapshot->statuses.size());
+
+  const auto& status = snapshot->statuses.at("camera");
+  EXPECT_EQ(ProxelStatus::State::Running, status.state);
+  EXPECT_EQ("processing", status.info);
+  EXPECT_EQ(2, status.num_restarts);
+  EXPECT_DOUBLE_EQ(0.5, status.busyness);
+  EXPECT_EQ(42, status.ports.at("in").num_transactions);
+  EXPECT_EQ(3, status.ports.at("in").num_dropped);
+  EXPECT_DOUBLE_EQ(0.25, status.ports.at("in").blocked_time);
+  EXPECT_EQ(4, status.ports.at("in").num_spilled);
+  EXPECT_EQ(StatusField::Type::Counter, status.fields.at("items").type);
+  EXPECT_DOUBLE_EQ(7., status.fields.at("items").value);
+  EXPECT_EQ(1234, status.thread.thread_id);
+  EXPECT_DOUBLE_EQ(0.125, status.thread.run_delay);
+  EXPECT_EQ(5, status.thread.involuntary_context_switches);
+  EXPECT_TRUE(status.thread.runnable);
+  EXPECT_DOUBLE_EQ(0.75, status.perf.cpu_utilization);
+  EXPECT_TRUE(status.perf.hardware);
+  EXPECT_EQ(4096, status.allocations.bytes);
+  EXPECT_DOUBLE_EQ(64., status.allocations.bytes_per_item);
+
+  EXPECT_EQ(ProxelStatus::State::AwaitingInput, snapshot->statuses.at("sink").state);
+}
+
+TEST(StatusBoard, readerGetsNothingBeforeFirstPublish)
+{
+  const ipc::StatusBoard board{getBoardName()};
+  const ipc::StatusBoardReader reader{board.getName()};
+
+  EXPECT_FALSE(reader.read());
+}
+
+TEST(StatusBoard, readerThrowsIfBoardDoesNotExist)
+{
+  EXPECT_THROW(ipc::StatusBoardReader{getBoardName()}, std::runtime_error);
+
+  {
+    const ipc::StatusBoard board{getBoardName()};
+  }
+
+  EXPECT_THROW(ipc::StatusBoardReader{getBoardName()}, std::runtime_error);
+}
+
+TEST(StatusBoard, publishThrowsIfStatusesDoNotFit)
+{
+  ipc::StatusBoard board{getBoardName(), 16};
+
+  EXPECT_THROW(board.publish(makeStatuses(0.)), std::runtime_error);
+  EXPECT_NO_THROW(board.publish({}));
+}
+
+TEST(StatusBoard, readerNeverSeesTornSnapshots)
+{
+  ipc::StatusBoard board{getBoardName()};
+  const ipc::StatusBoardReader reader{board.getName()};
+  board.publish(makeStatuses(0.));
+
+  std::atomic<bool> done{false};
+  std::thread publisher{
+    [&board, &done]
+    {
+      for (int i = 1; i <= 10000; ++i)
+      { board.publish(makeStatuses(i)); }
+
+      done = true;
+    }
+  };
+
+  uint64_t last_update = 0;
+
+  while (!done)
+  {
+    const auto snapshot = reader.read();
+
+    if (!snapshot)
+    { continue; }
+
+    // Every snapshot is published with the update count as its counter value
+    const auto& status = snapshot->statuses.at("camera");
+    EXPECT_DOUBLE_EQ(static_cast<double>(snapshot->num_updates - 1), status.fields.at("items").value);
+    EXPECT_EQ("processing", status.info);
+    EXPECT_GE(snapshot->num_updates, last_update);
+    last_update = snapshot->num_updates;
+  }
+
+  publisher.join();
+  EXPECT_EQ(10001, reader.read()->num_updates);
+}
@@ -0,0 +1,79 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include "superflow/graph.h"
+#include "superflow/utils/mutexed.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace flow::metrics
+{
+/// \brief Exports statistics from a Graph as OpenMetrics, to a file and/or a local HTTP endpoint.
+///
+/// The Graph is snapshotted by `update`, which must be called from the thread that owns the Graph,
+/// like GraphGUI::spinOnce. A snapshot only reads the status of each Proxel and connection, and the formatting
+/// is done afterwards, so the Proxels are never blocked by the exporter. The HTTP endpoint serves
+/// the most recent snapshot from its own thread, and never touches the Graph.
+///
+/// \code{.cpp}
+/// flow::metrics::MetricsExporter exporter{"/var/lib/node_exporter/textfile/superflow.prom"};
+/// exporter.serveHttp(9464);
+///
+/// graph.start();
+/// exporter.spin(graph); // until SIGINT or SIGTERM
+/// graph.stop();
+/// \endcode
+/// \see formatOpenMetrics
+class MetricsExporter
+{
+public:
+  /// \brief Create an exporter
+  /// \param textfile_path File that is replaced by every snapshot, e.g. for the textfile collector
+  /// of the Prometheus node exporter. The file is written next to the target and then renamed,
+  /// so that readers never see a partial file. Empty to disable.
+  explicit MetricsExporter(std::string textfile_path = {});
+
+  ~MetricsExporter();
+
+  MetricsExporter(const MetricsExporter&) = delete;
+
+  MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+  /// \brief Serve the most recent snapshot over HTTP, at any path, until the exporter is destroyed.
+  /// \param port TCP port to listen to, or 0 to let the system pick a free port
+  /// \param address IPv4 address to listen to, e.g. "0.0.0.0" for all interfaces
+  /// \throws std::runtime_error if the endpoint could not be opened, or is already being served
+  void serveHttp(uint16_t port, const std::string& address = "127.0.0.1");
+
+  /// \brief The TCP port of the HTTP endpoint, or 0 if it is not being served
+  [[nodiscard]] uint16_t getHttpPort() const;
+
+  /// \brief Take a new snapshot of the Graph, with rates averaged since the previous snapshot.
+  /// \throws std::runtime_error if the textfile could not be written
+  void update(const Graph& graph);
+
+  /// \brief Call `update` periodically until SIGINT or SIGTERM is received.
+  void spin(const Graph& graph, std::chrono::milliseconds period = std::chrono::seconds{1});
+
+  /// \brief The most recent snapshot, formatted as OpenMetrics
+  [[nodiscard]] std::string getText() const;
+
+private:
+  std::string textfile_path_;
+  Mutexed<std::string> text_;
+  Graph::Sampler sampler_;
+
+  int server_socket_ = -1;
+  std::atomic<uint16_t> http_port_{0};
+  std::atomic<bool> stopping_{false};
+  std::thread server_thread_;
+
+  void serve();
+
+  void respond(int client_socket) const;
+};
+}
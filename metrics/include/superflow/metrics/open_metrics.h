@@ -0,0 +1,66 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include "superflow/graph.h"
+#include "superflow/proxel_status.h"
+#include "superflow/utils/latency_histogram.h"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace flow::metrics
+{
+/// \brief Format a snapshot of a Graph in the
+/// [OpenMetrics](https://github.com/OpenObservability/OpenMetrics) text format.
+///
+/// The following metric families are written, labelled with `proxel` and `port` names:
+/// - `superflow_proxel_state`, stateset with the current ProxelStatus::State
+/// - `superflow_proxel_restarts_total`, counter
+/// - `superflow_proxel_mean_time_between_failures_seconds`, gauge
+/// - `superflow_proxel_busyness` and `superflow_proxel_processing_time_seconds`, gauges
+/// - `superflow_proxel_cpu_seconds_total`, `superflow_proxel_run_delay_seconds_total` and
+///   `superflow_proxel_context_switches_total`, labelled with `kind`, counters of the proxel thread
+/// - `superflow_proxel_perf_events_per_second`, gauge labelled with `event`, see Graph::enablePerfCounters
+/// - `superflow_proxel_allocations_total` and `superflow_proxel_allocated_bytes_total`, counters,
+///   see allocation::isInstrumented
+/// - `superflow_proxel_counter_total` and `superflow_proxel_gauge`, the ProxelStatus::fields,
+///   labelled with `field` name
+/// - `superflow_port_connections`, gauge
+/// - `superflow_port_transactions_total`, counter
+/// - `superflow_port_queue_size`, gauge, and `superflow_port_dropped_total`, counter
+/// - `superflow_port_spilled_bytes`, gauge, see LeakPolicy::Spill
+/// - `superflow_trace_latency_seconds`, histogram per traced path, labelled with
+///   `source_proxel`, `source_port`, `sink_proxel` and `sink_port`
+/// - `superflow_edge_messages_total`, `superflow_edge_bytes_total`, `superflow_edge_dropped_total`,
+///   `superflow_edge_consumed_total`, `superflow_edge_timed_total` and
+///   `superflow_edge_queue_latency_seconds_total`, counters per connection, labelled like the traces
+///
+/// The output is terminated by `# EOF`.
+/// \param statuses As returned by Graph::getProxelStatuses
+/// \param traces As returned by Graph::getTraceStatistics
+/// \param edges As returned by Graph::getEdgeStatistics
+/// \return The formatted metrics
+[[nodiscard]] std::string formatOpenMetrics(
+  const ProxelStatusMap& statuses,
+  const std::vector<Graph::TraceStatistics>& traces = {},
+  const std::vector<Graph::EdgeStatistics>& edges = {}
+);
+
+/// \brief Write the samples of a histogram metric, without the metric family header.
+///
+/// Buckets are written for every power of two nanoseconds, with `le` in seconds.
+/// \param os The stream to write to
+/// \param name Name of the metric family, e.g. `superflow_trace_latency_seconds`
+/// \param labels Formatted labels for all samples, e.g. `proxel="a",port="b"`. May be empty.
+/// \param histogram The histogram to write
+void writeHistogram(
+  std::ostream& os,
+  const std::string& name,
+  const std::string& labels,
+  const LatencyHistogram& histogram
+);
+
+/// \brief Escape a label value, i.e. backslashes, double quotes and line feeds
+[[nodiscard]] std::string escapeLabelValue(const std::string& value);
+}
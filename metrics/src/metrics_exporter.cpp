@@ -0,0 +1,198 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/metrics/metrics_exporter.h"
+#include "superflow/metrics/open_metrics.h"
+
+#include "superflow/utils/signal_waiter.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace flow::metrics
+{
+namespace
+{
+constexpr int poll_timeout_ms = 100;
+constexpr size_t max_request_size = 8192;
+
+std::runtime_error makeSocketError(const std::string& what)
+{
+  return std::runtime_error{"MetricsExporter: " + what + ": " + std::strerror(errno)};
+}
+
+void sendAll(const int socket, const std::string& data)
+{
+  size_t sent = 0;
+
+  while (sent < data.size())
+  {
+    const auto result = ::send(socket, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+
+    if (result <= 0)
+    { return; }
+
+    sent += static_cast<size_t>(result);
+  }
+}
+}
+
+MetricsExporter::MetricsExporter(std::string textfile_path)
+  : textfile_path_{std::move(textfile_path)}
+  , text_{"# EOF\n"}
+{}
+
+MetricsExporter::~MetricsExporter()
+{
+  stopping_ = true;
+
+  if (server_thread_.joinable())
+  { server_thread_.join(); }
+
+  if (server_socket_ >= 0)
+  { ::close(server_socket_); }
+}
+
+void MetricsExporter::serveHttp(const uint16_t port, const std::string& address)
+{
+  if (server_socket_ >= 0)
+  { throw std::runtime_error{"MetricsExporter is already serving HTTP on port " + std::to_string(http_port_)}; }
+
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+
+  if (::inet_pton(AF_INET, address.c_str(), &addr.sin_addr) != 1)
+  { throw std::runtime_error{"MetricsExporter: invalid IPv4 address '" + address + "'"}; }
+
+  const int server_socket = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+  if (server_socket < 0)
+  { throw makeSocketError("socket"); }
+
+  const int reuse = 1;
+  ::setsockopt(server_socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+  socklen_t addr_size = sizeof(addr);
+
+  if (::bind(server_socket, reinterpret_cast<const sockaddr*>(&addr), addr_size) != 0
+      || ::listen(server_socket, 8) != 0
+      || ::getsockname(server_socket, reinterpret_cast<sockaddr*>(&addr), &addr_size) != 0)
+  {
+    const auto error = makeSocketError("cannot listen to " + address + ":" + std::to_string(port));
+    ::close(server_socket);
+
+    throw error;
+  }
+
+  server_socket_ = server_socket;
+  http_port_ = ntohs(addr.sin_port);
+  server_thread_ = std::thread{[this]() { serve(); }};
+}
+
+uint16_t MetricsExporter::getHttpPort() const
+{
+  return http_port_;
+}
+
+void MetricsExporter::update(const Graph& graph)
+{
+  const auto statuses = graph.getProxelStatuses(sampler_);
+  const auto traces = graph.getTraceStatistics();
+  const auto edges = graph.getEdgeStatistics(sampler_);
+
+  auto text = formatOpenMetrics(statuses, traces, edges);
+
+  if (!textfile_path_.empty())
+  {
+    const auto tmp_path = textfile_path_ + ".tmp";
+
+    {
+      std::ofstream file{tmp_path, std::ios::trunc};
+      file << text;
+
+      if (!file)
+      { throw std::runtime_error{"MetricsExporter: cannot write '" + tmp_path + "'"}; }
+    }
+
+    if (std::rename(tmp_path.c_str(), textfile_path_.c_str()) != 0)
+    { throw std::runtime_error{"MetricsExporter: cannot rename '" + tmp_path + "' to '" + textfile_path_ + "'"}; }
+  }
+
+  text_.store(std::move(text));
+}
+
+void MetricsExporter::spin(const Graph& graph, const std::chrono::milliseconds period)
+{
+  SignalWaiter waiter{{SIGINT, SIGTERM}};
+  const auto signal = waiter.getFuture();
+
+  do
+  { update(graph); }
+  while (signal.wait_for(period) != std::future_status::ready);
+}
+
+std::string MetricsExporter::getText() const
+{
+  return text_.load();
+}
+
+void MetricsExporter::serve()
+{
+  pollfd server_poll{server_socket_, POLLIN, 0};
+
+  while (!stopping_)
+  {
+    if (::poll(&server_poll, 1, poll_timeout_ms) <= 0)
+    { continue; }
+
+    const int client_socket = ::accept4(server_socket_, nullptr, nullptr, SOCK_CLOEXEC);
+
+    if (client_socket < 0)
+    { continue; }
+
+    respond(client_socket);
+    ::close(client_socket);
+  }
+}
+
+void MetricsExporter::respond(const int client_socket) const
+{
+  std::string request;
+  pollfd client_poll{client_socket, POLLIN, 0};
+
+  // Read the request head, which is all we need. The request target is ignored.
+  while (request.find("\r\n\r\n") == std::string::npos && request.size() < max_request_size)
+  {
+    if (::poll(&client_poll, 1, poll_timeout_ms) <= 0)
+    { return; }
+
+    char buffer[1024];
+    const auto received = ::recv(client_socket, buffer, sizeof(buffer), 0);
+
+    if (received <= 0)
+    { return; }
+
+    request.append(buffer, static_cast<size_t>(received));
+  }
+
+  const auto body = text_.load();
+
+  sendAll(
+    client_socket,
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Type: application/openmetrics-text; version=1.0.0; charset=utf-8\r\n"
+    "Content-Length: " + std::to_string(body.size()) + "\r\n"
+    "Connection: close\r\n"
+    "\r\n" + body
+  );
+}
+}
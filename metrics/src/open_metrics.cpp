@@ -0,0 +1,370 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/metrics/open_metrics.h"
+
+#include <sstream>
+
+namespace flow::metrics
+{
+namespace
+{
+constexpr ProxelStatus::State all_states[] = {
+  ProxelStatus::State::AwaitingInput,
+  ProxelStatus::State::AwaitingRequest,
+  ProxelStatus::State::AwaitingResponse,
+  ProxelStatus::State::Crashed,
+  ProxelStatus::State::NotConnected,
+  ProxelStatus::State::Paused,
+  ProxelStatus::State::Running,
+  ProxelStatus::State::Unavailable,
+  ProxelStatus::State::Undefined,
+  ProxelStatus::State::Warning,
+};
+
+const char* getStateName(const ProxelStatus::State state)
+{
+  switch (state)
+  {
+    case ProxelStatus::State::AwaitingInput:
+      return "awaiting_input";
+    case ProxelStatus::State::AwaitingRequest:
+      return "awaiting_request";
+    case ProxelStatus::State::AwaitingResponse:
+      return "awaiting_response";
+    case ProxelStatus::State::Crashed:
+      return "crashed";
+    case ProxelStatus::State::NotConnected:
+      return "not_connected";
+    case ProxelStatus::State::Paused:
+      return "paused";
+    case ProxelStatus::State::Running:
+      return "running";
+    case ProxelStatus::State::Unavailable:
+      return "unavailable";
+    case ProxelStatus::State::Warning:
+      return "warning";
+    default:
+      return "undefined";
+  }
+}
+
+void writeFamily(
+  std::ostream& os,
+  const std::string& name,
+  const std::string& type,
+  const std::string& help
+)
+{
+  os << "# TYPE " << name << ' ' << type << '\n'
+     << "# HELP " << name << ' ' << help << '\n';
+
+  const std::string seconds = "_seconds";
+
+  if (name.size() > seconds.size() && name.compare(name.size() - seconds.size(), seconds.size(), seconds) == 0)
+  { os << "# UNIT " << name << " seconds\n"; }
+}
+
+std::string proxelLabel(const std::string& proxel_name)
+{
+  return "proxel=\"" + escapeLabelValue(proxel_name) + '"';
+}
+
+std::string fieldLabels(const std::string& proxel_name, const std::string& field_name)
+{
+  return proxelLabel(proxel_name) + ",field=\"" + escapeLabelValue(field_name) + '"';
+}
+
+std::string portLabels(const std::string& proxel_name, const std::string& port_name)
+{
+  return proxelLabel(proxel_name) + ",port=\"" + escapeLabelValue(port_name) + '"';
+}
+
+std::string pathLabels(
+  const std::string& source_proxel,
+  const std::string& source_port,
+  const std::string& sink_proxel,
+  const std::string& sink_port
+)
+{
+  return "source_proxel=\"" + escapeLabelValue(source_proxel) +
+         "\",source_port=\"" + escapeLabelValue(source_port) +
+         "\",sink_proxel=\"" + escapeLabelValue(sink_proxel) +
+         "\",sink_port=\"" + escapeLabelValue(sink_port) + '"';
+}
+
+std::string edgeLabels(const Graph::EdgeStatistics& edge)
+{
+  const auto& connection = edge.connection;
+  return pathLabels(connection.lhs_name, connection.lhs_port, connection.rhs_name, connection.rhs_port);
+}
+}
+
+std::string formatOpenMetrics(
+  const ProxelStatusMap& statuses,
+  const std::vector<Graph::TraceStatistics>& traces,
+  const std::vector<Graph::EdgeStatistics>& edges
+)
+{
+  std::ostringstream os;
+  os.precision(9);
+
+  writeFamily(os, "superflow_proxel_state", "stateset", "Current state of the proxel.");
+  for (const auto& [proxel_name, status] : statuses)
+  {
+    for (const auto state : all_states)
+    {
+      os << "superflow_proxel_state{" << proxelLabel(proxel_name)
+         << ",superflow_proxel_state=\"" << getStateName(state) << "\"} "
+         << (status.state == state ? 1 : 0) << '\n';
+    }
+  }
+
+  writeFamily(os, "superflow_proxel_restarts", "counter", "Number of restarts after a crash.");
+  for (const auto& [proxel_name, status] : statuses)
+  { os << "superflow_proxel_restarts_total{" << proxelLabel(proxel_name) << "} " << status.num_restarts << '\n'; }
+
+  writeFamily(os, "superflow_proxel_mean_time_between_failures_seconds", "gauge", "Mean uptime before a crash.");
+  for (const auto& [proxel_name, status] : statuses)
+  {
+    os << "superflow_proxel_mean_time_between_failures_seconds{" << proxelLabel(proxel_name) << "} "
+       << status.mean_time_between_failures << '\n';
+  }
+
+  writeFamily(os, "superflow_proxel_busyness", "gauge", "Fraction of time spent outside of consumer port gets.");
+  for (const auto& [proxel_name, status] : statuses)
+  { os << "superflow_proxel_busyness{" << proxelLabel(proxel_name) << "} " << status.busyness << '\n'; }
+
+  writeFamily(os, "superflow_proxel_processing_time_seconds", "gauge", "Mean time between consumer port gets.");
+  for (const auto& [proxel_name, status] : statuses)
+  {
+    os << "superflow_proxel_processing_time_seconds{" << proxelLabel(proxel_name) << "} "
+       << status.processing_time << '\n';
+  }
+
+  writeFamily(os, "superflow_proxel_cpu_seconds", "counter", "CPU time of the proxel thread.");
+  for (const auto& [proxel_name, status] : statuses)
+  { os << "superflow_proxel_cpu_seconds_total{" << proxelLabel(proxel_name) << "} " << status.thread.cpu_time << '\n'; }
+
+  writeFamily(os, "superflow_proxel_run_delay_seconds", "counter", "Time the proxel thread has waited for a CPU.");
+  for (const auto& [proxel_name, status] : statuses)
+  { os << "superflow_proxel_run_delay_seconds_total{" << proxelLabel(proxel_name) << "} " << status.thread.run_delay << '\n'; }
+
+  writeFamily(os, "superflow_proxel_context_switches", "counter", "Context switches of the proxel thread.");
+  for (const auto& [proxel_name, status] : statuses)
+  {
+    os << "superflow_proxel_context_switches_total{" << proxelLabel(proxel_name) << ",kind=\"voluntary\"} "
+       << status.thread.voluntary_context_switches << '\n'
+       << "superflow_proxel_context_switches_total{" << proxelLabel(proxel_name) << ",kind=\"involuntary\"} "
+       << status.thread.involuntary_context_switches << '\n';
+  }
+
+  writeFamily(os, "superflow_proxel_perf_events_per_second", "gauge", "Performance counter rates of the proxel thread.");
+  for (const auto& [proxel_name, status] : statuses)
+  {
+    const auto& perf = status.perf;
+    const std::pair<const char*, double> events[] = {
+      {"cycles", perf.cycles},
+      {"instructions", perf.instructions},
+      {"cache_misses", perf.cache_misses},
+      {"branch_misses", perf.branch_misses},
+      {"page_faults", perf.page_faults}
+    };
+
+    for (const auto& [event, rate] : events)
+    {
+      os << "superflow_proxel_perf_events_per_second{" << proxelLabel(proxel_name)
+         << ",event=\"" << event << "\"} " << rate << '\n';
+    }
+  }
+
+  writeFamily(os, "superflow_proxel_allocations", "counter", "Heap allocations of the proxel thread, if instrumented.");
+  for (const auto& [proxel_name, status] : statuses)
+  { os << "superflow_proxel_allocations_total{" << proxelLabel(proxel_name) << "} " << status.allocations.count << '\n'; }
+
+  writeFamily(os, "superflow_proxel_allocated_bytes", "counter", "Heap bytes allocated by the proxel thread, if instrumented.");
+  for (const auto& [proxel_name, status] : statuses)
+  { os << "superflow_proxel_allocated_bytes_total{" << proxelLabel(proxel_name) << "} " << status.allocations.bytes << '\n'; }
+
+  writeFamily(os, "superflow_proxel_counter", "counter", "Status counter reported by the proxel.");
+  for (const auto& [proxel_name, status] : statuses)
+  {
+    for (const auto& [field_name, field] : status.fields)
+    {
+      if (field.type != StatusField::Type::Counter)
+      { continue; }
+
+      os << "superflow_proxel_counter_total{" << fieldLabels(proxel_name, field_name) << "} "
+         << static_cast<uint64_t>(field.value) << '\n';
+    }
+  }
+
+  writeFamily(os, "superflow_proxel_gauge", "gauge", "Status gauge reported by the proxel.");
+  for (const auto& [proxel_name, status] : statuses)
+  {
+    for (const auto& [field_name, field] : status.fields)
+    {
+      if (field.type != StatusField::Type::Gauge)
+      { continue; }
+
+      os << "superflow_proxel_gauge{" << fieldLabels(proxel_name, field_name) << "} " << field.value << '\n';
+    }
+  }
+
+  writeFamily(os, "superflow_port_connections", "gauge", "Number of connections to the port.");
+  for (const auto& [proxel_name, status] : statuses)
+  {
+    for (const auto& [port_name, port_status] : status.ports)
+    {
+      if (port_status.num_connections == PortStatus::undefined)
+      { continue; }
+
+      os << "superflow_port_connections{" << portLabels(proxel_name, port_name) << "} "
+         << port_status.num_connections << '\n';
+    }
+  }
+
+  writeFamily(os, "superflow_port_transactions", "counter", "Number of transactions through the port.");
+  for (const auto& [proxel_name, status] : statuses)
+  {
+    for (const auto& [port_name, port_status] : status.ports)
+    {
+      if (port_status.num_transactions == PortStatus::undefined)
+      { continue; }
+
+      os << "superflow_port_transactions_total{" << portLabels(proxel_name, port_name) << "} "
+         << port_status.num_transactions << '\n';
+    }
+  }
+
+  writeFamily(os, "superflow_port_queue_size", "gauge", "Number of items waiting in the buffer of a consumer port.");
+  for (const auto& [proxel_name, status] : statuses)
+  {
+    for (const auto& [port_name, port_status] : status.ports)
+    {
+      if (port_status.num_transactions == PortStatus::undefined)
+      { continue; }
+
+      os << "superflow_port_queue_size{" << portLabels(proxel_name, port_name) << "} " << port_status.queue_size << '\n';
+    }
+  }
+
+  writeFamily(os, "superflow_port_dropped", "counter", "Number of items dropped from the full buffer of a consumer port.");
+  for (const auto& [proxel_name, status] : statuses)
+  {
+    for (const auto& [port_name, port_status] : status.ports)
+    {
+      if (port_status.num_transactions == PortStatus::undefined)
+      { continue; }
+
+      os << "superflow_port_dropped_total{" << portLabels(proxel_name, port_name) << "} " << port_status.num_dropped << '\n';
+    }
+  }
+
+  writeFamily(os, "superflow_port_spilled_bytes", "gauge", "Size of the items a consumer port holds in its spill file.");
+  for (const auto& [proxel_name, status] : statuses)
+  {
+    for (const auto& [port_name, port_status] : status.ports)
+    {
+      if (port_status.num_transactions == PortStatus::undefined)
+      { continue; }
+
+      os << "superflow_port_spilled_bytes{" << portLabels(proxel_name, port_name) << "} " << port_status.spilled_bytes << '\n';
+    }
+  }
+
+  if (!traces.empty())
+  {
+    writeFamily(os, "superflow_trace_latency_seconds", "histogram", "End-to-end latency of traced items.");
+    for (const auto& trace : traces)
+    {
+      const auto labels = pathLabels(trace.source_proxel, trace.source_port, trace.sink_proxel, trace.sink_port);
+
+      writeHistogram(os, "superflow_trace_latency_seconds", labels, trace.latency);
+    }
+  }
+
+  if (!edges.empty())
+  {
+    writeFamily(os, "superflow_edge_messages", "counter", "Number of items sent over the connection.");
+    for (const auto& edge : edges)
+    { os << "superflow_edge_messages_total{" << edgeLabels(edge) << "} " << edge.status.num_messages << '\n'; }
+
+    writeFamily(os, "superflow_edge_bytes", "counter", "Size of the items sent over the connection.");
+    for (const auto& edge : edges)
+    { os << "superflow_edge_bytes_total{" << edgeLabels(edge) << "} " << edge.status.num_bytes << '\n'; }
+
+    writeFamily(os, "superflow_edge_dropped", "counter", "Number of items from the connection dropped by a full buffer.");
+    for (const auto& edge : edges)
+    { os << "superflow_edge_dropped_total{" << edgeLabels(edge) << "} " << edge.status.num_dropped << '\n'; }
+
+    writeFamily(os, "superflow_edge_consumed", "counter", "Number of items from the connection taken out of the buffer.");
+    for (const auto& edge : edges)
+    { os << "superflow_edge_consumed_total{" << edgeLabels(edge) << "} " << edge.status.num_consumed << '\n'; }
+
+    writeFamily(os, "superflow_edge_timed", "counter", "Number of consumed items from the connection whose time in the buffer was measured.");
+    for (const auto& edge : edges)
+    { os << "superflow_edge_timed_total{" << edgeLabels(edge) << "} " << edge.status.num_timed << '\n'; }
+
+    writeFamily(os, "superflow_edge_queue_latency_seconds", "counter", "Total time the timed items waited in the buffer.");
+    for (const auto& edge : edges)
+    { os << "superflow_edge_queue_latency_seconds_total{" << edgeLabels(edge) << "} " << edge.status.queue_latency << '\n'; }
+  }
+
+  os << "# EOF\n";
+
+  return os.str();
+}
+
+void writeHistogram(
+  std::ostream& os,
+  const std::string& name,
+  const std::string& labels,
+  const LatencyHistogram& histogram
+)
+{
+  const std::string separator = labels.empty() ? "" : ",";
+  uint64_t cumulative_count = 0;
+
+  for (size_t i = 0; i + 1 < LatencyHistogram::num_buckets; ++i)
+  {
+    cumulative_count += histogram.getBucketCount(i);
+    const uint64_t upper_bound = LatencyHistogram::getBucketUpperBound(i);
+
+    if ((upper_bound & (upper_bound - 1)) != 0)
+    { continue; }
+
+    os << name << "_bucket{" << labels << separator
+       << "le=\"" << static_cast<double>(upper_bound) * 1e-9 << "\"} " << cumulative_count << '\n';
+  }
+
+  const std::string label_set = labels.empty() ? "" : "{" + labels + "}";
+
+  os << name << "_bucket{" << labels << separator << "le=\"+Inf\"} " << histogram.getCount() << '\n'
+     << name << "_count" << label_set << ' ' << histogram.getCount() << '\n'
+     << name << "_sum" << label_set << ' ' << histogram.getSum() << '\n';
+}
+
+std::string escapeLabelValue(const std::string& value)
+{
+  std::string escaped;
+
+  for (const char c : value)
+  {
+    switch (c)
+    {
+      case '\\':
+        escaped += "\\\\";
+        break;
+      case '"':
+        escaped += "\\\"";
+        break;
+      case '\n':
+        escaped += "\\n";
+        break;
+      default:
+        escaped += c;
+    }
+  }
+
+  return escaped;
+}
+}
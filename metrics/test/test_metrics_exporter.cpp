@@ -0,0 +1,108 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/metrics/metrics_exporter.h"
+#include "superflow/producer_port.h"
+#include "superflow/proxel.h"
+
+#include "gtest/gtest.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace flow;
+
+namespace
+{
+class OutputProxel : public Proxel
+{
+public:
+  OutputProxel()
+  {
+    registerPorts({{"out", std::make_shared<ProducerPort<int>>()}});
+    setState(State::Running);
+  }
+
+  void start() override
+  {}
+
+  void stop() noexcept override
+  {}
+};
+
+std::string httpGet(const uint16_t port)
+{
+  const int client = ::socket(AF_INET, SOCK_STREAM, 0);
+
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  ::inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+  if (::connect(client, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0)
+  {
+    ::close(client);
+    return {};
+  }
+
+  const std::string request = "GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n";
+  ::send(client, request.data(), request.size(), 0);
+
+  std::string response;
+  char buffer[1024];
+
+  for (ssize_t received; (received = ::recv(client, buffer, sizeof(buffer), 0)) > 0;)
+  { response.append(buffer, static_cast<size_t>(received)); }
+
+  ::close(client);
+
+  return response;
+}
+}
+
+TEST(MetricsExporter, writesTextfile)
+{
+  const std::string path = ::testing::TempDir() + "superflow_metrics_test.prom";
+  std::remove(path.c_str());
+
+  Graph graph{{{"output", std::make_shared<OutputProxel>()}}};
+  metrics::MetricsExporter exporter{path};
+  exporter.update(graph);
+
+  std::ifstream file{path};
+  std::stringstream content;
+  content << file.rdbuf();
+
+  EXPECT_EQ(exporter.getText(), content.str());
+  EXPECT_NE(std::string::npos, content.str().find(R"(superflow_port_connections{proxel="output",port="out"} 0)"));
+
+  std::remove(path.c_str());
+}
+
+TEST(MetricsExporter, servesLatestSnapshotOverHttp)
+{
+  Graph graph{{{"output", std::make_shared<OutputProxel>()}}};
+  metrics::MetricsExporter exporter;
+  EXPECT_EQ(0, exporter.getHttpPort());
+
+  exporter.serveHttp(0);
+  ASSERT_NE(0, exporter.getHttpPort());
+  EXPECT_THROW(exporter.serveHttp(0), std::runtime_error);
+
+  exporter.update(graph);
+  const auto response = httpGet(exporter.getHttpPort());
+
+  EXPECT_EQ(0, response.find("HTTP/1.1 200 OK\r\n"));
+  EXPECT_NE(std::string::npos, response.find("Content-Type: application/openmetrics-text"));
+  EXPECT_NE(std::string::npos, response.find("\r\n\r\n" + exporter.getText()));
+}
+
+TEST(MetricsExporter, invalidAddressThrows)
+{
+  metrics::MetricsExporter exporter;
+  EXPECT_THROW(exporter.serveHttp(0, "not an address"), std::runtime_error);
+}
@@ -0,0 +1,90 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/metrics/open_metrics.h"
+
+#include "gtest/gtest.h"
+
+#include <sstream>
+
+using namespace flow;
+
+namespace
+{
+bool contains(const std::string& text, const std::string& line)
+{
+  return text.find(line + '\n') != std::string::npos;
+}
+}
+
+TEST(OpenMetrics, proxelAndPortMetrics)
+{
+  ProxelStatus status{ProxelStatus::State::Running, "info", {{"in", {1, 42}}, {"ghost", {PortStatus::undefined, PortStatus::undefined}}}};
+  status.num_restarts = 3;
+  status.fields["items"] = {StatusField::Type::Counter, 12.};
+  status.fields["queue"] = {StatusField::Type::Gauge, 0.5};
+
+  const auto text = metrics::formatOpenMetrics({{"my \"proxel\"", status}});
+
+  EXPECT_TRUE(contains(text, "# TYPE superflow_proxel_state stateset"));
+  EXPECT_TRUE(contains(text, R"(superflow_proxel_state{proxel="my \"proxel\"",superflow_proxel_state="running"} 1)"));
+  EXPECT_TRUE(contains(text, R"(superflow_proxel_state{proxel="my \"proxel\"",superflow_proxel_state="crashed"} 0)"));
+  EXPECT_TRUE(contains(text, R"(superflow_proxel_restarts_total{proxel="my \"proxel\""} 3)"));
+  EXPECT_TRUE(contains(text, "# UNIT superflow_proxel_mean_time_between_failures_seconds seconds"));
+  EXPECT_TRUE(contains(text, R"(superflow_proxel_counter_total{proxel="my \"proxel\"",field="items"} 12)"));
+  EXPECT_TRUE(contains(text, R"(superflow_proxel_gauge{proxel="my \"proxel\"",field="queue"} 0.5)"));
+  EXPECT_TRUE(contains(text, R"(superflow_port_connections{proxel="my \"proxel\"",port="in"} 1)"));
+  EXPECT_TRUE(contains(text, R"(superflow_port_transactions_total{proxel="my \"proxel\"",port="in"} 42)"));
+  EXPECT_EQ(std::string::npos, text.find("ghost"));
+  EXPECT_EQ(std::string::npos, text.find("superflow_trace_latency_seconds"));
+
+  const std::string eof = "# EOF\n";
+  ASSERT_GE(text.size(), eof.size());
+  EXPECT_EQ(eof, text.substr(text.size() - eof.size()));
+}
+
+TEST(OpenMetrics, histogramIsCumulative)
+{
+  LatencyHistogram histogram;
+  histogram.record(std::chrono::nanoseconds{3});
+  histogram.record(std::chrono::nanoseconds{100});
+  histogram.record(std::chrono::seconds{1});
+
+  std::ostringstream os;
+  metrics::writeHistogram(os, "latency_seconds", "", histogram);
+  const auto text = os.str();
+
+  EXPECT_TRUE(contains(text, R"(latency_seconds_bucket{le="4e-09"} 1)"));
+  EXPECT_TRUE(contains(text, R"(latency_seconds_bucket{le="1.28e-07"} 2)"));
+  EXPECT_TRUE(contains(text, R"(latency_seconds_bucket{le="+Inf"} 3)"));
+  EXPECT_TRUE(contains(text, "latency_seconds_count 3"));
+}
+
+TEST(OpenMetrics, traceLatencyIsLabelledWithPath)
+{
+  Graph::TraceStatistics trace{"camera", "image", "tracker", "tracks", {}};
+  trace.latency.record(std::chrono::milliseconds{5});
+
+  const auto text = metrics::formatOpenMetrics({}, {trace});
+
+  EXPECT_TRUE(contains(text, "# TYPE superflow_trace_latency_seconds histogram"));
+  EXPECT_TRUE(contains(
+    text,
+    R"(superflow_trace_latency_seconds_count{source_proxel="camera",source_port="image",sink_proxel="tracker",sink_port="tracks"} 1)"
+  ));
+}
+
+TEST(OpenMetrics, edgesAreLabelledWithConnection)
+{
+  Graph::EdgeStatistics edge;
+  edge.connection = {"camera", "out", "detector", "in"};
+  edge.status.num_messages = 10;
+  edge.status.num_bytes = 1000;
+  edge.status.num_dropped = 2;
+
+  const auto text = metrics::formatOpenMetrics({}, {}, {edge});
+  const std::string labels = R"(source_proxel="camera",source_port="out",sink_proxel="detector",sink_port="in")";
+
+  EXPECT_TRUE(contains(text, "superflow_edge_messages_total{" + labels + "} 10"));
+  EXPECT_TRUE(contains(text, "superflow_edge_bytes_total{" + labels + "} 1000"));
+  EXPECT_TRUE(contains(text, "superflow_edge_dropped_total{" + labels + "} 2"));
+  EXPECT_TRUE(contains(text, "# UNIT superflow_edge_queue_latency_seconds seconds"));
+}
@@ -0,0 +1,105 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#pragma once
+
+#include "superflow/yaml/yaml.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace flow { class Graph; }
+
+namespace flow::yaml
+{
+/// \brief Resolve a config file and its includes, as `resolveConfig` does, and write the result
+/// to a compact binary graph description that CompiledGraph loads without parsing any YAML.
+///
+/// The description records the size and modification time of every source file, and the arguments
+/// it was compiled with, so that a stale description can be detected by CompiledGraph::isUpToDate.
+/// It is written to a temporary file that replaces `output_path` when it is complete, so a process
+/// that loads the description concurrently sees either the old or the new one.
+/// \param config_file_path Path to the YAML configuration file
+/// \param output_path Where to write the graph description
+/// \param proxel_section_paths Where to find proxels in the config file. Default is a top level "Proxels" section.
+/// \param config_search_directory If the config file utilizes the 'Includes' feature,
+///        search for included files relative to this directory.
+/// \throws std::runtime_error If the config cannot be resolved, or the description cannot be written
+void compileGraph(
+    const std::string& config_file_path,
+    const std::string& output_path,
+    const std::vector<SectionPath>& proxel_section_paths = default_proxel_section_paths,
+    const std::string& config_search_directory = {}
+);
+
+/// \brief A graph description written by `compileGraph`, memory-mapped for fast startup.
+///
+/// The proxel properties are stored as YAML node trees, which are rebuilt without parsing,
+/// so the factories receive the same YAMLPropertyList as they would from `createGraph`.
+/// Partitions and 'Bridges' are not part of the description; use `createPartitionGraph` for those.
+/// \code{.cpp}
+/// const flow::yaml::CompiledGraph compiled{"/var/cache/app/graph.bin"};
+///
+/// if (compiled.isUpToDate("/etc/app/config.yaml"))
+/// { auto graph = compiled.createGraph(factory_map); }
+/// \endcode
+/// \see createGraphFromCache
+class CompiledGraph
+{
+public:
+  /// \param path Path to a graph description written by `compileGraph`
+  /// \throws std::runtime_error If the file cannot be opened, or is not a graph description of this format
+  explicit CompiledGraph(const std::string& path);
+
+  ~CompiledGraph();
+
+  CompiledGraph(const CompiledGraph&) = delete;
+  CompiledGraph& operator=(const CompiledGraph&) = delete;
+
+  /// \brief Check that the description was compiled with the given arguments,
+  /// and that none of its source files have changed since.
+  [[nodiscard]] bool isUpToDate(
+    const std::string& config_file_path,
+    const std::vector<SectionPath>& proxel_section_paths = default_proxel_section_paths,
+    const std::string& config_search_directory = {}
+  ) const;
+
+  /// \brief Rebuild the resolved config, as `resolveConfig` returned it when it was compiled
+  /// \throws std::runtime_error If the description is corrupt
+  [[nodiscard]] ResolvedConfig getConfig() const;
+
+  /// \brief Create the described graph
+  /// \return A new graph, ready to be started
+  /// \throws std::runtime_error If the description is corrupt, or a proxel cannot be created
+  [[nodiscard]] flow::Graph createGraph(const FactoryMap& factory_map) const;
+
+  /// \brief The config file, followed by the files it includes
+  [[nodiscard]] std::vector<std::string> getSourceFiles() const;
+
+private:
+  std::string path_;
+  const std::byte* data_ = nullptr;
+  size_t size_ = 0;
+  std::vector<std::byte> buffer_; ///< Holds the file where it cannot be mapped
+};
+
+/// \brief Create a flow::Graph from a YAML config file through a compiled graph description.
+///
+/// Loads the description at `cache_path` if it is up to date, and otherwise compiles it from the
+/// config first, so only the first launch after a change to any of the config files parses YAML.
+/// Takes the same arguments as `createGraph`, which gives an equivalent graph.
+/// \param config_file_path Path to the YAML configuration file
+/// \param cache_path Where to keep the graph description
+/// \param factory_map Container for mapping Proxel types to their respective Factories
+/// \param proxel_section_paths Where to find proxels in the config file. Default is a top level "Proxels" section.
+/// \param config_search_directory If the config file utilizes the 'Includes' feature,
+///        search for included files relative to this directory.
+/// \return A new graph, ready to be started
+/// \throws std::runtime_error If the file(s) cannot be found or if something is wrong with the syntax
+flow::Graph createGraphFromCache(
+    const std::string& config_file_path,
+    const std::string& cache_path,
+    const FactoryMap& factory_map,
+    const std::vector<SectionPath>& proxel_section_paths = default_proxel_section_paths,
+    const std::string& config_search_directory = {}
+);
+}
@@ -3,8 +3,11 @@
 
 #include "superflow/yaml/factory.h"
 
+#include "superflow/connection_spec.h"
+
 #include "yaml-cpp/yaml.h"
 
+#include <map>
 #include <string>
 #include <vector>
 
@@ -20,6 +23,9 @@ using SectionPath = std::vector<std::string>;
 /// Sections in the YAML file to look for proxels.
 const std::vector<SectionPath> default_proxel_section_paths = {{"Proxels"}};
 
+/// The partition of proxels that have no `partition` property, \see createPartitionGraph
+const std::string default_partition = "default";
+
 /// \brief Create a flow::Graph from the given YAML config file.
 ///
 /// The structure and contents of the configuration file must follow a distinct pattern.
@@ -33,6 +39,9 @@ const std::vector<SectionPath> default_proxel_section_paths = {{"Proxels"}};
 /// specifications can be scattered across the union of the files.
 /// Only the first file (the one given as argument to this function) is parsed for includes.
 ///
+/// The optional \b FusedGroups map lets a chain of cheap proxels share one thread, see flow::Graph::fuse.
+/// Each entry maps a unique group name to a list of enabled proxels, head first.
+///
 /// The listing below is a valid example of a configuration file for the yaml module.
 /// For further documentation, see the superflow report 19/00776.
 /// \code{.yml}
@@ -53,6 +62,9 @@ const std::vector<SectionPath> default_proxel_section_paths = {{"Proxels"}};
 ///
 /// Connections:
 ///   - [proxel_1: 'out', proxel_2: 'in']
+///
+/// FusedGroups:
+///   preprocessing: [proxel_1, proxel_2]
 /// ...
 /// \endcode
 /// \param config_file_path Absolute path to the YAML configuration file
@@ -76,6 +88,121 @@ flow::Graph createGraph(
     const std::string& config_search_directory = {}
 );
 
+/// \brief The contents of a config file and its includes, as `createGraph` resolves them.
+/// \see resolveConfig
+struct ResolvedConfig
+{
+  std::vector<ProxelConfig> proxel_configurations;              ///< Enabled proxels, with replicas expanded
+  std::vector<ConnectionSpec> connections;                      ///< Connections between enabled proxels
+  std::map<std::string, std::vector<std::string>> fused_groups; ///< Members of each 'FusedGroups' entry
+  std::vector<std::string> files;                               ///< The config file, followed by the files it includes
+};
+
+/// \brief Load a config file and its includes, and resolve its proxels, connections and fused groups
+/// without creating any proxels.
+///
+/// Takes the same arguments as `createGraph`, which is equivalent to creating a graph from the result.
+/// \throws std::runtime_error If the file(s) cannot be found or if something is wrong with the syntax
+/// \see compileGraph
+[[nodiscard]] ResolvedConfig resolveConfig(
+    const std::string& config_file_path,
+    const std::vector<SectionPath>& proxel_section_paths = default_proxel_section_paths,
+    const std::string& config_search_directory = {}
+);
+
+/// \brief Apply the difference between two configs to a (possibly running) flow::Graph.
+///
+/// `graph` is expected to have been created from `old_root`. The proxels and connections of both
+/// configs are resolved as in `createGraph`, and then compared:
+/// - connections that are only in `old_root` are disconnected,
+/// - proxels that are only in `old_root` are removed,
+/// - proxels with a changed type or changed properties are replaced, keeping their connections,
+/// - proxels that are only in `new_root` are added (and started, if the graph is running),
+/// - connections that are only in `new_root` are connected.
+///
+/// The rest of the graph keeps running while this happens. See flow::Graph::remove and
+/// flow::Graph::replace for the quiescing semantics of the affected edges.
+/// All new proxels are created before the graph is modified, so a failing factory leaves the graph untouched.
+/// \param graph The graph to update
+/// \param old_root The config `graph` was created from
+/// \param new_root The config to apply
+/// \param factory_map Container for mapping Proxel types to their respective Factories
+/// \param proxel_section_paths Where to find proxels in the config file. Default is a top level "Proxels" section.
+/// \param config_search_directory If the configs utilize the 'Includes' feature,
+///        search for included files relative to this directory.
+/// \throws std::invalid_argument If the 'FusedGroups' differ between the configs
+void updateGraph(
+    flow::Graph& graph,
+    const YAML::Node& old_root,
+    const YAML::Node& new_root,
+    const FactoryMap& factory_map,
+    const std::vector<SectionPath>& proxel_section_paths = default_proxel_section_paths,
+    const std::string& config_search_directory = {}
+);
+
+/// \brief Returns the names of all partitions that the enabled proxels of a config are assigned to, sorted.
+/// \see createPartitionGraph
+[[nodiscard]] std::vector<std::string> getPartitions(
+    const YAML::Node& root,
+    const std::vector<SectionPath>& proxel_section_paths = default_proxel_section_paths,
+    const std::string& config_search_directory = {}
+);
+
+/// \brief Returns the `channel` names of all bridges between the partitions of a config, sorted.
+/// Pass them to flow::ipc::launchPartitions, so that it can remove the shared memory of the bridges.
+/// \see createPartitionGraph
+[[nodiscard]] std::vector<std::string> getBridgeChannels(
+    const YAML::Node& root,
+    const std::vector<SectionPath>& proxel_section_paths = default_proxel_section_paths,
+    const std::string& config_search_directory = {}
+);
+
+/// \brief Create the part of a flow::Graph that belongs to one partition, to run it in a process of its own.
+///
+/// Each proxel is assigned to the partition named by its `partition` property, or else to
+/// `default_partition`. The graph of a partition contains its proxels and the connections
+/// between them, as `createGraph` would. A connection to a proxel in another partition is
+/// replaced by a bridge: the producer is connected to a sink proxel, which sends the items
+/// to a source proxel in the partition of the consumer, which passes them on to the consumer.
+///
+/// The \b Bridges map tells how to carry the items of each producer port to other partitions.
+/// The entry of a port names a `type`, and the factory map must hold the types `<type>Sink`,
+/// with an "in" port, and `<type>Source`, with an "out" port, e.g. as created by
+/// flow::ipc::createShmBridgeFactories. Both proxels are named `<producer>.<port>-><consumer>.<port>`,
+/// and get the rest of the entry as properties, with a `channel` property added that names the edge.
+/// The same config may still be run in a single process by `createGraph`, which ignores partitions.
+/// \code{.yml}
+/// Proxels:
+///   camera:   {type: Camera, partition: capture}
+///   detector: {type: Detector, partition: vision}
+///   viewer:   {type: Viewer, partition: vision}
+///
+/// Connections:
+///   - [camera: out, detector: in]
+///   - [detector: out, viewer: in]
+///
+/// Bridges:
+///   camera:
+///     out: {type: ImageShm, buffer_size: 4}
+/// \endcode
+/// \param root The config
+/// \param partition Name of the partition
+/// \param factory_map Container for mapping Proxel and bridge types to their respective Factories
+/// \param proxel_section_paths Where to find proxels in the config file. Default is a top level "Proxels" section.
+/// \param config_search_directory If the config utilizes the 'Includes' feature,
+///        search for included files relative to this directory.
+/// \return A new graph, ready to be started
+/// \throws std::invalid_argument If the partition has no proxels, if a connection that crosses
+///         partitions has no bridge, or if a fused group spans several partitions
+/// \see getPartitions, getBridgeChannels, flow::ipc::launchPartitions
+flow::Graph createPartitionGraph(
+    const YAML::Node& root,
+    const std::string& partition,
+    const FactoryMap& factory_map,
+    const std::vector<SectionPath>& proxel_section_paths = default_proxel_section_paths,
+    const std::string& config_search_directory = {}
+);
+
 /// \brief Returns a list with the ID of all proxel configs with `flag` set to true.
 /// Useful for creating subsets of proxels that require special treatment. For example:
 /// \code{.yml}
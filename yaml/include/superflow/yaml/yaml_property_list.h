@@ -21,6 +21,14 @@ public:
 
   static constexpr const char* adapter_name{"YAML"};
 
+  /// \brief The YAML::Map holding the properties
+  const YAML::Node& getNode() const;
+
+  /// \brief Two property lists are equal if they serialize to the same YAML.
+  bool operator==(const YAMLPropertyList& other) const;
+
+  bool operator!=(const YAMLPropertyList& other) const;
+
 private:
   YAML::Node parent_;
 };
@@ -40,6 +48,21 @@ inline bool YAMLPropertyList::hasKey(const std::string& key) const
   return bool(parent_[key]);
 }
 
+inline const YAML::Node& YAMLPropertyList::getNode() const
+{
+  return parent_;
+}
+
+inline bool YAMLPropertyList::operator==(const YAMLPropertyList& other) const
+{
+  return YAML::Dump(parent_) == YAML::Dump(other.parent_);
+}
+
+inline bool YAMLPropertyList::operator!=(const YAMLPropertyList& other) const
+{
+  return !(*this == other);
+}
+
 template<typename T>
 T YAMLPropertyList::convertValue(const std::string& key) const
 {
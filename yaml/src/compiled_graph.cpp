@@ -0,0 +1,531 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/yaml/compiled_graph.h"
+
+#include "superflow/graph.h"
+#include "superflow/graph_factory.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace flow::yaml
+{
+namespace
+{
+constexpr uint32_t magic_number = 0x43474653; ///< "SFGC" in little endian
+constexpr uint32_t current_format = 1;
+
+enum class NodeKind : uint8_t
+{
+  Null,
+  Scalar,
+  Sequence,
+  Map
+};
+
+/// The size and modification time of a source file, when the description was compiled
+struct SourceStamp
+{
+  uint64_t size = 0;
+  int64_t modified = 0; ///< Ticks of std::filesystem::file_time_type
+};
+
+std::optional<SourceStamp> getStamp(const std::string& path)
+{
+  std::error_code error;
+  const auto size = fs::file_size(path, error);
+
+  if (error)
+  { return std::nullopt; }
+
+  const auto modified = fs::last_write_time(path, error);
+
+  if (error)
+  { return std::nullopt; }
+
+  return SourceStamp{size, static_cast<int64_t>(modified.time_since_epoch().count())};
+}
+
+class Encoder
+{
+public:
+  template<typename T>
+  void put(const T& value)
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values are written as they are");
+    buffer_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  void putString(const std::string& text)
+  {
+    put(static_cast<uint32_t>(text.size()));
+    buffer_.append(text);
+  }
+
+  void putStrings(const std::vector<std::string>& texts)
+  {
+    put(static_cast<uint32_t>(texts.size()));
+
+    for (const auto& text : texts)
+    { putString(text); }
+  }
+
+  void putNode(const YAML::Node& node)
+  {
+    switch (node.Type())
+    {
+      case YAML::NodeType::Scalar:
+        put(NodeKind::Scalar);
+        putString(node.Tag());
+        putString(node.Scalar());
+        return;
+      case YAML::NodeType::Sequence:
+        put(NodeKind::Sequence);
+        putString(node.Tag());
+        put(static_cast<uint8_t>(node.Style()));
+        put(static_cast<uint32_t>(node.size()));
+
+        for (const auto& element : node)
+        { putNode(element); }
+
+        return;
+      case YAML::NodeType::Map:
+        put(NodeKind::Map);
+        putString(node.Tag());
+        put(static_cast<uint8_t>(node.Style()));
+        put(static_cast<uint32_t>(node.size()));
+
+        for (const auto& kv : node)
+        {
+          putNode(kv.first);
+          putNode(kv.second);
+        }
+
+        return;
+      default:
+        put(NodeKind::Null);
+        return;
+    }
+  }
+
+  [[nodiscard]] const std::string& get() const
+  { return buffer_; }
+
+private:
+  std::string buffer_;
+};
+
+/// Reads the values written by Encoder, throwing if they run past the end
+class Decoder
+{
+public:
+  Decoder(const std::byte* data, const size_t size, const std::string& path)
+    : data_{data}
+    , size_{size}
+    , path_{path}
+  {}
+
+  template<typename T>
+  T get()
+  {
+    T value;
+    std::memcpy(&value, take(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  std::string getString()
+  {
+    const auto size = get<uint32_t>();
+    return {reinterpret_cast<const char*>(take(size)), size};
+  }
+
+  std::vector<std::string> getStrings()
+  {
+    std::vector<std::string> texts(get<uint32_t>());
+
+    for (auto& text : texts)
+    { text = getString(); }
+
+    return texts;
+  }
+
+  YAML::Node getNode()
+  {
+    const auto kind = get<NodeKind>();
+
+    if (kind == NodeKind::Null)
+    { return YAML::Node{}; }
+
+    const auto tag = getString();
+    YAML::Node node;
+
+    switch (kind)
+    {
+      case NodeKind::Scalar:
+        node = getString();
+        break;
+      case NodeKind::Sequence:
+        node = YAML::Node{YAML::NodeType::Sequence};
+        node.SetStyle(static_cast<YAML::EmitterStyle::value>(get<uint8_t>()));
+
+        for (auto size = get<uint32_t>(); size > 0; --size)
+        { node.push_back(getNode()); }
+
+        break;
+      case NodeKind::Map:
+        node = YAML::Node{YAML::NodeType::Map};
+        node.SetStyle(static_cast<YAML::EmitterStyle::value>(get<uint8_t>()));
+
+        for (auto size = get<uint32_t>(); size > 0; --size)
+        {
+          const auto key = getNode();
+          node.force_insert(key, getNode());
+        }
+
+        break;
+      default:
+        throw corrupt();
+    }
+
+    node.SetTag(tag);
+    return node;
+  }
+
+  [[nodiscard]] std::runtime_error corrupt() const
+  { return std::runtime_error{"CompiledGraph '" + path_ + "' is corrupt"}; }
+
+private:
+  const std::byte* data_;
+  size_t size_;
+  const std::string& path_;
+  size_t offset_ = 0;
+
+  const std::byte* take(const size_t size)
+  {
+    if (size > size_ - offset_)
+    { throw corrupt(); }
+
+    const auto* data = data_ + offset_;
+    offset_ += size;
+    return data;
+  }
+};
+
+void putArguments(
+  Encoder& encoder,
+  const std::string& config_file_path,
+  const std::vector<SectionPath>& proxel_section_paths,
+  const std::string& config_search_directory)
+{
+  encoder.putString(config_file_path);
+  encoder.put(static_cast<uint32_t>(proxel_section_paths.size()));
+
+  for (const auto& section_path : proxel_section_paths)
+  { encoder.putStrings(section_path); }
+
+  encoder.putString(config_search_directory);
+}
+
+void unmap([[maybe_unused]] const std::byte* data, [[maybe_unused]] const size_t size)
+{
+#ifdef __linux__
+  munmap(const_cast<std::byte*>(data), size);
+#endif
+}
+
+/// Skips past the header and the compile arguments, to the source files
+Decoder getSourcesDecoder(const std::byte* data, const size_t size, const std::string& path)
+{
+  Decoder decoder{data, size, path};
+  decoder.get<uint32_t>();
+  decoder.get<uint32_t>();
+  decoder.getString();
+
+  for (auto num_paths = decoder.get<uint32_t>(); num_paths > 0; --num_paths)
+  { decoder.getStrings(); }
+
+  decoder.getString();
+  return decoder;
+}
+}
+
+void compileGraph(
+    const std::string& config_file_path,
+    const std::string& output_path,
+    const std::vector<SectionPath>& proxel_section_paths,
+    const std::string& config_search_directory
+)
+{
+  const auto config = resolveConfig(config_file_path, proxel_section_paths, config_search_directory);
+
+  Encoder encoder;
+  encoder.put(magic_number);
+  encoder.put(current_format);
+  putArguments(encoder, config_file_path, proxel_section_paths, config_search_directory);
+
+  encoder.put(static_cast<uint32_t>(config.files.size()));
+
+  for (const auto& file : config.files)
+  {
+    const auto stamp = getStamp(file);
+
+    if (!stamp)
+    { throw std::runtime_error{"compileGraph: cannot stat '" + file + "'"}; }
+
+    encoder.putString(file);
+    encoder.put(*stamp);
+  }
+
+  encoder.put(static_cast<uint32_t>(config.proxel_configurations.size()));
+
+  for (const auto& proxel : config.proxel_configurations)
+  {
+    encoder.putString(proxel.id);
+    encoder.putString(proxel.type);
+    encoder.putNode(proxel.properties.getNode());
+  }
+
+  encoder.put(static_cast<uint32_t>(config.connections.size()));
+
+  for (const auto& connection : config.connections)
+  {
+    encoder.putString(connection.lhs_name);
+    encoder.putString(connection.lhs_port);
+    encoder.putString(connection.rhs_name);
+    encoder.putString(connection.rhs_port);
+  }
+
+  encoder.put(static_cast<uint32_t>(config.fused_groups.size()));
+
+  for (const auto& [group_name, members] : config.fused_groups)
+  {
+    encoder.putString(group_name);
+    encoder.putStrings(members);
+  }
+
+  // Write next to the target and rename, so that readers never see a partial description
+  const auto temporary_path = output_path + ".tmp-" + std::to_string(std::random_device{}());
+
+  {
+    std::ofstream file{temporary_path, std::ios::binary | std::ios::trunc};
+    file.write(encoder.get().data(), static_cast<std::streamsize>(encoder.get().size()));
+
+    if (!file)
+    {
+      fs::remove(temporary_path);
+      throw std::runtime_error{"compileGraph: cannot write '" + temporary_path + "'"};
+    }
+  }
+
+  std::error_code error;
+  fs::rename(temporary_path, output_path, error);
+
+  if (error)
+  {
+    fs::remove(temporary_path);
+    throw std::runtime_error{"compileGraph: cannot write '" + output_path + "': " + error.message()};
+  }
+}
+
+CompiledGraph::CompiledGraph(const std::string& path)
+  : path_{path}
+{
+#ifdef __linux__
+  const int fd = open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+
+  if (fd < 0)
+  { throw std::runtime_error{"CompiledGraph '" + path_ + "': cannot open: " + std::strerror(errno)}; }
+
+  struct stat status{};
+
+  if (fstat(fd, &status) != 0 || status.st_size == 0)
+  {
+    close(fd);
+    throw std::runtime_error{"CompiledGraph '" + path_ + "' is empty or cannot be read"};
+  }
+
+  size_ = static_cast<size_t>(status.st_size);
+  void* memory = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+
+  if (memory == MAP_FAILED)
+  { throw std::runtime_error{"CompiledGraph '" + path_ + "': cannot map: " + std::strerror(errno)}; }
+
+  data_ = static_cast<const std::byte*>(memory);
+#else
+  std::ifstream file{path_, std::ios::binary};
+
+  if (!file)
+  { throw std::runtime_error{"CompiledGraph '" + path_ + "': cannot open"}; }
+
+  const std::string contents{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+  buffer_.resize(contents.size());
+  std::memcpy(buffer_.data(), contents.data(), contents.size());
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+#endif
+
+  uint32_t header[2]{};
+
+  if (size_ >= sizeof(header))
+  { std::memcpy(header, data_, sizeof(header)); }
+
+  if (header[0] != magic_number || header[1] != current_format)
+  {
+    unmap(data_, size_);
+    throw std::runtime_error{
+      "CompiledGraph '" + path_ + "' is not a graph description of format " + std::to_string(current_format)
+    };
+  }
+}
+
+CompiledGraph::~CompiledGraph()
+{
+  unmap(data_, size_);
+}
+
+bool CompiledGraph::isUpToDate(
+  const std::string& config_file_path,
+  const std::vector<SectionPath>& proxel_section_paths,
+  const std::string& config_search_directory
+) const
+{
+  Encoder arguments;
+  arguments.put(magic_number);
+  arguments.put(current_format);
+  putArguments(arguments, config_file_path, proxel_section_paths, config_search_directory);
+
+  const auto& expected = arguments.get();
+
+  if (expected.size() > size_ || std::memcmp(expected.data(), data_, expected.size()) != 0)
+  { return false; }
+
+  try
+  {
+    auto decoder = getSourcesDecoder(data_, size_, path_);
+
+    for (auto num_sources = decoder.get<uint32_t>(); num_sources > 0; --num_sources)
+    {
+      const auto file = decoder.getString();
+      const auto recorded = decoder.get<SourceStamp>();
+      const auto current = getStamp(file);
+
+      if (!current || current->size != recorded.size || current->modified != recorded.modified)
+      { return false; }
+    }
+  }
+  catch (const std::runtime_error&)
+  { return false; }
+
+  return true;
+}
+
+ResolvedConfig CompiledGraph::getConfig() const
+{
+  auto decoder = getSourcesDecoder(data_, size_, path_);
+  ResolvedConfig config;
+
+  for (auto num_sources = decoder.get<uint32_t>(); num_sources > 0; --num_sources)
+  {
+    config.files.push_back(decoder.getString());
+    decoder.get<SourceStamp>();
+  }
+
+  for (auto num_proxels = decoder.get<uint32_t>(); num_proxels > 0; --num_proxels)
+  {
+    auto id = decoder.getString();
+    auto type = decoder.getString();
+    const auto properties = decoder.getNode();
+
+    if (!properties.IsMap())
+    { throw decoder.corrupt(); }
+
+    config.proxel_configurations.push_back({std::move(id), std::move(type), YAMLPropertyList{properties}});
+  }
+
+  for (auto num_connections = decoder.get<uint32_t>(); num_connections > 0; --num_connections)
+  {
+    ConnectionSpec connection;
+    connection.lhs_name = decoder.getString();
+    connection.lhs_port = decoder.getString();
+    connection.rhs_name = decoder.getString();
+    connection.rhs_port = decoder.getString();
+    config.connections.push_back(std::move(connection));
+  }
+
+  for (auto num_groups = decoder.get<uint32_t>(); num_groups > 0; --num_groups)
+  {
+    auto group_name = decoder.getString();
+    config.fused_groups.emplace(std::move(group_name), decoder.getStrings());
+  }
+
+  return config;
+}
+
+flow::Graph CompiledGraph::createGraph(const FactoryMap& factory_map) const
+{
+  const auto config = getConfig();
+
+  auto graph = flow::createGraph(factory_map, config.proxel_configurations, config.connections);
+
+  for (const auto& [group_name, members] : config.fused_groups)
+  { graph.fuse(group_name, members); }
+
+  return graph;
+}
+
+std::vector<std::string> CompiledGraph::getSourceFiles() const
+{
+  auto decoder = getSourcesDecoder(data_, size_, path_);
+  std::vector<std::string> files;
+
+  for (auto num_sources = decoder.get<uint32_t>(); num_sources > 0; --num_sources)
+  {
+    files.push_back(decoder.getString());
+    decoder.get<SourceStamp>();
+  }
+
+  return files;
+}
+
+flow::Graph createGraphFromCache(
+    const std::string& config_file_path,
+    const std::string& cache_path,
+    const FactoryMap& factory_map,
+    const std::vector<SectionPath>& proxel_section_paths,
+    const std::string& config_search_directory
+)
+{
+  std::optional<CompiledGraph> compiled;
+
+  try
+  { compiled.emplace(cache_path); }
+  catch (const std::runtime_error&)
+  {} // A missing description, or one of another format, is compiled below
+
+  if (!compiled || !compiled->isUpToDate(config_file_path, proxel_section_paths, config_search_directory))
+  {
+    compiled.reset();
+    compileGraph(config_file_path, cache_path, proxel_section_paths, config_search_directory);
+    compiled.emplace(cache_path);
+  }
+
+  return compiled->createGraph(factory_map);
+}
+}
@@ -8,8 +8,10 @@
 #include "superflow/utils/graphviz.h"
 #include "superflow/value.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <map>
+#include <set>
 #include <vector>
 
 namespace fs = std::filesystem;
@@ -20,6 +22,22 @@ using namespace flow::yaml;
 using ReplicaMap = std::map<std::string, size_t>;
 using PortSpecification = std::pair<std::string, std::vector<std::string>>;
 using ExpandedPortSpecification = std::vector<std::pair<std::string, std::string>>;
+using FusedGroups = std::map<std::string, std::vector<std::string>>;
+
+/// The fully resolved contents of a config file and its includes.
+struct GraphSpec
+{
+  std::vector<ProxelConfig> proxel_configurations;
+  std::vector<flow::ConnectionSpec> connections;
+  FusedGroups fused_groups;
+  YAML::Node bridges;
+  std::vector<std::string> included_files; ///< Paths of the files loaded from 'Includes'
+};
+
+GraphSpec loadGraphSpec(
+    const YAML::Node& root,
+    const std::vector<SectionPath>& proxel_section_paths,
+    const std::string& config_search_directory);
 
 ExpandedPortSpecification expandConnectionSpecifier(const PortSpecification& port_spec, size_t proxel_replicas);
 std::vector<ProxelConfig> getAllProxelConfigs(const std::vector<YAML::Node>& config_sections);
@@ -34,6 +52,17 @@ std::vector<flow::ConnectionSpec> getConnections(
     const std::vector<std::string>& enabled_proxels,
     const ReplicaMap& replica_map);
 
+FusedGroups getFusedGroups(
+    const YAML::Node& config,
+    const std::vector<std::string>& enabled_proxels);
+
+std::map<std::string, std::string> getProxelPartitions(const std::vector<ProxelConfig>& configs);
+std::string getBridgeChannel(const flow::ConnectionSpec& connection);
+ProxelConfig createBridgeConfig(
+    const YAML::Node& bridges,
+    const flow::ConnectionSpec& connection,
+    const std::string& suffix);
+
 bool validConnectionSpecification(const YAML::Node& node);
 bool validPortSpecification(const YAML::Node& node);
 
@@ -103,39 +132,207 @@ flow::Graph createGraph(
     const std::string& config_search_directory
 )
 {
-  YAML::Node node = YAML::Clone(root);
-  auto all_config_sections = getProxelSections(node, proxel_section_paths);
+  const auto spec = loadGraphSpec(root, proxel_section_paths, config_search_directory);
 
-  if (node["Includes"])
+  auto graph = flow::createGraph(factory_map, spec.proxel_configurations, spec.connections);
+
+  for (const auto& [group_name, members] : spec.fused_groups)
+  { graph.fuse(group_name, members); }
+
+  return graph;
+}
+
+void updateGraph(
+    flow::Graph& graph,
+    const YAML::Node& old_root,
+    const YAML::Node& new_root,
+    const FactoryMap& factory_map,
+    const std::vector<SectionPath>& proxel_section_paths,
+    const std::string& config_search_directory
+)
+{
+  const auto old_spec = loadGraphSpec(old_root, proxel_section_paths, config_search_directory);
+  const auto new_spec = loadGraphSpec(new_root, proxel_section_paths, config_search_directory);
+
+  if (old_spec.fused_groups != new_spec.fused_groups)
+  { throw std::invalid_argument("Changes to 'FusedGroups' cannot be applied to a running graph"); }
+
+  const auto find_config = [](const std::vector<ProxelConfig>& configs, const std::string& id)
   {
-    for (const auto& included_file : node["Includes"])
-    {
-      const auto filename = included_file.as<std::string>();
-      YAML::Node incl;
-      try
-      { incl = YAML::LoadFile(filename); }
-      catch (const YAML::BadFile&)
-      {
-        const auto full_path = fs::path{config_search_directory} /= filename;
-        incl = YAML::LoadFile(full_path.string());
-      }
+    return std::find_if(
+      configs.begin(), configs.end(),
+      [&id](const ProxelConfig& config)
+      { return config.id == id; }
+    );
+  };
 
-      if (!incl["Connections"])
-      { throw std::invalid_argument("No section 'Connections' specified in file: " + filename); }
+  const auto contains = [](const std::vector<flow::ConnectionSpec>& connections, const flow::ConnectionSpec& connection)
+  { return std::find(connections.begin(), connections.end(), connection) != connections.end(); };
 
-      for (const auto& connection : incl["Connections"])
-      { node["Connections"].push_back(connection); }
+  std::vector<ProxelConfig> added_configs;
+  std::vector<ProxelConfig> changed_configs;
+  std::vector<std::string> removed_ids;
 
-      all_config_sections = all_config_sections + getProxelSections(incl, proxel_section_paths);
+  for (const auto& config : new_spec.proxel_configurations)
+  {
+    const auto it = find_config(old_spec.proxel_configurations, config.id);
+
+    if (it == old_spec.proxel_configurations.end())
+    { added_configs.push_back(config); }
+    else if (it->type != config.type || it->properties != config.properties)
+    { changed_configs.push_back(config); }
+  }
+
+  for (const auto& config : old_spec.proxel_configurations)
+  {
+    if (find_config(new_spec.proxel_configurations, config.id) == new_spec.proxel_configurations.end())
+    { removed_ids.push_back(config.id); }
+  }
+
+  // Create all new proxels up front, so that a failing factory leaves the graph untouched.
+  auto added_proxels = flow::createProxelsFromConfig(factory_map, added_configs);
+  auto changed_proxels = flow::createProxelsFromConfig(factory_map, changed_configs);
+
+  for (const auto& connection : old_spec.connections)
+  {
+    if (!contains(new_spec.connections, connection))
+    { graph.disconnect(connection.lhs_name, connection.lhs_port, connection.rhs_name, connection.rhs_port); }
+  }
+
+  for (const auto& proxel_id : removed_ids)
+  { graph.remove(proxel_id); }
+
+  for (auto& [proxel_id, proxel] : changed_proxels)
+  { graph.replace(proxel_id, std::move(proxel)); }
+
+  for (auto& [proxel_id, proxel] : added_proxels)
+  { graph.add(proxel_id, std::move(proxel)); }
+
+  for (const auto& connection : new_spec.connections)
+  {
+    if (!contains(old_spec.connections, connection))
+    { graph.connect(connection.lhs_name, connection.lhs_port, connection.rhs_name, connection.rhs_port); }
+  }
+}
+
+ResolvedConfig resolveConfig(
+    const std::string& config_file_path,
+    const std::vector<SectionPath>& proxel_section_paths,
+    const std::string& config_search_directory
+)
+{
+  const auto root = YAML::LoadFile(config_file_path);
+  const auto search_directory = config_search_directory.empty()
+                                ? fs::path{config_file_path}.parent_path().string()
+                                : config_search_directory;
+
+  auto spec = loadGraphSpec(root, proxel_section_paths, search_directory);
+
+  ResolvedConfig config;
+  config.proxel_configurations = std::move(spec.proxel_configurations);
+  config.connections = std::move(spec.connections);
+  config.fused_groups = std::move(spec.fused_groups);
+  config.files.push_back(config_file_path);
+  config.files += spec.included_files;
+
+  return config;
+}
+
+std::vector<std::string> getPartitions(
+    const YAML::Node& root,
+    const std::vector<SectionPath>& proxel_section_paths,
+    const std::string& config_search_directory
+)
+{
+  const auto spec = loadGraphSpec(root, proxel_section_paths, config_search_directory);
+  std::set<std::string> partitions;
+
+  for (const auto& kv : getProxelPartitions(spec.proxel_configurations))
+  { partitions.insert(kv.second); }
+
+  return {partitions.begin(), partitions.end()};
+}
+
+std::vector<std::string> getBridgeChannels(
+    const YAML::Node& root,
+    const std::vector<SectionPath>& proxel_section_paths,
+    const std::string& config_search_directory
+)
+{
+  const auto spec = loadGraphSpec(root, proxel_section_paths, config_search_directory);
+  const auto partitions = getProxelPartitions(spec.proxel_configurations);
+  std::set<std::string> channels;
+
+  for (const auto& connection : spec.connections)
+  {
+    if (partitions.at(connection.lhs_name) != partitions.at(connection.rhs_name))
+    { channels.insert(getBridgeChannel(connection)); }
+  }
+
+  return {channels.begin(), channels.end()};
+}
+
+flow::Graph createPartitionGraph(
+    const YAML::Node& root,
+    const std::string& partition,
+    const FactoryMap& factory_map,
+    const std::vector<SectionPath>& proxel_section_paths,
+    const std::string& config_search_directory
+)
+{
+  const auto spec = loadGraphSpec(root, proxel_section_paths, config_search_directory);
+  const auto partitions = getProxelPartitions(spec.proxel_configurations);
+
+  const auto is_local = [&](const std::string& proxel_id)
+  { return partitions.at(proxel_id) == partition; };
+
+  std::vector<ProxelConfig> configs;
+  std::vector<flow::ConnectionSpec> connections;
+
+  for (const auto& config : spec.proxel_configurations)
+  {
+    if (is_local(config.id))
+    { configs.push_back(config); }
+  }
+
+  if (configs.empty())
+  { throw std::invalid_argument("No proxels are assigned to partition '" + partition + "'"); }
+
+  for (const auto& connection : spec.connections)
+  {
+    const bool lhs_local = is_local(connection.lhs_name);
+    const bool rhs_local = is_local(connection.rhs_name);
+
+    if (lhs_local && rhs_local)
+    { connections.push_back(connection); }
+    else if (lhs_local)
+    {
+      configs.push_back(createBridgeConfig(spec.bridges, connection, "Sink"));
+      connections.push_back({connection.lhs_name, connection.lhs_port, configs.back().id, "in"});
+    }
+    else if (rhs_local)
+    {
+      configs.push_back(createBridgeConfig(spec.bridges, connection, "Source"));
+      connections.push_back({configs.back().id, "out", connection.rhs_name, connection.rhs_port});
     }
   }
 
-  const auto proxel_configurations = getAllProxelConfigs(all_config_sections);
-  const auto enabled_proxels = getAllProxelNamesFilteredByEnableValue(all_config_sections, true);
-  const auto replicated_proxels = getAllReplicatedProxels(all_config_sections);
-  const auto connections = getConnections(node, enabled_proxels, replicated_proxels);
+  auto graph = flow::createGraph(factory_map, configs, connections);
+
+  for (const auto& [group_name, members] : spec.fused_groups)
+  {
+    const auto num_local = std::count_if(members.begin(), members.end(), is_local);
+
+    if (num_local == 0)
+    { continue; }
+
+    if (static_cast<size_t>(num_local) != members.size())
+    { throw std::invalid_argument("Fused group '" + group_name + "' spans several partitions"); }
 
-  return flow::createGraph(factory_map, proxel_configurations, connections);
+    graph.fuse(group_name, members);
+  }
+
+  return graph;
 }
 
 std::vector<std::string> getFlaggedProxels(
@@ -216,6 +413,60 @@ std::string generateDOTFile(
 // ----- Helper functions -----
 namespace
 {
+GraphSpec loadGraphSpec(
+    const YAML::Node& root,
+    const std::vector<SectionPath>& proxel_section_paths,
+    const std::string& config_search_directory)
+{
+  YAML::Node node = YAML::Clone(root);
+  auto all_config_sections = getProxelSections(node, proxel_section_paths);
+  std::vector<std::string> included_files;
+
+  if (node["Includes"])
+  {
+    for (const auto& included_file : node["Includes"])
+    {
+      const auto filename = included_file.as<std::string>();
+      YAML::Node incl;
+      std::string loaded_path = filename;
+      try
+      { incl = YAML::LoadFile(filename); }
+      catch (const YAML::BadFile&)
+      {
+        loaded_path = (fs::path{config_search_directory} /= filename).string();
+        incl = YAML::LoadFile(loaded_path);
+      }
+
+      included_files.push_back(loaded_path);
+
+      if (!incl["Connections"])
+      { throw std::invalid_argument("No section 'Connections' specified in file: " + filename); }
+
+      for (const auto& connection : incl["Connections"])
+      { node["Connections"].push_back(connection); }
+
+      for (const auto& group : incl["FusedGroups"])
+      { node["FusedGroups"][group.first] = group.second; }
+
+      for (const auto& bridge : incl["Bridges"])
+      { node["Bridges"][bridge.first] = bridge.second; }
+
+      all_config_sections = all_config_sections + getProxelSections(incl, proxel_section_paths);
+    }
+  }
+
+  const auto enabled_proxels = getAllProxelNamesFilteredByEnableValue(all_config_sections, true);
+  const auto replicated_proxels = getAllReplicatedProxels(all_config_sections);
+
+  return {
+    getAllProxelConfigs(all_config_sections),
+    getConnections(node, enabled_proxels, replicated_proxels),
+    getFusedGroups(node, enabled_proxels),
+    node["Bridges"],
+    included_files
+  };
+}
+
 std::vector<ProxelConfig> getAllProxelConfigs(const std::vector<YAML::Node>& config_sections)
 {
   std::vector<ProxelConfig> configs;
@@ -408,6 +659,89 @@ std::vector<flow::ConnectionSpec> getConnections(
   return connections;
 }
 
+FusedGroups getFusedGroups(
+    const YAML::Node& config,
+    const std::vector<std::string>& enabled_proxels)
+{
+  FusedGroups groups;
+
+  if (!config["FusedGroups"])
+  { return groups; }
+
+  if (!config["FusedGroups"].IsMap())
+  {
+    throw std::invalid_argument("Bad fused group format. 'FusedGroups' must be a YAML::Map of proxel lists.\n"
+                                " E.g.: preprocessing: [decode, undistort, resize]"
+    );
+  }
+
+  for (const auto& group : config["FusedGroups"])
+  {
+    const auto group_name = group.first.as<std::string>();
+    auto members = group.second.as<std::vector<std::string>>();
+
+    // Leaving a member out could make another one the head, or split the chain
+    for (const auto& member : members)
+    {
+      if (std::find(enabled_proxels.begin(), enabled_proxels.end(), member) == enabled_proxels.end())
+      {
+        throw std::invalid_argument(
+          "Fused group '" + group_name + "' has member '" + member + "', which is disabled or does not exist"
+        );
+      }
+    }
+
+    groups[group_name] = std::move(members);
+  }
+
+  return groups;
+}
+
+std::map<std::string, std::string> getProxelPartitions(const std::vector<ProxelConfig>& configs)
+{
+  std::map<std::string, std::string> partitions;
+
+  for (const auto& config : configs)
+  { partitions[config.id] = flow::value<std::string>(config.properties, "partition", default_partition); }
+
+  return partitions;
+}
+
+std::string getBridgeChannel(const flow::ConnectionSpec& connection)
+{
+  return "superflow-" + connection.lhs_name + "-" + connection.lhs_port
+         + "-" + connection.rhs_name + "-" + connection.rhs_port;
+}
+
+ProxelConfig createBridgeConfig(
+    const YAML::Node& bridges,
+    const flow::ConnectionSpec& connection,
+    const std::string& suffix)
+{
+  const auto bridge_id = connection.lhs_name + "." + connection.lhs_port
+                         + "->" + connection.rhs_name + "." + connection.rhs_port;
+
+  const YAML::Node bridge = bridges && bridges[connection.lhs_name]
+                       ? bridges[connection.lhs_name][connection.lhs_port]
+                       : YAML::Node{};
+
+  if (!bridge || !bridge.IsMap() || !bridge["type"])
+  {
+    throw std::invalid_argument(
+      "Connection " + bridge_id + " crosses partitions, but 'Bridges' has no type for "
+      + connection.lhs_name + ": " + connection.lhs_port + "\n"
+      " E.g.: Bridges: {" + connection.lhs_name + ": {" + connection.lhs_port + ": {type: ImageShm}}}"
+    );
+  }
+
+  YAML::Node properties = YAML::Clone(bridge);
+  const auto type = properties["type"].as<std::string>() + suffix;
+  properties.remove("type");
+  properties["channel"] = getBridgeChannel(connection);
+
+  return {bridge_id, type, YAMLPropertyList{properties}};
+}
+
 ExpandedPortSpecification expandConnectionSpecifier(const PortSpecification& port_spec, const size_t proxel_replicas)
 {
   const auto& proxel_id = port_spec.first;
@@ -0,0 +1,199 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/yaml/compiled_graph.h"
+
+#include "superflow/callback_consumer_port.h"
+#include "superflow/graph.h"
+#include "superflow/producer_port.h"
+#include "superflow/proxel.h"
+#include "superflow/value.h"
+
+#include "gtest/gtest.h"
+
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+class NumberProxel : public flow::Proxel
+{
+public:
+  explicit NumberProxel(const int number)
+    : number_{number}
+    , out_port_{std::make_shared<flow::ProducerPort<int>>()}
+    , in_port_{std::make_shared<flow::CallbackConsumerPort<int, flow::ConnectPolicy::Multi>>([](int){})}
+  {
+    registerPorts({{"out", out_port_}, {"in", in_port_}});
+  }
+
+  void start() override
+  {}
+
+  void stop() noexcept override
+  {}
+
+  int getNumber() const
+  { return number_; }
+
+private:
+  int number_;
+  flow::Port::Ptr out_port_;
+  flow::Port::Ptr in_port_;
+};
+
+flow::yaml::FactoryMap getFactoryMap()
+{
+  return flow::yaml::FactoryMap{
+    {
+      {
+        "NumberProxel",
+        [](const flow::yaml::YAMLPropertyList& properties)
+        { return std::make_shared<NumberProxel>(flow::value<int>(properties, "number")); }
+      }
+    }
+  };
+}
+
+/// A directory with a config and an included file, removed at the end of the test
+struct ConfigDirectory
+{
+  fs::path path = fs::temp_directory_path() / (
+    "superflow-test-" + std::to_string(getpid()) + '-'
+    + ::testing::UnitTest::GetInstance()->current_test_info()->name()
+  );
+
+  ConfigDirectory()
+  {
+    fs::create_directories(path);
+
+    write("config.yaml", R"(
+Includes:
+  - included.yaml
+Proxels:
+  source: {type: NumberProxel, number: 1}
+  workers:
+    type: NumberProxel
+    replicate: 2
+    $number: [10, "11"]
+  disabled: {type: NumberProxel, number: 3, enable: false}
+Connections:
+  - [source: out, workers: in]
+  - [source: out, disabled: in]
+FusedGroups:
+  pair: [workers_0, workers_1]
+)");
+    setSinkNumber(4);
+  }
+
+  ~ConfigDirectory()
+  { fs::remove_all(path); }
+
+  void write(const std::string& name, const std::string& contents) const
+  { std::ofstream{path / name} << contents; }
+
+  void setSinkNumber(const int number) const
+  {
+    write("included.yaml", "Proxels:\n  sink: {type: NumberProxel, number: " + std::to_string(number) + "}\n"
+                           "Connections:\n  - [workers: out, sink: in]\n");
+  }
+
+  std::string config() const
+  { return (path / "config.yaml").string(); }
+
+  std::string cache() const
+  { return (path / "graph.bin").string(); }
+};
+}
+
+TEST(CompiledGraph, holdsResolvedConfig)
+{
+  const ConfigDirectory directory;
+  flow::yaml::compileGraph(directory.config(), directory.cache());
+
+  const auto expected = flow::yaml::resolveConfig(directory.config());
+  const auto config = flow::yaml::CompiledGraph{directory.cache()}.getConfig();
+
+  ASSERT_EQ(expected.proxel_configurations.size(), config.proxel_configurations.size());
+  ASSERT_EQ(4, config.proxel_configurations.size());
+
+  for (size_t i = 0; i < config.proxel_configurations.size(); ++i)
+  {
+    EXPECT_EQ(expected.proxel_configurations[i].id, config.proxel_configurations[i].id);
+    EXPECT_EQ(expected.proxel_configurations[i].type, config.proxel_configurations[i].type);
+    EXPECT_EQ(expected.proxel_configurations[i].properties, config.proxel_configurations[i].properties);
+  }
+
+  EXPECT_EQ(expected.connections, config.connections);
+  EXPECT_EQ(expected.fused_groups, config.fused_groups);
+  EXPECT_EQ(expected.files, config.files);
+  EXPECT_EQ(2, config.files.size());
+}
+
+TEST(CompiledGraph, createsSameGraphAsConfig)
+{
+  const ConfigDirectory directory;
+  flow::yaml::compileGraph(directory.config(), directory.cache());
+
+  auto graph = flow::yaml::CompiledGraph{directory.cache()}.createGraph(getFactoryMap());
+
+  EXPECT_EQ(1, graph.getProxel<NumberProxel>("source")->getNumber());
+  EXPECT_EQ(10, graph.getProxel<NumberProxel>("workers_0")->getNumber());
+  EXPECT_EQ(11, graph.getProxel<NumberProxel>("workers_1")->getNumber());
+  EXPECT_EQ(4, graph.getProxel<NumberProxel>("sink")->getNumber());
+  EXPECT_THROW(graph.getProxel("disabled"), std::invalid_argument);
+  EXPECT_EQ(4, graph.getConnections().size());
+}
+
+TEST(CompiledGraph, isOutdatedWhenIncludedFileChanges)
+{
+  const ConfigDirectory directory;
+  flow::yaml::compileGraph(directory.config(), directory.cache());
+
+  {
+    const flow::yaml::CompiledGraph compiled{directory.cache()};
+    EXPECT_TRUE(compiled.isUpToDate(directory.config()));
+    EXPECT_FALSE(compiled.isUpToDate(directory.config(), {{"Other"}}));
+    EXPECT_FALSE(compiled.isUpToDate(directory.config(), flow::yaml::default_proxel_section_paths, "/tmp"));
+  }
+
+  directory.setSinkNumber(40);
+
+  EXPECT_FALSE(flow::yaml::CompiledGraph{directory.cache()}.isUpToDate(directory.config()));
+}
+
+TEST(CompiledGraph, throwsOnOtherFiles)
+{
+  const ConfigDirectory directory;
+
+  EXPECT_THROW(flow::yaml::CompiledGraph{directory.cache()}, std::runtime_error);
+  EXPECT_THROW(flow::yaml::CompiledGraph{directory.config()}, std::runtime_error);
+}
+
+TEST(CompiledGraph, cacheIsCompiledOnlyWhenOutdated)
+{
+  const ConfigDirectory directory;
+  directory.write("graph.bin", "not a graph description");
+
+  {
+    auto graph = flow::yaml::createGraphFromCache(directory.config(), directory.cache(), getFactoryMap());
+    EXPECT_EQ(4, graph.getProxel<NumberProxel>("sink")->getNumber());
+  }
+
+  const auto compiled_time = fs::last_write_time(directory.cache());
+
+  {
+    auto graph = flow::yaml::createGraphFromCache(directory.config(), directory.cache(), getFactoryMap());
+    EXPECT_EQ(4, graph.getProxel<NumberProxel>("sink")->getNumber());
+    EXPECT_EQ(compiled_time, fs::last_write_time(directory.cache()));
+  }
+
+  directory.setSinkNumber(40);
+
+  {
+    auto graph = flow::yaml::createGraphFromCache(directory.config(), directory.cache(), getFactoryMap());
+    EXPECT_EQ(40, graph.getProxel<NumberProxel>("sink")->getNumber());
+  }
+}
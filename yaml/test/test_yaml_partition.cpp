@@ -0,0 +1,161 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/yaml/yaml.h"
+
+#include "superflow/callback_consumer_port.h"
+#include "superflow/graph.h"
+#include "superflow/producer_port.h"
+#include "superflow/proxel.h"
+#include "superflow/value.h"
+
+#include "gtest/gtest.h"
+
+namespace
+{
+class PassProxel : public flow::Proxel
+{
+public:
+  explicit PassProxel(std::string channel = {})
+    : channel_{std::move(channel)}
+    , out_port_{std::make_shared<flow::ProducerPort<int>>()}
+    , in_port_{std::make_shared<flow::CallbackConsumerPort<int, flow::ConnectPolicy::Multi>>([](int){})}
+  {
+    registerPorts({{"out", out_port_}, {"in", in_port_}});
+  }
+
+  void start() override
+  {}
+
+  void stop() noexcept override
+  {}
+
+  const std::string& getChannel() const
+  { return channel_; }
+
+private:
+  std::string channel_;
+  flow::Port::Ptr out_port_;
+  flow::Port::Ptr in_port_;
+};
+
+flow::yaml::FactoryMap getFactoryMap()
+{
+  const auto create = [](const flow::yaml::YAMLPropertyList&)
+  { return std::make_shared<PassProxel>(); };
+
+  const auto create_bridge = [](const flow::yaml::YAMLPropertyList& properties)
+  { return std::make_shared<PassProxel>(flow::value<std::string>(properties, "channel")); };
+
+  return flow::yaml::FactoryMap{
+    {
+      {"PassProxel", create},
+      {"IntSink", create_bridge},
+      {"IntSource", create_bridge}
+    }
+  };
+}
+
+const YAML::Node config = YAML::Load(R"(
+Proxels:
+  camera:   {type: PassProxel, partition: capture}
+  detector: {type: PassProxel, partition: vision}
+  viewer:   {type: PassProxel, partition: vision}
+  logger:   {type: PassProxel}
+Connections:
+  - [camera: out, detector: in]
+  - [detector: out, viewer: in]
+  - [detector: out, logger: in]
+Bridges:
+  detector:
+    out: {type: Int, buffer_size: 4}
+  camera:
+    out: {type: Int}
+)");
+
+bool contains(const std::vector<flow::ConnectionSpec>& connections, const flow::ConnectionSpec& connection)
+{
+  return std::find(connections.begin(), connections.end(), connection) != connections.end();
+}
+}
+
+TEST(YamlPartition, getPartitions)
+{
+  const std::vector<std::string> expected{"capture", "default", "vision"};
+  EXPECT_EQ(expected, flow::yaml::getPartitions(config));
+}
+
+TEST(YamlPartition, getBridgeChannels)
+{
+  const std::vector<std::string> expected{
+    "superflow-camera-out-detector-in",
+    "superflow-detector-out-logger-in"
+  };
+  EXPECT_EQ(expected, flow::yaml::getBridgeChannels(config));
+}
+
+TEST(YamlPartition, crossPartitionEdgesAreBridged)
+{
+  const auto factory_map = getFactoryMap();
+
+  const auto capture = flow::yaml::createPartitionGraph(config, "capture", factory_map);
+  EXPECT_EQ(1, capture.getConnections().size());
+  EXPECT_TRUE(contains(capture.getConnections(), {"camera", "out", "camera.out->detector.in", "in"}));
+  EXPECT_EQ(
+    "superflow-camera-out-detector-in",
+    capture.getProxel<PassProxel>("camera.out->detector.in")->getChannel()
+  );
+
+  const auto vision = flow::yaml::createPartitionGraph(config, "vision", factory_map);
+  const auto& connections = vision.getConnections();
+  EXPECT_EQ(3, connections.size());
+  EXPECT_TRUE(contains(connections, {"camera.out->detector.in", "out", "detector", "in"}));
+  EXPECT_TRUE(contains(connections, {"detector", "out", "viewer", "in"}));
+  EXPECT_TRUE(contains(connections, {"detector", "out", "detector.out->logger.in", "in"}));
+  EXPECT_THROW(vision.getProxel("camera"), std::invalid_argument);
+
+  const auto logger = flow::yaml::createPartitionGraph(config, flow::yaml::default_partition, factory_map);
+  EXPECT_TRUE(contains(logger.getConnections(), {"detector.out->logger.in", "out", "logger", "in"}));
+}
+
+TEST(YamlPartition, unbridgedEdgeThrows)
+{
+  YAML::Node unbridged = YAML::Clone(config);
+  unbridged["Bridges"].remove("camera");
+
+  EXPECT_THROW(flow::yaml::createPartitionGraph(unbridged, "capture", getFactoryMap()), std::invalid_argument);
+  EXPECT_NO_THROW(flow::yaml::createPartitionGraph(unbridged, flow::yaml::default_partition, getFactoryMap()));
+}
+
+TEST(YamlPartition, emptyPartitionThrows)
+{
+  EXPECT_THROW(flow::yaml::createPartitionGraph(config, "nonexistent", getFactoryMap()), std::invalid_argument);
+}
+
+TEST(YamlPartition, fusedGroupAcrossPartitionsThrows)
+{
+  YAML::Node fused = YAML::Clone(config);
+  fused["FusedGroups"]["pipeline"] = std::vector<std::string>{"camera", "detector"};
+
+  EXPECT_THROW(flow::yaml::createPartitionGraph(fused, "vision", getFactoryMap()), std::invalid_argument);
+}
+
+TEST(YamlPartition, createGraphIgnoresPartitions)
+{
+  const auto graph = flow::yaml::createGraph(config, getFactoryMap());
+
+  EXPECT_EQ(3, graph.getConnections().size());
+  EXPECT_TRUE(contains(graph.getConnections(), {"camera", "out", "detector", "in"}));
+}
+
+TEST(YamlFusedGroups, disabledMemberThrows)
+{
+  YAML::Node fused = YAML::Clone(config);
+  fused["Proxels"]["camera"]["enable"] = false;
+  fused["FusedGroups"]["pipeline"] = std::vector<std::string>{"camera", "detector"};
+  EXPECT_THROW(flow::yaml::createGraph(fused, getFactoryMap()), std::invalid_argument);
+
+  fused["FusedGroups"]["pipeline"] = std::vector<std::string>{"detector", "camera"};
+  EXPECT_THROW(flow::yaml::createGraph(fused, getFactoryMap()), std::invalid_argument);
+
+  fused["FusedGroups"]["pipeline"] = std::vector<std::string>{"detector", "nonexistent"};
+  EXPECT_THROW(flow::yaml::createGraph(fused, getFactoryMap()), std::invalid_argument);
+}
@@ -0,0 +1,110 @@
+// Copyright 2026, Forsvarets forskningsinstitutt. All rights reserved.
+#include "superflow/yaml/yaml.h"
+
+#include "superflow/callback_consumer_port.h"
+#include "superflow/graph.h"
+#include "superflow/producer_port.h"
+#include "superflow/proxel.h"
+#include "superflow/value.h"
+
+#include "gtest/gtest.h"
+
+namespace
+{
+class NumberProxel : public flow::Proxel
+{
+public:
+  explicit NumberProxel(const int number)
+    : number_{number}
+    , out_port_{std::make_shared<flow::ProducerPort<int>>()}
+    , in_port_{std::make_shared<flow::CallbackConsumerPort<int, flow::ConnectPolicy::Multi>>([](int){})}
+  {
+    registerPorts({{"out", out_port_}, {"in", in_port_}});
+  }
+
+  void start() override
+  {}
+
+  void stop() noexcept override
+  {}
+
+  int getNumber() const
+  { return number_; }
+
+private:
+  int number_;
+  flow::Port::Ptr out_port_;
+  flow::Port::Ptr in_port_;
+};
+
+flow::yaml::FactoryMap getFactoryMap()
+{
+  return flow::yaml::FactoryMap{
+    {
+      {
+        "NumberProxel",
+        [](const flow::yaml::YAMLPropertyList& properties)
+        { return std::make_shared<NumberProxel>(flow::value<int>(properties, "number")); }
+      }
+    }
+  };
+}
+
+const YAML::Node old_config = YAML::Load(R"(
+Proxels:
+  a: {type: NumberProxel, number: 1}
+  b: {type: NumberProxel, number: 2}
+  c: {type: NumberProxel, number: 3}
+Connections:
+  - [a: out, b: in]
+  - [b: out, c: in]
+)");
+
+const YAML::Node new_config = YAML::Load(R"(
+Proxels:
+  a: {type: NumberProxel, number: 1}
+  b: {type: NumberProxel, number: 20}
+  d: {type: NumberProxel, number: 4}
+Connections:
+  - [a: out, b: in]
+  - [b: out, d: in]
+)");
+}
+
+TEST(UpdateGraph, appliesDiffBetweenConfigs)
+{
+  const auto factory_map = getFactoryMap();
+  auto graph = flow::yaml::createGraph(old_config, factory_map);
+
+  const auto a = graph.getProxel("a");
+  const auto old_b = graph.getProxel("b");
+
+  graph.start();
+  ASSERT_NO_THROW(flow::yaml::updateGraph(graph, old_config, new_config, factory_map));
+  graph.stop();
+
+  EXPECT_EQ(a, graph.getProxel("a"));
+  EXPECT_NE(old_b, graph.getProxel("b"));
+  EXPECT_EQ(20, graph.getProxel<NumberProxel>("b")->getNumber());
+  EXPECT_EQ(4, graph.getProxel<NumberProxel>("d")->getNumber());
+  EXPECT_THROW(graph.getProxel("c"), std::invalid_argument);
+
+  const auto& connections = graph.getConnections();
+  ASSERT_EQ(2, connections.size());
+  EXPECT_NE(std::find(connections.begin(), connections.end(), flow::ConnectionSpec{"a", "out", "b", "in"}), connections.end());
+  EXPECT_NE(std::find(connections.begin(), connections.end(), flow::ConnectionSpec{"b", "out", "d", "in"}), connections.end());
+  EXPECT_TRUE(graph.getProxel("a")->getPort("out")->isConnected());
+  EXPECT_TRUE(graph.getProxel("d")->getPort("in")->isConnected());
+}
+
+TEST(UpdateGraph, unchangedConfigLeavesGraphUntouched)
+{
+  const auto factory_map = getFactoryMap();
+  auto graph = flow::yaml::createGraph(old_config, factory_map);
+
+  const auto b = graph.getProxel("b");
+  flow::yaml::updateGraph(graph, old_config, YAML::Clone(old_config), factory_map);
+
+  EXPECT_EQ(b, graph.getProxel("b"));
+  EXPECT_EQ(2, graph.getConnections().size());
+}